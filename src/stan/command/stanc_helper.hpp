@@ -5,13 +5,21 @@
 #include <stan/lang/compiler.hpp>
 #include <stan/lang/compile_functions.hpp>
 #include <stan/io/cmd_line.hpp>
+#include <stan/io/program_reader.hpp>
+#include <boost/cstdint.hpp>
+#include <cstdio>
 #include <exception>
 #include <fstream>
 #include <iostream>
+#include <sstream>
 #include <stdexcept>
 #include <string>
 #include <vector>
-
+#ifdef _WIN32
+#include <process.h>
+#else
+#include <unistd.h>
+#endif
 
 /**
  * Print the version of stanc with major, minor and patch.
@@ -63,6 +71,19 @@ inline void print_stanc_help(std::ostream* out_stream) {
 
   print_help_option(out_stream, "allow_undefined", "",
                     "Do not fail if a function is declared but not defined");
+
+  print_help_option(out_stream, "split", "",
+                    "Split output into a header and separate .cpp files",
+                    "log_prob for double, var, fvar<double> and fvar<var>"
+                    " only");
+
+  print_help_option(out_stream, "cache_dir", "dir",
+                    "Reuse generated C++ for unchanged input from cache in"
+                    " directory");
+
+  print_help_option(out_stream, "sufficient_stats", "",
+                    "Compute sufficient statistics of data for normal,"
+                    " Poisson and Bernoulli sampling statements once");
   // TODO(martincerny) help for standalone function compilation
 }
 
@@ -86,6 +107,141 @@ inline void delete_file(std::ostream* err_stream,
                   << std::endl;
 }
 
+/**
+ * Delete the files at the specified paths, writing messages to
+ * error stream for files that cannot be removed.
+ *
+ * @param[in,out] err_stream stream to which error messages are
+ * written
+ * @param[in] file_names paths of files
+ */
+inline void delete_files(std::ostream* err_stream,
+                         const std::vector<std::string>& file_names) {
+  for (size_t i = 0; i < file_names.size(); ++i)
+    delete_file(err_stream, file_names[i]);
+}
+
+/**
+ * Return a key identifying the compilation of the specified program
+ * with the specified options.  The key is a 64-bit FNV-1a hash,
+ * written as 16 hexadecimal digits, of the stanc version, the
+ * options, the include history and the program text after include
+ * expansion.  The input stream is rewound so that it may be read
+ * again by the compiler.
+ *
+ * @param[in,out] in stream from which the program is read
+ * @param[in] in_file_name name of the program file
+ * @param[in] include_paths paths to search for included files
+ * @param[in] options options that affect the generated code
+ * @return cache key for the compilation
+ */
+inline std::string compile_cache_key(std::istream& in,
+                                     const std::string& in_file_name,
+                                     const std::vector<std::string>&
+                                     include_paths,
+                                     const std::vector<std::string>& options) {
+  stan::io::program_reader reader(in, in_file_name, include_paths);
+  in.clear();
+  in.seekg(0, std::ios::beg);
+
+  std::stringstream ss;
+  ss << stan::MAJOR_VERSION << "." << stan::MINOR_VERSION
+     << "." << stan::PATCH_VERSION << '\0';
+  for (size_t i = 0; i < options.size(); ++i)
+    ss << options[i] << '\0';
+  std::vector<stan::io::preproc_event> history = reader.history();
+  for (size_t i = 0; i < history.size(); ++i)
+    ss << history[i].concat_line_num_ << ' ' << history[i].line_num_
+       << ' ' << history[i].action_ << ' ' << history[i].path_ << '\0';
+  ss << reader.program();
+
+  std::string text = ss.str();
+  boost::uint64_t hash = 14695981039346656037ULL;
+  for (size_t i = 0; i < text.size(); ++i) {
+    hash ^= static_cast<unsigned char>(text[i]);
+    hash *= 1099511628211ULL;
+  }
+  static const char* digits = "0123456789abcdef";
+  std::string key(16, '0');
+  for (int i = 15; i >= 0; --i, hash >>= 4)
+    key[i] = digits[hash & 0xf];
+  return key;
+}
+
+/**
+ * Read the compiler messages and generated outputs stored in the
+ * compile cache file at the specified path, returning
+ * <code>true</code> if the file exists and is complete.
+ *
+ * @param[in] path path of cache file
+ * @param[out] messages compiler messages
+ * @param[out] outputs generated outputs
+ * @return true if cache entry was read
+ */
+inline bool read_compile_cache(const std::string& path,
+                               std::string& messages,
+                               std::vector<std::string>& outputs) {
+  std::ifstream in(path.c_str(), std::ios::in | std::ios::binary);
+  if (!in.is_open())
+    return false;
+  std::string header;
+  size_t num_parts;
+  if (!std::getline(in, header) || header != "stanc-cache 1"
+      || !(in >> num_parts) || num_parts == 0)
+    return false;
+  std::vector<std::string> parts(num_parts);
+  for (size_t i = 0; i < num_parts; ++i) {
+    size_t size;
+    if (!(in >> size) || in.get() != '\n')
+      return false;
+    parts[i].resize(size);
+    if (size > 0 && !in.read(&parts[i][0], size))
+      return false;
+  }
+  std::string trailer;
+  if (!(in >> trailer) || trailer != "end")
+    return false;
+  messages = parts[0];
+  outputs.assign(parts.begin() + 1, parts.end());
+  return true;
+}
+
+/**
+ * Store the specified compiler messages and generated outputs in
+ * the compile cache file at the specified path.  The entry is
+ * written to a temporary file named after the process and renamed
+ * into place, so that concurrent writers of the same entry do not
+ * interleave and concurrent readers never see a partial entry.
+ * Failure to write the cache is not an error.
+ *
+ * @param[in] path path of cache file
+ * @param[in] messages compiler messages
+ * @param[in] outputs generated outputs
+ */
+inline void write_compile_cache(const std::string& path,
+                                const std::string& messages,
+                                const std::vector<std::string>& outputs) {
+#ifdef _WIN32
+  int pid = _getpid();
+#else
+  int pid = getpid();
+#endif
+  std::stringstream tmp_name;
+  tmp_name << path << "." << pid << ".tmp";
+  std::string tmp_path = tmp_name.str();
+  std::ofstream out(tmp_path.c_str(), std::ios::out | std::ios::binary);
+  if (!out.is_open())
+    return;
+  out << "stanc-cache 1\n" << (outputs.size() + 1) << "\n";
+  out << messages.size() << "\n" << messages;
+  for (size_t i = 0; i < outputs.size(); ++i)
+    out << outputs[i].size() << "\n" << outputs[i];
+  out << "\nend\n";
+  out.close();
+  if (!out || std::rename(tmp_path.c_str(), path.c_str()) != 0)
+    std::remove(tmp_path.c_str());
+}
+
 /**
  * Transform a provided input file name into a valid C++ identifier
  * @param[in] in_file_name the name of the input file
@@ -189,6 +345,7 @@ inline int stanc_helper(int argc, const char* argv[],
   static const int INVALID_ARGUMENT_RC = -3;
 
   std::string out_file_name;  // declare outside of try to delete in catch
+  std::vector<std::string> split_file_names;
 
   try {
     stan::io::cmd_line cmd(argc, argv);
@@ -229,6 +386,7 @@ inline int stanc_helper(int argc, const char* argv[],
     include_paths.push_back("");
 
     bool allow_undefined = cmd.has_flag("allow_undefined");
+    bool sufficient_stats = cmd.has_flag("sufficient_stats");
 
     bool valid_input = false;
 
@@ -253,23 +411,125 @@ inline int stanc_helper(int argc, const char* argv[],
 
       check_identifier(model_name, "model_name");
 
-      std::fstream out(out_file_name.c_str(), std::fstream::out);
+      bool split = cmd.has_flag("split");
+      if (split) {
+        std::string base_name = out_file_name;
+        if (has_extension(base_name, "cpp") || has_extension(base_name, "hpp"))
+          base_name.erase(base_name.size() - 4);
+        out_file_name.clear();
+        split_file_names.push_back(base_name + ".hpp");
+        split_file_names.push_back(base_name + "_functions.cpp");
+        split_file_names.push_back(base_name + "_ctor.cpp");
+        split_file_names.push_back(base_name + "_log_prob_var.cpp");
+        split_file_names.push_back(base_name + "_log_prob_double.cpp");
+        split_file_names.push_back(base_name + "_log_prob_fvar.cpp");
+        split_file_names.push_back(base_name + "_write_array.cpp");
+      }
+
       if (out_stream) {
         *out_stream << "Model name=" << model_name << std::endl;
         *out_stream << "Input file=" << in_file_name << std::endl;
-        *out_stream << "Output file=" << out_file_name << std::endl;
+        if (split)
+          for (size_t i = 0; i < split_file_names.size(); ++i)
+            *out_stream << "Output file=" << split_file_names[i]
+                        << std::endl;
+        else
+          *out_stream << "Output file=" << out_file_name << std::endl;
       }
-      if (!out.is_open()) {
-        std::stringstream msg;
-        msg << "Failed to open output file "
-            <<  out_file_name.c_str();
-        throw std::invalid_argument(msg.str());
+
+      std::fstream out;
+      if (!split) {
+        out.open(out_file_name.c_str(), std::fstream::out);
+        if (!out.is_open()) {
+          std::stringstream msg;
+          msg << "Failed to open output file "
+              <<  out_file_name.c_str();
+          throw std::invalid_argument(msg.str());
+        }
       }
 
-      valid_input = stan::lang::compile(err_stream, in, out, model_name,
-                                        allow_undefined, in_file_name,
-                                        include_paths);
-      out.close();
+      std::string header_name;
+      if (split) {
+        size_t slash_pos = split_file_names[0].find_last_of("/\\");
+        header_name = slash_pos == std::string::npos
+          ? split_file_names[0]
+          : split_file_names[0].substr(slash_pos + 1);
+      }
+      size_t num_outputs = split ? split_file_names.size() : 1;
+
+      std::string cache_file;
+      if (cmd.has_key("cache_dir")) {
+        std::string cache_dir;
+        cmd.val("cache_dir", cache_dir);
+        std::vector<std::string> options;
+        options.push_back(model_name);
+        options.push_back(in_file_name);
+        options.push_back(allow_undefined ? "allow_undefined" : "");
+        options.push_back(split ? "split=" + header_name : "");
+        options.push_back(sufficient_stats ? "sufficient_stats" : "");
+        cache_file = cache_dir + "/"
+          + compile_cache_key(in, in_file_name, include_paths, options)
+          + ".stanc";
+      }
+
+      std::string messages;
+      std::vector<std::string> outputs;
+      if (!cache_file.empty()
+          && read_compile_cache(cache_file, messages, outputs)
+          && outputs.size() == num_outputs) {
+        valid_input = true;
+      } else {
+        std::stringstream msgs;
+        std::stringstream outs[7];
+        try {
+          if (split)
+            valid_input = stan::lang::compile_split(&msgs, in, header_name,
+                                                    outs[0], outs[1],
+                                                    outs[2], outs[3],
+                                                    outs[4], outs[5],
+                                                    outs[6], model_name,
+                                                    allow_undefined,
+                                                    in_file_name,
+                                                    include_paths,
+                                                    sufficient_stats);
+          else
+            valid_input = stan::lang::compile(&msgs, in, outs[0],
+                                              model_name, allow_undefined,
+                                              in_file_name, include_paths,
+                                              sufficient_stats);
+        } catch (...) {
+          // warnings written before the failure are not in its message
+          if (err_stream)
+            *err_stream << msgs.str();
+          throw;
+        }
+        messages = msgs.str();
+        outputs.clear();
+        for (size_t i = 0; i < num_outputs; ++i)
+          outputs.push_back(outs[i].str());
+        if (valid_input && !cache_file.empty())
+          write_compile_cache(cache_file, messages, outputs);
+      }
+      if (err_stream)
+        *err_stream << messages;
+
+      if (!split) {
+        out << outputs[0];
+        out.close();
+        break;
+      }
+      for (size_t i = 0; valid_input && i < split_file_names.size(); ++i) {
+        std::fstream split_out(split_file_names[i].c_str(),
+                               std::fstream::out);
+        if (!split_out.is_open()) {
+          std::stringstream msg;
+          msg << "Failed to open output file "
+              <<  split_file_names[i].c_str();
+          throw std::invalid_argument(msg.str());
+        }
+        split_out << outputs[i];
+        split_out.close();
+      }
       break;
     }
     case kStandaloneFunctions: {
@@ -330,6 +590,7 @@ inline int stanc_helper(int argc, const char* argv[],
         *err_stream << "PARSING FAILED." << std::endl;
       // FIXME: how to remove triple cut-and-paste?
       delete_file(out_stream, out_file_name);
+      delete_files(out_stream, split_file_names);
       return PARSE_FAIL_RC;
     }
   } catch (const std::invalid_argument& e) {
@@ -338,6 +599,7 @@ inline int stanc_helper(int argc, const char* argv[],
                   << e.what()
                   << std::endl;
       delete_file(out_stream, out_file_name);
+      delete_files(out_stream, split_file_names);
     }
     return INVALID_ARGUMENT_RC;
   } catch (const std::exception& e) {
@@ -347,6 +609,7 @@ inline int stanc_helper(int argc, const char* argv[],
                   << std::endl;
     }
     delete_file(out_stream, out_file_name);
+    delete_files(out_stream, split_file_names);
     return EXCEPTION_RC;
   }
   return SUCCESS_RC;
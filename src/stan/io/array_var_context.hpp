@@ -180,16 +180,30 @@ namespace stan {
         if (contains_r_only(name)) {
           return (vars_r_.find(name)->second).first;
         } else if (contains_i(name)) {
-          std::vector<int> vec_int = (vars_i_.find(name)->second).first;
-          std::vector<double> vec_r(vec_int.size());
-          for (size_t ii = 0; ii < vec_int.size(); ii++) {
-            vec_r[ii] = vec_int[ii];
-          }
-          return vec_r;
+          const std::vector<int>& vec_int
+            = (vars_i_.find(name)->second).first;
+          return std::vector<double>(vec_int.begin(), vec_int.end());
         }
         return empty_vec_r_;
       }
 
+      /**
+       * Return a view of the double values for the variable with the
+       * specified name, pointing into this context's storage.
+       *
+       * @param name Name of variable.
+       * @return View of values of variable.
+       */
+      array_view<double> vals_r_view(const std::string& name) const {
+        if (contains_r_only(name)) {
+          return array_view<double>::of((vars_r_.find(name)->second).first);
+        } else if (contains_i(name)) {
+          return array_view<double>
+            ::converting((vars_i_.find(name)->second).first);
+        }
+        return array_view<double>();
+      }
+
       /**
        * Return the dimensions for the double variable with the specified
        * name.
@@ -220,6 +234,20 @@ namespace stan {
         return empty_vec_i_;
       }
 
+      /**
+       * Return a view of the integer values for the variable with the
+       * specified name, pointing into this context's storage.
+       *
+       * @param name Name of variable.
+       * @return View of values of variable.
+       */
+      array_view<int> vals_i_view(const std::string& name) const {
+        if (contains_i(name)) {
+          return array_view<int>::of((vars_i_.find(name)->second).first);
+        }
+        return array_view<int>();
+      }
+
       /**
        * Return the dimensions for the integer variable with the specified
        * name.
@@ -0,0 +1,150 @@
+#ifndef STAN_IO_ARRAY_VIEW_HPP
+#define STAN_IO_ARRAY_VIEW_HPP
+
+#include <boost/shared_ptr.hpp>
+#include <cstddef>
+#include <vector>
+
+namespace stan {
+  namespace io {
+
+    /**
+     * A read-only view of the values of a variable in a
+     * <code>var_context</code>, in last-index-major order.
+     *
+     * <p>A view usually points into the storage of the context that
+     * returned it and is valid only as long as that context is
+     * neither destroyed nor modified.  A view of integer values read
+     * as floating point values converts them as they are indexed
+     * rather than copying them.  Contexts that have no storage to
+     * point into return a view that owns its values.
+     *
+     * @tparam T type of values
+     */
+    template <typename T>
+    class array_view {
+    private:
+      const T* data_;
+      const int* ints_;
+      size_t size_;
+      boost::shared_ptr<const std::vector<T> > owned_;
+
+    public:
+      /**
+       * Construct an empty view.
+       */
+      array_view() : data_(0), ints_(0), size_(0) { }
+
+      /**
+       * Return a view of the specified values, which must outlive the
+       * view.
+       *
+       * @param values Values to view.
+       * @return View of the values.
+       */
+      static array_view<T> of(const std::vector<T>& values) {
+        return of(values.empty() ? 0 : &values[0], values.size());
+      }
+
+      /**
+       * Return a view of the specified number of values starting at
+       * the specified pointer, which must outlive the view.
+       *
+       * @param data Pointer to first value.
+       * @param size Number of values.
+       * @return View of the values.
+       */
+      static array_view<T> of(const T* data, size_t size) {
+        array_view<T> view;
+        view.data_ = size == 0 ? 0 : data;
+        view.size_ = size;
+        return view;
+      }
+
+      /**
+       * Return a view of the specified integer values, converted to
+       * <code>T</code> as they are indexed.  The values must outlive
+       * the view.
+       *
+       * @param values Values to view.
+       * @return View of the values.
+       */
+      static array_view<T> converting(const std::vector<int>& values) {
+        return converting(values.empty() ? 0 : &values[0], values.size());
+      }
+
+      /**
+       * Return a view of the specified number of integer values
+       * starting at the specified pointer, converted to
+       * <code>T</code> as they are indexed.  The values must outlive
+       * the view.
+       *
+       * @param data Pointer to first value.
+       * @param size Number of values.
+       * @return View of the values.
+       */
+      static array_view<T> converting(const int* data, size_t size) {
+        array_view<T> view;
+        view.ints_ = size == 0 ? 0 : data;
+        view.size_ = size;
+        return view;
+      }
+
+      /**
+       * Return a view that owns the specified values.  The values are
+       * swapped out of the argument, which is left empty.
+       *
+       * @param values Values to own.
+       * @return View of the values.
+       */
+      static array_view<T> owning(std::vector<T>& values) {
+        boost::shared_ptr<std::vector<T> > owned(new std::vector<T>());
+        owned->swap(values);
+        array_view<T> view = of(*owned);
+        view.owned_ = owned;
+        return view;
+      }
+
+      /**
+       * Return the number of values.
+       *
+       * @return Number of values.
+       */
+      size_t size() const {
+        return size_;
+      }
+
+      /**
+       * Return <code>true</code> if there are no values.
+       *
+       * @return <code>true</code> if there are no values.
+       */
+      bool empty() const {
+        return size_ == 0;
+      }
+
+      /**
+       * Return the value at the specified position.
+       *
+       * @param i Position.
+       * @return Value.
+       */
+      T operator[](size_t i) const {
+        return ints_ ? static_cast<T>(ints_[i]) : data_[i];
+      }
+
+      /**
+       * Return a copy of the values.
+       *
+       * @return Values.
+       */
+      std::vector<T> to_vector() const {
+        if (ints_)
+          return std::vector<T>(ints_, ints_ + size_);
+        return std::vector<T>(data_, data_ + size_);
+      }
+    };
+
+  }
+}
+#endif
@@ -0,0 +1,428 @@
+#ifndef STAN_IO_BINARY_VAR_CONTEXT_HPP
+#define STAN_IO_BINARY_VAR_CONTEXT_HPP
+
+#include <stan/io/array_view.hpp>
+#include <stan/io/little_endian.hpp>
+#include <stan/io/var_context.hpp>
+#include <boost/cstdint.hpp>
+#include <boost/throw_exception.hpp>
+#include <cstring>
+#include <fstream>
+#include <iterator>
+#include <limits>
+#include <map>
+#include <mutex>
+#include <new>
+#include <sstream>
+#include <stdexcept>
+#include <string>
+#include <vector>
+#ifndef _WIN32
+#include <fcntl.h>
+#include <sys/mman.h>
+#include <sys/stat.h>
+#include <unistd.h>
+#endif
+
+namespace stan {
+  namespace io {
+
+    /**
+     * A <code>binary_var_context</code> reads variables from a binary
+     * data container.
+     *
+     * <p>A container consists of a header followed by the values of
+     * each variable.  All numbers are stored in little-endian byte
+     * order.  The header is
+     *
+     * <ul>
+     * <li>the eight characters <code>STANDATA</code>,</li>
+     * <li>the format version, a 32-bit integer, currently 1,</li>
+     * <li>the number of variables, a 32-bit integer,</li>
+     * </ul>
+     *
+     * followed by, for each variable,
+     *
+     * <ul>
+     * <li>the length of its name in bytes, a 32-bit integer,</li>
+     * <li>the characters of its name,</li>
+     * <li>its type, a 32-bit integer, 0 for integer and 1 for real
+     * values,</li>
+     * <li>the number of its dimensions, a 32-bit integer,</li>
+     * <li>each of its dimensions, as 64-bit integers,</li>
+     * <li>the position of its values from the start of the
+     * container, a 64-bit integer that is a multiple of 8.</li>
+     * </ul>
+     *
+     * <p>The values of a variable are stored in last-index-major
+     * order as 32-bit two's complement integers or 64-bit IEEE 754
+     * floating point values.  Containers are written by
+     * <code>write_binary_var_context()</code>.
+     *
+     * <p>A container file is mapped into memory rather than read, so
+     * only the header is read when the context is constructed and
+     * the values of a variable are read from the file as they are
+     * first accessed.  On little-endian hosts the views returned by
+     * <code>vals_r_view()</code> and <code>vals_i_view()</code> point
+     * directly into the mapped file; on other hosts the values of a
+     * variable are converted on first access and kept.  On Windows
+     * the file is read into memory.
+     */
+    class binary_var_context : public var_context {
+    private:
+      struct variable {
+        bool is_int_;
+        std::vector<size_t> dims_;
+        size_t size_;
+        size_t offset_;
+      };
+
+      std::map<std::string, variable> vars_;
+      const char* data_;
+      size_t size_;
+      void* map_;
+      char* owned_;
+      bool native_;
+      mutable std::map<std::string, std::vector<double> > decoded_r_;
+      mutable std::map<std::string, std::vector<int> > decoded_i_;
+      mutable std::mutex decode_mutex_;
+
+      binary_var_context(const binary_var_context&);
+      binary_var_context& operator=(const binary_var_context&);
+
+      void invalid(const std::string& msg) const {
+        BOOST_THROW_EXCEPTION(std::invalid_argument("binary data: " + msg));
+      }
+
+      void copy(const char* begin, const char* end) {
+        size_ = end - begin;
+        owned_ = static_cast<char*>(::operator new(size_ == 0 ? 1 : size_));
+        if (size_ > 0)
+          std::memcpy(owned_, begin, size_);
+        data_ = owned_;
+      }
+
+      void release() {
+#ifndef _WIN32
+        if (map_)
+          ::munmap(map_, size_);
+#endif
+        if (owned_)
+          ::operator delete(owned_);
+        map_ = 0;
+        owned_ = 0;
+      }
+
+      void open(const std::string& path) {
+#ifdef _WIN32
+        std::ifstream in(path.c_str(), std::ios::in | std::ios::binary);
+        if (!in)
+          invalid("cannot open " + path);
+        std::string text((std::istreambuf_iterator<char>(in)),
+                         std::istreambuf_iterator<char>());
+        copy(text.data(), text.data() + text.size());
+#else
+        int fd = ::open(path.c_str(), O_RDONLY);
+        if (fd < 0)
+          invalid("cannot open " + path);
+        struct stat st;
+        if (::fstat(fd, &st) != 0) {
+          ::close(fd);
+          invalid("cannot read " + path);
+        }
+        size_ = static_cast<size_t>(st.st_size);
+        if (size_ == 0) {
+          ::close(fd);
+          data_ = "";
+          return;
+        }
+        void* map = ::mmap(0, size_, PROT_READ, MAP_PRIVATE, fd, 0);
+        ::close(fd);
+        if (map == MAP_FAILED)
+          invalid("cannot map " + path);
+        map_ = map;
+        data_ = static_cast<const char*>(map);
+#endif
+      }
+
+      boost::uint32_t read_32(size_t& pos) const {
+        if (size_ - pos < 4)
+          invalid("header is truncated");
+        boost::uint32_t n = read_little_endian_32(data_ + pos);
+        pos += 4;
+        return n;
+      }
+
+      size_t read_size(size_t& pos) const {
+        if (size_ - pos < 8)
+          invalid("header is truncated");
+        boost::uint64_t n = read_little_endian_64(data_ + pos);
+        pos += 8;
+        if (n > std::numeric_limits<size_t>::max())
+          invalid("size out of range");
+        return static_cast<size_t>(n);
+      }
+
+      void read_header() {
+        if (size_ < 16 || std::memcmp(data_, "STANDATA", 8) != 0)
+          invalid("not a binary data container");
+        size_t pos = 8;
+        boost::uint32_t version = read_32(pos);
+        if (version != 1) {
+          std::stringstream msg;
+          msg << "unsupported format version " << version;
+          invalid(msg.str());
+        }
+        boost::uint32_t num_vars = read_32(pos);
+        for (boost::uint32_t n = 0; n < num_vars; ++n) {
+          boost::uint32_t name_length = read_32(pos);
+          if (size_ - pos < name_length)
+            invalid("header is truncated");
+          std::string name(data_ + pos, name_length);
+          pos += name_length;
+          if (vars_.find(name) != vars_.end())
+            invalid("variable " + name + " is defined twice");
+          variable& var = vars_[name];
+          boost::uint32_t type = read_32(pos);
+          if (type > 1)
+            invalid("variable " + name + " has an unknown type");
+          var.is_int_ = type == 0;
+          boost::uint32_t num_dims = read_32(pos);
+          var.size_ = 1;
+          for (boost::uint32_t k = 0; k < num_dims; ++k) {
+            size_t dim = read_size(pos);
+            if (dim > 0 && var.size_ > size_ / dim)
+              invalid("variable " + name + " is truncated");
+            var.dims_.push_back(dim);
+            var.size_ *= dim;
+          }
+          var.offset_ = read_size(pos);
+          size_t width = var.is_int_ ? 4 : 8;
+          if (var.offset_ % 8 != 0)
+            invalid("variable " + name + " is not aligned");
+          if (var.offset_ > size_ || var.size_ > (size_ - var.offset_) / width)
+            invalid("variable " + name + " is truncated");
+        }
+      }
+
+      void init() {
+        native_ = host_is_little_endian();
+        try {
+          read_header();
+        } catch (...) {
+          release();
+          throw;
+        }
+      }
+
+      const variable* find(const std::string& name) const {
+        std::map<std::string, variable>::const_iterator it = vars_.find(name);
+        return it == vars_.end() ? 0 : &it->second;
+      }
+
+      const int* ints(const std::string& name, const variable& var) const {
+        const char* p = data_ + var.offset_;
+        if (native_)
+          return reinterpret_cast<const int*>(p);
+        std::lock_guard<std::mutex> lock(decode_mutex_);
+        std::vector<int>& vals = decoded_i_[name];
+        if (vals.size() != var.size_) {
+          vals.resize(var.size_);
+          for (size_t i = 0; i < var.size_; ++i) {
+            boost::uint32_t bits = read_little_endian_32(p + 4 * i);
+            std::memcpy(&vals[i], &bits, 4);
+          }
+        }
+        return vals.empty() ? 0 : &vals[0];
+      }
+
+      const double* reals(const std::string& name,
+                          const variable& var) const {
+        const char* p = data_ + var.offset_;
+        if (native_)
+          return reinterpret_cast<const double*>(p);
+        std::lock_guard<std::mutex> lock(decode_mutex_);
+        std::vector<double>& vals = decoded_r_[name];
+        if (vals.size() != var.size_) {
+          vals.resize(var.size_);
+          for (size_t i = 0; i < var.size_; ++i) {
+            boost::uint64_t bits = read_little_endian_64(p + 8 * i);
+            std::memcpy(&vals[i], &bits, 8);
+          }
+        }
+        return vals.empty() ? 0 : &vals[0];
+      }
+
+      void list_names(bool is_int, std::vector<std::string>& names) const {
+        names.resize(0);
+        for (std::map<std::string, variable>::const_iterator it
+               = vars_.begin();
+             it != vars_.end(); ++it)
+          if (it->second.is_int_ == is_int)
+            names.push_back(it->first);
+      }
+
+    public:
+      /**
+       * Construct a context from the binary data container in the
+       * file with the specified path.  The file is mapped into memory
+       * and must not be modified while the context exists.
+       *
+       * @param path Path of container file.
+       * @throw std::invalid_argument if the file cannot be opened or
+       * is not a valid container.
+       */
+      explicit binary_var_context(const std::string& path)
+        : data_(0), size_(0), map_(0), owned_(0), native_(false) {
+        open(path);
+        init();
+      }
+
+      /**
+       * Construct a context from a copy of the binary data container
+       * held in the specified range of characters.
+       *
+       * @param begin Pointer to first character.
+       * @param end Pointer to one past last character.
+       * @throw std::invalid_argument if the characters are not a
+       * valid container.
+       */
+      binary_var_context(const char* begin, const char* end)
+        : data_(0), size_(0), map_(0), owned_(0), native_(false) {
+        copy(begin, end);
+        init();
+      }
+
+      ~binary_var_context() {
+        release();
+      }
+
+      /**
+       * Return <code>true</code> if the specified variable name is
+       * defined, whether its values are integers or real.
+       *
+       * @param name Name of variable.
+       * @return <code>true</code> if the variable exists.
+       */
+      bool contains_r(const std::string& name) const {
+        return find(name) != 0;
+      }
+
+      /**
+       * Return <code>true</code> if a variable with the specified
+       * name is defined with integer values.
+       *
+       * @param name Name of variable.
+       * @return <code>true</code> if the variable exists with integer
+       * values.
+       */
+      bool contains_i(const std::string& name) const {
+        const variable* var = find(name);
+        return var != 0 && var->is_int_;
+      }
+
+      /**
+       * Return the floating point values for the variable with the
+       * specified name, or an empty vector if it is not defined.
+       *
+       * @param name Name of variable.
+       * @return Values of variable.
+       */
+      std::vector<double> vals_r(const std::string& name) const {
+        return vals_r_view(name).to_vector();
+      }
+
+      /**
+       * Return a view of the floating point values for the variable
+       * with the specified name, or an empty view if it is not
+       * defined.
+       *
+       * @param name Name of variable.
+       * @return View of values of variable.
+       */
+      array_view<double> vals_r_view(const std::string& name) const {
+        const variable* var = find(name);
+        if (var == 0)
+          return array_view<double>();
+        if (var->is_int_)
+          return array_view<double>::converting(ints(name, *var),
+                                                var->size_);
+        return array_view<double>::of(reals(name, *var), var->size_);
+      }
+
+      /**
+       * Return the dimensions of the variable with the specified
+       * name, or an empty vector if it is not defined.
+       *
+       * @param name Name of variable.
+       * @return Dimensions of variable.
+       */
+      std::vector<size_t> dims_r(const std::string& name) const {
+        const variable* var = find(name);
+        return var == 0 ? std::vector<size_t>() : var->dims_;
+      }
+
+      /**
+       * Return the integer values for the variable with the specified
+       * name, or an empty vector if it is not defined with integer
+       * values.
+       *
+       * @param name Name of variable.
+       * @return Values of variable.
+       */
+      std::vector<int> vals_i(const std::string& name) const {
+        return vals_i_view(name).to_vector();
+      }
+
+      /**
+       * Return a view of the integer values for the variable with the
+       * specified name, or an empty view if it is not defined with
+       * integer values.
+       *
+       * @param name Name of variable.
+       * @return View of values of variable.
+       */
+      array_view<int> vals_i_view(const std::string& name) const {
+        const variable* var = find(name);
+        if (var == 0 || !var->is_int_)
+          return array_view<int>();
+        return array_view<int>::of(ints(name, *var), var->size_);
+      }
+
+      /**
+       * Return the dimensions of the integer variable with the
+       * specified name, or an empty vector if it is not defined with
+       * integer values.
+       *
+       * @param name Name of variable.
+       * @return Dimensions of variable.
+       */
+      std::vector<size_t> dims_i(const std::string& name) const {
+        const variable* var = find(name);
+        if (var == 0 || !var->is_int_)
+          return std::vector<size_t>();
+        return var->dims_;
+      }
+
+      /**
+       * Return the names of the variables with real values.
+       *
+       * @param names Vector to store the list of names in.
+       */
+      void names_r(std::vector<std::string>& names) const {
+        list_names(false, names);
+      }
+
+      /**
+       * Return the names of the variables with integer values.
+       *
+       * @param names Vector to store the list of names in.
+       */
+      void names_i(std::vector<std::string>& names) const {
+        list_names(true, names);
+      }
+    };
+
+  }
+}
+#endif
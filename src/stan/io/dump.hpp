@@ -1,6 +1,8 @@
 #ifndef STAN_IO_DUMP_HPP
 #define STAN_IO_DUMP_HPP
 
+#include <stan/io/parse_double.hpp>
+#include <stan/io/read_stream.hpp>
 #include <stan/io/validate_zero_buf.hpp>
 #include <stan/io/var_context.hpp>
 #include <stan/math/prim/mat.hpp>
@@ -10,6 +12,7 @@
 #include <boost/type_traits/is_integral.hpp>
 #include <boost/type_traits/is_arithmetic.hpp>
 #include <boost/utility/enable_if.hpp>
+#include <algorithm>
 #include <iostream>
 #include <limits>
 #include <map>
@@ -115,20 +118,46 @@ namespace stan {
      */
     class dump_reader {
     private:
+      std::string text_;
+      const char* p_;
+      const char* end_;
       std::string buf_;
       std::string name_;
       std::vector<int> stack_i_;
       std::vector<double> stack_r_;
       std::vector<size_t> dims_;
-      std::istream& in_;
+
+      // the scan position may point into text_, so readers are not
+      // copied
+      dump_reader(const dump_reader&);
+      dump_reader& operator=(const dump_reader&);
+
+      static bool is_space(char c) {
+        return std::isspace(static_cast<unsigned char>(c)) != 0;
+      }
+
+      static bool is_digit(char c) {
+        return c >= '0' && c <= '9';
+      }
+
+      // next character without skipping whitespace
+      bool get(char& c) {
+        if (p_ >= end_) return false;
+        c = *p_++;
+        return true;
+      }
+
+      // next non-whitespace character
+      bool get_non_ws(char& c) {
+        while (p_ < end_ && is_space(*p_))
+          ++p_;
+        return get(c);
+      }
 
       bool scan_single_char(char c_expected) {
-        int c = in_.peek();
-        if (in_.fail()) return false;
-        if (c != c_expected)
+        if (p_ >= end_ || *p_ != c_expected)
           return false;
-        char c_skip;
-        in_.get(c_skip);
+        ++p_;
         return true;
       }
 
@@ -141,12 +170,12 @@ namespace stan {
           return false;
       }
 
+      // skips whitespace even if the character does not match
       bool scan_char(char c_expected) {
         char c;
-        in_ >> c;
-        if (in_.fail()) return false;
+        if (!get_non_ws(c)) return false;
         if (c != c_expected) {
-          in_.putback(c);
+          --p_;
           return false;
         }
         return true;
@@ -154,15 +183,14 @@ namespace stan {
 
       bool scan_name_unquoted() {
         char c;
-        in_ >> c;
-        if (in_.fail()) return false;
+        if (!get_non_ws(c)) return false;
         if (!std::isalpha(c)) return false;
         name_.push_back(c);
-        while (in_.get(c)) {  // get turns off auto space skip
+        while (get(c)) {
           if (std::isalpha(c) || std::isdigit(c) || c == '_' || c == '.') {
             name_.push_back(c);
           } else {
-            in_.putback(c);
+            --p_;
             return true;
           }
         }
@@ -182,65 +210,54 @@ namespace stan {
         return true;
       }
 
-
+      // skips whitespace even if the characters do not match
       bool scan_chars(const char *s, bool case_sensitive = true) {
+        while (p_ < end_ && is_space(*p_))
+          ++p_;
+        const char* start = p_;
         for (size_t i = 0; s[i]; ++i) {
           char c;
-          if (!(in_ >> c)) {
-            for (size_t j = 1; j < i; ++j)
-              in_.putback(s[i-j]);
-            return false;
-          }
           // all ASCII, so toupper is OK
-          if ((case_sensitive && c != s[i])
+          if (!get_non_ws(c)
+              || (case_sensitive && c != s[i])
               || (!case_sensitive && ::toupper(c) != ::toupper(s[i]))) {
-            in_.putback(c);
-            for (size_t j = 1; j < i; ++j)
-              in_.putback(s[i-j]);
+            p_ = start;
             return false;
           }
         }
         return true;
       }
 
-      bool scan_chars(std::string s, bool case_sensitive = true) {
-        for (size_t i = 0; i < s.size(); ++i) {
-          char c;
-          if (!(in_ >> c)) {
-            for (size_t j = 1; j < i; ++j)
-              in_.putback(s[i-j]);
-            return false;
-          }
-          // all ASCII, so toupper is OK
-          if ((case_sensitive && c != s[i])
-              || (!case_sensitive && ::toupper(c) != ::toupper(s[i]))) {
-            in_.putback(c);
-            for (size_t j = 1; j < i; ++j)
-              in_.putback(s[i-j]);
-            return false;
-          }
-        }
-        return true;
+      bool scan_chars(const std::string& s, bool case_sensitive = true) {
+        return scan_chars(s.c_str(), case_sensitive);
       }
 
-      size_t scan_dim() {
-        char c;
+      // digits, skipping any whitespace between them, into buf_
+      void scan_digits() {
         buf_.clear();
-        while (in_.get(c)) {
-          if (std::isspace(c)) continue;
-          if (std::isdigit(c)) {
+        char c;
+        while (get(c)) {
+          if (is_space(c)) continue;
+          if (is_digit(c)) {
             buf_.push_back(c);
           } else {
-            in_.putback(c);
+            --p_;
             break;
           }
         }
+      }
+
+      size_t scan_dim() {
+        scan_digits();
         scan_optional_long();
         size_t d = 0;
-        try {
-          d = boost::lexical_cast<size_t>(buf_);
+        bool ok = buf_.size() > 0;
+        for (size_t i = 0; ok && i < buf_.size(); ++i) {
+          size_t digit = buf_[i] - '0';
+          ok = d <= (std::numeric_limits<size_t>::max() - digit) / 10;
+          d = 10 * d + digit;
         }
-        catch ( const boost::bad_lexical_cast &exc ) {
+        if (!ok) {
           std::string msg = "value " + buf_ + " beyond array dimension range";
           BOOST_THROW_EXCEPTION(std::invalid_argument(msg));
         }
@@ -248,26 +265,20 @@ namespace stan {
       }
 
       int scan_int() {
-        char c;
-        buf_.clear();
-        while (in_.get(c)) {
-          if (std::isspace(c)) continue;
-          if (std::isdigit(c)) {
-            buf_.push_back(c);
-          } else {
-            in_.putback(c);
-            break;
-          }
-        }
+        scan_digits();
         return(get_int());
       }
 
       int get_int() {
+        // buf_ holds digits only
         int n = 0;
-        try {
-          n = boost::lexical_cast<int>(buf_);
+        bool ok = buf_.size() > 0;
+        for (size_t i = 0; ok && i < buf_.size(); ++i) {
+          int digit = buf_[i] - '0';
+          ok = n <= (std::numeric_limits<int>::max() - digit) / 10;
+          n = 10 * n + digit;
         }
-        catch ( const boost::bad_lexical_cast &exc ) {
+        if (!ok) {
           std::string msg = "value " + buf_ + " beyond int range";
           BOOST_THROW_EXCEPTION(std::invalid_argument(msg));
         }
@@ -276,31 +287,54 @@ namespace stan {
 
       double scan_double() {
         double x = 0;
+        bool ok = parse_double(buf_, x);
         try {
-          x = boost::lexical_cast<double>(buf_);
-          if (x == 0)
+          if (ok && x == 0)
             validate_zero_buf(buf_);
         }
         catch ( const boost::bad_lexical_cast &exc ) {
+          ok = false;
+        }
+        if (!ok) {
           std::string msg = "value " + buf_ + " beyond numeric range";
           BOOST_THROW_EXCEPTION(std::invalid_argument(msg));
         }
         return x;
       }
 
+      // the values read so far are ints; move them to the real values
+      void promote_to_real() {
+        stack_r_.reserve(std::max(stack_i_.capacity(), stack_i_.size() + 1));
+        stack_r_.assign(stack_i_.begin(), stack_i_.end());
+        std::vector<int>().swap(stack_i_);
+      }
 
+      // Upper bound on the number of values in the sequence starting
+      // at the current position: one more than the number of
+      // separators up to the closing parenthesis.
+      size_t count_seq_values() const {
+        size_t commas = 0;
+        for (const char* q = p_; q < end_ && *q != ')'; ++q)
+          if (*q == ',')
+            ++commas;
+        return commas + 1;
+      }
 
       // scan number stores number or throws bad lexical cast exception
       void scan_number(bool negate_val) {
         // must take longest first!
         if (scan_chars("Inf")) {
           scan_chars("inity");  // read past if there
+          if (stack_r_.size() == 0)
+            promote_to_real();
           stack_r_.push_back(negate_val
                              ? -std::numeric_limits<double>::infinity()
                              : std::numeric_limits<double>::infinity());
           return;
         }
         if (scan_chars("NaN", false)) {
+          if (stack_r_.size() == 0)
+            promote_to_real();
           stack_r_.push_back(std::numeric_limits<double>::quiet_NaN());
           return;
         }
@@ -308,8 +342,8 @@ namespace stan {
         char c;
         bool is_double = false;
         buf_.clear();
-        while (in_.get(c)) {
-          if (std::isdigit(c)) {  // before pre-scan || c == '-' || c == '+') {
+        while (get(c)) {
+          if (is_digit(c)) {
             buf_.push_back(c);
           } else if (c == '.'
                      || c == 'e'
@@ -319,7 +353,7 @@ namespace stan {
             is_double = true;
             buf_.push_back(c);
           } else {
-            in_.putback(c);
+            --p_;
             break;
           }
         }
@@ -328,21 +362,16 @@ namespace stan {
           stack_i_.push_back(negate_val ? -n : n);
           scan_optional_long();
         } else {
-          for (size_t j = 0; j < stack_i_.size(); ++j)
-            stack_r_.push_back(static_cast<double>(stack_i_[j]));
-          stack_i_.clear();
+          if (stack_r_.size() == 0)
+            promote_to_real();
           double x = scan_double();
           stack_r_.push_back(negate_val ? -x : x);
         }
       }
 
       void scan_number() {
-        char c;
-        while (in_.get(c)) {
-          if (std::isspace(c)) continue;
-          in_.putback(c);
-          break;
-        }
+        while (p_ < end_ && is_space(*p_))
+          ++p_;
         bool negate_val = scan_char('-');
         if (!negate_val) scan_char('+');  // flush leading +
         return scan_number(negate_val);
@@ -356,9 +385,7 @@ namespace stan {
         }
         int s = scan_int();
         if (s < 0) return false;
-        for (int i = 0; i < s; ++i) {
-          stack_i_.push_back(0);
-        }
+        stack_i_.assign(s, 0);
         if (!scan_char(')')) return false;
         dims_.push_back(s);
         return true;
@@ -372,21 +399,19 @@ namespace stan {
         }
         int s = scan_int();
         if (s < 0) return false;
-        for (int i = 0; i < s; ++i) {
-          stack_r_.push_back(0);
-        }
+        stack_r_.assign(s, 0);
         if (!scan_char(')')) return false;
         dims_.push_back(s);
         return true;
       }
 
-
       bool scan_seq_value() {
         if (!scan_char('(')) return false;
         if (scan_char(')')) {
           dims_.push_back(0U);
           return true;
         }
+        stack_i_.reserve(count_seq_values());
         scan_number();  // first entry
         while (scan_char(',')) {
           scan_number();
@@ -395,6 +420,19 @@ namespace stan {
         return scan_char(')');
       }
 
+      void push_range(int start, int end) {
+        // NOLINTNEXTLINE(runtime/int)
+        long long size = static_cast<long long>(end) - start;
+        stack_i_.reserve(stack_i_.size() + (size < 0 ? -size : size) + 1);
+        if (start <= end) {
+          for (int i = start; i <= end; ++i)
+            stack_i_.push_back(i);
+        } else {
+          for (int i = start; i >= end; --i)
+            stack_i_.push_back(i);
+        }
+      }
+
       bool scan_struct_value() {
         if (!scan_char('(')) return false;
         if (scan_chars("integer")) {
@@ -408,13 +446,7 @@ namespace stan {
           if (!scan_char(':'))
             return false;
           int end = scan_int();
-          if (start <= end) {
-            for (int i = start; i <= end; ++i)
-              stack_i_.push_back(i);
-          } else {
-            for (int i = start; i >= end; --i)
-              stack_i_.push_back(i);
-          }
+          push_range(start, end);
         }
         dims_.clear();
         if (!scan_char(',')) return false;
@@ -467,13 +499,7 @@ namespace stan {
         int start = stack_i_[0];
         int end = stack_i_[1];
         stack_i_.clear();
-        if (start <= end) {
-          for (int i = start; i <= end; ++i)
-            stack_i_.push_back(i);
-        } else {
-          for (int i = start; i >= end; --i)
-            stack_i_.push_back(i);
-        }
+        push_range(start, end);
         dims_.push_back(stack_i_.size());
         return true;
       }
@@ -481,11 +507,28 @@ namespace stan {
 
     public:
       /**
-       * Construct a reader for the specified input stream.
+       * Construct a reader for the specified input stream.  The rest
+       * of the stream is read into memory in large blocks and scanned
+       * from there.
        *
        * @param in Input stream reference from which to read.
        */
-      explicit dump_reader(std::istream& in) : in_(in) { }
+      explicit dump_reader(std::istream& in) {
+        read_stream(in, text_);
+        p_ = text_.data();
+        end_ = p_ + text_.size();
+      }
+
+      /**
+       * Construct a reader for the dump text held in the specified
+       * buffer, such as a memory-mapped file.  The buffer must
+       * outlive the reader.
+       *
+       * @param begin Pointer to the first character of the text.
+       * @param end Pointer one past the last character of the text.
+       */
+      dump_reader(const char* begin, const char* end)
+        : p_(begin), end_(end) { }
 
       /**
        * Destroy this reader.
@@ -545,6 +588,28 @@ namespace stan {
         return stack_r_;
       }
 
+      /**
+       * Swap the integer values of the last item with the specified
+       * vector, avoiding a copy when they are no longer needed here.
+       *
+       * @param[in,out] values Vector swapped with the integer values.
+       */
+      void swap_int_values(std::vector<int>& values) {
+        stack_i_.swap(values);
+      }
+
+      /**
+       * Swap the floating point values of the last item with the
+       * specified vector, avoiding a copy when they are no longer
+       * needed here.
+       *
+       * @param[in,out] values Vector swapped with the floating point
+       * values.
+       */
+      void swap_double_values(std::vector<double>& values) {
+        stack_r_.swap(values);
+      }
+
       /**
        * Read the next value from the input stream, returning
        * <code>true</code> if successful and <code>false</code> if no
@@ -620,6 +685,28 @@ namespace stan {
         return vars_r_.find(name) != vars_r_.end();
       }
 
+      /**
+       * Move every variable read by the specified reader into this
+       * dump.
+       *
+       * @param reader Reader positioned at the start of the dump.
+       */
+      void read(dump_reader& reader) {
+        while (reader.next()) {
+          if (reader.is_int()) {
+            std::pair<std::vector<int>, std::vector<size_t> >& var
+              = vars_i_[reader.name()];
+            reader.swap_int_values(var.first);
+            var.second = reader.dims();
+          } else {
+            std::pair<std::vector<double>, std::vector<size_t> >& var
+              = vars_r_[reader.name()];
+            reader.swap_double_values(var.first);
+            var.second = reader.dims();
+          }
+        }
+      }
+
     public:
       /**
        * Construct a dump object from the specified input stream.
@@ -630,20 +717,19 @@ namespace stan {
        */
       explicit dump(std::istream& in) {
         dump_reader reader(in);
-        while (reader.next()) {
-          if (reader.is_int()) {
-            vars_i_[reader.name()]
-              = std::pair<std::vector<int>,
-                          std::vector<size_t> >(reader.int_values(),
-                                                reader.dims());
+        read(reader);
+      }
 
-          } else {
-            vars_r_[reader.name()]
-              = std::pair<std::vector<double>,
-                          std::vector<size_t> >(reader.double_values(),
-                                                reader.dims());
-          }
-        }
+      /**
+       * Construct a dump object from the dump text held in the
+       * specified buffer, such as a memory-mapped file.
+       *
+       * @param begin Pointer to the first character of the text.
+       * @param end Pointer one past the last character of the text.
+       */
+      dump(const char* begin, const char* end) {
+        dump_reader reader(begin, end);
+        read(reader);
       }
 
       /**
@@ -681,16 +767,30 @@ namespace stan {
         if (contains_r_only(name)) {
           return (vars_r_.find(name)->second).first;
         } else if (contains_i(name)) {
-          std::vector<int> vec_int = (vars_i_.find(name)->second).first;
-          std::vector<double> vec_r(vec_int.size());
-          for (size_t ii = 0; ii < vec_int.size(); ii++) {
-            vec_r[ii] = vec_int[ii];
-          }
-          return vec_r;
+          const std::vector<int>& vec_int
+            = (vars_i_.find(name)->second).first;
+          return std::vector<double>(vec_int.begin(), vec_int.end());
         }
         return empty_vec_r_;
       }
 
+      /**
+       * Return a view of the double values for the variable with the
+       * specified name, pointing into this dump's storage.
+       *
+       * @param name Name of variable.
+       * @return View of values of variable.
+       */
+      array_view<double> vals_r_view(const std::string& name) const {
+        if (contains_r_only(name)) {
+          return array_view<double>::of((vars_r_.find(name)->second).first);
+        } else if (contains_i(name)) {
+          return array_view<double>
+            ::converting((vars_i_.find(name)->second).first);
+        }
+        return array_view<double>();
+      }
+
       /**
        * Return the dimensions for the double variable with the specified
        * name.
@@ -721,6 +821,20 @@ namespace stan {
         return empty_vec_i_;
       }
 
+      /**
+       * Return a view of the integer values for the variable with the
+       * specified name, pointing into this dump's storage.
+       *
+       * @param name Name of variable.
+       * @return View of values of variable.
+       */
+      array_view<int> vals_i_view(const std::string& name) const {
+        if (contains_i(name)) {
+          return array_view<int>::of((vars_i_.find(name)->second).first);
+        }
+        return array_view<int>();
+      }
+
       /**
        * Return the dimensions for the integer variable with the specified
        * name.
@@ -0,0 +1,488 @@
+#ifndef STAN_IO_JSON_JSON_BUFFER_PARSER_HPP
+#define STAN_IO_JSON_JSON_BUFFER_PARSER_HPP
+
+#include <boost/lexical_cast.hpp>
+
+#include <stan/io/parse_double.hpp>
+#include <stan/io/validate_zero_buf.hpp>
+#include <stan/io/json/json_error.hpp>
+#include <stan/io/json/json_parser.hpp>
+
+#include <limits>
+#include <sstream>
+#include <string>
+
+namespace stan {
+
+  namespace json {
+
+    /**
+     * A <code>buffer_parser</code> parses a JSON text held in a
+     * contiguous character buffer, sending the same callbacks to the
+     * handler as <code>parser</code> does for a stream and enforcing
+     * the same syntax with the same error messages.
+     *
+     * <p>Working on a buffer removes the per-character stream calls
+     * and the string streams used to collect tokens.  Numbers are
+     * converted in place: integers by accumulating digits, doubles
+     * by an exact fast path when the significand and the power of
+     * ten are both exactly representable and by <code>strtod</code>
+     * otherwise.  Before the values of a top-level array are parsed
+     * the handler is given an upper bound on their number through
+     * <code>array_size_hint</code>, so it can size its storage once.
+     *
+     * @tparam Handler class of handler
+     */
+    template <typename Handler>
+    class buffer_parser {
+    public:
+      buffer_parser(Handler& h, const char* begin, const char* end)
+        : h_(h), begin_(begin), end_(end), p_(begin), array_depth_(0) { }
+
+      void parse() {
+        h_.start_text();
+        parse_text();
+        h_.end_text();
+      }
+
+    private:
+      json_error json_exception(const std::string& msg) const {
+        size_t line = 0;
+        size_t column = 0;
+        for (const char* q = begin_; q < p_; ++q) {
+          if (*q == '\n') {
+            ++line;
+            column = 1;
+          } else {
+            ++column;
+          }
+        }
+        std::stringstream ss;
+        ss << "Error in JSON parsing at"
+           << " line=" << line << " column=" << column
+           << std::endl
+           << msg
+           << std::endl;
+        return json_error(ss.str());
+      }
+
+      // JSON-text = object / array
+      void parse_text() {
+        char c = get_non_ws_char();
+        if (c == '{') {              // begin-object
+          h_.start_object();
+          parse_object_members_end_object();
+          h_.end_object();
+        } else if (c == '[') {      // begin-array
+          h_.start_array();
+          if (array_depth_ == 0)
+            h_.array_size_hint(count_array_values());
+          ++array_depth_;
+          parse_array_values_end_array();
+          --array_depth_;
+          h_.end_array();
+        } else {
+          throw json_exception("expecting start of object ({) or array ([)");
+        }
+      }
+
+      // value =  false / null / true / object / array / number / string
+      void parse_value() {
+        char c = get_non_ws_char();
+        if (c == 'f') {
+          get_chars("alse");
+          h_.boolean(false);
+        } else if (c == 'n') {
+          get_chars("ull");
+          h_.null();
+        } else if (c == 't') {
+          get_chars("rue");
+          h_.boolean(true);
+        } else if (c == '"') {
+          h_.string(parse_string_chars_quotation_mark());
+        } else if (c == '{' || c == '[') {
+          --p_;
+          parse_text();
+        } else if (c == '-' || (c >= '0' && c <= '9')) {
+          --p_;
+          parse_number();
+        } else {
+          throw json_exception("illegal value, expecting object, array, "
+                               "number, string, or literal true/false/null");
+        }
+      }
+
+      // Upper bound on the number of values in the array starting at
+      // the current position: one more than the number of separators
+      // up to the matching end of array.
+      size_t count_array_values() const {
+        size_t commas = 0;
+        int depth = 1;
+        for (const char* q = p_; q < end_; ++q) {
+          char c = *q;
+          if (c == ',') {
+            ++commas;
+          } else if (c == '[') {
+            ++depth;
+          } else if (c == ']') {
+            if (--depth == 0)
+              break;
+          } else if (c == '"') {
+            for (++q; q < end_ && *q != '"'; ++q)
+              if (*q == '\\')
+                ++q;
+          }
+        }
+        return commas + 1;
+      }
+
+      void parse_number() {
+        const char* start = p_;
+        bool is_positive = true;
+
+        char c = get_char();
+        // minus
+        if (c == '-') {
+          is_positive = false;
+          c = get_char();
+        }
+
+        // int
+        //   zero / digit1-9
+        if (c < '0' || c > '9')
+          throw json_exception("expecting int part of number");
+
+        // significand digits and the decimal exponent they are scaled
+        // by; the fast path gives up after 19 significant digits
+        unsigned long long significand = 0;  // NOLINT(runtime/int)
+        int num_digits = 0;
+        int scale = 0;
+        bool exact = true;
+
+        //   *DIGIT
+        bool leading_zero = (c == '0');
+        accumulate_digit(c, significand, num_digits, scale, exact, false);
+        c = peek_char();
+        if (leading_zero && (c == '0'))
+          throw json_exception("zero padded numbers not allowed");
+        while (c >= '0' && c <= '9') {
+          ++p_;
+          accumulate_digit(c, significand, num_digits, scale, exact, false);
+          c = peek_char();
+        }
+
+        // frac
+        bool is_integer = true;
+        if (c == '.') {
+          is_integer = false;
+          ++p_;
+          c = get_char();
+          if (c < '0' || c > '9')
+            throw json_exception("expected digit after decimal");
+          accumulate_digit(c, significand, num_digits, scale, exact, true);
+          c = peek_char();
+          while (c >= '0' && c <= '9') {
+            ++p_;
+            accumulate_digit(c, significand, num_digits, scale, exact, true);
+            c = peek_char();
+          }
+        }
+
+        // exp
+        if (c == 'e' || c == 'E') {
+          is_integer = false;
+          ++p_;
+          c = get_char();
+          // minus / plus
+          bool exp_positive = true;
+          if (c == '+' || c == '-') {
+            exp_positive = (c == '+');
+            c = get_char();
+          }
+          // 1*DIGIT
+          if (c < '0' || c > '9')
+            throw json_exception("expected digit after e/E");
+          int exponent = 0;
+          while (true) {
+            if (exponent < 100000)
+              exponent = 10 * exponent + (c - '0');
+            c = peek_char();
+            if (c < '0' || c > '9')
+              break;
+            ++p_;
+          }
+          scale += exp_positive ? exponent : -exponent;
+        }
+
+        if (is_integer) {
+          if (!exact)
+            significand = convert_integer(std::string(is_positive ? start
+                                                      : start + 1, p_));
+          // NOLINTNEXTLINE(runtime/int)
+          if (significand > std::numeric_limits<unsigned long>::max())
+            throw json_exception("number exceeds integer range");
+          if (is_positive) {
+            // NOLINTNEXTLINE(runtime/int)
+            h_.number_unsigned_long(static_cast<unsigned long>(significand));
+          } else {
+            // NOLINTNEXTLINE(runtime/int)
+            unsigned long long min_magnitude
+              // NOLINTNEXTLINE(runtime/int)
+              = static_cast<unsigned long long>(std::numeric_limits<long>
+                                                ::max()) + 1;
+            if (significand > min_magnitude)
+              throw json_exception("number exceeds integer range");
+            // NOLINTNEXTLINE(runtime/int)
+            h_.number_long(significand == min_magnitude
+                           // NOLINTNEXTLINE(runtime/int)
+                           ? std::numeric_limits<long>::min()
+                           // NOLINTNEXTLINE(runtime/int)
+                           : -static_cast<long>(significand));
+          }
+        } else {
+          double x;
+          if (exact && io::exact_decimal(significand, scale, x)) {
+            if (!is_positive)
+              x = -x;
+          } else {
+            x = convert_double(std::string(start, p_));
+          }
+          h_.number_double(x);
+        }
+      }
+
+      // NOLINTNEXTLINE(runtime/int)
+      static void accumulate_digit(char c, unsigned long long& significand,
+                                   int& num_digits, int& scale, bool& exact,
+                                   bool fraction) {
+        if (num_digits == 0 && c == '0') {
+          // leading zeros carry no information
+          if (fraction)
+            --scale;
+          return;
+        }
+        if (num_digits < 19) {
+          significand = 10 * significand + (c - '0');
+          ++num_digits;
+          if (fraction)
+            --scale;
+        } else {
+          exact = false;
+        }
+      }
+
+      // NOLINTNEXTLINE(runtime/int)
+      unsigned long long convert_integer(const std::string& digits) const {
+        try {
+          // NOLINTNEXTLINE(runtime/int)
+          return boost::lexical_cast<unsigned long>(digits);
+        } catch (const boost::bad_lexical_cast & ) {
+          throw json_exception("number exceeds integer range");
+        }
+      }
+
+      double convert_double(const std::string& token) const {
+        double x;
+        if (!io::parse_double(token, x))
+          throw json_exception("number exceeds double range");
+        if (x == 0) {
+          try {
+            io::validate_zero_buf(token);
+          } catch (const boost::bad_lexical_cast & ) {
+            throw json_exception("number exceeds double range");
+          }
+        }
+        return x;
+      }
+
+      std::string parse_string_chars_quotation_mark() {
+        std::string s;
+        while (true) {
+          const char* run = p_;
+          while (p_ < end_ && *p_ != '"' && *p_ != '\\'
+                 && !(*p_ > 0 && *p_ < 0x20))
+            ++p_;
+          s.append(run, p_);
+          char c = get_char();
+          if (c == '"') {
+            return s;
+          } else if (c == '\\') {
+            c = get_char();
+            if (c == '\\'  || c == '/' || c == '"') {
+              s += c;
+            } else if (c == 'b') {
+              s += '\b';
+            } else if (c == 'f') {
+              s += '\f';
+            } else if (c == 'n') {
+              s += '\n';
+            } else if (c == 'r') {
+              s += '\r';
+            } else if (c == 't') {
+              s += '\t';
+            } else if (c == 'u') {
+              get_escaped_unicode(s);
+            } else {
+              throw json_exception("expecting legal escape");
+            }
+          } else {  // ASCII control characters
+            throw json_exception("found control character, char values less "
+                                 "than U+0020 must be \\u escaped");
+          }
+        }
+      }
+
+      void get_escaped_unicode(std::string& s) {
+        unsigned int codepoint = get_int_as_hex_chars();
+        if (!(is_high_surrogate(codepoint) || is_low_surrogate(codepoint))) {
+          put_codepoint(s, codepoint);
+        } else if (!is_high_surrogate(codepoint)) {
+          throw json_exception("illegal unicode values, found "
+                               "low-surrogate, missing high-surrogate");
+        } else {
+          char c = get_char();
+          if (!(c == '\\'))
+            throw json_exception("illegal unicode values, found "
+                                 "high-surrogate, expecting low-surrogate");
+          c = get_char();
+          if (!(c == 'u'))
+            throw json_exception("illegal unicode values, found "
+                                 "high-surrogate, expecting low-surrogate");
+          unsigned int codepoint2 = get_int_as_hex_chars();
+          unsigned int supplemental
+            = ((codepoint - MIN_HIGH_SURROGATE) << 10)
+            + (codepoint2 - MIN_LOW_SURROGATE)
+            + MIN_SUPPLEMENTARY_CODE_POINT;
+          put_codepoint(s, supplemental);
+        }
+      }
+
+      unsigned int get_int_as_hex_chars() {
+        unsigned int hex = 0;
+        for (int i = 0; i < 4; i++) {
+          char c = get_char();
+          if (c >= 'a' && c<= 'f')
+            hex = 16 * hex + (c - 'a' + 10);
+          else if (c >= 'A' && c<= 'F')
+            hex = 16 * hex + (c - 'A' + 10);
+          else if (c >= '0' && c<= '9')
+            hex = 16 * hex + (c - '0');
+          else
+            throw json_exception("illegal unicode code point");
+        }
+        return hex;
+      }
+
+      static void put_codepoint(std::string& s, unsigned int codepoint) {
+        if (codepoint <= 0x7f) {
+          s += static_cast<char>(codepoint);
+        } else if (codepoint <= 0x7ff) {
+          s += static_cast<char>(0xc0 | ((codepoint >> 6) & 0x1f));
+          s += static_cast<char>(0x80 | (codepoint & 0x3f));
+        } else if (codepoint <= 0xffff) {
+          s += static_cast<char>(0xe0 | ((codepoint >> 12) & 0x0f));
+          s += static_cast<char>(0x80 | ((codepoint >> 6) & 0x3f));
+          s += static_cast<char>(0x80 | (codepoint & 0x3f));
+        } else {
+          s += static_cast<char>(0xf0 | ((codepoint >> 18) & 0x07));
+          s += static_cast<char>(0x80 | ((codepoint >> 12) & 0x3f));
+          s += static_cast<char>(0x80 | ((codepoint >> 6) & 0x3f));
+          s += static_cast<char>(0x80 | (codepoint & 0x3f));
+        }
+      }
+
+      void get_chars(const std::string& s) {
+        for (size_t i = 0; i < s.size(); ++i) {
+          char c = get_char();
+          if (c != s[i])
+            throw json_exception("expecting rest of literal: "
+                                 + s.substr(i));
+        }
+      }
+
+      void parse_array_values_end_array() {
+        char c = get_non_ws_char();
+        if (c == ']') return;
+        --p_;
+        while (true) {
+          parse_value();
+          char c = get_non_ws_char();
+          if (c == ']') return;
+          if (c != ',') {
+            throw json_exception("in array, expecting ] or ,");
+          }
+          c = get_non_ws_char();
+          if (c == ']')
+            throw json_exception("in array, expecting value");
+          --p_;
+        }
+      }
+
+      void parse_object_members_end_object() {
+        char c = get_non_ws_char();
+        if (c == '}') return;
+        while (true) {
+          // string (key)
+          if (c != '"')
+            throw json_exception("expecting member key"
+                                 " or end of object marker (})");
+          std::string key = parse_string_chars_quotation_mark();
+          h_.key(key);
+          // name-separator separator
+          c = get_non_ws_char();
+          if (c != ':')
+            throw json_exception("expecting key-value separator :");
+          // value
+          parse_value();
+
+          // continuation
+          c = get_non_ws_char();
+          if (c == '}')
+            return;
+          if (c != ',')
+            throw json_exception("expecting end of object } or separator ,");
+          c = get_non_ws_char();
+        }
+      }
+
+      // the next character, or 0 at the end of the buffer
+      char peek_char() const {
+        return p_ < end_ ? *p_ : 0;
+      }
+
+      char get_char() {
+        if (p_ >= end_)
+          throw json_exception("unexpected end of stream");
+        return *p_++;
+      }
+
+      char get_non_ws_char() {
+        while (p_ < end_ && is_whitespace(*p_))
+          ++p_;
+        return get_char();
+      }
+
+      Handler& h_;
+      const char* begin_;
+      const char* end_;
+      const char* p_;
+      int array_depth_;
+    };
+
+    /**
+     * Parse the JSON text held in the specified buffer, sending
+     * events to the specified handler.
+     *
+     * @tparam Handler
+     * @param begin Pointer to the first character of the text
+     * @param end Pointer one past the last character of the text
+     * @param handler Handler for events from parser
+     */
+    template <typename Handler>
+    void parse(const char* begin, const char* end, Handler& handler) {
+      buffer_parser<Handler>(handler, begin, end).parse();
+    }
+
+  }
+}
+#endif
@@ -3,7 +3,9 @@
 
 #include <boost/throw_exception.hpp>
 #include <boost/lexical_cast.hpp>
+#include <stan/io/read_stream.hpp>
 #include <stan/io/var_context.hpp>
+#include <stan/io/json/json_buffer_parser.hpp>
 #include <stan/io/json/json_error.hpp>
 #include <stan/io/json/json_parser.hpp>
 #include <stan/io/json/json_data_handler.hpp>
@@ -66,6 +68,8 @@ namespace stan {
     public:
       /**
        * Construct a json_data object from the specified input stream.
+       * The rest of the stream is read into memory in large blocks
+       * and parsed from there.
        *
        * <b>Warning:</b> This method does not close the input stream.
        *
@@ -73,8 +77,23 @@ namespace stan {
        * @throws json_exception if data is not well-formed stan data declaration
        */
       explicit json_data(std::istream& in) : vars_r_(), vars_i_() {
+        std::string buf;
+        stan::io::read_stream(in, buf);
         json_data_handler handler(vars_r_, vars_i_);
-        stan::json::parse(in, handler);
+        stan::json::parse(buf.data(), buf.data() + buf.size(), handler);
+      }
+
+      /**
+       * Construct a json_data object from the JSON text held in the
+       * specified buffer, such as a memory-mapped file.
+       *
+       * @param begin Pointer to the first character of the text.
+       * @param end Pointer one past the last character of the text.
+       * @throws json_exception if data is not well-formed stan data declaration
+       */
+      json_data(const char* begin, const char* end) : vars_r_(), vars_i_() {
+        json_data_handler handler(vars_r_, vars_i_);
+        stan::json::parse(begin, end, handler);
       }
 
       /**
@@ -112,16 +131,31 @@ namespace stan {
         if (contains_r_only(name)) {
           return (vars_r_.find(name)->second).first;
         } else if (contains_i(name)) {
-          std::vector<int> vec_int = (vars_i_.find(name)->second).first;
-          std::vector<double> vec_r(vec_int.size());
-          for (size_t ii = 0; ii < vec_int.size(); ii++) {
-            vec_r[ii] = vec_int[ii];
-          }
-          return vec_r;
+          const std::vector<int>& vec_int
+            = (vars_i_.find(name)->second).first;
+          return std::vector<double>(vec_int.begin(), vec_int.end());
         }
         return empty_vec_r_;
       }
 
+      /**
+       * Return a view of the double values for the variable with the
+       * specified name, pointing into this json_data's storage.
+       *
+       * @param name Name of variable.
+       * @return View of values of variable.
+       */
+      stan::io::array_view<double> vals_r_view(const std::string& name) const {
+        if (contains_r_only(name)) {
+          return stan::io::array_view<double>
+            ::of((vars_r_.find(name)->second).first);
+        } else if (contains_i(name)) {
+          return stan::io::array_view<double>
+            ::converting((vars_i_.find(name)->second).first);
+        }
+        return stan::io::array_view<double>();
+      }
+
       /**
        * Return the dimensions for the variable with the specified
        * name.
@@ -152,6 +186,21 @@ namespace stan {
         return empty_vec_i_;
       }
 
+      /**
+       * Return a view of the integer values for the variable with the
+       * specified name, pointing into this json_data's storage.
+       *
+       * @param name Name of variable.
+       * @return View of values of variable.
+       */
+      stan::io::array_view<int> vals_i_view(const std::string& name) const {
+        if (contains_i(name)) {
+          return stan::io::array_view<int>
+            ::of((vars_i_.find(name)->second).first);
+        }
+        return stan::io::array_view<int>();
+      }
+
       /**
        * Return the dimensions for the integer variable with the specified
        * name.
@@ -7,6 +7,7 @@
 #include <stan/io/json/json_error.hpp>
 #include <stan/io/json/json_parser.hpp>
 #include <stan/io/json/json_handler.hpp>
+#include <algorithm>
 #include <cctype>
 #include <iostream>
 #include <limits>
@@ -60,6 +61,7 @@ namespace stan {
       std::vector<bool> dims_unknown_;
       size_t dim_idx_;
       size_t dim_last_;
+      size_t size_hint_;
       bool is_int_;
 
       void reset() {
@@ -71,9 +73,18 @@ namespace stan {
         dims_unknown_.clear();
         dim_idx_ = 0;
         dim_last_ = 0;
+        size_hint_ = 0;
         is_int_ = true;
       }
 
+      // the values read so far are ints; move them to the real values
+      void promote_to_real() {
+        values_r_.reserve(std::max(size_hint_, values_i_.size() + 1));
+        values_r_.assign(values_i_.begin(), values_i_.end());
+        std::vector<int>().swap(values_i_);
+        is_int_ = false;
+      }
+
       bool is_init() {
         return (key_.size() == 0
                 && values_r_.size() == 0
@@ -100,7 +111,7 @@ namespace stan {
         : json_handler(), vars_r_(vars_r), vars_i_(vars_i),
           key_(), values_r_(), values_i_(),
           dims_(), dims_verify_(), dims_unknown_(),
-          dim_idx_(0), dim_last_(0), is_int_(true) {
+          dim_idx_(0), dim_last_(0), size_hint_(0), is_int_(true) {
       }
 
       void start_text() {
@@ -134,6 +145,16 @@ namespace stan {
         }
       }
 
+      void array_size_hint(size_t n) {
+        if (dim_idx_ != 1)
+          return;
+        size_hint_ = n;
+        if (is_int_)
+          values_i_.reserve(n);
+        else
+          values_r_.reserve(n);
+      }
+
       void end_array() {
         if (dims_[dim_idx_-1] == 0) {
           std::stringstream errorMsg;
@@ -193,12 +214,8 @@ namespace stan {
                    << ", error: string values not allowed";
           throw json_error(errorMsg.str());
         }
-        if (is_int_) {
-          for (std::vector<int>::iterator it = values_i_.begin();
-               it != values_i_.end(); ++it)
-            values_r_.push_back(*it);
-        }
-        is_int_ = false;
+        if (is_int_)
+          promote_to_real();
         values_r_.push_back(tmp);
         incr_dim_size();
       }
@@ -211,12 +228,8 @@ namespace stan {
 
       void number_double(double x) {
         set_last_dim();
-        if (is_int_) {
-          for (std::vector<int>::iterator it = values_i_.begin();
-               it != values_i_.end(); ++it)
-            values_r_.push_back(*it);
-        }
-        is_int_ = false;
+        if (is_int_)
+          promote_to_real();
         values_r_.push_back(x);
         incr_dim_size();
       }
@@ -254,30 +267,28 @@ namespace stan {
             throw json_error(errorMsg.str());
         }
 
-        // transpose order of array values to column-major
+        // transpose order of array values to column-major; the
+        // values are moved into the map rather than copied
         if (is_int_) {
-          std::pair<std::vector<int>,
-                    std::vector<size_t> > pair;
+          std::pair<std::vector<int>, std::vector<size_t> >& pair
+            = vars_i_[key_];
           if (dims_.size() > 1) {
-            std::vector<int> cm_values_i(values_i_.size());
-            to_column_major(cm_values_i, values_i_, dims_);
-            pair = make_pair(cm_values_i, dims_);
-
+            pair.first.resize(values_i_.size());
+            to_column_major(pair.first, values_i_, dims_);
           } else {
-            pair = make_pair(values_i_, dims_);
+            pair.first.swap(values_i_);
           }
-          vars_i_[key_] = pair;
+          pair.second = dims_;
         } else {
-          std::pair<std::vector<double>,
-                    std::vector<size_t> > pair;
+          std::pair<std::vector<double>, std::vector<size_t> >& pair
+            = vars_r_[key_];
           if (dims_.size() > 1) {
-            std::vector<double> cm_values_r(values_r_.size());
-            to_column_major(cm_values_r, values_r_, dims_);
-            pair = make_pair(cm_values_r, dims_);
+            pair.first.resize(values_r_.size());
+            to_column_major(pair.first, values_r_, dims_);
           } else {
-            pair = make_pair(values_r_, dims_);
+            pair.first.swap(values_r_);
           }
-          vars_r_[key_] = pair;
+          pair.second = dims_;
         }
       }
 
@@ -294,9 +305,30 @@ namespace stan {
       void to_column_major(std::vector<T>& cm_vals,
                            const std::vector<T>& rm_vals,
                            const std::vector<size_t>& dims) {
-        for (size_t i = 0; i< rm_vals.size(); i++) {
-          size_t idx = convert_offset_rtl_2_ltr(i, dims);
-          cm_vals[idx] = rm_vals[i];
+        if (rm_vals.size() == 0)
+          return;
+        // array index should be valid, but check just in case
+        convert_offset_rtl_2_ltr(rm_vals.size() - 1, dims);
+
+        // walk the row-major values keeping their array indices and
+        // column-major offset up to date, rather than recomputing the
+        // offset of each value from scratch
+        size_t num_dims = dims.size();
+        std::vector<size_t> idxs(num_dims, 0);
+        std::vector<size_t> strides(num_dims, 1);
+        for (size_t i = 1; i < num_dims; ++i)
+          strides[i] = strides[i-1] * dims[i-1];
+        size_t ltr_offset = 0;
+        for (size_t i = 0; i < rm_vals.size(); ++i) {
+          cm_vals[ltr_offset] = rm_vals[i];
+          for (size_t d = num_dims; d-- > 0; ) {
+            if (++idxs[d] < dims[d]) {
+              ltr_offset += strides[d];
+              break;
+            }
+            ltr_offset -= (dims[d] - 1) * strides[d];
+            idxs[d] = 0;
+          }
         }
       }
 
@@ -1,6 +1,7 @@
 #ifndef STAN_IO_JSON_JSON_HANDLER_HPP
 #define STAN_IO_JSON_JSON_HANDLER_HPP
 
+#include <cstddef>
 #include <string>
 
 namespace stan {
@@ -28,6 +29,16 @@ namespace stan {
        */
       virtual void end_text() { }
 
+      /**
+       * Handle an upper bound on the number of values of the array
+       * that has just started.  Parsers that can look ahead send this
+       * after the start of each array that is not nested in another
+       * array.
+       *
+       * @param n Upper bound on the number of values.
+       */
+      virtual void array_size_hint(size_t n) { }
+
       /**
        * Handle the start of an array.
        */
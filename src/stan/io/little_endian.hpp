@@ -0,0 +1,110 @@
+#ifndef STAN_IO_LITTLE_ENDIAN_HPP
+#define STAN_IO_LITTLE_ENDIAN_HPP
+
+#include <boost/cstdint.hpp>
+#include <cstring>
+#include <ostream>
+
+namespace stan {
+  namespace io {
+
+    /**
+     * Return <code>true</code> if the host stores 32-bit integers and
+     * double precision floating point values in little-endian byte
+     * order, so that little-endian arrays of them may be read in
+     * place.
+     *
+     * @return <code>true</code> if the host is little endian.
+     */
+    inline bool host_is_little_endian() {
+      if (sizeof(int) != 4 || sizeof(double) != 8)
+        return false;
+      int n = 1;
+      double x = 1.0;
+      unsigned char c[8];
+      std::memcpy(c, &n, 4);
+      if (c[0] != 1)
+        return false;
+      std::memcpy(c, &x, 8);
+      return c[7] == 0x3f && c[6] == 0xf0;
+    }
+
+    /**
+     * Return the unsigned 32-bit integer stored in little-endian
+     * byte order at the specified position.
+     *
+     * @param p Pointer to first byte.
+     * @return Value.
+     */
+    inline boost::uint32_t read_little_endian_32(const char* p) {
+      const unsigned char* u = reinterpret_cast<const unsigned char*>(p);
+      return static_cast<boost::uint32_t>(u[0])
+        | (static_cast<boost::uint32_t>(u[1]) << 8)
+        | (static_cast<boost::uint32_t>(u[2]) << 16)
+        | (static_cast<boost::uint32_t>(u[3]) << 24);
+    }
+
+    /**
+     * Return the unsigned 64-bit integer stored in little-endian
+     * byte order at the specified position.
+     *
+     * @param p Pointer to first byte.
+     * @return Value.
+     */
+    inline boost::uint64_t read_little_endian_64(const char* p) {
+      return static_cast<boost::uint64_t>(read_little_endian_32(p))
+        | (static_cast<boost::uint64_t>(read_little_endian_32(p + 4)) << 32);
+    }
+
+    /**
+     * Store the specified unsigned 32-bit integer in little-endian
+     * byte order at the specified position.
+     *
+     * @param n Value.
+     * @param p Pointer to first byte.
+     */
+    inline void encode_little_endian_32(boost::uint32_t n, char* p) {
+      for (int i = 0; i < 4; ++i)
+        p[i] = static_cast<char>((n >> (8 * i)) & 0xff);
+    }
+
+    /**
+     * Store the specified unsigned 64-bit integer in little-endian
+     * byte order at the specified position.
+     *
+     * @param n Value.
+     * @param p Pointer to first byte.
+     */
+    inline void encode_little_endian_64(boost::uint64_t n, char* p) {
+      encode_little_endian_32(static_cast<boost::uint32_t>(n), p);
+      encode_little_endian_32(static_cast<boost::uint32_t>(n >> 32), p + 4);
+    }
+
+    /**
+     * Write the specified unsigned 32-bit integer to the specified
+     * stream in little-endian byte order.
+     *
+     * @param out Stream to write to.
+     * @param n Value.
+     */
+    inline void write_little_endian_32(std::ostream& out, boost::uint32_t n) {
+      char c[4];
+      encode_little_endian_32(n, c);
+      out.write(c, 4);
+    }
+
+    /**
+     * Write the specified unsigned 64-bit integer to the specified
+     * stream in little-endian byte order.
+     *
+     * @param out Stream to write to.
+     * @param n Value.
+     */
+    inline void write_little_endian_64(std::ostream& out, boost::uint64_t n) {
+      write_little_endian_32(out, static_cast<boost::uint32_t>(n));
+      write_little_endian_32(out, static_cast<boost::uint32_t>(n >> 32));
+    }
+
+  }
+}
+#endif
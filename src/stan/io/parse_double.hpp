@@ -0,0 +1,158 @@
+#ifndef STAN_IO_PARSE_DOUBLE_HPP
+#define STAN_IO_PARSE_DOUBLE_HPP
+
+#include <boost/lexical_cast.hpp>
+#include <cerrno>
+#include <clocale>
+#include <cstdlib>
+#include <limits>
+#include <string>
+
+namespace stan {
+  namespace io {
+
+    /**
+     * Return <code>true</code> if <code>strtod</code> uses a period
+     * as the decimal point in the current C locale.
+     *
+     * @return <code>true</code> if the decimal point is a period
+     */
+    inline bool strtod_uses_period() {
+      const char* point = std::localeconv()->decimal_point;
+      return point[0] == '.' && point[1] == '\0';
+    }
+
+    /**
+     * Set the specified double to the decimal
+     * <code>significand * 10^scale</code> and return
+     * <code>true</code> if both factors are exactly representable as
+     * doubles, so that a single multiplication or division rounds
+     * correctly; otherwise leave it unchanged and return
+     * <code>false</code>.
+     *
+     * @param[in] significand decimal significand
+     * @param[in] scale power of ten
+     * @param[out] x value
+     * @return <code>true</code> if the value was set
+     */
+    // NOLINTNEXTLINE(runtime/int)
+    inline bool exact_decimal(unsigned long long significand, int scale,
+                              double& x) {
+      static const double powers[] = {
+        1e0, 1e1, 1e2, 1e3, 1e4, 1e5, 1e6, 1e7, 1e8, 1e9, 1e10, 1e11,
+        1e12, 1e13, 1e14, 1e15, 1e16, 1e17, 1e18, 1e19, 1e20, 1e21, 1e22
+      };
+      if (significand > (1ULL << 53) || scale < -22 || scale > 22)
+        return false;
+      x = static_cast<double>(significand);
+      if (scale < 0)
+        x /= powers[-scale];
+      else
+        x *= powers[scale];
+      return true;
+    }
+
+    /**
+     * Convert the specified decimal floating point literal, of the
+     * form <code>[+-] digits [. digits] [(e|E) [+-] digits]</code>
+     * with at least one significand digit, and return
+     * <code>true</code> if it is well formed and within double range.
+     * Literals with at most 19 significant digits and small exponents
+     * are converted exactly without calling the C library; the rest
+     * go through <code>strtod</code>, or <code>lexical_cast</code>
+     * if the C locale does not use a period as the decimal point.
+     * Values that underflow are returned as zero or subnormals.
+     *
+     * @param[in] begin pointer to first character of literal
+     * @param[in] end pointer to one past last character of literal
+     * @param[out] x value
+     * @return <code>true</code> if the literal was converted
+     */
+    inline bool parse_double(const char* begin, const char* end, double& x) {
+      const char* p = begin;
+      bool negative = false;
+      if (p < end && (*p == '+' || *p == '-'))
+        negative = (*p++ == '-');
+
+      // NOLINTNEXTLINE(runtime/int)
+      unsigned long long significand = 0;
+      int num_digits = 0;
+      int scale = 0;
+      bool exact = true;
+      bool any_digit = false;
+      for (bool fraction = false; p < end; ++p) {
+        if (*p == '.' && !fraction) {
+          fraction = true;
+          continue;
+        }
+        if (*p < '0' || *p > '9')
+          break;
+        any_digit = true;
+        if (num_digits == 0 && *p == '0') {
+          // leading zeros carry no information
+          if (fraction)
+            --scale;
+        } else if (num_digits < 19) {
+          significand = 10 * significand + (*p - '0');
+          ++num_digits;
+          if (fraction)
+            --scale;
+        } else {
+          exact = false;
+        }
+      }
+      if (!any_digit)
+        return false;
+      if (p < end && (*p == 'e' || *p == 'E')) {
+        ++p;
+        bool exp_negative = false;
+        if (p < end && (*p == '+' || *p == '-'))
+          exp_negative = (*p++ == '-');
+        if (p == end)
+          return false;
+        int exponent = 0;
+        for (; p < end && *p >= '0' && *p <= '9'; ++p)
+          if (exponent < 100000)
+            exponent = 10 * exponent + (*p - '0');
+        scale += exp_negative ? -exponent : exponent;
+      }
+      if (p != end)
+        return false;
+
+      if (exact && exact_decimal(significand, scale, x)) {
+        if (negative)
+          x = -x;
+        return true;
+      }
+      std::string s(begin, end);
+      if (strtod_uses_period()) {
+        errno = 0;
+        x = std::strtod(s.c_str(), 0);
+        return !(errno == ERANGE
+                 && (x == std::numeric_limits<double>::infinity()
+                     || x == -std::numeric_limits<double>::infinity()));
+      }
+      try {
+        x = boost::lexical_cast<double>(s);
+      } catch (const boost::bad_lexical_cast&) {
+        return false;
+      }
+      return true;
+    }
+
+    /**
+     * Convert the specified decimal floating point literal as
+     * <code>parse_double(const char*, const char*, double&)</code>
+     * does.
+     *
+     * @param[in] s literal
+     * @param[out] x value
+     * @return <code>true</code> if the literal was converted
+     */
+    inline bool parse_double(const std::string& s, double& x) {
+      return parse_double(s.data(), s.data() + s.size(), x);
+    }
+
+  }
+}
+#endif
@@ -119,6 +119,22 @@ namespace stan {
         return vals_r_[loc - names_.begin()];
       }
 
+      /**
+       * Returns a view of the values of the constrained variables.
+       *
+       * @param name Name of variable.
+       *
+       * @return view of the constrained values if the variable is in
+       *   the var_context; an empty view is returned otherwise
+       */
+      array_view<double> vals_r_view(const std::string& name) const {
+        std::vector<std::string>::const_iterator loc
+          = std::find(names_.begin(), names_.end(), name);
+        if (loc == names_.end())
+          return array_view<double>();
+        return array_view<double>::of(vals_r_[loc - names_.begin()]);
+      }
+
       /**
        * Returns the dimensions of the variable
        *
@@ -156,6 +172,16 @@ namespace stan {
         return empty_vals_i;
       }
 
+      /**
+       * Returns an empty view.
+       *
+       * @param name Name of variable.
+       * @return empty view
+       */
+      array_view<int> vals_i_view(const std::string& name) const {
+        return array_view<int>();
+      }
+
       /**
        * Return the dimensions of the specified floating point variable.
        * Returns an empty vector.
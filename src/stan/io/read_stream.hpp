@@ -0,0 +1,36 @@
+#ifndef STAN_IO_READ_STREAM_HPP
+#define STAN_IO_READ_STREAM_HPP
+
+#include <istream>
+#include <string>
+
+namespace stan {
+  namespace io {
+
+    /**
+     * Read the rest of the specified input stream into the specified
+     * string, in large blocks and with the string presized when the
+     * stream can report its length.
+     *
+     * @param[in,out] in input stream
+     * @param[out] buf string to which the characters are appended
+     */
+    inline void read_stream(std::istream& in, std::string& buf) {
+      std::streampos start = in.tellg();
+      if (start != std::streampos(-1)) {
+        in.seekg(0, std::ios::end);
+        std::streampos end = in.tellg();
+        in.seekg(start);
+        if (end > start)
+          buf.reserve(buf.size() + static_cast<size_t>(end - start));
+      }
+      char block[65536];
+      std::streamsize n;
+      while ((n = in.rdbuf()->sgetn(block, sizeof(block))) > 0)
+        buf.append(block, n);
+      in.setstate(std::ios::eofbit);
+    }
+
+  }
+}
+#endif
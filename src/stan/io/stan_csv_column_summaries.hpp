@@ -0,0 +1,167 @@
+#ifndef STAN_IO_STAN_CSV_COLUMN_SUMMARIES_HPP
+#define STAN_IO_STAN_CSV_COLUMN_SUMMARIES_HPP
+
+#include <stan/io/stan_csv_stream_reader.hpp>
+#include <cmath>
+#include <limits>
+#include <string>
+#include <vector>
+
+namespace stan {
+  namespace io {
+
+    /**
+     * Running summaries of the columns of Stan output csv draws,
+     * updated one draw at a time so the draws need not be kept.
+     *
+     * <p>Means and variances are accumulated with Welford's
+     * algorithm.  Variances are sample variances, dividing by one
+     * less than the number of draws, as in <code>mcmc::chains</code>.
+     */
+    class stan_csv_column_summaries {
+    private:
+      std::vector<std::string> names_;
+      size_t num_rows_;
+      std::vector<double> mean_;
+      std::vector<double> sum_sq_;
+      std::vector<double> min_;
+      std::vector<double> max_;
+
+    public:
+      /**
+       * Construct empty summaries of the columns with the specified
+       * names.
+       *
+       * @param[in] names names of columns
+       */
+      explicit stan_csv_column_summaries(const std::vector<std::string>& names)
+        : names_(names), num_rows_(0), mean_(names.size(), 0),
+          sum_sq_(names.size(), 0),
+          min_(names.size(), std::numeric_limits<double>::infinity()),
+          max_(names.size(), -std::numeric_limits<double>::infinity()) { }
+
+      /**
+       * Add the specified draw, with one value per column.
+       *
+       * @param[in] values values of columns
+       */
+      void add(const std::vector<double>& values) {
+        ++num_rows_;
+        for (size_t k = 0; k < mean_.size(); ++k) {
+          double x = values[k];
+          double delta = x - mean_[k];
+          mean_[k] += delta / num_rows_;
+          sum_sq_[k] += delta * (x - mean_[k]);
+          if (x < min_[k])
+            min_[k] = x;
+          if (x > max_[k])
+            max_[k] = x;
+        }
+      }
+
+      /**
+       * Add every remaining draw of the specified reader, whose
+       * selected columns must be the summarized columns, and return
+       * the number of draws added.
+       *
+       * @param[in, out] reader reader of draws
+       * @return number of draws added
+       */
+      size_t add(stan_csv_stream_reader& reader) {
+        std::vector<double> values;
+        size_t n = 0;
+        for (; reader.next_row(values); ++n)
+          add(values);
+        return n;
+      }
+
+      /**
+       * Return the names of the summarized columns.
+       *
+       * @return names of columns
+       */
+      const std::vector<std::string>& names() const {
+        return names_;
+      }
+
+      /**
+       * Return the number of draws added.
+       *
+       * @return number of draws
+       */
+      size_t num_rows() const {
+        return num_rows_;
+      }
+
+      /**
+       * Return the mean of the specified column.
+       *
+       * @param[in] k index of column
+       * @return mean
+       */
+      double mean(size_t k) const {
+        return mean_[k];
+      }
+
+      /**
+       * Return the sample variance of the specified column, or
+       * NaN if fewer than two draws have been added.
+       *
+       * @param[in] k index of column
+       * @return variance
+       */
+      double variance(size_t k) const {
+        if (num_rows_ < 2)
+          return std::numeric_limits<double>::quiet_NaN();
+        return sum_sq_[k] / (num_rows_ - 1.0);
+      }
+
+      /**
+       * Return the sample standard deviation of the specified
+       * column.
+       *
+       * @param[in] k index of column
+       * @return standard deviation
+       */
+      double sd(size_t k) const {
+        return std::sqrt(variance(k));
+      }
+
+      /**
+       * Return the minimum of the specified column.
+       *
+       * @param[in] k index of column
+       * @return minimum
+       */
+      double min(size_t k) const {
+        return min_[k];
+      }
+
+      /**
+       * Return the maximum of the specified column.
+       *
+       * @param[in] k index of column
+       * @return maximum
+       */
+      double max(size_t k) const {
+        return max_[k];
+      }
+    };
+
+    /**
+     * Read the remaining draws of the specified reader and return
+     * running summaries of its selected columns.
+     *
+     * @param[in, out] reader reader of draws
+     * @return summaries of selected columns
+     */
+    inline stan_csv_column_summaries
+    summarize_columns(stan_csv_stream_reader& reader) {
+      stan_csv_column_summaries summaries(reader.selected_names());
+      summaries.add(reader);
+      return summaries;
+    }
+
+  }
+}
+#endif
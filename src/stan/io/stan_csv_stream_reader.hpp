@@ -0,0 +1,302 @@
+#ifndef STAN_IO_STAN_CSV_STREAM_READER_HPP
+#define STAN_IO_STAN_CSV_STREAM_READER_HPP
+
+#include <stan/io/parse_double.hpp>
+#include <stan/io/stan_csv_reader.hpp>
+#include <boost/lexical_cast.hpp>
+#include <Eigen/Dense>
+#include <cstring>
+#include <istream>
+#include <ostream>
+#include <sstream>
+#include <stdexcept>
+#include <string>
+#include <vector>
+
+namespace stan {
+  namespace io {
+
+    /**
+     * Reads the draws of a Stan output csv file one row at a time.
+     *
+     * <p>Construction reads the metadata, header and adaptation
+     * comments with <code>stan_csv_reader</code>.  The draws are then
+     * read through a fixed-size buffer and their numbers converted in
+     * place, so memory use does not grow with the number of draws.
+     * Only the columns picked out by <code>select()</code>, all of
+     * them by default, are converted; the others are skipped.
+     * Timing comments are accumulated as they are passed and are
+     * complete once <code>next_row()</code> has returned
+     * <code>false</code>.
+     */
+    class stan_csv_stream_reader {
+    private:
+      std::istream& in_;
+      std::ostream* out_;
+      stan_csv_metadata metadata_;
+      Eigen::Matrix<std::string, Eigen::Dynamic, 1> header_;
+      stan_csv_adaptation adaptation_;
+      stan_csv_timing timing_;
+      std::vector<int> columns_;
+      std::vector<int> positions_;
+      std::string buffer_;
+      size_t pos_;
+      size_t buffer_size_;
+      size_t num_rows_;
+      bool eof_;
+
+      bool next_line(const char*& begin, const char*& end) {
+        while (true) {
+          const char* first = buffer_.data() + pos_;
+          const char* last = buffer_.data() + buffer_.size();
+          const char* newline = static_cast<const char*>
+            (std::memchr(first, '\n', last - first));
+          if (newline || (eof_ && first < last)) {
+            begin = first;
+            end = newline ? newline : last;
+            pos_ = end - buffer_.data() + (newline ? 1 : 0);
+            return true;
+          }
+          if (eof_)
+            return false;
+          buffer_.erase(0, pos_);
+          pos_ = 0;
+          size_t size = buffer_.size();
+          buffer_.resize(size + buffer_size_);
+          in_.read(&buffer_[size], buffer_size_);
+          buffer_.resize(size + in_.gcount());
+          eof_ = in_.gcount() == 0;
+        }
+      }
+
+      void read_timing(const char* begin, const char* end) {
+        std::string line(begin, end);
+        bool warmup = line.find("(Warm-up)") != std::string::npos;
+        if (!warmup && line.find("(Sampling)") == std::string::npos)
+          return;
+        int left = 17;
+        int right = line.find(" seconds");
+        double seconds
+          = boost::lexical_cast<double>(line.substr(left, right - left));
+        if (warmup)
+          timing_.warmup += seconds;
+        else
+          timing_.sampling += seconds;
+      }
+
+      void read_row(const char* begin, const char* end,
+                    std::vector<double>& values) {
+        values.resize(columns_.size());
+        int num_cols = header_.size();
+        int col = 0;
+        for (const char* p = begin; ; ++col) {
+          const char* comma = static_cast<const char*>
+            (std::memchr(p, ',', end - p));
+          const char* field_end = comma ? comma : end;
+          if (col < num_cols && positions_[col] >= 0)
+            values[positions_[col]] = to_double(p, field_end);
+          if (!comma)
+            break;
+          p = comma + 1;
+        }
+        if (col + 1 != num_cols) {
+          std::stringstream msg;
+          msg << "Error: expected " << num_cols << " columns, but found "
+              << col + 1 << " instead for row " << num_rows_ + 1;
+          if (out_)
+            *out_ << msg.str() << std::endl;
+          throw std::invalid_argument(msg.str());
+        }
+      }
+
+      static double to_double(const char* begin, const char* end) {
+        while (begin < end && (*begin == ' ' || *begin == '\t'))
+          ++begin;
+        while (begin < end && (*(end - 1) == ' ' || *(end - 1) == '\t'))
+          --end;
+        double x;
+        if (parse_double(begin, end, x))
+          return x;
+        return boost::lexical_cast<double>(std::string(begin, end));
+      }
+
+    public:
+      /**
+       * Construct a reader for the specified stream, reading its
+       * metadata, header and adaptation comments.
+       *
+       * @param[in] in input stream to read
+       * @param[out] out output stream to send messages, or null
+       * @param[in] buffer_size number of characters read at a time
+       * @throw std::invalid_argument if the header cannot be read
+       */
+      stan_csv_stream_reader(std::istream& in, std::ostream* out,
+                             size_t buffer_size = 1 << 20)
+        : in_(in), out_(out), pos_(0),
+          buffer_size_(buffer_size > 0 ? buffer_size : 1),
+          num_rows_(0), eof_(false) {
+        if (!stan_csv_reader::read_metadata(in_, metadata_, out_)) {
+          if (out_)
+            *out_ << "Warning: non-fatal error reading metadata" << std::endl;
+        }
+        if (!stan_csv_reader::read_header(in_, header_, out_)) {
+          if (out_)
+            *out_ << "Error: error reading header" << std::endl;
+          throw std::invalid_argument
+            ("Error with header of input file in stan_csv_stream_reader");
+        }
+        if (!stan_csv_reader::read_adaptation(in_, adaptation_, out_)) {
+          if (out_)
+            *out_ << "Warning: non-fatal error reading adapation data"
+                  << std::endl;
+        }
+        std::vector<std::string> all;
+        select(all);
+      }
+
+      /**
+       * Restrict the values returned by <code>next_row()</code> to
+       * the columns with the specified names, in the order given.  A
+       * name without brackets also picks out all the columns of the
+       * array of that name, such as <code>theta[1]</code> and
+       * <code>theta[2]</code> for <code>theta</code>.  An empty list
+       * of names selects all columns.
+       *
+       * @param[in] names names of columns
+       * @throw std::invalid_argument if a name matches no column
+       */
+      void select(const std::vector<std::string>& names) {
+        int num_cols = header_.size();
+        columns_.clear();
+        positions_.assign(num_cols, -1);
+        if (names.empty()) {
+          for (int col = 0; col < num_cols; ++col)
+            columns_.push_back(col);
+        }
+        for (size_t n = 0; n < names.size(); ++n) {
+          const std::string& name = names[n];
+          bool found = false;
+          for (int col = 0; col < num_cols; ++col) {
+            const std::string& column = header_(col);
+            if (column == name
+                || (column.size() > name.size()
+                    && column.compare(0, name.size(), name) == 0
+                    && column[name.size()] == '[')) {
+              found = true;
+              if (positions_[col] < 0) {
+                positions_[col] = 0;
+                columns_.push_back(col);
+              }
+            }
+          }
+          if (!found)
+            throw std::invalid_argument("Unknown column name: " + name);
+        }
+        for (size_t k = 0; k < columns_.size(); ++k)
+          positions_[columns_[k]] = k;
+      }
+
+      /**
+       * Read the next draw and set the specified vector to the values
+       * of the selected columns.
+       *
+       * @param[out] values values of selected columns
+       * @return <code>true</code> if a draw was read,
+       * <code>false</code> at the end of the stream
+       * @throw std::invalid_argument if the draw has the wrong number
+       * of columns
+       * @throw boost::bad_lexical_cast if a selected value is not a
+       * number
+       */
+      bool next_row(std::vector<double>& values) {
+        const char* begin;
+        const char* end;
+        while (next_line(begin, end)) {
+          if (begin < end && *(end - 1) == '\r')
+            --end;
+          if (begin == end)
+            continue;
+          if (*begin == '#') {
+            read_timing(begin, end);
+            continue;
+          }
+          read_row(begin, end, values);
+          ++num_rows_;
+          return true;
+        }
+        return false;
+      }
+
+      /**
+       * Return the names of the selected columns, in the order their
+       * values are returned by <code>next_row()</code>.
+       *
+       * @return names of selected columns
+       */
+      std::vector<std::string> selected_names() const {
+        std::vector<std::string> names;
+        for (size_t k = 0; k < columns_.size(); ++k)
+          names.push_back(header_(columns_[k]));
+        return names;
+      }
+
+      /**
+       * Return the indexes in the header of the selected columns, in
+       * the order their values are returned by
+       * <code>next_row()</code>.
+       *
+       * @return indexes of selected columns
+       */
+      const std::vector<int>& selected_columns() const {
+        return columns_;
+      }
+
+      /**
+       * Return the number of draws read so far.
+       *
+       * @return number of draws read
+       */
+      size_t num_rows() const {
+        return num_rows_;
+      }
+
+      /**
+       * Return the metadata read from the comments before the header.
+       *
+       * @return metadata
+       */
+      const stan_csv_metadata& metadata() const {
+        return metadata_;
+      }
+
+      /**
+       * Return the names of all columns.
+       *
+       * @return names of all columns
+       */
+      const Eigen::Matrix<std::string, Eigen::Dynamic, 1>& header() const {
+        return header_;
+      }
+
+      /**
+       * Return the adaptation read from the comments after the header.
+       *
+       * @return adaptation
+       */
+      const stan_csv_adaptation& adaptation() const {
+        return adaptation_;
+      }
+
+      /**
+       * Return the timing read from the comments passed so far.
+       *
+       * @return timing
+       */
+      const stan_csv_timing& timing() const {
+        return timing_;
+      }
+    };
+
+  }
+}
+#endif
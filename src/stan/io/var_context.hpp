@@ -1,6 +1,7 @@
 #ifndef STAN_IO_VAR_CONTEXT_HPP
 #define STAN_IO_VAR_CONTEXT_HPP
 
+#include <stan/io/array_view.hpp>
 #include <sstream>
 #include <stdexcept>
 #include <string>
@@ -95,6 +96,42 @@ namespace stan {
        */
       virtual std::vector<size_t> dims_i(const std::string& name) const = 0;
 
+      /**
+       * Return a view of the floating point values for the variable
+       * of the specified name, as <code>vals_r</code> would return
+       * them, or an empty view if the variable is not defined.
+       *
+       * <p>Contexts that store their values should return a view of
+       * that storage, converting integer values as they are read, so
+       * large data is not copied.  The view is valid as long as the
+       * context is neither destroyed nor modified.  This default
+       * implementation returns a view owning a copy of the values.
+       *
+       * @param name Name of variable.
+       * @return View of the values for the named variable.
+       */
+      virtual array_view<double> vals_r_view(const std::string& name) const {
+        std::vector<double> values = vals_r(name);
+        return array_view<double>::owning(values);
+      }
+
+      /**
+       * Return a view of the integer values for the variable of the
+       * specified name, as <code>vals_i</code> would return them, or
+       * an empty view if the variable is not defined.
+       *
+       * <p>See <code>vals_r_view</code> for the lifetime of the view.
+       * This default implementation returns a view owning a copy of
+       * the values.
+       *
+       * @param name Name of variable.
+       * @return View of the integer values for the named variable.
+       */
+      virtual array_view<int> vals_i_view(const std::string& name) const {
+        std::vector<int> values = vals_i(name);
+        return array_view<int>::owning(values);
+      }
+
       /**
        * Fill a list of the names of the floating point variables in
        * the context.
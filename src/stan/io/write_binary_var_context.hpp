@@ -0,0 +1,95 @@
+#ifndef STAN_IO_WRITE_BINARY_VAR_CONTEXT_HPP
+#define STAN_IO_WRITE_BINARY_VAR_CONTEXT_HPP
+
+#include <stan/io/array_view.hpp>
+#include <stan/io/little_endian.hpp>
+#include <stan/io/var_context.hpp>
+#include <boost/cstdint.hpp>
+#include <cstring>
+#include <ostream>
+#include <string>
+#include <vector>
+
+namespace stan {
+  namespace io {
+
+    /**
+     * Write the variables of the specified context to the specified
+     * stream as a binary data container, which may be read back by
+     * <code>binary_var_context</code>.  This converts data read from
+     * R dump or JSON files into a form that can be mapped into memory
+     * rather than parsed.
+     *
+     * <p>Variables with integer values are written as integers and
+     * all others as real values.  The stream should be opened in
+     * binary mode.
+     *
+     * @param context Context to write.
+     * @param out Stream to write to.
+     */
+    inline void write_binary_var_context(const var_context& context,
+                                         std::ostream& out) {
+      std::vector<std::string> names;
+      context.names_i(names);
+      size_t num_ints = names.size();
+      std::vector<std::string> names_r;
+      context.names_r(names_r);
+      for (size_t n = 0; n < names_r.size(); ++n)
+        if (!context.contains_i(names_r[n]))
+          names.push_back(names_r[n]);
+
+      std::vector<std::vector<size_t> > dims(names.size());
+      std::vector<size_t> sizes(names.size());
+      size_t header_size = 16;
+      for (size_t n = 0; n < names.size(); ++n) {
+        dims[n] = n < num_ints ? context.dims_i(names[n])
+          : context.dims_r(names[n]);
+        sizes[n] = n < num_ints ? context.vals_i_view(names[n]).size()
+          : context.vals_r_view(names[n]).size();
+        header_size += 20 + names[n].size() + 8 * dims[n].size();
+      }
+
+      out.write("STANDATA", 8);
+      write_little_endian_32(out, 1);
+      write_little_endian_32(out, static_cast<boost::uint32_t>(names.size()));
+      size_t offset = (header_size + 7) / 8 * 8;
+      for (size_t n = 0; n < names.size(); ++n) {
+        write_little_endian_32(out,
+                               static_cast<boost::uint32_t>(names[n].size()));
+        out.write(names[n].data(), names[n].size());
+        write_little_endian_32(out, n < num_ints ? 0 : 1);
+        write_little_endian_32(out,
+                               static_cast<boost::uint32_t>(dims[n].size()));
+        for (size_t k = 0; k < dims[n].size(); ++k)
+          write_little_endian_64(out, dims[n][k]);
+        write_little_endian_64(out, offset);
+        offset += ((n < num_ints ? 4 : 8) * sizes[n] + 7) / 8 * 8;
+      }
+
+      const char padding[8] = { 0, 0, 0, 0, 0, 0, 0, 0 };
+      out.write(padding, (8 - header_size % 8) % 8);
+      std::vector<char> buffer;
+      for (size_t n = 0; n < names.size(); ++n) {
+        buffer.assign(((n < num_ints ? 4 : 8) * sizes[n] + 7) / 8 * 8, 0);
+        char* p = buffer.empty() ? 0 : &buffer[0];
+        if (n < num_ints) {
+          array_view<int> vals = context.vals_i_view(names[n]);
+          for (size_t i = 0; i < vals.size(); ++i)
+            encode_little_endian_32(static_cast<boost::uint32_t>(vals[i]),
+                                    p + 4 * i);
+        } else {
+          array_view<double> vals = context.vals_r_view(names[n]);
+          for (size_t i = 0; i < vals.size(); ++i) {
+            double x = vals[i];
+            boost::uint64_t bits;
+            std::memcpy(&bits, &x, 8);
+            encode_little_endian_64(bits, p + 8 * i);
+          }
+        }
+        out.write(p, buffer.size());
+      }
+    }
+
+  }
+}
+#endif
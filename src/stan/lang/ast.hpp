@@ -15,9 +15,17 @@
 #include <stan/lang/ast/scope.hpp>
 #include <stan/lang/ast/variable_map.hpp>
 
+#include <stan/lang/ast/fun/assigned_vars_vis.hpp>
 #include <stan/lang/ast/fun/has_non_param_var_vis.hpp>
 #include <stan/lang/ast/fun/has_prob_fun_suffix.hpp>
 #include <stan/lang/ast/fun/has_var_vis.hpp>
+#include <stan/lang/ast/fun/hoist_data_only_statement_vis.hpp>
+#include <stan/lang/ast/fun/hoist_data_only_vis.hpp>
+#include <stan/lang/ast/fun/hoist_loop_invariant_loops_vis.hpp>
+#include <stan/lang/ast/fun/hoist_loop_invariant_statement_vis.hpp>
+#include <stan/lang/ast/fun/hoist_loop_invariant_vis.hpp>
+#include <stan/lang/ast/fun/is_data_only_vis.hpp>
+#include <stan/lang/ast/fun/is_loop_invariant_vis.hpp>
 #include <stan/lang/ast/fun/is_multi_index_vis.hpp>
 #include <stan/lang/ast/fun/is_no_op_statement_vis.hpp>
 #include <stan/lang/ast/fun/is_nil_vis.hpp>
@@ -31,6 +39,7 @@
 #include <stan/lang/ast/fun/var_decl_dims_vis.hpp>
 #include <stan/lang/ast/fun/var_decl_has_def_vis.hpp>
 #include <stan/lang/ast/fun/var_occurs_vis.hpp>
+#include <stan/lang/ast/fun/vectorize_sampling_loops_vis.hpp>
 
 #include <stan/lang/ast/fun/ends_with.hpp>
 #include <stan/lang/ast/fun/fun_name_exists.hpp>
@@ -44,9 +53,14 @@
 #include <stan/lang/ast/fun/has_non_param_var.hpp>
 #include <stan/lang/ast/fun/has_rng_suffix.hpp>
 #include <stan/lang/ast/fun/has_var.hpp>
+#include <stan/lang/ast/fun/hoist_data_only_exprs.hpp>
+#include <stan/lang/ast/fun/hoist_loop_invariant_exprs.hpp>
 #include <stan/lang/ast/fun/indexed_type.hpp>
 #include <stan/lang/ast/fun/infer_type_indexing.hpp>
 #include <stan/lang/ast/fun/is_assignable.hpp>
+#include <stan/lang/ast/fun/is_assigned_before_use.hpp>
+#include <stan/lang/ast/fun/is_data_only.hpp>
+#include <stan/lang/ast/fun/is_loop_invariant.hpp>
 #include <stan/lang/ast/fun/is_multi_index.hpp>
 #include <stan/lang/ast/fun/is_nil.hpp>
 #include <stan/lang/ast/fun/is_nonempty.hpp>
@@ -58,7 +72,11 @@
 #include <stan/lang/ast/fun/print_scope.hpp>
 #include <stan/lang/ast/fun/promote_primitive.hpp>
 #include <stan/lang/ast/fun/returns_type.hpp>
+#include <stan/lang/ast/fun/rewrite_sufficient_stats.hpp>
+#include <stan/lang/ast/fun/sufficient_stats_sample.hpp>
 #include <stan/lang/ast/fun/total_dims.hpp>
+#include <stan/lang/ast/fun/vectorize_sampling_loop.hpp>
+#include <stan/lang/ast/fun/vectorize_sampling_loops.hpp>
 #include <stan/lang/ast/fun/write_base_expr_type.hpp>
 
 #include <stan/lang/ast/sigs/function_signature_t.hpp>
@@ -112,6 +130,7 @@
 #include <stan/lang/ast/node/printable.hpp>
 #include <stan/lang/ast/node/program.hpp>
 #include <stan/lang/ast/node/range.hpp>
+#include <stan/lang/ast/node/reduce_sum.hpp>
 #include <stan/lang/ast/node/reject_statement.hpp>
 #include <stan/lang/ast/node/return_statement.hpp>
 #include <stan/lang/ast/node/matrix_expr.hpp>
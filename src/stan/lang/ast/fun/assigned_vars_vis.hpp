@@ -0,0 +1,197 @@
+#ifndef STAN_LANG_AST_FUN_ASSIGNED_VARS_VIS_HPP
+#define STAN_LANG_AST_FUN_ASSIGNED_VARS_VIS_HPP
+
+#include <boost/variant/static_visitor.hpp>
+#include <set>
+#include <string>
+
+namespace stan {
+  namespace lang {
+
+    struct nil;
+    struct assignment;
+    struct assgn;
+    struct compound_assignment;
+    struct sample;
+    struct increment_log_prob_statement;
+    struct expression;
+    struct statements;
+    struct for_statement;
+    struct for_array_statement;
+    struct for_matrix_statement;
+    struct conditional_statement;
+    struct while_statement;
+    struct break_continue_statement;
+    struct print_statement;
+    struct reject_statement;
+    struct no_op_statement;
+    struct return_statement;
+    struct statement;
+
+    /**
+     * Visitor to collect the names of the variables whose values a
+     * statement may change: the variables it assigns and the loop
+     * and local variables it declares.  The visitor also records
+     * whether the statement contains a break or continue statement.
+     */
+    struct assigned_vars_vis : public boost::static_visitor<> {
+      /**
+       * Construct a visitor adding to the specified names.
+       *
+       * @param[in,out] vars names of variables, to which the names
+       * of the variables the statements change are added
+       * @param[in,out] has_break_continue set to true if a visited
+       * statement contains a break or continue statement
+       */
+      assigned_vars_vis(std::set<std::string>& vars,
+                        bool& has_break_continue);
+
+      /**
+       * Add the variables changed by the specified statement.
+       *
+       * @param[in] st statement
+       */
+      void collect(const statement& st) const;
+
+      /**
+       * Add nothing.
+       *
+       * @param[in] st statement
+       */
+      void operator()(const nil& st) const;
+
+      /**
+       * Add the assigned variable.
+       *
+       * @param[in] st statement
+       */
+      void operator()(const assignment& st) const;
+
+      /**
+       * Add the assigned variable.
+       *
+       * @param[in] st statement
+       */
+      void operator()(const assgn& st) const;
+
+      /**
+       * Add the assigned variable.
+       *
+       * @param[in] st statement
+       */
+      void operator()(const compound_assignment& st) const;
+
+      /**
+       * Add nothing.
+       *
+       * @param[in] st statement
+       */
+      void operator()(const sample& st) const;
+
+      /**
+       * Add nothing.
+       *
+       * @param[in] st statement
+       */
+      void operator()(const increment_log_prob_statement& st) const;
+
+      /**
+       * Add nothing.
+       *
+       * @param[in] st statement
+       */
+      void operator()(const expression& st) const;
+
+      /**
+       * Add the local variables and the variables changed by the
+       * nested statements.
+       *
+       * @param[in] st statement
+       */
+      void operator()(const statements& st) const;
+
+      /**
+       * Add the loop variable and the variables changed by the body.
+       *
+       * @param[in] st statement
+       */
+      void operator()(const for_statement& st) const;
+
+      /**
+       * Add the loop variable and the variables changed by the body.
+       *
+       * @param[in] st statement
+       */
+      void operator()(const for_array_statement& st) const;
+
+      /**
+       * Add the loop variable and the variables changed by the body.
+       *
+       * @param[in] st statement
+       */
+      void operator()(const for_matrix_statement& st) const;
+
+      /**
+       * Add the variables changed by the bodies.
+       *
+       * @param[in] st statement
+       */
+      void operator()(const conditional_statement& st) const;
+
+      /**
+       * Add the variables changed by the body.
+       *
+       * @param[in] st statement
+       */
+      void operator()(const while_statement& st) const;
+
+      /**
+       * Record the break or continue statement.
+       *
+       * @param[in] st statement
+       */
+      void operator()(const break_continue_statement& st) const;
+
+      /**
+       * Add nothing.
+       *
+       * @param[in] st statement
+       */
+      void operator()(const print_statement& st) const;
+
+      /**
+       * Add nothing.
+       *
+       * @param[in] st statement
+       */
+      void operator()(const reject_statement& st) const;
+
+      /**
+       * Add nothing.
+       *
+       * @param[in] st statement
+       */
+      void operator()(const no_op_statement& st) const;
+
+      /**
+       * Add nothing.
+       *
+       * @param[in] st statement
+       */
+      void operator()(const return_statement& st) const;
+
+      /**
+       * Names of the variables changed by the visited statements.
+       */
+      std::set<std::string>& vars_;
+
+      /**
+       * True if a visited statement contains a break or continue
+       * statement.
+       */
+      bool& has_break_continue_;
+    };
+
+  }
+}
+#endif
@@ -0,0 +1,90 @@
+#ifndef STAN_LANG_AST_FUN_ASSIGNED_VARS_VIS_DEF_HPP
+#define STAN_LANG_AST_FUN_ASSIGNED_VARS_VIS_DEF_HPP
+
+#include <stan/lang/ast.hpp>
+#include <boost/variant/apply_visitor.hpp>
+#include <set>
+#include <string>
+
+namespace stan {
+  namespace lang {
+
+    assigned_vars_vis::assigned_vars_vis(std::set<std::string>& vars,
+                                         bool& has_break_continue)
+      : vars_(vars), has_break_continue_(has_break_continue) {
+    }
+
+    void assigned_vars_vis::collect(const statement& st) const {
+      boost::apply_visitor(*this, st.statement_);
+    }
+
+    void assigned_vars_vis::operator()(const nil& st) const { }
+
+    void assigned_vars_vis::operator()(const assignment& st) const {
+      vars_.insert(st.var_dims_.name_);
+    }
+
+    void assigned_vars_vis::operator()(const assgn& st) const {
+      vars_.insert(st.lhs_var_.name_);
+    }
+
+    void assigned_vars_vis::operator()(const compound_assignment& st) const {
+      vars_.insert(st.var_dims_.name_);
+    }
+
+    void assigned_vars_vis::operator()(const sample& st) const { }
+
+    void assigned_vars_vis::operator()(
+        const increment_log_prob_statement& st) const { }
+
+    void assigned_vars_vis::operator()(const expression& st) const { }
+
+    void assigned_vars_vis::operator()(const statements& st) const {
+      for (size_t i = 0; i < st.local_decl_.size(); ++i)
+        vars_.insert(st.local_decl_[i].name());
+      for (size_t i = 0; i < st.statements_.size(); ++i)
+        collect(st.statements_[i]);
+    }
+
+    void assigned_vars_vis::operator()(const for_statement& st) const {
+      vars_.insert(st.variable_);
+      collect(st.statement_);
+    }
+
+    void assigned_vars_vis::operator()(const for_array_statement& st) const {
+      vars_.insert(st.variable_);
+      collect(st.statement_);
+    }
+
+    void assigned_vars_vis::operator()(const for_matrix_statement& st)
+      const {
+      vars_.insert(st.variable_);
+      collect(st.statement_);
+    }
+
+    void assigned_vars_vis::operator()(const conditional_statement& st)
+      const {
+      for (size_t i = 0; i < st.bodies_.size(); ++i)
+        collect(st.bodies_[i]);
+    }
+
+    void assigned_vars_vis::operator()(const while_statement& st) const {
+      collect(st.body_);
+    }
+
+    void assigned_vars_vis::operator()(const break_continue_statement& st)
+      const {
+      has_break_continue_ = true;
+    }
+
+    void assigned_vars_vis::operator()(const print_statement& st) const { }
+
+    void assigned_vars_vis::operator()(const reject_statement& st) const { }
+
+    void assigned_vars_vis::operator()(const no_op_statement& st) const { }
+
+    void assigned_vars_vis::operator()(const return_statement& st) const { }
+
+  }
+}
+#endif
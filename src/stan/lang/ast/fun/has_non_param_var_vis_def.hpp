@@ -104,6 +104,11 @@ namespace stan {
       return boost::apply_visitor(*this, e.y_.expr_);
     }
 
+    bool has_non_param_var_vis::operator()(const reduce_sum& e) const {
+      // if any vars, return true because the sum is nonlinear
+      return boost::apply_visitor(*this, e.theta_.expr_);
+    }
+
     bool has_non_param_var_vis::operator()(const fun& e) const {
       // any function applied to non-linearly transformed var
       for (size_t i = 0; i < e.args_.size(); ++i)
@@ -19,6 +19,7 @@ namespace stan {
     struct integrate_ode_control;
     struct algebra_solver;
     struct algebra_solver_control;
+    struct reduce_sum;
     struct index_op;
     struct index_op_sliced;
     struct conditional_op;
@@ -135,6 +136,15 @@ namespace stan {
        */
       bool operator()(const algebra_solver_control& e) const;
 
+      /**
+       * Return true if the specified expression contains a non-data
+       * variable.
+       *
+       * @param e expression
+       * @return true if expression contains a non-data variable
+       */
+      bool operator()(const reduce_sum& e) const;
+
       /**
        * Return true if the specified expression contains a non-data
        * variable. 
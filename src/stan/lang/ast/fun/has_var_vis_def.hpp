@@ -79,6 +79,11 @@ namespace stan {
       return boost::apply_visitor(*this, e.theta_.expr_);
     }
 
+    bool has_var_vis::operator()(const reduce_sum& e) const {
+      // only theta may contain vars
+      return boost::apply_visitor(*this, e.theta_.expr_);
+    }
+
     bool has_var_vis::operator()(const index_op& e) const {
       return boost::apply_visitor(*this, e.expr_.expr_);
     }
@@ -0,0 +1,22 @@
+#ifndef STAN_LANG_AST_FUN_HOIST_DATA_ONLY_EXPRS_HPP
+#define STAN_LANG_AST_FUN_HOIST_DATA_ONLY_EXPRS_HPP
+
+namespace stan {
+  namespace lang {
+
+    struct program;
+
+    /**
+     * Replace the data-only subexpressions of the model block of the
+     * specified program with member variables, recording the
+     * variables and the statements computing them in the program's
+     * hoisted declarations so that they are computed once by the
+     * constructor rather than on every log density evaluation.
+     *
+     * @param[in,out] prog program to rewrite
+     */
+    void hoist_data_only_exprs(program& prog);
+
+  }
+}
+#endif
@@ -0,0 +1,25 @@
+#ifndef STAN_LANG_AST_FUN_HOIST_DATA_ONLY_EXPRS_DEF_HPP
+#define STAN_LANG_AST_FUN_HOIST_DATA_ONLY_EXPRS_DEF_HPP
+
+#include <stan/lang/ast.hpp>
+#include <set>
+#include <string>
+#include <vector>
+
+namespace stan {
+  namespace lang {
+
+    void hoist_data_only_exprs(program& prog) {
+      std::set<std::string> data_vars;
+      for (size_t i = 0; i < prog.data_decl_.size(); ++i)
+        data_vars.insert(prog.data_decl_[i].name());
+      for (size_t i = 0; i < prog.derived_data_decl_.first.size(); ++i)
+        data_vars.insert(prog.derived_data_decl_.first[i].name());
+      hoist_data_only_statement_vis vis(data_vars, std::vector<expression>(),
+                                        prog.hoisted_decl_);
+      vis.hoist(prog.statement_);
+    }
+
+  }
+}
+#endif
@@ -0,0 +1,241 @@
+#ifndef STAN_LANG_AST_FUN_HOIST_DATA_ONLY_STATEMENT_VIS_HPP
+#define STAN_LANG_AST_FUN_HOIST_DATA_ONLY_STATEMENT_VIS_HPP
+
+#include <boost/variant/static_visitor.hpp>
+#include <cstddef>
+#include <set>
+#include <string>
+#include <utility>
+#include <vector>
+
+namespace stan {
+  namespace lang {
+
+    struct nil;
+    struct assignment;
+    struct assgn;
+    struct compound_assignment;
+    struct sample;
+    struct increment_log_prob_statement;
+    struct expression;
+    struct statements;
+    struct for_statement;
+    struct for_array_statement;
+    struct for_matrix_statement;
+    struct conditional_statement;
+    struct while_statement;
+    struct break_continue_statement;
+    struct print_statement;
+    struct reject_statement;
+    struct no_op_statement;
+    struct return_statement;
+    struct statement;
+    struct variable;
+
+    /**
+     * Visitor to hoist the data-only subexpressions of a statement
+     * and the statements nested in it into member variables computed
+     * once in the model constructor.  Each hoisted computation is
+     * guarded by the data-only conditions under which the statement
+     * is executed, so that it is evaluated in the constructor only if
+     * it would be evaluated in the log density.
+     */
+    struct hoist_data_only_statement_vis : public boost::static_visitor<> {
+      /**
+       * Construct a visitor for hoisting data-only subexpressions
+       * from statements executed under the specified conditions.
+       *
+       * @param[in] data_vars names of data and transformed data
+       * variables
+       * @param[in] guards data-only conditions under which the
+       * statements are executed
+       * @param[in,out] hoisted member variables and the constructor
+       * statements computing them, to which hoisted subexpressions are
+       * added
+       */
+      hoist_data_only_statement_vis(const std::set<std::string>& data_vars,
+                                    const std::vector<expression>& guards,
+                                    std::pair<std::vector<variable>,
+                                              std::vector<statement> >&
+                                    hoisted);
+
+      /**
+       * Hoist the data-only subexpressions of the specified
+       * statement.
+       *
+       * @param[in,out] s statement
+       */
+      void hoist(statement& s) const;
+
+      /**
+       * Hoist the data-only subexpressions of the specified
+       * expression, which belongs to the statement being visited.
+       *
+       * @param[in,out] e expression
+       */
+      void hoist(expression& e) const;
+
+      /**
+       * Leave the specified statement unchanged.
+       *
+       * @param[in,out] st statement
+       */
+      void operator()(nil& st) const;
+
+      /**
+       * Hoist data-only subexpressions of the indexes and value.
+       *
+       * @param[in,out] st statement
+       */
+      void operator()(assignment& st) const;
+
+      /**
+       * Hoist data-only subexpressions of the indexes and value.
+       *
+       * @param[in,out] st statement
+       */
+      void operator()(assgn& st) const;
+
+      /**
+       * Hoist data-only subexpressions of the indexes and value.
+       *
+       * @param[in,out] st statement
+       */
+      void operator()(compound_assignment& st) const;
+
+      /**
+       * Hoist data-only subexpressions of the variate, arguments
+       * and truncation bounds.
+       *
+       * @param[in,out] st statement
+       */
+      void operator()(sample& st) const;
+
+      /**
+       * Hoist data-only subexpressions of the increment.
+       *
+       * @param[in,out] st statement
+       */
+      void operator()(increment_log_prob_statement& st) const;
+
+      /**
+       * Leave the specified statement unchanged, as it is
+       * evaluated for its effect.
+       *
+       * @param[in,out] st statement
+       */
+      void operator()(expression& st) const;
+
+      /**
+       * Hoist data-only subexpressions of the nested statements.
+       *
+       * @param[in,out] st statement
+       */
+      void operator()(statements& st) const;
+
+      /**
+       * Hoist data-only subexpressions of the bounds and, if the
+       * bounds are data only, of the body under the condition that
+       * the range is not empty.
+       *
+       * @param[in,out] st statement
+       */
+      void operator()(for_statement& st) const;
+
+      /**
+       * Leave the specified statement unchanged, as whether its
+       * body executes is not known.
+       *
+       * @param[in,out] st statement
+       */
+      void operator()(for_array_statement& st) const;
+
+      /**
+       * Leave the specified statement unchanged, as whether its
+       * body executes is not known.
+       *
+       * @param[in,out] st statement
+       */
+      void operator()(for_matrix_statement& st) const;
+
+      /**
+       * Hoist data-only subexpressions of the conditions and
+       * bodies under the conditions leading to them, up to the first
+       * condition that is not data only.
+       *
+       * @param[in,out] st statement
+       */
+      void operator()(conditional_statement& st) const;
+
+      /**
+       * Hoist data-only subexpressions of the condition, which is
+       * evaluated at least once, but not of the body.
+       *
+       * @param[in,out] st statement
+       */
+      void operator()(while_statement& st) const;
+
+      /**
+       * Leave the specified statement unchanged.
+       *
+       * @param[in,out] st statement
+       */
+      void operator()(break_continue_statement& st) const;
+
+      /**
+       * Leave the specified statement unchanged.
+       *
+       * @param[in,out] st statement
+       */
+      void operator()(print_statement& st) const;
+
+      /**
+       * Leave the specified statement unchanged.
+       *
+       * @param[in,out] st statement
+       */
+      void operator()(reject_statement& st) const;
+
+      /**
+       * Leave the specified statement unchanged.
+       *
+       * @param[in,out] st statement
+       */
+      void operator()(no_op_statement& st) const;
+
+      /**
+       * Leave the specified statement unchanged.
+       *
+       * @param[in,out] st statement
+       */
+      void operator()(return_statement& st) const;
+
+      /**
+       * Names of the data and transformed data variables.
+       */
+      const std::set<std::string>& data_vars_;
+
+      /**
+       * Data-only conditions under which the statements are executed.
+       */
+      std::vector<expression> guards_;
+
+      /**
+       * First line of the statement being visited.
+       */
+      std::size_t begin_line_;
+
+      /**
+       * Last line of the statement being visited.
+       */
+      std::size_t end_line_;
+
+      /**
+       * Hoisted member variables and the statements computing them.
+       */
+      std::pair<std::vector<variable>, std::vector<statement> >& hoisted_;
+    };
+
+  }
+}
+#endif
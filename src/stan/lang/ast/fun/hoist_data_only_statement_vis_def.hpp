@@ -0,0 +1,145 @@
+#ifndef STAN_LANG_AST_FUN_HOIST_DATA_ONLY_STATEMENT_VIS_DEF_HPP
+#define STAN_LANG_AST_FUN_HOIST_DATA_ONLY_STATEMENT_VIS_DEF_HPP
+
+#include <stan/lang/ast.hpp>
+#include <boost/variant/apply_visitor.hpp>
+#include <set>
+#include <string>
+#include <utility>
+#include <vector>
+
+namespace stan {
+  namespace lang {
+
+    hoist_data_only_statement_vis::hoist_data_only_statement_vis(
+        const std::set<std::string>& data_vars,
+        const std::vector<expression>& guards,
+        std::pair<std::vector<variable>, std::vector<statement> >& hoisted)
+      : data_vars_(data_vars), guards_(guards), begin_line_(0),
+        end_line_(0), hoisted_(hoisted) {
+    }
+
+    void hoist_data_only_statement_vis::hoist(statement& s) const {
+      hoist_data_only_statement_vis vis(*this);
+      vis.begin_line_ = s.begin_line_;
+      vis.end_line_ = s.end_line_;
+      boost::apply_visitor(vis, s.statement_);
+    }
+
+    void hoist_data_only_statement_vis::hoist(expression& e) const {
+      hoist_data_only_vis vis(data_vars_, guards_, begin_line_, end_line_,
+                              hoisted_);
+      vis.hoist(e);
+    }
+
+    void hoist_data_only_statement_vis::operator()(nil& st) const { }
+
+    void hoist_data_only_statement_vis::operator()(assignment& st) const {
+      for (size_t i = 0; i < st.var_dims_.dims_.size(); ++i)
+        hoist(st.var_dims_.dims_[i]);
+      hoist(st.expr_);
+    }
+
+    void hoist_data_only_statement_vis::operator()(assgn& st) const {
+      hoist_data_only_vis vis(data_vars_, guards_, begin_line_, end_line_,
+                              hoisted_);
+      for (size_t i = 0; i < st.idxs_.size(); ++i)
+        boost::apply_visitor(vis, st.idxs_[i].idx_);
+      hoist(st.rhs_);
+    }
+
+    void hoist_data_only_statement_vis::operator()(
+        compound_assignment& st) const {
+      for (size_t i = 0; i < st.var_dims_.dims_.size(); ++i)
+        hoist(st.var_dims_.dims_[i]);
+      hoist(st.expr_);
+    }
+
+    void hoist_data_only_statement_vis::operator()(sample& st) const {
+      hoist(st.expr_);
+      for (size_t i = 0; i < st.dist_.args_.size(); ++i)
+        hoist(st.dist_.args_[i]);
+      hoist(st.truncation_.low_);
+      hoist(st.truncation_.high_);
+    }
+
+    void hoist_data_only_statement_vis::operator()(
+        increment_log_prob_statement& st) const {
+      hoist(st.log_prob_);
+    }
+
+    void hoist_data_only_statement_vis::operator()(expression& st) const { }
+
+    void hoist_data_only_statement_vis::operator()(statements& st) const {
+      for (size_t i = 0; i < st.statements_.size(); ++i)
+        hoist(st.statements_[i]);
+    }
+
+    void hoist_data_only_statement_vis::operator()(for_statement& st) const {
+      bool has_data_only_range = is_data_only(st.range_.low_, data_vars_)
+        && is_data_only(st.range_.high_, data_vars_);
+      std::vector<expression> args;
+      args.push_back(st.range_.low_);
+      args.push_back(st.range_.high_);
+      fun nonempty("logical_lte", args);
+      nonempty.type_ = expr_type(int_type());
+      hoist(st.range_.low_);
+      hoist(st.range_.high_);
+      if (!has_data_only_range)
+        return;
+      hoist_data_only_statement_vis body_vis(*this);
+      body_vis.guards_.push_back(nonempty);
+      body_vis.hoist(st.statement_);
+    }
+
+    void hoist_data_only_statement_vis::operator()(
+        for_array_statement& st) const { }
+
+    void hoist_data_only_statement_vis::operator()(
+        for_matrix_statement& st) const { }
+
+    void hoist_data_only_statement_vis::operator()(
+        conditional_statement& st) const {
+      hoist_data_only_statement_vis branch_vis(*this);
+      for (size_t i = 0; i < st.bodies_.size(); ++i) {
+        if (i < st.conditions_.size()) {
+          expression cond = st.conditions_[i];
+          branch_vis.hoist(st.conditions_[i]);
+          if (!is_data_only(cond, data_vars_))
+            return;
+          hoist_data_only_statement_vis body_vis(branch_vis);
+          body_vis.guards_.push_back(cond);
+          body_vis.hoist(st.bodies_[i]);
+          std::vector<expression> args(1, cond);
+          fun negation("logical_negation", args);
+          negation.type_ = expr_type(int_type());
+          branch_vis.guards_.push_back(negation);
+        } else {
+          branch_vis.hoist(st.bodies_[i]);
+        }
+      }
+    }
+
+    void hoist_data_only_statement_vis::operator()(while_statement& st)
+      const {
+      hoist(st.condition_);
+    }
+
+    void hoist_data_only_statement_vis::operator()(
+        break_continue_statement& st) const { }
+
+    void hoist_data_only_statement_vis::operator()(print_statement& st)
+      const { }
+
+    void hoist_data_only_statement_vis::operator()(reject_statement& st)
+      const { }
+
+    void hoist_data_only_statement_vis::operator()(no_op_statement& st)
+      const { }
+
+    void hoist_data_only_statement_vis::operator()(return_statement& st)
+      const { }
+
+  }
+}
+#endif
@@ -0,0 +1,279 @@
+#ifndef STAN_LANG_AST_FUN_HOIST_DATA_ONLY_VIS_HPP
+#define STAN_LANG_AST_FUN_HOIST_DATA_ONLY_VIS_HPP
+
+#include <boost/variant/static_visitor.hpp>
+#include <cstddef>
+#include <set>
+#include <string>
+#include <utility>
+#include <vector>
+
+namespace stan {
+  namespace lang {
+
+    struct nil;
+    struct int_literal;
+    struct double_literal;
+    struct array_expr;
+    struct matrix_expr;
+    struct row_vector_expr;
+    struct variable;
+    struct fun;
+    struct integrate_ode;
+    struct integrate_ode_control;
+    struct algebra_solver;
+    struct algebra_solver_control;
+    struct reduce_sum;
+    struct index_op;
+    struct index_op_sliced;
+    struct conditional_op;
+    struct binary_op;
+    struct unary_op;
+    struct uni_idx;
+    struct multi_idx;
+    struct omni_idx;
+    struct lb_idx;
+    struct ub_idx;
+    struct lub_idx;
+    struct expression;
+    struct statement;
+
+    /**
+     * Visitor to replace the data-only subexpressions of an
+     * expression with member variables computed once in the model
+     * constructor.  Only maximal subexpressions that do some work are
+     * hoisted, not variables, literals, single indexes or integer
+     * scalars.
+     */
+    struct hoist_data_only_vis : public boost::static_visitor<> {
+      /**
+       * Construct a visitor for hoisting the data-only
+       * subexpressions of an expression in a statement.
+       *
+       * @param[in] data_vars names of data and transformed data
+       * variables
+       * @param[in] guards data-only conditions under which the
+       * statement is executed
+       * @param[in] begin_line first line of the statement
+       * @param[in] end_line last line of the statement
+       * @param[in,out] hoisted member variables and the constructor
+       * statements computing them, to which hoisted subexpressions are
+       * added
+       */
+      hoist_data_only_vis(const std::set<std::string>& data_vars,
+                          const std::vector<expression>& guards,
+                          std::size_t begin_line, std::size_t end_line,
+                          std::pair<std::vector<variable>,
+                                    std::vector<statement> >& hoisted);
+
+      /**
+       * Replace the specified expression with a member variable if it
+       * is data only and worth hoisting, and otherwise hoist its
+       * data-only subexpressions.
+       *
+       * @param[in,out] e expression
+       */
+      void hoist(expression& e) const;
+
+      /**
+       * Leave the specified expression unchanged.
+       *
+       * @param[in,out] e expression
+       */
+      void operator()(nil& e) const;
+
+      /**
+       * Leave the specified expression unchanged.
+       *
+       * @param[in,out] e expression
+       */
+      void operator()(int_literal& e) const;
+
+      /**
+       * Leave the specified expression unchanged.
+       *
+       * @param[in,out] e expression
+       */
+      void operator()(double_literal& e) const;
+
+      /**
+       * Hoist data-only subexpressions of the elements.
+       *
+       * @param[in,out] e expression
+       */
+      void operator()(array_expr& e) const;
+
+      /**
+       * Hoist data-only subexpressions of the elements.
+       *
+       * @param[in,out] e expression
+       */
+      void operator()(matrix_expr& e) const;
+
+      /**
+       * Hoist data-only subexpressions of the elements.
+       *
+       * @param[in,out] e expression
+       */
+      void operator()(row_vector_expr& e) const;
+
+      /**
+       * Leave the specified expression unchanged.
+       *
+       * @param[in,out] e expression
+       */
+      void operator()(variable& e) const;
+
+      /**
+       * Hoist data-only subexpressions of the arguments, only
+       * from the first argument of a short-circuiting logical
+       * operator.
+       *
+       * @param[in,out] e expression
+       */
+      void operator()(fun& e) const;
+
+      /**
+       * Leave the specified expression unchanged.
+       *
+       * @param[in,out] e expression
+       */
+      void operator()(integrate_ode& e) const;
+
+      /**
+       * Leave the specified expression unchanged.
+       *
+       * @param[in,out] e expression
+       */
+      void operator()(integrate_ode_control& e) const;
+
+      /**
+       * Leave the specified expression unchanged.
+       *
+       * @param[in,out] e expression
+       */
+      void operator()(algebra_solver& e) const;
+
+      /**
+       * Leave the specified expression unchanged.
+       *
+       * @param[in,out] e expression
+       */
+      void operator()(algebra_solver_control& e) const;
+
+      /**
+       * Leave the specified expression unchanged.
+       *
+       * @param[in,out] e expression
+       */
+      void operator()(reduce_sum& e) const;
+
+      /**
+       * Hoist data-only subexpressions of the indexed expression
+       * and indexes.
+       *
+       * @param[in,out] e expression
+       */
+      void operator()(index_op& e) const;
+
+      /**
+       * Hoist data-only subexpressions of the indexed expression
+       * and indexes.
+       *
+       * @param[in,out] e expression
+       */
+      void operator()(index_op_sliced& e) const;
+
+      /**
+       * Hoist data-only subexpressions of the condition, which
+       * unlike the results is always evaluated.
+       *
+       * @param[in,out] e expression
+       */
+      void operator()(conditional_op& e) const;
+
+      /**
+       * Hoist data-only subexpressions of the operands.
+       *
+       * @param[in,out] e expression
+       */
+      void operator()(binary_op& e) const;
+
+      /**
+       * Hoist data-only subexpressions of the operand.
+       *
+       * @param[in,out] e expression
+       */
+      void operator()(unary_op& e) const;
+
+      /**
+       * Hoist data-only subexpressions of the specified index.
+       *
+       * @param[in,out] i index
+       */
+      void operator()(uni_idx& i) const;
+
+      /**
+       * Hoist data-only subexpressions of the specified index.
+       *
+       * @param[in,out] i index
+       */
+      void operator()(multi_idx& i) const;
+
+      /**
+       * Leave the specified index unchanged.
+       *
+       * @param[in,out] i index
+       */
+      void operator()(omni_idx& i) const;
+
+      /**
+       * Hoist data-only subexpressions of the specified index.
+       *
+       * @param[in,out] i index
+       */
+      void operator()(lb_idx& i) const;
+
+      /**
+       * Hoist data-only subexpressions of the specified index.
+       *
+       * @param[in,out] i index
+       */
+      void operator()(ub_idx& i) const;
+
+      /**
+       * Hoist data-only subexpressions of the specified index.
+       *
+       * @param[in,out] i index
+       */
+      void operator()(lub_idx& i) const;
+
+      /**
+       * Names of the data and transformed data variables.
+       */
+      const std::set<std::string>& data_vars_;
+
+      /**
+       * Data-only conditions under which the statement is executed.
+       */
+      const std::vector<expression>& guards_;
+
+      /**
+       * First line of the statement.
+       */
+      const std::size_t begin_line_;
+
+      /**
+       * Last line of the statement.
+       */
+      const std::size_t end_line_;
+
+      /**
+       * Hoisted member variables and the statements computing them.
+       */
+      std::pair<std::vector<variable>, std::vector<statement> >& hoisted_;
+    };
+
+  }
+}
+#endif
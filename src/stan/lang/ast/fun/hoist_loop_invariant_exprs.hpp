@@ -0,0 +1,24 @@
+#ifndef STAN_LANG_AST_FUN_HOIST_LOOP_INVARIANT_EXPRS_HPP
+#define STAN_LANG_AST_FUN_HOIST_LOOP_INVARIANT_EXPRS_HPP
+
+namespace stan {
+  namespace lang {
+
+    struct program;
+
+    /**
+     * Replace the loop-invariant subexpressions of the bodies of the
+     * for loops in the model block of the specified program with
+     * local variables declared and computed once before each loop,
+     * rather than on every iteration.  Subexpressions are invariant
+     * if they do not depend on the loop variable or on any variable
+     * the body changes and call no <code>_lp</code> or user-defined
+     * function.
+     *
+     * @param[in,out] prog program to rewrite
+     */
+    void hoist_loop_invariant_exprs(program& prog);
+
+  }
+}
+#endif
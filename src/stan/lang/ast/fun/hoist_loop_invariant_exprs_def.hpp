@@ -0,0 +1,17 @@
+#ifndef STAN_LANG_AST_FUN_HOIST_LOOP_INVARIANT_EXPRS_DEF_HPP
+#define STAN_LANG_AST_FUN_HOIST_LOOP_INVARIANT_EXPRS_DEF_HPP
+
+#include <stan/lang/ast.hpp>
+
+namespace stan {
+  namespace lang {
+
+    void hoist_loop_invariant_exprs(program& prog) {
+      int num_hoisted = 0;
+      hoist_loop_invariant_loops_vis vis(num_hoisted);
+      vis.hoist(prog.statement_);
+    }
+
+  }
+}
+#endif
@@ -0,0 +1,190 @@
+#ifndef STAN_LANG_AST_FUN_HOIST_LOOP_INVARIANT_LOOPS_VIS_HPP
+#define STAN_LANG_AST_FUN_HOIST_LOOP_INVARIANT_LOOPS_VIS_HPP
+
+#include <boost/variant/static_visitor.hpp>
+
+namespace stan {
+  namespace lang {
+
+    struct nil;
+    struct assignment;
+    struct assgn;
+    struct compound_assignment;
+    struct sample;
+    struct increment_log_prob_statement;
+    struct expression;
+    struct statements;
+    struct for_statement;
+    struct for_array_statement;
+    struct for_matrix_statement;
+    struct conditional_statement;
+    struct while_statement;
+    struct break_continue_statement;
+    struct print_statement;
+    struct reject_statement;
+    struct no_op_statement;
+    struct return_statement;
+    struct statement;
+
+    /**
+     * Visitor to find the for loops in a statement and hoist the
+     * loop-invariant subexpressions of their bodies into local
+     * variables computed before them.  Inner loops are rewritten
+     * before the loops containing them, so an expression invariant
+     * in several nested loops is computed before the outermost one.
+     */
+    struct hoist_loop_invariant_loops_vis : public boost::static_visitor<> {
+      /**
+       * Construct a visitor for rewriting loops.
+       *
+       * @param[in,out] num_hoisted number of local variables hoisted
+       * so far in the program, used to name them
+       */
+      explicit hoist_loop_invariant_loops_vis(int& num_hoisted);
+
+      /**
+       * Rewrite the loops nested in the specified statement and, if
+       * it is a for loop whose body contains no break or continue
+       * statement, replace it with a block declaring and computing
+       * the loop-invariant subexpressions of its body followed by
+       * the loop.
+       *
+       * @param[in,out] s statement
+       */
+      void hoist(statement& s) const;
+
+      /**
+       * Leave the specified statement unchanged.
+       *
+       * @param[in,out] st statement
+       */
+      void operator()(nil& st) const;
+
+      /**
+       * Leave the specified statement unchanged.
+       *
+       * @param[in,out] st statement
+       */
+      void operator()(assignment& st) const;
+
+      /**
+       * Leave the specified statement unchanged.
+       *
+       * @param[in,out] st statement
+       */
+      void operator()(assgn& st) const;
+
+      /**
+       * Leave the specified statement unchanged.
+       *
+       * @param[in,out] st statement
+       */
+      void operator()(compound_assignment& st) const;
+
+      /**
+       * Leave the specified statement unchanged.
+       *
+       * @param[in,out] st statement
+       */
+      void operator()(sample& st) const;
+
+      /**
+       * Leave the specified statement unchanged.
+       *
+       * @param[in,out] st statement
+       */
+      void operator()(increment_log_prob_statement& st) const;
+
+      /**
+       * Leave the specified statement unchanged.
+       *
+       * @param[in,out] st statement
+       */
+      void operator()(expression& st) const;
+
+      /**
+       * Rewrite the loops in the nested statements.
+       *
+       * @param[in,out] st statement
+       */
+      void operator()(statements& st) const;
+
+      /**
+       * Rewrite the loops in the body.
+       *
+       * @param[in,out] st statement
+       */
+      void operator()(for_statement& st) const;
+
+      /**
+       * Rewrite the loops in the body.
+       *
+       * @param[in,out] st statement
+       */
+      void operator()(for_array_statement& st) const;
+
+      /**
+       * Rewrite the loops in the body.
+       *
+       * @param[in,out] st statement
+       */
+      void operator()(for_matrix_statement& st) const;
+
+      /**
+       * Rewrite the loops in the bodies.
+       *
+       * @param[in,out] st statement
+       */
+      void operator()(conditional_statement& st) const;
+
+      /**
+       * Rewrite the loops in the body.
+       *
+       * @param[in,out] st statement
+       */
+      void operator()(while_statement& st) const;
+
+      /**
+       * Leave the specified statement unchanged.
+       *
+       * @param[in,out] st statement
+       */
+      void operator()(break_continue_statement& st) const;
+
+      /**
+       * Leave the specified statement unchanged.
+       *
+       * @param[in,out] st statement
+       */
+      void operator()(print_statement& st) const;
+
+      /**
+       * Leave the specified statement unchanged.
+       *
+       * @param[in,out] st statement
+       */
+      void operator()(reject_statement& st) const;
+
+      /**
+       * Leave the specified statement unchanged.
+       *
+       * @param[in,out] st statement
+       */
+      void operator()(no_op_statement& st) const;
+
+      /**
+       * Leave the specified statement unchanged.
+       *
+       * @param[in,out] st statement
+       */
+      void operator()(return_statement& st) const;
+
+      /**
+       * Number of local variables hoisted so far in the program.
+       */
+      int& num_hoisted_;
+    };
+
+  }
+}
+#endif
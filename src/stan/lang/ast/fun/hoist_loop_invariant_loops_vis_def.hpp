@@ -0,0 +1,115 @@
+#ifndef STAN_LANG_AST_FUN_HOIST_LOOP_INVARIANT_LOOPS_VIS_DEF_HPP
+#define STAN_LANG_AST_FUN_HOIST_LOOP_INVARIANT_LOOPS_VIS_DEF_HPP
+
+#include <stan/lang/ast.hpp>
+#include <boost/variant/apply_visitor.hpp>
+#include <boost/variant/get.hpp>
+#include <set>
+#include <string>
+#include <utility>
+#include <vector>
+
+namespace stan {
+  namespace lang {
+
+    hoist_loop_invariant_loops_vis::hoist_loop_invariant_loops_vis(
+        int& num_hoisted)
+      : num_hoisted_(num_hoisted) {
+    }
+
+    void hoist_loop_invariant_loops_vis::hoist(statement& s) const {
+      boost::apply_visitor(*this, s.statement_);
+      for_statement* loop = boost::get<for_statement>(&s.statement_);
+      if (!loop)
+        return;
+      std::set<std::string> loop_vars;
+      bool has_break_continue = false;
+      assigned_vars_vis assigned_vis(loop_vars, has_break_continue);
+      assigned_vis.collect(loop->statement_);
+      if (has_break_continue)
+        return;  // body statements may be skipped on some iterations
+      loop_vars.insert(loop->variable_);
+      std::vector<expression> args;
+      args.push_back(loop->range_.low_);
+      args.push_back(loop->range_.high_);
+      fun nonempty("logical_lte", args);
+      nonempty.type_ = expr_type(int_type());
+      std::pair<std::vector<var_decl>, std::vector<statement> > hoisted;
+      hoist_loop_invariant_statement_vis body_vis(
+          loop_vars, std::vector<expression>(1, nonempty), num_hoisted_,
+          hoisted);
+      body_vis.hoist(loop->statement_);
+      if (hoisted.first.empty())
+        return;
+      hoisted.second.push_back(s);
+      statement block(statements(hoisted.first, hoisted.second));
+      block.begin_line_ = s.begin_line_;
+      block.end_line_ = s.end_line_;
+      s = block;
+    }
+
+    void hoist_loop_invariant_loops_vis::operator()(nil& st) const { }
+
+    void hoist_loop_invariant_loops_vis::operator()(assignment& st) const { }
+
+    void hoist_loop_invariant_loops_vis::operator()(assgn& st) const { }
+
+    void hoist_loop_invariant_loops_vis::operator()(
+        compound_assignment& st) const { }
+
+    void hoist_loop_invariant_loops_vis::operator()(sample& st) const { }
+
+    void hoist_loop_invariant_loops_vis::operator()(
+        increment_log_prob_statement& st) const { }
+
+    void hoist_loop_invariant_loops_vis::operator()(expression& st) const { }
+
+    void hoist_loop_invariant_loops_vis::operator()(statements& st) const {
+      for (size_t i = 0; i < st.statements_.size(); ++i)
+        hoist(st.statements_[i]);
+    }
+
+    void hoist_loop_invariant_loops_vis::operator()(for_statement& st)
+      const {
+      hoist(st.statement_);
+    }
+
+    void hoist_loop_invariant_loops_vis::operator()(
+        for_array_statement& st) const {
+      hoist(st.statement_);
+    }
+
+    void hoist_loop_invariant_loops_vis::operator()(
+        for_matrix_statement& st) const {
+      hoist(st.statement_);
+    }
+
+    void hoist_loop_invariant_loops_vis::operator()(
+        conditional_statement& st) const {
+      for (size_t i = 0; i < st.bodies_.size(); ++i)
+        hoist(st.bodies_[i]);
+    }
+
+    void hoist_loop_invariant_loops_vis::operator()(while_statement& st)
+      const {
+      hoist(st.body_);
+    }
+
+    void hoist_loop_invariant_loops_vis::operator()(
+        break_continue_statement& st) const { }
+
+    void hoist_loop_invariant_loops_vis::operator()(print_statement& st)
+      const { }
+
+    void hoist_loop_invariant_loops_vis::operator()(reject_statement& st)
+      const { }
+
+    void hoist_loop_invariant_loops_vis::operator()(no_op_statement& st)
+      const { }
+
+    void hoist_loop_invariant_loops_vis::operator()(return_statement& st)
+      const { }
+
+  }
+}
+#endif
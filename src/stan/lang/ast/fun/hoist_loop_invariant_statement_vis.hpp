@@ -0,0 +1,263 @@
+#ifndef STAN_LANG_AST_FUN_HOIST_LOOP_INVARIANT_STATEMENT_VIS_HPP
+#define STAN_LANG_AST_FUN_HOIST_LOOP_INVARIANT_STATEMENT_VIS_HPP
+
+#include <boost/variant/static_visitor.hpp>
+#include <cstddef>
+#include <set>
+#include <string>
+#include <utility>
+#include <vector>
+
+namespace stan {
+  namespace lang {
+
+    struct nil;
+    struct assignment;
+    struct assgn;
+    struct compound_assignment;
+    struct sample;
+    struct increment_log_prob_statement;
+    struct expression;
+    struct statements;
+    struct for_statement;
+    struct for_array_statement;
+    struct for_matrix_statement;
+    struct conditional_statement;
+    struct while_statement;
+    struct break_continue_statement;
+    struct print_statement;
+    struct reject_statement;
+    struct no_op_statement;
+    struct return_statement;
+    struct statement;
+    struct var_decl;
+
+    /**
+     * Visitor to hoist the loop-invariant subexpressions of the body
+     * of a for loop and the statements nested in it into local
+     * variables computed once before the loop.  Each hoisted
+     * computation is guarded by the loop-invariant conditions under
+     * which the statement is executed, starting with the condition
+     * that the range of the loop is not empty, so that it is
+     * evaluated before the loop only if it would be evaluated in the
+     * loop.
+     */
+    struct hoist_loop_invariant_statement_vis
+      : public boost::static_visitor<> {
+      /**
+       * Construct a visitor for hoisting loop-invariant
+       * subexpressions from statements executed under the specified
+       * conditions.
+       *
+       * @param[in] loop_vars names of the loop variable and of the
+       * variables changed by the loop body
+       * @param[in] guards loop-invariant conditions under which the
+       * statements are executed on every iteration
+       * @param[in,out] num_hoisted number of local variables hoisted
+       * so far in the program, used to name them
+       * @param[in,out] hoisted local variables and the statements
+       * computing them before the loop, to which hoisted
+       * subexpressions are added
+       */
+      hoist_loop_invariant_statement_vis(
+          const std::set<std::string>& loop_vars,
+          const std::vector<expression>& guards, int& num_hoisted,
+          std::pair<std::vector<var_decl>, std::vector<statement> >&
+          hoisted);
+
+      /**
+       * Hoist the loop-invariant subexpressions of the specified
+       * statement.
+       *
+       * @param[in,out] s statement
+       */
+      void hoist(statement& s) const;
+
+      /**
+       * Hoist the loop-invariant subexpressions of the specified
+       * expression, which belongs to the statement being visited.
+       *
+       * @param[in,out] e expression
+       */
+      void hoist(expression& e) const;
+
+      /**
+       * Return true if the specified expression has the same value
+       * on every iteration of the loop.
+       *
+       * @param[in] e expression
+       * @return true if the expression is loop invariant
+       */
+      bool is_invariant(const expression& e) const;
+
+      /**
+       * Leave the specified statement unchanged.
+       *
+       * @param[in,out] st statement
+       */
+      void operator()(nil& st) const;
+
+      /**
+       * Hoist loop-invariant subexpressions of the indexes and value.
+       *
+       * @param[in,out] st statement
+       */
+      void operator()(assignment& st) const;
+
+      /**
+       * Hoist loop-invariant subexpressions of the indexes and value.
+       *
+       * @param[in,out] st statement
+       */
+      void operator()(assgn& st) const;
+
+      /**
+       * Hoist loop-invariant subexpressions of the indexes and value.
+       *
+       * @param[in,out] st statement
+       */
+      void operator()(compound_assignment& st) const;
+
+      /**
+       * Hoist loop-invariant subexpressions of the variate, arguments
+       * and truncation bounds.
+       *
+       * @param[in,out] st statement
+       */
+      void operator()(sample& st) const;
+
+      /**
+       * Hoist loop-invariant subexpressions of the increment.
+       *
+       * @param[in,out] st statement
+       */
+      void operator()(increment_log_prob_statement& st) const;
+
+      /**
+       * Leave the specified statement unchanged, as it is
+       * evaluated for its effect.
+       *
+       * @param[in,out] st statement
+       */
+      void operator()(expression& st) const;
+
+      /**
+       * Hoist loop-invariant subexpressions of the nested statements.
+       *
+       * @param[in,out] st statement
+       */
+      void operator()(statements& st) const;
+
+      /**
+       * Hoist loop-invariant subexpressions of the bounds and, if the
+       * bounds are loop invariant, of the body under the condition that
+       * the range is not empty.
+       *
+       * @param[in,out] st statement
+       */
+      void operator()(for_statement& st) const;
+
+      /**
+       * Leave the specified statement unchanged, as whether its
+       * body executes is not known.
+       *
+       * @param[in,out] st statement
+       */
+      void operator()(for_array_statement& st) const;
+
+      /**
+       * Leave the specified statement unchanged, as whether its
+       * body executes is not known.
+       *
+       * @param[in,out] st statement
+       */
+      void operator()(for_matrix_statement& st) const;
+
+      /**
+       * Hoist loop-invariant subexpressions of the conditions and
+       * bodies under the conditions leading to them, up to the first
+       * condition that is not loop invariant.
+       *
+       * @param[in,out] st statement
+       */
+      void operator()(conditional_statement& st) const;
+
+      /**
+       * Hoist loop-invariant subexpressions of the condition, which is
+       * evaluated at least once, but not of the body.
+       *
+       * @param[in,out] st statement
+       */
+      void operator()(while_statement& st) const;
+
+      /**
+       * Leave the specified statement unchanged.
+       *
+       * @param[in,out] st statement
+       */
+      void operator()(break_continue_statement& st) const;
+
+      /**
+       * Leave the specified statement unchanged.
+       *
+       * @param[in,out] st statement
+       */
+      void operator()(print_statement& st) const;
+
+      /**
+       * Leave the specified statement unchanged.
+       *
+       * @param[in,out] st statement
+       */
+      void operator()(reject_statement& st) const;
+
+      /**
+       * Leave the specified statement unchanged.
+       *
+       * @param[in,out] st statement
+       */
+      void operator()(no_op_statement& st) const;
+
+      /**
+       * Leave the specified statement unchanged.
+       *
+       * @param[in,out] st statement
+       */
+      void operator()(return_statement& st) const;
+
+      /**
+       * Names of the loop variable and of the variables changed by
+       * the loop body.
+       */
+      const std::set<std::string>& loop_vars_;
+
+      /**
+       * Loop-invariant conditions under which the statements are
+       * executed.
+       */
+      std::vector<expression> guards_;
+
+      /**
+       * First line of the statement being visited.
+       */
+      std::size_t begin_line_;
+
+      /**
+       * Last line of the statement being visited.
+       */
+      std::size_t end_line_;
+
+      /**
+       * Number of local variables hoisted so far in the program.
+       */
+      int& num_hoisted_;
+
+      /**
+       * Hoisted local variables and the statements computing them.
+       */
+      std::pair<std::vector<var_decl>, std::vector<statement> >& hoisted_;
+    };
+
+  }
+}
+#endif
@@ -0,0 +1,303 @@
+#ifndef STAN_LANG_AST_FUN_HOIST_LOOP_INVARIANT_VIS_HPP
+#define STAN_LANG_AST_FUN_HOIST_LOOP_INVARIANT_VIS_HPP
+
+#include <boost/variant/static_visitor.hpp>
+#include <cstddef>
+#include <set>
+#include <string>
+#include <utility>
+#include <vector>
+
+namespace stan {
+  namespace lang {
+
+    struct nil;
+    struct int_literal;
+    struct double_literal;
+    struct array_expr;
+    struct matrix_expr;
+    struct row_vector_expr;
+    struct variable;
+    struct fun;
+    struct integrate_ode;
+    struct integrate_ode_control;
+    struct algebra_solver;
+    struct algebra_solver_control;
+    struct reduce_sum;
+    struct index_op;
+    struct index_op_sliced;
+    struct conditional_op;
+    struct binary_op;
+    struct unary_op;
+    struct uni_idx;
+    struct multi_idx;
+    struct omni_idx;
+    struct lb_idx;
+    struct ub_idx;
+    struct lub_idx;
+    struct expression;
+    struct statement;
+    struct var_decl;
+
+    /**
+     * Visitor to replace the loop-invariant subexpressions of an
+     * expression in the body of a for loop with local variables
+     * computed once before the loop.  A subexpression is invariant if
+     * it is invariant, as defined by <code>is_loop_invariant</code>,
+     * for the loop variable and for every variable the loop body
+     * changes.  Only maximal subexpressions that do some work are
+     * hoisted, not variables, literals, single indexes or integer
+     * values.
+     */
+    struct hoist_loop_invariant_vis : public boost::static_visitor<> {
+      /**
+       * Construct a visitor for hoisting the loop-invariant
+       * subexpressions of an expression in a statement of a loop
+       * body.
+       *
+       * @param[in] loop_vars names of the loop variable and of the
+       * variables changed by the loop body
+       * @param[in] guards loop-invariant conditions under which the
+       * statement is executed on every iteration
+       * @param[in] begin_line first line of the statement
+       * @param[in] end_line last line of the statement
+       * @param[in,out] num_hoisted number of local variables hoisted
+       * so far in the program, used to name them
+       * @param[in,out] hoisted local variables and the statements
+       * computing them before the loop, to which hoisted
+       * subexpressions are added
+       */
+      hoist_loop_invariant_vis(const std::set<std::string>& loop_vars,
+                               const std::vector<expression>& guards,
+                               std::size_t begin_line, std::size_t end_line,
+                               int& num_hoisted,
+                               std::pair<std::vector<var_decl>,
+                                         std::vector<statement> >& hoisted);
+
+      /**
+       * Return true if the specified expression has the same value
+       * on every iteration of the loop.
+       *
+       * @param[in] e expression
+       * @return true if the expression is loop invariant
+       */
+      bool is_invariant(const expression& e) const;
+
+      /**
+       * Replace the specified expression with a local variable if it
+       * is loop invariant and worth hoisting, and otherwise hoist its
+       * loop-invariant subexpressions.
+       *
+       * @param[in,out] e expression
+       */
+      void hoist(expression& e) const;
+
+      /**
+       * Leave the specified expression unchanged.
+       *
+       * @param[in,out] e expression
+       */
+      void operator()(nil& e) const;
+
+      /**
+       * Leave the specified expression unchanged.
+       *
+       * @param[in,out] e expression
+       */
+      void operator()(int_literal& e) const;
+
+      /**
+       * Leave the specified expression unchanged.
+       *
+       * @param[in,out] e expression
+       */
+      void operator()(double_literal& e) const;
+
+      /**
+       * Hoist loop-invariant subexpressions of the elements.
+       *
+       * @param[in,out] e expression
+       */
+      void operator()(array_expr& e) const;
+
+      /**
+       * Hoist loop-invariant subexpressions of the elements.
+       *
+       * @param[in,out] e expression
+       */
+      void operator()(matrix_expr& e) const;
+
+      /**
+       * Hoist loop-invariant subexpressions of the elements.
+       *
+       * @param[in,out] e expression
+       */
+      void operator()(row_vector_expr& e) const;
+
+      /**
+       * Leave the specified expression unchanged.
+       *
+       * @param[in,out] e expression
+       */
+      void operator()(variable& e) const;
+
+      /**
+       * Hoist loop-invariant subexpressions of the arguments, only
+       * from the first argument of a short-circuiting logical
+       * operator.
+       *
+       * @param[in,out] e expression
+       */
+      void operator()(fun& e) const;
+
+      /**
+       * Leave the specified expression unchanged.
+       *
+       * @param[in,out] e expression
+       */
+      void operator()(integrate_ode& e) const;
+
+      /**
+       * Leave the specified expression unchanged.
+       *
+       * @param[in,out] e expression
+       */
+      void operator()(integrate_ode_control& e) const;
+
+      /**
+       * Leave the specified expression unchanged.
+       *
+       * @param[in,out] e expression
+       */
+      void operator()(algebra_solver& e) const;
+
+      /**
+       * Leave the specified expression unchanged.
+       *
+       * @param[in,out] e expression
+       */
+      void operator()(algebra_solver_control& e) const;
+
+      /**
+       * Leave the specified expression unchanged.
+       *
+       * @param[in,out] e expression
+       */
+      void operator()(reduce_sum& e) const;
+
+      /**
+       * Hoist loop-invariant subexpressions of the indexed expression
+       * and indexes.
+       *
+       * @param[in,out] e expression
+       */
+      void operator()(index_op& e) const;
+
+      /**
+       * Hoist loop-invariant subexpressions of the indexed expression
+       * and indexes.
+       *
+       * @param[in,out] e expression
+       */
+      void operator()(index_op_sliced& e) const;
+
+      /**
+       * Hoist loop-invariant subexpressions of the condition, which
+       * unlike the results is always evaluated.
+       *
+       * @param[in,out] e expression
+       */
+      void operator()(conditional_op& e) const;
+
+      /**
+       * Hoist loop-invariant subexpressions of the operands.
+       *
+       * @param[in,out] e expression
+       */
+      void operator()(binary_op& e) const;
+
+      /**
+       * Hoist loop-invariant subexpressions of the operand.
+       *
+       * @param[in,out] e expression
+       */
+      void operator()(unary_op& e) const;
+
+      /**
+       * Hoist loop-invariant subexpressions of the specified index.
+       *
+       * @param[in,out] i index
+       */
+      void operator()(uni_idx& i) const;
+
+      /**
+       * Hoist loop-invariant subexpressions of the specified index.
+       *
+       * @param[in,out] i index
+       */
+      void operator()(multi_idx& i) const;
+
+      /**
+       * Leave the specified index unchanged.
+       *
+       * @param[in,out] i index
+       */
+      void operator()(omni_idx& i) const;
+
+      /**
+       * Hoist loop-invariant subexpressions of the specified index.
+       *
+       * @param[in,out] i index
+       */
+      void operator()(lb_idx& i) const;
+
+      /**
+       * Hoist loop-invariant subexpressions of the specified index.
+       *
+       * @param[in,out] i index
+       */
+      void operator()(ub_idx& i) const;
+
+      /**
+       * Hoist loop-invariant subexpressions of the specified index.
+       *
+       * @param[in,out] i index
+       */
+      void operator()(lub_idx& i) const;
+
+      /**
+       * Names of the loop variable and of the variables changed by
+       * the loop body.
+       */
+      const std::set<std::string>& loop_vars_;
+
+      /**
+       * Loop-invariant conditions under which the statement is
+       * executed.
+       */
+      const std::vector<expression>& guards_;
+
+      /**
+       * First line of the statement.
+       */
+      const std::size_t begin_line_;
+
+      /**
+       * Last line of the statement.
+       */
+      const std::size_t end_line_;
+
+      /**
+       * Number of local variables hoisted so far in the program.
+       */
+      int& num_hoisted_;
+
+      /**
+       * Hoisted local variables and the statements computing them.
+       */
+      std::pair<std::vector<var_decl>, std::vector<statement> >& hoisted_;
+    };
+
+  }
+}
+#endif
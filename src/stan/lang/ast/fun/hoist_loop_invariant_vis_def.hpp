@@ -0,0 +1,181 @@
+#ifndef STAN_LANG_AST_FUN_HOIST_LOOP_INVARIANT_VIS_DEF_HPP
+#define STAN_LANG_AST_FUN_HOIST_LOOP_INVARIANT_VIS_DEF_HPP
+
+#include <stan/lang/ast.hpp>
+#include <boost/variant/apply_visitor.hpp>
+#include <boost/variant/get.hpp>
+#include <cstddef>
+#include <set>
+#include <sstream>
+#include <string>
+#include <utility>
+#include <vector>
+
+namespace stan {
+  namespace lang {
+
+    hoist_loop_invariant_vis::hoist_loop_invariant_vis(
+        const std::set<std::string>& loop_vars,
+        const std::vector<expression>& guards,
+        std::size_t begin_line, std::size_t end_line, int& num_hoisted,
+        std::pair<std::vector<var_decl>, std::vector<statement> >& hoisted)
+      : loop_vars_(loop_vars), guards_(guards), begin_line_(begin_line),
+        end_line_(end_line), num_hoisted_(num_hoisted), hoisted_(hoisted) {
+    }
+
+    bool hoist_loop_invariant_vis::is_invariant(const expression& e) const {
+      for (std::set<std::string>::const_iterator it = loop_vars_.begin();
+           it != loop_vars_.end(); ++it)
+        if (!is_loop_invariant(e, *it))
+          return false;
+      return true;
+    }
+
+    void hoist_loop_invariant_vis::hoist(expression& e) const {
+      bool worth_hoisting
+        = !boost::get<nil>(&e.expr_)
+        && !boost::get<int_literal>(&e.expr_)
+        && !boost::get<double_literal>(&e.expr_)
+        && !boost::get<variable>(&e.expr_)
+        && !boost::get<index_op>(&e.expr_);
+      if (const fun* f = boost::get<fun>(&e.expr_))
+        worth_hoisting = !f->args_.empty();
+      expr_type type = e.expression_type();
+      if (!type.base_type_.is_double_type()
+          && !type.base_type_.is_vector_type()
+          && !type.base_type_.is_row_vector_type()
+          && !type.base_type_.is_matrix_type())
+        worth_hoisting = false;  // sizes, comparisons and index arithmetic
+      if (!worth_hoisting || !is_invariant(e)) {
+        boost::apply_visitor(*this, e.expr_);
+        return;
+      }
+      std::stringstream name;
+      name << "loop_invariant_" << ++num_hoisted_ << "__";
+      variable v(name.str());
+      v.set_type(type.base_type_, type.num_dims_);
+      // declared empty, then resized by the assignment
+      expression size(int_literal(0));
+      std::vector<expression> dims(type.num_dims_, size);
+      expression def = expression(nil());
+      var_decl decl;
+      if (type.base_type_.is_double_type())
+        decl = double_var_decl(range(), v.name_, dims, def);
+      else if (type.base_type_.is_vector_type())
+        decl = vector_var_decl(range(), size, v.name_, dims, def);
+      else if (type.base_type_.is_row_vector_type())
+        decl = row_vector_var_decl(range(), size, v.name_, dims, def);
+      else
+        decl = matrix_var_decl(range(), size, size, v.name_, dims, def);
+      decl.begin_line_ = begin_line_;
+      decl.end_line_ = end_line_;
+      statement s(assgn(v, std::vector<idx>(), e));
+      s.begin_line_ = begin_line_;
+      s.end_line_ = end_line_;
+      for (size_t i = guards_.size(); i > 0; --i) {
+        s = statement(conditional_statement(
+            std::vector<expression>(1, guards_[i - 1]),
+            std::vector<statement>(1, s)));
+        s.begin_line_ = begin_line_;
+        s.end_line_ = end_line_;
+      }
+      hoisted_.first.push_back(decl);
+      hoisted_.second.push_back(s);
+      e = expression(v);
+    }
+
+    void hoist_loop_invariant_vis::operator()(nil& e) const { }
+
+    void hoist_loop_invariant_vis::operator()(int_literal& e) const { }
+
+    void hoist_loop_invariant_vis::operator()(double_literal& e) const { }
+
+    void hoist_loop_invariant_vis::operator()(array_expr& e) const {
+      for (size_t i = 0; i < e.args_.size(); ++i)
+        hoist(e.args_[i]);
+    }
+
+    void hoist_loop_invariant_vis::operator()(matrix_expr& e) const {
+      for (size_t i = 0; i < e.args_.size(); ++i)
+        hoist(e.args_[i]);
+    }
+
+    void hoist_loop_invariant_vis::operator()(row_vector_expr& e) const {
+      for (size_t i = 0; i < e.args_.size(); ++i)
+        hoist(e.args_[i]);
+    }
+
+    void hoist_loop_invariant_vis::operator()(variable& e) const { }
+
+    void hoist_loop_invariant_vis::operator()(fun& e) const {
+      // right operand of || and && is evaluated conditionally
+      size_t num_args = (e.name_ == "logical_or" || e.name_ == "logical_and")
+        ? 1 : e.args_.size();
+      for (size_t i = 0; i < num_args && i < e.args_.size(); ++i)
+        hoist(e.args_[i]);
+    }
+
+    void hoist_loop_invariant_vis::operator()(integrate_ode& e) const { }
+
+    void hoist_loop_invariant_vis::operator()(integrate_ode_control& e)
+      const { }
+
+    void hoist_loop_invariant_vis::operator()(algebra_solver& e) const { }
+
+    void hoist_loop_invariant_vis::operator()(algebra_solver_control& e)
+      const { }
+
+    void hoist_loop_invariant_vis::operator()(reduce_sum& e) const { }
+
+    void hoist_loop_invariant_vis::operator()(index_op& e) const {
+      hoist(e.expr_);
+      for (size_t i = 0; i < e.dimss_.size(); ++i)
+        for (size_t j = 0; j < e.dimss_[i].size(); ++j)
+          hoist(e.dimss_[i][j]);
+    }
+
+    void hoist_loop_invariant_vis::operator()(index_op_sliced& e) const {
+      hoist(e.expr_);
+      for (size_t i = 0; i < e.idxs_.size(); ++i)
+        boost::apply_visitor(*this, e.idxs_[i].idx_);
+    }
+
+    void hoist_loop_invariant_vis::operator()(conditional_op& e) const {
+      hoist(e.cond_);
+    }
+
+    void hoist_loop_invariant_vis::operator()(binary_op& e) const {
+      hoist(e.left);
+      hoist(e.right);
+    }
+
+    void hoist_loop_invariant_vis::operator()(unary_op& e) const {
+      hoist(e.subject);
+    }
+
+    void hoist_loop_invariant_vis::operator()(uni_idx& i) const {
+      hoist(i.idx_);
+    }
+
+    void hoist_loop_invariant_vis::operator()(multi_idx& i) const {
+      hoist(i.idxs_);
+    }
+
+    void hoist_loop_invariant_vis::operator()(omni_idx& i) const { }
+
+    void hoist_loop_invariant_vis::operator()(lb_idx& i) const {
+      hoist(i.lb_);
+    }
+
+    void hoist_loop_invariant_vis::operator()(ub_idx& i) const {
+      hoist(i.ub_);
+    }
+
+    void hoist_loop_invariant_vis::operator()(lub_idx& i) const {
+      hoist(i.lb_);
+      hoist(i.ub_);
+    }
+
+  }
+}
+#endif
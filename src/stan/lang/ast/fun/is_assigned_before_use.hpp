@@ -0,0 +1,34 @@
+#ifndef STAN_LANG_AST_FUN_IS_ASSIGNED_BEFORE_USE_HPP
+#define STAN_LANG_AST_FUN_IS_ASSIGNED_BEFORE_USE_HPP
+
+#include <cstddef>
+#include <vector>
+
+namespace stan {
+  namespace lang {
+
+    struct statement;
+    struct var_decl;
+
+    /**
+     * Return true if the variable declared at the specified position
+     * in a sequence of declarations is provably assigned in full
+     * before its value can be read.  The variable is assigned if its
+     * declaration has a definition, or if it is the target of an
+     * unindexed assignment reached before any later declaration or
+     * statement that could read it.  The analysis is conservative:
+     * any statement other than an unindexed assignment to another
+     * variable that does not read this one ends the search.
+     *
+     * @param decls declarations in the block
+     * @param n position of the variable's declaration
+     * @param stmts statements following the declarations
+     * @return true if the variable is assigned before use
+     */
+    bool is_assigned_before_use(const std::vector<var_decl>& decls,
+                                size_t n,
+                                const std::vector<statement>& stmts);
+
+  }
+}
+#endif
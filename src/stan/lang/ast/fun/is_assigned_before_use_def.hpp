@@ -0,0 +1,46 @@
+#ifndef STAN_LANG_AST_FUN_IS_ASSIGNED_BEFORE_USE_DEF_HPP
+#define STAN_LANG_AST_FUN_IS_ASSIGNED_BEFORE_USE_DEF_HPP
+
+#include <stan/lang/ast.hpp>
+#include <boost/variant/get.hpp>
+#include <string>
+#include <vector>
+
+namespace stan {
+  namespace lang {
+
+    bool is_assigned_before_use(const std::vector<var_decl>& decls,
+                                size_t n,
+                                const std::vector<statement>& stmts) {
+      if (decls[n].has_def())
+        return true;
+      std::string name = decls[n].name();
+      // definitions of later declarations are evaluated first
+      for (size_t i = n + 1; i < decls.size(); ++i)
+        if (decls[i].has_def() && !is_loop_invariant(decls[i].def(), name))
+          return false;
+      for (size_t i = 0; i < stmts.size(); ++i) {
+        std::string lhs_name;
+        if (const assignment* a
+            = boost::get<assignment>(&stmts[i].statement_)) {
+          if (!a->var_dims_.dims_.empty()
+              || !is_loop_invariant(a->expr_, name))
+            return false;
+          lhs_name = a->var_dims_.name_;
+        } else if (const assgn* a
+                   = boost::get<assgn>(&stmts[i].statement_)) {
+          if (!a->idxs_.empty() || !is_loop_invariant(a->rhs_, name))
+            return false;
+          lhs_name = a->lhs_var_.name_;
+        } else {
+          return false;
+        }
+        if (lhs_name == name)
+          return true;
+      }
+      return false;
+    }
+
+  }
+}
+#endif
@@ -0,0 +1,27 @@
+#ifndef STAN_LANG_AST_FUN_IS_DATA_ONLY_HPP
+#define STAN_LANG_AST_FUN_IS_DATA_ONLY_HPP
+
+#include <set>
+#include <string>
+
+namespace stan {
+  namespace lang {
+
+    struct expression;
+
+    /**
+     * Return true if the specified expression depends only on the
+     * variables with the specified names, which are the data and
+     * transformed data variables, and calls no user-defined or
+     * <code>_lp</code> functions.
+     *
+     * @param e expression to test
+     * @param data_vars names of data and transformed data variables
+     * @return true if expression is data only
+     */
+    bool is_data_only(const expression& e,
+                      const std::set<std::string>& data_vars);
+
+  }
+}
+#endif
@@ -0,0 +1,20 @@
+#ifndef STAN_LANG_AST_FUN_IS_DATA_ONLY_DEF_HPP
+#define STAN_LANG_AST_FUN_IS_DATA_ONLY_DEF_HPP
+
+#include <stan/lang/ast.hpp>
+#include <boost/variant/apply_visitor.hpp>
+#include <set>
+#include <string>
+
+namespace stan {
+  namespace lang {
+
+    bool is_data_only(const expression& e,
+                      const std::set<std::string>& data_vars) {
+      is_data_only_vis vis(data_vars);
+      return boost::apply_visitor(vis, e.expr_);
+    }
+
+  }
+}
+#endif
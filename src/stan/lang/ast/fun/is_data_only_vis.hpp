@@ -0,0 +1,256 @@
+#ifndef STAN_LANG_AST_FUN_IS_DATA_ONLY_VIS_HPP
+#define STAN_LANG_AST_FUN_IS_DATA_ONLY_VIS_HPP
+
+#include <boost/variant/static_visitor.hpp>
+#include <set>
+#include <string>
+
+namespace stan {
+  namespace lang {
+
+    struct nil;
+    struct int_literal;
+    struct double_literal;
+    struct array_expr;
+    struct matrix_expr;
+    struct row_vector_expr;
+    struct variable;
+    struct fun;
+    struct integrate_ode;
+    struct integrate_ode_control;
+    struct algebra_solver;
+    struct algebra_solver_control;
+    struct reduce_sum;
+    struct index_op;
+    struct index_op_sliced;
+    struct conditional_op;
+    struct binary_op;
+    struct unary_op;
+    struct uni_idx;
+    struct multi_idx;
+    struct omni_idx;
+    struct lb_idx;
+    struct ub_idx;
+    struct lub_idx;
+
+    /**
+     * Visitor to determine if an expression or index depends only on
+     * data and transformed data, so that it has the same value on
+     * every evaluation of the log density.  Calls to user-defined
+     * functions, <code>_lp</code> functions and the solvers are never
+     * data only.
+     */
+    struct is_data_only_vis : public boost::static_visitor<bool> {
+      /**
+       * Construct a visitor for the specified data variable names.
+       *
+       * @param data_vars names of data and transformed data variables
+       */
+      explicit is_data_only_vis(const std::set<std::string>& data_vars);
+
+      /**
+       * Return true if the specified expression is data only.
+       *
+       * @param e expression
+       * @return true
+       */
+      bool operator()(const nil& e) const;
+
+      /**
+       * Return true if the specified expression is data only.
+       *
+       * @param e expression
+       * @return true
+       */
+      bool operator()(const int_literal& e) const;
+
+      /**
+       * Return true if the specified expression is data only.
+       *
+       * @param e expression
+       * @return true
+       */
+      bool operator()(const double_literal& e) const;
+
+      /**
+       * Return true if the specified expression is data only.
+       *
+       * @param e expression
+       * @return true if all elements are data only
+       */
+      bool operator()(const array_expr& e) const;
+
+      /**
+       * Return true if the specified expression is data only.
+       *
+       * @param e expression
+       * @return true if all elements are data only
+       */
+      bool operator()(const matrix_expr& e) const;
+
+      /**
+       * Return true if the specified expression is data only.
+       *
+       * @param e expression
+       * @return true if all elements are data only
+       */
+      bool operator()(const row_vector_expr& e) const;
+
+      /**
+       * Return true if the specified expression is data only.
+       *
+       * @param e expression
+       * @return true if the variable is declared in the data or
+       * transformed data block
+       */
+      bool operator()(const variable& e) const;
+
+      /**
+       * Return true if the specified expression is data only.
+       *
+       * @param e expression
+       * @return true if the function is a built-in function without
+       * an <code>_lp</code> suffix and its arguments are data only
+       */
+      bool operator()(const fun& e) const;
+
+      /**
+       * Return true if the specified expression is data only.
+       *
+       * @param e expression
+       * @return false
+       */
+      bool operator()(const integrate_ode& e) const;
+
+      /**
+       * Return true if the specified expression is data only.
+       *
+       * @param e expression
+       * @return false
+       */
+      bool operator()(const integrate_ode_control& e) const;
+
+      /**
+       * Return true if the specified expression is data only.
+       *
+       * @param e expression
+       * @return false
+       */
+      bool operator()(const algebra_solver& e) const;
+
+      /**
+       * Return true if the specified expression is data only.
+       *
+       * @param e expression
+       * @return false
+       */
+      bool operator()(const algebra_solver_control& e) const;
+
+      /**
+       * Return true if the specified expression is data only.
+       *
+       * @param e expression
+       * @return false
+       */
+      bool operator()(const reduce_sum& e) const;
+
+      /**
+       * Return true if the specified expression is data only.
+       *
+       * @param e expression
+       * @return true if the indexed expression and indexes are data
+       * only
+       */
+      bool operator()(const index_op& e) const;
+
+      /**
+       * Return true if the specified expression is data only.
+       *
+       * @param e expression
+       * @return true if the indexed expression and indexes are data
+       * only
+       */
+      bool operator()(const index_op_sliced& e) const;
+
+      /**
+       * Return true if the specified expression is data only.
+       *
+       * @param e expression
+       * @return true if the condition and both results are data
+       * only
+       */
+      bool operator()(const conditional_op& e) const;
+
+      /**
+       * Return true if the specified expression is data only.
+       *
+       * @param e expression
+       * @return true if both operands are data only
+       */
+      bool operator()(const binary_op& e) const;
+
+      /**
+       * Return true if the specified expression is data only.
+       *
+       * @param e expression
+       * @return true if the operand is data only
+       */
+      bool operator()(const unary_op& e) const;
+
+      /**
+       * Return true if the specified index is data only.
+       *
+       * @param i index
+       * @return true if the index is data only
+       */
+      bool operator()(const uni_idx& i) const;
+
+      /**
+       * Return true if the specified index is data only.
+       *
+       * @param i index
+       * @return true if the index is data only
+       */
+      bool operator()(const multi_idx& i) const;
+
+      /**
+       * Return true if the specified index is data only.
+       *
+       * @param i index
+       * @return true
+       */
+      bool operator()(const omni_idx& i) const;
+
+      /**
+       * Return true if the specified index is data only.
+       *
+       * @param i index
+       * @return true if the bound is data only
+       */
+      bool operator()(const lb_idx& i) const;
+
+      /**
+       * Return true if the specified index is data only.
+       *
+       * @param i index
+       * @return true if the bound is data only
+       */
+      bool operator()(const ub_idx& i) const;
+
+      /**
+       * Return true if the specified index is data only.
+       *
+       * @param i index
+       * @return true if both bounds are data only
+       */
+      bool operator()(const lub_idx& i) const;
+
+      /**
+       * Names of the data and transformed data variables.
+       */
+      const std::set<std::string>& data_vars_;
+    };
+
+  }
+}
+#endif
@@ -0,0 +1,26 @@
+#ifndef STAN_LANG_AST_FUN_IS_LOOP_INVARIANT_HPP
+#define STAN_LANG_AST_FUN_IS_LOOP_INVARIANT_HPP
+
+#include <string>
+
+namespace stan {
+  namespace lang {
+
+    struct expression;
+
+    /**
+     * Return true if the specified expression evaluates to the same
+     * value with the same effect on every iteration of a loop over
+     * the specified variable.
+     *
+     * @param e expression to test
+     * @param loop_var name of loop variable
+     * @return true if the loop variable does not occur in the
+     * expression and the expression calls no <code>_lp</code> or
+     * user-defined function and does not read the log density
+     */
+    bool is_loop_invariant(const expression& e, const std::string& loop_var);
+
+  }
+}
+#endif
@@ -0,0 +1,18 @@
+#ifndef STAN_LANG_AST_FUN_IS_LOOP_INVARIANT_DEF_HPP
+#define STAN_LANG_AST_FUN_IS_LOOP_INVARIANT_DEF_HPP
+
+#include <stan/lang/ast.hpp>
+#include <boost/variant/apply_visitor.hpp>
+#include <string>
+
+namespace stan {
+  namespace lang {
+
+    bool is_loop_invariant(const expression& e, const std::string& loop_var) {
+      is_loop_invariant_vis vis(loop_var);
+      return boost::apply_visitor(vis, e.expr_);
+    }
+
+  }
+}
+#endif
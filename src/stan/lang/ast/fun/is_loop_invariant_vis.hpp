@@ -0,0 +1,256 @@
+#ifndef STAN_LANG_AST_FUN_IS_LOOP_INVARIANT_VIS_HPP
+#define STAN_LANG_AST_FUN_IS_LOOP_INVARIANT_VIS_HPP
+
+#include <boost/variant/static_visitor.hpp>
+#include <string>
+
+namespace stan {
+  namespace lang {
+
+    struct nil;
+    struct int_literal;
+    struct double_literal;
+    struct array_expr;
+    struct matrix_expr;
+    struct row_vector_expr;
+    struct variable;
+    struct fun;
+    struct integrate_ode;
+    struct integrate_ode_control;
+    struct algebra_solver;
+    struct algebra_solver_control;
+    struct reduce_sum;
+    struct index_op;
+    struct index_op_sliced;
+    struct conditional_op;
+    struct binary_op;
+    struct unary_op;
+    struct uni_idx;
+    struct multi_idx;
+    struct omni_idx;
+    struct lb_idx;
+    struct ub_idx;
+    struct lub_idx;
+
+    /**
+     * Visitor to determine if an expression or index has the same
+     * value and effect for every iteration of a loop.  An expression
+     * is invariant if the loop variable does not occur anywhere in
+     * it, indexes included, and it calls no function with an
+     * <code>_lp</code> suffix, no user-defined function (directly or
+     * through a solver) and does not read the log density.
+     */
+    struct is_loop_invariant_vis : public boost::static_visitor<bool> {
+      /**
+       * Construct a visitor for the specified loop variable.
+       *
+       * @param loop_var name of the loop variable
+       */
+      explicit is_loop_invariant_vis(const std::string& loop_var);
+
+      /**
+       * Return true because nil does not vary.
+       *
+       * @param e expression
+       * @return true
+       */
+      bool operator()(const nil& e) const;
+
+      /**
+       * Return true because literals do not vary.
+       *
+       * @param e expression
+       * @return true
+       */
+      bool operator()(const int_literal& e) const;
+
+      /**
+       * Return true because literals do not vary.
+       *
+       * @param e expression
+       * @return true
+       */
+      bool operator()(const double_literal& e) const;
+
+      /**
+       * Return true if all of the array elements are invariant.
+       *
+       * @param e expression
+       * @return true if all elements are invariant
+       */
+      bool operator()(const array_expr& e) const;
+
+      /**
+       * Return true if all of the matrix elements are invariant.
+       *
+       * @param e expression
+       * @return true if all elements are invariant
+       */
+      bool operator()(const matrix_expr& e) const;
+
+      /**
+       * Return true if all of the row vector elements are invariant.
+       *
+       * @param e expression
+       * @return true if all elements are invariant
+       */
+      bool operator()(const row_vector_expr& e) const;
+
+      /**
+       * Return true if the variable is not the loop variable.
+       *
+       * @param e expression
+       * @return true if variable is not the loop variable
+       */
+      bool operator()(const variable& e) const;
+
+      /**
+       * Return true if the function is not user defined, does not
+       * have an <code>_lp</code> suffix, does not read the log
+       * density and its arguments are invariant.
+       *
+       * @param e expression
+       * @return true if function call is invariant
+       */
+      bool operator()(const fun& e) const;
+
+      /**
+       * Return false because the system function is user defined.
+       *
+       * @param e expression
+       * @return false
+       */
+      bool operator()(const integrate_ode& e) const;
+
+      /**
+       * Return false because the system function is user defined.
+       *
+       * @param e expression
+       * @return false
+       */
+      bool operator()(const integrate_ode_control& e) const;
+
+      /**
+       * Return false because the system function is user defined.
+       *
+       * @param e expression
+       * @return false
+       */
+      bool operator()(const algebra_solver& e) const;
+
+      /**
+       * Return false because the system function is user defined.
+       *
+       * @param e expression
+       * @return false
+       */
+      bool operator()(const algebra_solver_control& e) const;
+
+      /**
+       * Return false because the partial sum function is user
+       * defined.
+       *
+       * @param e expression
+       * @return false
+       */
+      bool operator()(const reduce_sum& e) const;
+
+      /**
+       * Return true if the indexed expression and all indexes are
+       * invariant.
+       *
+       * @param e expression
+       * @return true if expression and indexes are invariant
+       */
+      bool operator()(const index_op& e) const;
+
+      /**
+       * Return true if the indexed expression and all indexes are
+       * invariant.
+       *
+       * @param e expression
+       * @return true if expression and indexes are invariant
+       */
+      bool operator()(const index_op_sliced& e) const;
+
+      /**
+       * Return true if the condition and both results are invariant.
+       *
+       * @param e expression
+       * @return true if all subexpressions are invariant
+       */
+      bool operator()(const conditional_op& e) const;
+
+      /**
+       * Return true if both operands are invariant.
+       *
+       * @param e expression
+       * @return true if operands are invariant
+       */
+      bool operator()(const binary_op& e) const;
+
+      /**
+       * Return true if the operand is invariant.
+       *
+       * @param e expression
+       * @return true if operand is invariant
+       */
+      bool operator()(const unary_op& e) const;
+
+      /**
+       * Return true if the index is invariant.
+       *
+       * @param i index
+       * @return true if index is invariant
+       */
+      bool operator()(const uni_idx& i) const;
+
+      /**
+       * Return true if the index is invariant.
+       *
+       * @param i index
+       * @return true if index is invariant
+       */
+      bool operator()(const multi_idx& i) const;
+
+      /**
+       * Return true because the omni-index does not vary.
+       *
+       * @param i index
+       * @return true
+       */
+      bool operator()(const omni_idx& i) const;
+
+      /**
+       * Return true if the lower bound is invariant.
+       *
+       * @param i index
+       * @return true if bound is invariant
+       */
+      bool operator()(const lb_idx& i) const;
+
+      /**
+       * Return true if the upper bound is invariant.
+       *
+       * @param i index
+       * @return true if bound is invariant
+       */
+      bool operator()(const ub_idx& i) const;
+
+      /**
+       * Return true if both bounds are invariant.
+       *
+       * @param i index
+       * @return true if bounds are invariant
+       */
+      bool operator()(const lub_idx& i) const;
+
+      /**
+       * Name of the loop variable.
+       */
+      const std::string loop_var_;
+    };
+
+  }
+}
+#endif
@@ -0,0 +1,148 @@
+#ifndef STAN_LANG_AST_FUN_IS_LOOP_INVARIANT_VIS_DEF_HPP
+#define STAN_LANG_AST_FUN_IS_LOOP_INVARIANT_VIS_DEF_HPP
+
+#include <stan/lang/ast.hpp>
+#include <boost/variant/apply_visitor.hpp>
+#include <string>
+
+namespace stan {
+  namespace lang {
+
+    is_loop_invariant_vis::is_loop_invariant_vis(const std::string& loop_var)
+      : loop_var_(loop_var) {
+    }
+
+    bool is_loop_invariant_vis::operator()(const nil& e) const {
+      return true;
+    }
+
+    bool is_loop_invariant_vis::operator()(const int_literal& e) const {
+      return true;
+    }
+
+    bool is_loop_invariant_vis::operator()(const double_literal& e) const {
+      return true;
+    }
+
+    bool is_loop_invariant_vis::operator()(const array_expr& e) const {
+      for (size_t i = 0; i < e.args_.size(); ++i)
+        if (!boost::apply_visitor(*this, e.args_[i].expr_))
+          return false;
+      return true;
+    }
+
+    bool is_loop_invariant_vis::operator()(const matrix_expr& e) const {
+      for (size_t i = 0; i < e.args_.size(); ++i)
+        if (!boost::apply_visitor(*this, e.args_[i].expr_))
+          return false;
+      return true;
+    }
+
+    bool is_loop_invariant_vis::operator()(const row_vector_expr& e) const {
+      for (size_t i = 0; i < e.args_.size(); ++i)
+        if (!boost::apply_visitor(*this, e.args_[i].expr_))
+          return false;
+      return true;
+    }
+
+    bool is_loop_invariant_vis::operator()(const variable& e) const {
+      return e.name_ != loop_var_;
+    }
+
+    bool is_loop_invariant_vis::operator()(const fun& e) const {
+      if (has_lp_suffix(e.name_))
+        return false;  // increments the log density on every call
+      if (e.name_ == "get_lp")
+        return false;  // reads the log density the loop may increment
+      if (is_user_defined(e))
+        return false;  // may print or reject on every call
+      for (size_t i = 0; i < e.args_.size(); ++i)
+        if (!boost::apply_visitor(*this, e.args_[i].expr_))
+          return false;
+      return true;
+    }
+
+    bool is_loop_invariant_vis::operator()(const integrate_ode& e) const {
+      return false;  // system function is user defined
+    }
+
+    bool is_loop_invariant_vis::operator()(const integrate_ode_control& e)
+      const {
+      return false;  // system function is user defined
+    }
+
+    bool is_loop_invariant_vis::operator()(const algebra_solver& e) const {
+      return false;  // system function is user defined
+    }
+
+    bool is_loop_invariant_vis::operator()(const algebra_solver_control& e)
+      const {
+      return false;  // system function is user defined
+    }
+
+    bool is_loop_invariant_vis::operator()(const reduce_sum& e) const {
+      return false;  // partial sum function is user defined
+    }
+
+    bool is_loop_invariant_vis::operator()(const index_op& e) const {
+      if (!boost::apply_visitor(*this, e.expr_.expr_))
+        return false;
+      for (size_t i = 0; i < e.dimss_.size(); ++i)
+        for (size_t j = 0; j < e.dimss_[i].size(); ++j)
+          if (!boost::apply_visitor(*this, e.dimss_[i][j].expr_))
+            return false;
+      return true;
+    }
+
+    bool is_loop_invariant_vis::operator()(const index_op_sliced& e) const {
+      if (!boost::apply_visitor(*this, e.expr_.expr_))
+        return false;
+      for (size_t i = 0; i < e.idxs_.size(); ++i)
+        if (!boost::apply_visitor(*this, e.idxs_[i].idx_))
+          return false;
+      return true;
+    }
+
+    bool is_loop_invariant_vis::operator()(const conditional_op& e) const {
+      return boost::apply_visitor(*this, e.cond_.expr_)
+        && boost::apply_visitor(*this, e.true_val_.expr_)
+        && boost::apply_visitor(*this, e.false_val_.expr_);
+    }
+
+    bool is_loop_invariant_vis::operator()(const binary_op& e) const {
+      return boost::apply_visitor(*this, e.left.expr_)
+        && boost::apply_visitor(*this, e.right.expr_);
+    }
+
+    bool is_loop_invariant_vis::operator()(const unary_op& e) const {
+      return boost::apply_visitor(*this, e.subject.expr_);
+    }
+
+    bool is_loop_invariant_vis::operator()(const uni_idx& i) const {
+      return boost::apply_visitor(*this, i.idx_.expr_);
+    }
+
+    bool is_loop_invariant_vis::operator()(const multi_idx& i) const {
+      return boost::apply_visitor(*this, i.idxs_.expr_);
+    }
+
+    bool is_loop_invariant_vis::operator()(const omni_idx& i) const {
+      return true;
+    }
+
+    bool is_loop_invariant_vis::operator()(const lb_idx& i) const {
+      return boost::apply_visitor(*this, i.lb_.expr_);
+    }
+
+    bool is_loop_invariant_vis::operator()(const ub_idx& i) const {
+      return boost::apply_visitor(*this, i.ub_.expr_);
+    }
+
+    bool is_loop_invariant_vis::operator()(const lub_idx& i) const {
+      return boost::apply_visitor(*this, i.lb_.expr_)
+        && boost::apply_visitor(*this, i.ub_.expr_);
+    }
+
+  }
+}
+#endif
@@ -18,6 +18,7 @@ namespace stan {
     struct integrate_ode_control;
     struct algebra_solver;
     struct algebra_solver_control;
+    struct reduce_sum;
     struct index_op;
     struct index_op_sliced;
     struct conditional_op;
@@ -40,6 +41,7 @@ namespace stan {
       bool operator()(const integrate_ode_control& x) const;  // NOLINT
       bool operator()(const algebra_solver& x) const;  // NOLINT
       bool operator()(const algebra_solver_control& x) const;  // NOLINT
+      bool operator()(const reduce_sum& x) const;  // NOLINT
       bool operator()(const fun& x) const;  // NOLINT(runtime/explicit)
       bool operator()(const index_op& x) const;  // NOLINT(runtime/explicit)
       bool operator()(const index_op_sliced& x) const;  // NOLINT
@@ -0,0 +1,48 @@
+#ifndef STAN_LANG_AST_FUN_REWRITE_SUFFICIENT_STATS_HPP
+#define STAN_LANG_AST_FUN_REWRITE_SUFFICIENT_STATS_HPP
+
+#include <set>
+#include <string>
+#include <utility>
+#include <vector>
+
+namespace stan {
+  namespace lang {
+
+    struct expression;
+    struct program;
+    struct statement;
+    struct variable;
+
+    /**
+     * Replace the sampling statements of the model block of the
+     * specified program that <code>sufficient_stats_sample</code>
+     * can rewrite with sampling statements from the density of
+     * sufficient statistics computed by the constructor, recording
+     * the statistics in the program's hoisted declarations.
+     *
+     * @param[in,out] prog program to rewrite
+     */
+    void rewrite_sufficient_stats(program& prog);
+
+    /**
+     * Rewrite the sampling statements of the specified statement that
+     * are executed once per log density evaluation, descending into
+     * blocks and into the branches of conditionals whose conditions
+     * are data only, but not into loops.
+     *
+     * @param[in,out] s statement to rewrite
+     * @param[in] data_vars names of data and transformed data variables
+     * @param[in] guards data-only conditions under which the
+     * statement is executed
+     * @param[in,out] hoisted member variables and the constructor
+     * statements computing them
+     */
+    void rewrite_sufficient_stats(statement& s,
+        const std::set<std::string>& data_vars,
+        const std::vector<expression>& guards,
+        std::pair<std::vector<variable>, std::vector<statement> >& hoisted);
+
+  }
+}
+#endif
@@ -0,0 +1,62 @@
+#ifndef STAN_LANG_AST_FUN_REWRITE_SUFFICIENT_STATS_DEF_HPP
+#define STAN_LANG_AST_FUN_REWRITE_SUFFICIENT_STATS_DEF_HPP
+
+#include <stan/lang/ast.hpp>
+#include <boost/variant/get.hpp>
+#include <set>
+#include <string>
+#include <utility>
+#include <vector>
+
+namespace stan {
+  namespace lang {
+
+    void rewrite_sufficient_stats(program& prog) {
+      std::set<std::string> data_vars;
+      for (size_t i = 0; i < prog.data_decl_.size(); ++i)
+        data_vars.insert(prog.data_decl_[i].name());
+      for (size_t i = 0; i < prog.derived_data_decl_.first.size(); ++i)
+        data_vars.insert(prog.derived_data_decl_.first[i].name());
+      rewrite_sufficient_stats(prog.statement_, data_vars,
+                               std::vector<expression>(),
+                               prog.hoisted_decl_);
+    }
+
+    void rewrite_sufficient_stats(statement& s,
+        const std::set<std::string>& data_vars,
+        const std::vector<expression>& guards,
+        std::pair<std::vector<variable>, std::vector<statement> >& hoisted) {
+      statement rewritten;
+      if (sufficient_stats_sample(s, data_vars, guards, hoisted, rewritten)) {
+        s = rewritten;
+      } else if (statements* x = boost::get<statements>(&s.statement_)) {
+        for (size_t i = 0; i < x->statements_.size(); ++i)
+          rewrite_sufficient_stats(x->statements_[i], data_vars, guards,
+                                   hoisted);
+      } else if (conditional_statement* x
+                 = boost::get<conditional_statement>(&s.statement_)) {
+        std::vector<expression> branch_guards(guards);
+        for (size_t i = 0; i < x->bodies_.size(); ++i) {
+          if (i < x->conditions_.size()) {
+            const expression& cond = x->conditions_[i];
+            if (!is_data_only(cond, data_vars))
+              return;
+            std::vector<expression> body_guards(branch_guards);
+            body_guards.push_back(cond);
+            rewrite_sufficient_stats(x->bodies_[i], data_vars, body_guards,
+                                     hoisted);
+            fun negation("logical_negation",
+                         std::vector<expression>(1, cond));
+            negation.type_ = expr_type(int_type());
+            branch_guards.push_back(negation);
+          } else {
+            rewrite_sufficient_stats(x->bodies_[i], data_vars,
+                                     branch_guards, hoisted);
+          }
+        }
+      }
+    }
+
+  }
+}
+#endif
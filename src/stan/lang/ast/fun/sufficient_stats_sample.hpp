@@ -0,0 +1,55 @@
+#ifndef STAN_LANG_AST_FUN_SUFFICIENT_STATS_SAMPLE_HPP
+#define STAN_LANG_AST_FUN_SUFFICIENT_STATS_SAMPLE_HPP
+
+#include <set>
+#include <string>
+#include <utility>
+#include <vector>
+
+namespace stan {
+  namespace lang {
+
+    struct expression;
+    struct statement;
+    struct variable;
+
+    /**
+     * Rewrite a sampling statement whose log density depends on its
+     * data-only variate only through sufficient statistics into a
+     * sampling statement from the density of those statistics,
+     * returning true if the rewrite applies.  For example,
+     *
+     * <code>y ~ normal(mu, sigma);</code>
+     *
+     * <p>becomes a call to <code>stan::model::normal_sufficient_log</code>
+     * with the size, mean and sum of squared deviations of
+     * <code>y</code>, which are appended to the specified hoisted
+     * declarations so that the constructor computes them once.
+     * Poisson and Bernoulli sampling statements are rewritten in the
+     * same way.  The statistic computations are wrapped in
+     * conditionals on the specified guards.
+     *
+     * <p>The rewrite applies only if the statement is not truncated,
+     * the variate is a data-only array or vector and each argument
+     * is a scalar.  The density of the statistics drops the same
+     * terms under <code>propto__</code> as the original density.
+     *
+     * @param[in] st statement to rewrite
+     * @param[in] data_vars names of data and transformed data variables
+     * @param[in] guards data-only conditions under which the
+     * statement is executed
+     * @param[in,out] hoisted member variables and the constructor
+     * statements computing them
+     * @param[out] result rewritten statement, set only if the rewrite
+     * applies
+     * @return true if the statement was rewritten
+     */
+    bool sufficient_stats_sample(const statement& st,
+        const std::set<std::string>& data_vars,
+        const std::vector<expression>& guards,
+        std::pair<std::vector<variable>, std::vector<statement> >& hoisted,
+        statement& result);
+
+  }
+}
+#endif
@@ -0,0 +1,108 @@
+#ifndef STAN_LANG_AST_FUN_SUFFICIENT_STATS_SAMPLE_DEF_HPP
+#define STAN_LANG_AST_FUN_SUFFICIENT_STATS_SAMPLE_DEF_HPP
+
+#include <stan/lang/ast.hpp>
+#include <boost/variant/get.hpp>
+#include <set>
+#include <sstream>
+#include <string>
+#include <utility>
+#include <vector>
+
+namespace stan {
+  namespace lang {
+
+    bool sufficient_stats_sample(const statement& st,
+        const std::set<std::string>& data_vars,
+        const std::vector<expression>& guards,
+        std::pair<std::vector<variable>, std::vector<statement> >& hoisted,
+        statement& result) {
+      const sample* x = boost::get<sample>(&st.statement_);
+      if (!x)
+        return false;
+      const sample& s = *x;
+      if (s.truncation_.has_low() || s.truncation_.has_high())
+        return false;
+      expr_type y_type = s.expr_.expression_type();
+      bool is_int_array = y_type.base_type_.is_int_type()
+        && y_type.num_dims_ == 1U;
+      bool is_real_array = (y_type.base_type_.is_double_type()
+                            && y_type.num_dims_ == 1U)
+        || ((y_type.base_type_.is_vector_type()
+             || y_type.base_type_.is_row_vector_type())
+            && y_type.num_dims_ == 0U);
+
+      // functions computing the statistics, in argument order
+      std::vector<std::string> stats;
+      std::vector<base_expr_type> stat_types;
+      stats.push_back("num_elements");
+      stat_types.push_back(int_type());
+      if (s.dist_.family_ == "normal" && (is_int_array || is_real_array)) {
+        stats.push_back("stan::model::sufficient_mean");
+        stat_types.push_back(double_type());
+        stats.push_back("stan::model::sufficient_sq_dev");
+        stat_types.push_back(double_type());
+      } else if (s.dist_.family_ == "poisson" && is_int_array) {
+        stats.push_back("stan::model::sufficient_sum");
+        stat_types.push_back(double_type());
+        stats.push_back("stan::model::sufficient_log_factorial");
+        stat_types.push_back(double_type());
+        stats.push_back("stan::model::sufficient_min");
+        stat_types.push_back(int_type());
+      } else if (s.dist_.family_ == "bernoulli" && is_int_array) {
+        stats.push_back("sum");
+        stat_types.push_back(int_type());
+        stats.push_back("stan::model::sufficient_min");
+        stat_types.push_back(int_type());
+        stats.push_back("stan::model::sufficient_max");
+        stat_types.push_back(int_type());
+      } else {
+        return false;
+      }
+      for (size_t i = 0; i < s.dist_.args_.size(); ++i)
+        if (!s.dist_.args_[i].expression_type().is_primitive())
+          return false;
+      if (!is_data_only(s.expr_, data_vars))
+        return false;
+
+      std::vector<expression> stat_vars;
+      for (size_t i = 0; i < stats.size(); ++i) {
+        std::stringstream name;
+        name << "hoisted_" << (hoisted.first.size() + 1) << "__";
+        variable v(name.str());
+        v.set_type(stat_types[i], 0);
+        fun stat(stats[i], std::vector<expression>(1, s.expr_));
+        stat.type_ = expr_type(stat_types[i]);
+        statement assign_stat(assgn(v, std::vector<idx>(), expression(stat)));
+        assign_stat.begin_line_ = st.begin_line_;
+        assign_stat.end_line_ = st.end_line_;
+        for (size_t j = guards.size(); j > 0; --j) {
+          assign_stat = statement(conditional_statement(
+              std::vector<expression>(1, guards[j - 1]),
+              std::vector<statement>(1, assign_stat)));
+          assign_stat.begin_line_ = st.begin_line_;
+          assign_stat.end_line_ = st.end_line_;
+        }
+        hoisted.first.push_back(v);
+        hoisted.second.push_back(assign_stat);
+        stat_vars.push_back(expression(v));
+      }
+
+      sample rewritten;
+      rewritten.expr_ = stat_vars[0];
+      rewritten.dist_.family_
+        = "stan::model::" + s.dist_.family_ + "_sufficient_log";
+      rewritten.dist_.args_.assign(stat_vars.begin() + 1, stat_vars.end());
+      rewritten.dist_.args_.insert(rewritten.dist_.args_.end(),
+                                   s.dist_.args_.begin(),
+                                   s.dist_.args_.end());
+      rewritten.is_discrete_ = s.is_discrete_;
+      result = statement(rewritten);
+      result.begin_line_ = st.begin_line_;
+      result.end_line_ = st.end_line_;
+      return true;
+    }
+
+  }
+}
+#endif
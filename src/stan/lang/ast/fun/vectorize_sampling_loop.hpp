@@ -0,0 +1,39 @@
+#ifndef STAN_LANG_AST_FUN_VECTORIZE_SAMPLING_LOOP_HPP
+#define STAN_LANG_AST_FUN_VECTORIZE_SAMPLING_LOOP_HPP
+
+namespace stan {
+  namespace lang {
+
+    struct for_statement;
+    struct statement;
+
+    /**
+     * Rewrite a for loop whose body is a single sampling statement
+     * into one sampling statement over slices, returning true if the
+     * rewrite applies.  For example,
+     *
+     * <code>for (n in 1:N) y[n] ~ normal(mu[n], sigma);</code>
+     *
+     * <p>becomes <code>if (1 <= N) y[1:N] ~ normal(mu[1:N],
+     * sigma);</code>, with the test dropped if both bounds are
+     * literals.
+     *
+     * <p>The rewrite applies only if the distribution is a built-in
+     * univariate distribution whose vectorized form is the sum of
+     * its elementwise log densities, the statement is not truncated,
+     * the loop bounds are loop invariant, and the variate and each
+     * argument are either loop invariant or a one-dimensional
+     * variable indexed by the loop variable alone, with at least one
+     * of the latter.  The sliced call must also match a signature.
+     *
+     * @param[in] loop for loop to rewrite
+     * @param[out] result vectorized statement, set only if the
+     * rewrite applies
+     * @return true if the loop was rewritten
+     */
+    bool vectorize_sampling_loop(const for_statement& loop,
+                                 statement& result);
+
+  }
+}
+#endif
@@ -0,0 +1,111 @@
+#ifndef STAN_LANG_AST_FUN_VECTORIZE_SAMPLING_LOOP_DEF_HPP
+#define STAN_LANG_AST_FUN_VECTORIZE_SAMPLING_LOOP_DEF_HPP
+
+#include <stan/lang/ast.hpp>
+#include <boost/variant/get.hpp>
+#include <set>
+#include <sstream>
+#include <string>
+#include <vector>
+
+namespace stan {
+  namespace lang {
+
+    bool vectorize_sampling_loop(const for_statement& loop,
+                                 statement& result) {
+      static const char* families[] = {
+        "bernoulli", "bernoulli_logit", "beta", "beta_binomial",
+        "binomial", "binomial_logit", "cauchy", "chi_square",
+        "double_exponential", "exp_mod_normal", "exponential", "frechet",
+        "gamma", "gumbel", "inv_chi_square", "inv_gamma", "logistic",
+        "lognormal", "neg_binomial", "neg_binomial_2",
+        "neg_binomial_2_log", "normal", "pareto", "pareto_type_2",
+        "poisson", "poisson_log", "rayleigh", "scaled_inv_chi_square",
+        "skew_normal", "student_t", "uniform", "von_mises", "weibull"
+      };
+      static const std::set<std::string> vectorized_families(
+          families, families + sizeof(families) / sizeof(families[0]));
+
+      // body may be wrapped in braces without local declarations
+      const statement* body = &loop.statement_;
+      while (const statements* block
+             = boost::get<statements>(&body->statement_)) {
+        if (block->local_decl_.size() != 0 || block->statements_.size() != 1)
+          return false;
+        body = &block->statements_[0];
+      }
+      const sample* s = boost::get<sample>(&body->statement_);
+      if (!s || s->truncation_.has_low() || s->truncation_.has_high()
+          || vectorized_families.find(s->dist_.family_)
+             == vectorized_families.end())
+        return false;
+
+      const std::string& n = loop.variable_;
+      const expression& low = loop.range_.low_;
+      const expression& high = loop.range_.high_;
+      if (!is_loop_invariant(low, n) || !is_loop_invariant(high, n))
+        return false;
+
+      std::vector<expression> args;
+      args.push_back(s->expr_);
+      args.insert(args.end(), s->dist_.args_.begin(), s->dist_.args_.end());
+      std::vector<idx> slice(1, idx(lub_idx(low, high)));
+      bool has_slice = false;
+      for (size_t i = 0; i < args.size(); ++i) {
+        if (is_loop_invariant(args[i], n))
+          continue;
+        const index_op* x = boost::get<index_op>(&args[i].expr_);
+        if (!x || x->dimss_.size() != 1 || x->dimss_[0].size() != 1
+            || !x->type_.is_primitive())
+          return false;
+        const variable* v = boost::get<variable>(&x->expr_.expr_);
+        const variable* i_n = boost::get<variable>(&x->dimss_[0][0].expr_);
+        if (!v || !i_n || i_n->name_ != n)
+          return false;
+        index_op_sliced sliced(x->expr_, slice);
+        if (sliced.type_.is_ill_formed())
+          return false;
+        args[i] = expression(sliced);
+        has_slice = true;
+      }
+      if (!has_slice)
+        return false;
+
+      std::vector<expr_type> arg_types;
+      for (size_t i = 0; i < args.size(); ++i)
+        arg_types.push_back(args[i].expression_type());
+      std::stringstream error_msgs;
+      expr_type result_type = function_signatures::instance()
+        .get_result_type(get_prob_fun(s->dist_.family_), arg_types,
+                         error_msgs);
+      if (!result_type.is_primitive_double())
+        return false;
+
+      sample vectorized;
+      vectorized.expr_ = args[0];
+      vectorized.dist_.family_ = s->dist_.family_;
+      vectorized.dist_.args_.assign(args.begin() + 1, args.end());
+      vectorized.is_discrete_ = s->is_discrete_;
+      result = statement(vectorized);
+      result.begin_line_ = body->begin_line_;
+      result.end_line_ = body->end_line_;
+
+      // an empty range must add nothing, so guard unless known nonempty
+      const int_literal* low_lit = boost::get<int_literal>(&low.expr_);
+      const int_literal* high_lit = boost::get<int_literal>(&high.expr_);
+      if (low_lit && high_lit && low_lit->val_ <= high_lit->val_)
+        return true;
+      std::vector<expression> lte_args;
+      lte_args.push_back(low);
+      lte_args.push_back(high);
+      fun lte("logical_lte", lte_args);
+      lte.type_ = expr_type(int_type());
+      result = statement(conditional_statement(
+          std::vector<expression>(1, expression(lte)),
+          std::vector<statement>(1, result)));
+      return true;
+    }
+
+  }
+}
+#endif
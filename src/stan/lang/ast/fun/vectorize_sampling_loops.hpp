@@ -0,0 +1,21 @@
+#ifndef STAN_LANG_AST_FUN_VECTORIZE_SAMPLING_LOOPS_HPP
+#define STAN_LANG_AST_FUN_VECTORIZE_SAMPLING_LOOPS_HPP
+
+namespace stan {
+  namespace lang {
+
+    struct statement;
+
+    /**
+     * Replace every for loop within the specified statement, itself
+     * included, that <code>vectorize_sampling_loop</code> can rewrite
+     * with its vectorized sampling statement.  Loops are rewritten
+     * innermost first.
+     *
+     * @param[in,out] s statement to rewrite
+     */
+    void vectorize_sampling_loops(statement& s);
+
+  }
+}
+#endif
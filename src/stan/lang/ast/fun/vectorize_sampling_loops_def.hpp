@@ -0,0 +1,25 @@
+#ifndef STAN_LANG_AST_FUN_VECTORIZE_SAMPLING_LOOPS_DEF_HPP
+#define STAN_LANG_AST_FUN_VECTORIZE_SAMPLING_LOOPS_DEF_HPP
+
+#include <stan/lang/ast.hpp>
+#include <boost/variant/apply_visitor.hpp>
+#include <boost/variant/get.hpp>
+
+namespace stan {
+  namespace lang {
+
+    void vectorize_sampling_loops(statement& s) {
+      vectorize_sampling_loops_vis vis;
+      boost::apply_visitor(vis, s.statement_);
+      const for_statement* loop = boost::get<for_statement>(&s.statement_);
+      statement vectorized;
+      if (!loop || !vectorize_sampling_loop(*loop, vectorized))
+        return;
+      vectorized.begin_line_ = s.begin_line_;
+      vectorized.end_line_ = s.end_line_;
+      s = vectorized;
+    }
+
+  }
+}
+#endif
@@ -0,0 +1,180 @@
+#ifndef STAN_LANG_AST_FUN_VECTORIZE_SAMPLING_LOOPS_VIS_HPP
+#define STAN_LANG_AST_FUN_VECTORIZE_SAMPLING_LOOPS_VIS_HPP
+
+#include <boost/variant/static_visitor.hpp>
+
+namespace stan {
+  namespace lang {
+
+    struct nil;
+    struct assignment;
+    struct assgn;
+    struct compound_assignment;
+    struct sample;
+    struct increment_log_prob_statement;
+    struct expression;
+    struct statements;
+    struct for_statement;
+    struct for_array_statement;
+    struct for_matrix_statement;
+    struct conditional_statement;
+    struct while_statement;
+    struct break_continue_statement;
+    struct print_statement;
+    struct reject_statement;
+    struct no_op_statement;
+    struct return_statement;
+
+    /**
+     * Visitor to vectorize the sampling loops nested within a
+     * statement, modifying the statement in place.
+     */
+    struct vectorize_sampling_loops_vis : public boost::static_visitor<> {
+      /**
+       * Leave the specified statement unchanged, as it contains no
+       * nested statements.
+       *
+       * @param st statement
+       */
+      void operator()(nil& st) const;
+
+      /**
+       * Leave the specified statement unchanged, as it contains no
+       * nested statements.
+       *
+       * @param st statement
+       */
+      void operator()(assignment& st) const;
+
+      /**
+       * Leave the specified statement unchanged, as it contains no
+       * nested statements.
+       *
+       * @param st statement
+       */
+      void operator()(assgn& st) const;
+
+      /**
+       * Leave the specified statement unchanged, as it contains no
+       * nested statements.
+       *
+       * @param st statement
+       */
+      void operator()(compound_assignment& st) const;
+
+      /**
+       * Leave the specified statement unchanged, as it contains no
+       * nested statements.
+       *
+       * @param st statement
+       */
+      void operator()(sample& st) const;
+
+      /**
+       * Leave the specified statement unchanged, as it contains no
+       * nested statements.
+       *
+       * @param st statement
+       */
+      void operator()(increment_log_prob_statement& st) const;
+
+      /**
+       * Leave the specified statement unchanged, as it contains no
+       * nested statements.
+       *
+       * @param st statement
+       */
+      void operator()(expression& st) const;
+
+      /**
+       * Vectorize the sampling loops in the nested statements of the
+       * specified statement.
+       *
+       * @param st statement
+       */
+      void operator()(statements& st) const;
+
+      /**
+       * Vectorize the sampling loops in the nested statements of the
+       * specified statement.
+       *
+       * @param st statement
+       */
+      void operator()(for_statement& st) const;
+
+      /**
+       * Vectorize the sampling loops in the nested statements of the
+       * specified statement.
+       *
+       * @param st statement
+       */
+      void operator()(for_array_statement& st) const;
+
+      /**
+       * Vectorize the sampling loops in the nested statements of the
+       * specified statement.
+       *
+       * @param st statement
+       */
+      void operator()(for_matrix_statement& st) const;
+
+      /**
+       * Vectorize the sampling loops in the nested statements of the
+       * specified statement.
+       *
+       * @param st statement
+       */
+      void operator()(conditional_statement& st) const;
+
+      /**
+       * Vectorize the sampling loops in the nested statements of the
+       * specified statement.
+       *
+       * @param st statement
+       */
+      void operator()(while_statement& st) const;
+
+      /**
+       * Leave the specified statement unchanged, as it contains no
+       * nested statements.
+       *
+       * @param st statement
+       */
+      void operator()(break_continue_statement& st) const;
+
+      /**
+       * Leave the specified statement unchanged, as it contains no
+       * nested statements.
+       *
+       * @param st statement
+       */
+      void operator()(print_statement& st) const;
+
+      /**
+       * Leave the specified statement unchanged, as it contains no
+       * nested statements.
+       *
+       * @param st statement
+       */
+      void operator()(reject_statement& st) const;
+
+      /**
+       * Leave the specified statement unchanged, as it contains no
+       * nested statements.
+       *
+       * @param st statement
+       */
+      void operator()(no_op_statement& st) const;
+
+      /**
+       * Leave the specified statement unchanged, as it contains no
+       * nested statements.
+       *
+       * @param st statement
+       */
+      void operator()(return_statement& st) const;
+    };
+
+  }
+}
+#endif
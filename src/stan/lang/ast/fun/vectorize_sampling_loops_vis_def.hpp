@@ -0,0 +1,69 @@
+#ifndef STAN_LANG_AST_FUN_VECTORIZE_SAMPLING_LOOPS_VIS_DEF_HPP
+#define STAN_LANG_AST_FUN_VECTORIZE_SAMPLING_LOOPS_VIS_DEF_HPP
+
+#include <stan/lang/ast.hpp>
+
+namespace stan {
+  namespace lang {
+
+    void vectorize_sampling_loops_vis::operator()(nil& st) const { }
+
+    void vectorize_sampling_loops_vis::operator()(assignment& st) const { }
+
+    void vectorize_sampling_loops_vis::operator()(assgn& st) const { }
+
+    void vectorize_sampling_loops_vis::operator()(
+        compound_assignment& st) const { }
+
+    void vectorize_sampling_loops_vis::operator()(sample& st) const { }
+
+    void vectorize_sampling_loops_vis::operator()(
+        increment_log_prob_statement& st) const { }
+
+    void vectorize_sampling_loops_vis::operator()(expression& st) const { }
+
+    void vectorize_sampling_loops_vis::operator()(statements& st) const {
+      for (size_t i = 0; i < st.statements_.size(); ++i)
+        vectorize_sampling_loops(st.statements_[i]);
+    }
+
+    void vectorize_sampling_loops_vis::operator()(for_statement& st) const {
+      vectorize_sampling_loops(st.statement_);
+    }
+
+    void vectorize_sampling_loops_vis::operator()(
+        for_array_statement& st) const {
+      vectorize_sampling_loops(st.statement_);
+    }
+
+    void vectorize_sampling_loops_vis::operator()(
+        for_matrix_statement& st) const {
+      vectorize_sampling_loops(st.statement_);
+    }
+
+    void vectorize_sampling_loops_vis::operator()(
+        conditional_statement& st) const {
+      for (size_t i = 0; i < st.bodies_.size(); ++i)
+        vectorize_sampling_loops(st.bodies_[i]);
+    }
+
+    void vectorize_sampling_loops_vis::operator()(while_statement& st) const {
+      vectorize_sampling_loops(st.body_);
+    }
+
+    void vectorize_sampling_loops_vis::operator()(
+        break_continue_statement& st) const { }
+
+    void vectorize_sampling_loops_vis::operator()(print_statement& st) const { }
+
+    void vectorize_sampling_loops_vis::operator()(
+        reject_statement& st) const { }
+
+    void vectorize_sampling_loops_vis::operator()(no_op_statement& st) const { }
+
+    void vectorize_sampling_loops_vis::operator()(
+        return_statement& st) const { }
+
+  }
+}
+#endif
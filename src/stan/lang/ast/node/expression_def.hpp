@@ -39,6 +39,8 @@ namespace stan {
 
     expression::expression(const algebra_solver_control& expr) : expr_(expr) { }
 
+    expression::expression(const reduce_sum& expr) : expr_(expr) { }
+
     expression::expression(const fun& expr) : expr_(expr) { }
 
     expression::expression(const index_op& expr) : expr_(expr) { }
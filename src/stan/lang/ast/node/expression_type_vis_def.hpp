@@ -53,6 +53,10 @@ namespace stan {
       return expr_type(vector_type(), 0);
     }
 
+    expr_type expression_type_vis::operator()(const reduce_sum& e) const {
+      return expr_type(double_type(), 0);
+    }
+
     expr_type expression_type_vis::operator()(const fun& e) const {
       return e.type_;
     }
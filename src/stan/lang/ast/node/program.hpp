@@ -4,6 +4,7 @@
 #include <stan/lang/ast/node/function_decl_def.hpp>
 #include <stan/lang/ast/node/statement.hpp>
 #include <stan/lang/ast/node/var_decl.hpp>
+#include <stan/lang/ast/node/variable.hpp>
 #include <utility>
 #include <vector>
 
@@ -94,6 +95,13 @@ namespace stan {
        * Generated quantities block.
        */
       std::pair<std::vector<var_decl>, std::vector<statement> > generated_decl_;
+
+      /**
+       * Member variables holding data-only subexpressions hoisted out
+       * of the model block and the constructor statements computing
+       * them.
+       */
+      std::pair<std::vector<variable>, std::vector<statement> > hoisted_decl_;
     };
 
   }
@@ -0,0 +1,73 @@
+#ifndef STAN_LANG_AST_NODE_REDUCE_SUM_HPP
+#define STAN_LANG_AST_NODE_REDUCE_SUM_HPP
+
+#include <stan/lang/ast/node/expression.hpp>
+#include <string>
+
+namespace stan {
+  namespace lang {
+
+    struct expression;
+
+    /**
+     * Structure for a sum of independent terms over the positions
+     * <code>1:N</code>, evaluated in chunks that may run in parallel.
+     */
+    struct reduce_sum {
+      /**
+       * Name of the function returning the partial sum over a range
+       * of positions.
+       */
+      std::string partial_sum_function_name_;
+
+      /**
+       * Number of positions.
+       */
+      expression n_;
+
+      /**
+       * Number of positions per chunk.
+       */
+      expression grainsize_;
+
+      /**
+       * Parameters.
+       */
+      expression theta_;
+
+      /**
+       * Real-valued data.
+       */
+      expression x_r_;
+
+      /**
+       * Integer-valued data.
+       */
+      expression x_i_;
+
+      /**
+       * Construct a default reduce sum node.
+       */
+      reduce_sum();
+
+      /**
+       * Construct a reduce sum node.
+       *
+       * @param partial_sum_function_name name of partial sum function
+       * @param n number of positions
+       * @param grainsize number of positions per chunk
+       * @param theta parameters
+       * @param x_r real-valued data
+       * @param x_i integer-valued data
+       */
+      reduce_sum(const std::string& partial_sum_function_name,
+                 const expression& n,
+                 const expression& grainsize,
+                 const expression& theta,
+                 const expression& x_r,
+                 const expression& x_i);
+    };
+
+  }
+}
+#endif
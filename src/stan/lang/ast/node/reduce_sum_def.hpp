@@ -0,0 +1,23 @@
+#ifndef STAN_LANG_AST_NODE_REDUCE_SUM_DEF_HPP
+#define STAN_LANG_AST_NODE_REDUCE_SUM_DEF_HPP
+
+#include <stan/lang/ast.hpp>
+#include <string>
+
+namespace stan {
+  namespace lang {
+
+    reduce_sum::reduce_sum() { }
+
+    reduce_sum::reduce_sum(const std::string& partial_sum_function_name,
+                           const expression& n,
+                           const expression& grainsize,
+                           const expression& theta,
+                           const expression& x_r,
+                           const expression& x_i)
+      : partial_sum_function_name_(partial_sum_function_name),
+        n_(n), grainsize_(grainsize), theta_(theta), x_r_(x_r), x_i_(x_i) { }
+
+  }
+}
+#endif
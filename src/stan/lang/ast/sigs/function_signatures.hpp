@@ -3,6 +3,7 @@
 
 #include <stan/lang/ast/expr_type.hpp>
 #include <stan/lang/ast/sigs/function_signature_t.hpp>
+#include <boost/unordered_map.hpp>
 #include <map>
 #include <ostream>
 #include <set>
@@ -362,11 +363,61 @@ namespace stan {
        */
       function_signatures(const function_signatures& fs);
 
+      /**
+       * Add a function with the specified name, result type and
+       * argument types, which are swapped into the stored signature
+       * rather than copied and left empty.
+       *
+       * @param name function name
+       * @param result_type function return type
+       * @param arg_types sequence of argument types
+       */
+      void add_signature(const std::string& name,
+                         const expr_type& result_type,
+                         std::vector<function_arg_type>& arg_types);
+
+      /**
+       * Return the number of signatures for the specified function
+       * name that match the specified argument types with the
+       * minimum number of promotions, setting the index of the last
+       * such signature and the minimum number of promotions.  Only
+       * signatures with the same number of arguments as the call
+       * are considered, and unique matches are cached.
+       *
+       * @param name function name
+       * @param args argument types with which function is called
+       * @param match_index index of matching signature among the
+       * signatures for the function name
+       * @param min_promotions minimum number of promotions
+       * @return number of matches
+       */
+      size_t resolve(const std::string& name,
+                     const std::vector<expr_type>& args,
+                     size_t& match_index, size_t& min_promotions);
+
       /**
        * The mapping from function names to their signatures.
        */
       std::map<std::string, std::vector<function_signature_t> > sigs_map_;
 
+      /**
+       * For each function name, the indexes of its signatures in
+       * <code>sigs_map_</code> grouped by number of arguments.
+       * Entries are built on first lookup and dropped when a
+       * signature is added for the name.
+       */
+      boost::unordered_map<std::string, std::vector<std::vector<size_t> > >
+      arity_index_;
+
+      /**
+       * Unique overload resolutions found so far, mapping function
+       * name and argument types to the index of the matching
+       * signature and its number of promotions.  Cleared whenever a
+       * signature is added.
+       */
+      std::map<std::pair<std::string, std::vector<expr_type> >,
+               std::pair<size_t, size_t> > resolution_cache_;
+
       /**
        * The set of user-defined function name and signature pairs.
        */
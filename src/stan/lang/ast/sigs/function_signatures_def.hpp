@@ -37,9 +37,11 @@ namespace stan {
 
     bool function_signatures::is_defined(const std::string& name,
                                          const function_signature_t& sig) {
-      if (sigs_map_.find(name) == sigs_map_.end())
+      std::map<std::string, std::vector<function_signature_t> >
+        ::const_iterator it = sigs_map_.find(name);
+      if (it == sigs_map_.end())
         return false;
-      const std::vector<function_signature_t> sigs = sigs_map_[name];
+      const std::vector<function_signature_t>& sigs = it->second;
       // check return type
       for (size_t i = 0; i < sigs.size(); ++i)
         if (sig.first == sigs[i].first && sig.second == sigs[i].second)
@@ -50,10 +52,14 @@ namespace stan {
     function_signature_t
     function_signatures::get_definition(const std::string& name,
                                         const function_signature_t& sig) {
-      const std::vector<function_signature_t> sigs = sigs_map_[name];
-      for (size_t i = 0; i < sigs.size(); ++i)
-        if (sig.first == sigs[i].first && sig.second == sigs[i].second)
-          return sigs[i];
+      std::map<std::string, std::vector<function_signature_t> >
+        ::const_iterator it = sigs_map_.find(name);
+      if (it != sigs_map_.end()) {
+        const std::vector<function_signature_t>& sigs = it->second;
+        for (size_t i = 0; i < sigs.size(); ++i)
+          if (sig.first == sigs[i].first && sig.second == sigs[i].second)
+            return sigs[i];
+      }
       expr_type ill_formed = expr_type();
       std::vector<function_arg_type> arg_types;
       return function_signature_t(ill_formed, arg_types);
@@ -68,7 +74,7 @@ namespace stan {
         = sigs_map_.find(fun);
       if (it == sigs_map_.end())
         return false;
-      const vector<function_signature_t> sigs = it->second;
+      const vector<function_signature_t>& sigs = it->second;
       for (size_t i = 0; i < sigs.size(); ++i) {
         if (sigs[i].second.size() == 0
             || !sigs[i].second[0].expr_type_.base_type_.is_int_type())
@@ -81,21 +87,36 @@ namespace stan {
                                   const expr_type& result_type,
                                   const std::vector<function_arg_type>&
                                   arg_types) {
-      sigs_map_[name].push_back(function_signature_t(result_type, arg_types));
+      std::vector<function_arg_type> arg_types_copy(arg_types);
+      add_signature(name, result_type, arg_types_copy);
+    }
+
+    void function_signatures::add_signature(const std::string& name,
+                                            const expr_type& result_type,
+                                            std::vector<function_arg_type>&
+                                            arg_types) {
+      std::vector<function_signature_t>& sigs = sigs_map_[name];
+      sigs.push_back(function_signature_t());
+      sigs.back().first = result_type;
+      sigs.back().second.swap(arg_types);
+      if (!arity_index_.empty())
+        arity_index_.erase(name);
+      resolution_cache_.clear();
     }
 
     void function_signatures::add(const std::string& name,
                                   const expr_type& result_type) {
       std::vector<function_arg_type> arg_types;
-      add(name, result_type, arg_types);
+      add_signature(name, result_type, arg_types);
     }
 
     void function_signatures::add(const std::string& name,
                                   const expr_type& result_type,
                                   const expr_type& arg_type) {
       std::vector<function_arg_type> arg_types;
+      arg_types.reserve(1);
       arg_types.push_back(function_arg_type(arg_type));
-      add(name, result_type, arg_types);
+      add_signature(name, result_type, arg_types);
     }
 
     void function_signatures::add(const std::string& name,
@@ -103,9 +124,10 @@ namespace stan {
                                   const expr_type& arg_type1,
                                   const expr_type& arg_type2) {
       std::vector<function_arg_type> arg_types;
+      arg_types.reserve(2);
       arg_types.push_back(function_arg_type(arg_type1));
       arg_types.push_back(function_arg_type(arg_type2));
-      add(name, result_type, arg_types);
+      add_signature(name, result_type, arg_types);
     }
 
     void function_signatures::add(const std::string& name,
@@ -114,10 +136,11 @@ namespace stan {
                                   const expr_type& arg_type2,
                                   const expr_type& arg_type3) {
       std::vector<function_arg_type> arg_types;
+      arg_types.reserve(3);
       arg_types.push_back(function_arg_type(arg_type1));
       arg_types.push_back(function_arg_type(arg_type2));
       arg_types.push_back(function_arg_type(arg_type3));
-      add(name, result_type, arg_types);
+      add_signature(name, result_type, arg_types);
     }
 
     void function_signatures::add(const std::string& name,
@@ -127,11 +150,12 @@ namespace stan {
                                   const expr_type& arg_type3,
                                   const expr_type& arg_type4) {
       std::vector<function_arg_type> arg_types;
+      arg_types.reserve(4);
       arg_types.push_back(function_arg_type(arg_type1));
       arg_types.push_back(function_arg_type(arg_type2));
       arg_types.push_back(function_arg_type(arg_type3));
       arg_types.push_back(function_arg_type(arg_type4));
-      add(name, result_type, arg_types);
+      add_signature(name, result_type, arg_types);
     }
 
     void function_signatures::add(const std::string& name,
@@ -142,12 +166,13 @@ namespace stan {
                                   const expr_type& arg_type4,
                                   const expr_type& arg_type5) {
       std::vector<function_arg_type> arg_types;
+      arg_types.reserve(5);
       arg_types.push_back(function_arg_type(arg_type1));
       arg_types.push_back(function_arg_type(arg_type2));
       arg_types.push_back(function_arg_type(arg_type3));
       arg_types.push_back(function_arg_type(arg_type4));
       arg_types.push_back(function_arg_type(arg_type5));
-      add(name, result_type, arg_types);
+      add_signature(name, result_type, arg_types);
     }
 
     void function_signatures::add(const std::string& name,
@@ -159,13 +184,14 @@ namespace stan {
                                   const expr_type& arg_type5,
                                   const expr_type& arg_type6) {
       std::vector<function_arg_type> arg_types;
+      arg_types.reserve(6);
       arg_types.push_back(function_arg_type(arg_type1));
       arg_types.push_back(function_arg_type(arg_type2));
       arg_types.push_back(function_arg_type(arg_type3));
       arg_types.push_back(function_arg_type(arg_type4));
       arg_types.push_back(function_arg_type(arg_type5));
       arg_types.push_back(function_arg_type(arg_type6));
-      add(name, result_type, arg_types);
+      add_signature(name, result_type, arg_types);
     }
 
     void function_signatures::add(const std::string& name,
@@ -178,6 +204,7 @@ namespace stan {
                                   const expr_type& arg_type6,
                                   const expr_type& arg_type7) {
       std::vector<function_arg_type> arg_types;
+      arg_types.reserve(7);
       arg_types.push_back(function_arg_type(arg_type1));
       arg_types.push_back(function_arg_type(arg_type2));
       arg_types.push_back(function_arg_type(arg_type3));
@@ -185,7 +212,7 @@ namespace stan {
       arg_types.push_back(function_arg_type(arg_type5));
       arg_types.push_back(function_arg_type(arg_type6));
       arg_types.push_back(function_arg_type(arg_type7));
-      add(name, result_type, arg_types);
+      add_signature(name, result_type, arg_types);
     }
 
     void function_signatures::add_nullary(const::std::string& name) {
@@ -244,25 +271,74 @@ namespace stan {
       return num_promotions;
     }
 
-    int function_signatures::get_signature_matches(const std::string& name,
-                              const std::vector<expr_type>& args,
-                              function_signature_t& signature) {
-      if (!has_key(name)) return 0;
-      std::vector<function_signature_t> signatures = sigs_map_[name];
-      size_t min_promotions = std::numeric_limits<size_t>::max();
+    size_t function_signatures::resolve(const std::string& name,
+                                        const std::vector<expr_type>& args,
+                                        size_t& match_index,
+                                        size_t& min_promotions) {
+      using std::map;
+      using std::pair;
+      using std::string;
+      using std::vector;
+      min_promotions = std::numeric_limits<size_t>::max();
+      pair<string, vector<expr_type> > call(name, args);
+      map<pair<string, vector<expr_type> >, pair<size_t, size_t> >
+        ::const_iterator cached = resolution_cache_.find(call);
+      if (cached != resolution_cache_.end()) {
+        match_index = cached->second.first;
+        min_promotions = cached->second.second;
+        return 1;
+      }
+
+      map<string, vector<function_signature_t> >::const_iterator it
+        = sigs_map_.find(name);
+      if (it == sigs_map_.end())
+        return 0;
+      const vector<function_signature_t>& signatures = it->second;
+
+      boost::unordered_map<string, vector<vector<size_t> > >::iterator idx
+        = arity_index_.find(name);
+      if (idx == arity_index_.end()) {
+        idx = arity_index_.insert(std::make_pair(name,
+                                                 vector<vector<size_t> >()))
+          .first;
+        for (size_t i = 0; i < signatures.size(); ++i) {
+          size_t arity = signatures[i].second.size();
+          if (idx->second.size() <= arity)
+            idx->second.resize(arity + 1);
+          idx->second[arity].push_back(i);
+        }
+      }
+      if (args.size() >= idx->second.size())
+        return 0;
+      const vector<size_t>& candidates = idx->second[args.size()];
+
       size_t num_matches = 0;
-      for (size_t i = 0; i < signatures.size(); ++i) {
-        signature = signatures[i];
-        int promotions = num_promotions(args, signature.second);
+      for (size_t k = 0; k < candidates.size(); ++k) {
+        int promotions
+          = num_promotions(args, signatures[candidates[k]].second);
         if (promotions < 0) continue;  // no match
         size_t promotions_ui = static_cast<size_t>(promotions);
         if (promotions_ui < min_promotions) {
           min_promotions = promotions_ui;
+          match_index = candidates[k];
           num_matches = 1;
         } else if (promotions_ui == min_promotions) {
           ++num_matches;
         }
       }
+      if (num_matches == 1)
+        resolution_cache_[call] = std::make_pair(match_index, min_promotions);
+      return num_matches;
+    }
+
+    int function_signatures::get_signature_matches(const std::string& name,
+                              const std::vector<expr_type>& args,
+                              function_signature_t& signature) {
+      size_t match_index = 0;
+      size_t min_promotions;
+      size_t num_matches = resolve(name, args, match_index, min_promotions);
+      if (num_matches > 0)
+        signature = sigs_map_[name][match_index];
       return num_matches;
     }
 
@@ -392,10 +468,19 @@ namespace stan {
                                            const std::vector<expr_type>& args,
                                            std::ostream& error_msgs,
                                            bool sampling_error_style) {
-      std::vector<function_signature_t> signatures = sigs_map_[name];
       size_t match_index = 0;
-      size_t min_promotions = std::numeric_limits<size_t>::max();
-      size_t num_matches = 0;
+      size_t min_promotions;
+      size_t num_matches = resolve(name, args, match_index, min_promotions);
+      if (num_matches == 1)
+        return sigs_map_[name][match_index].first;
+
+      // all returns after here are for ill-typed input
+
+      static const std::vector<function_signature_t> no_signatures;
+      std::map<std::string, std::vector<function_signature_t> >
+        ::const_iterator it = sigs_map_.find(name);
+      const std::vector<function_signature_t>& signatures
+        = it == sigs_map_.end() ? no_signatures : it->second;
 
       std::string display_name;
       if (is_operator(name)) {
@@ -409,24 +494,6 @@ namespace stan {
         display_name = name;
       }
 
-      for (size_t i = 0; i < signatures.size(); ++i) {
-        int promotions = num_promotions(args, signatures[i].second);
-        if (promotions < 0) continue;  // no match
-        size_t promotions_ui = static_cast<size_t>(promotions);
-        if (promotions_ui < min_promotions) {
-          min_promotions = promotions_ui;
-          match_index = i;
-          num_matches = 1;
-        } else if (promotions_ui == min_promotions) {
-          ++num_matches;
-        }
-      }
-
-      if (num_matches == 1)
-        return signatures[match_index].first;
-
-      // all returns after here are for ill-typed input
-
       if (num_matches == 0) {
         error_msgs << "No matches for: "
                    << std::endl << std::endl;
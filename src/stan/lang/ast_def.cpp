@@ -11,6 +11,7 @@
 #include <stan/lang/ast/scope_def.hpp>
 #include <stan/lang/ast/variable_map_def.hpp>
 
+#include <stan/lang/ast/fun/assigned_vars_vis_def.hpp>
 #include <stan/lang/ast/fun/ends_with_def.hpp>
 #include <stan/lang/ast/fun/fun_name_exists_def.hpp>
 #include <stan/lang/ast/fun/get_cdf_def.hpp>
@@ -25,9 +26,21 @@
 #include <stan/lang/ast/fun/has_rng_suffix_def.hpp>
 #include <stan/lang/ast/fun/has_var_def.hpp>
 #include <stan/lang/ast/fun/has_var_vis_def.hpp>
+#include <stan/lang/ast/fun/hoist_data_only_exprs_def.hpp>
+#include <stan/lang/ast/fun/hoist_data_only_statement_vis_def.hpp>
+#include <stan/lang/ast/fun/hoist_data_only_vis_def.hpp>
+#include <stan/lang/ast/fun/hoist_loop_invariant_exprs_def.hpp>
+#include <stan/lang/ast/fun/hoist_loop_invariant_loops_vis_def.hpp>
+#include <stan/lang/ast/fun/hoist_loop_invariant_statement_vis_def.hpp>
+#include <stan/lang/ast/fun/hoist_loop_invariant_vis_def.hpp>
 #include <stan/lang/ast/fun/indexed_type_def.hpp>
 #include <stan/lang/ast/fun/infer_type_indexing_def.hpp>
 #include <stan/lang/ast/fun/is_assignable_def.hpp>
+#include <stan/lang/ast/fun/is_assigned_before_use_def.hpp>
+#include <stan/lang/ast/fun/is_data_only_def.hpp>
+#include <stan/lang/ast/fun/is_data_only_vis_def.hpp>
+#include <stan/lang/ast/fun/is_loop_invariant_def.hpp>
+#include <stan/lang/ast/fun/is_loop_invariant_vis_def.hpp>
 #include <stan/lang/ast/fun/is_multi_index_def.hpp>
 #include <stan/lang/ast/fun/is_multi_index_vis_def.hpp>
 #include <stan/lang/ast/fun/is_nil_def.hpp>
@@ -42,9 +55,11 @@
 #include <stan/lang/ast/fun/promote_primitive_def.hpp>
 #include <stan/lang/ast/fun/returns_type_def.hpp>
 #include <stan/lang/ast/fun/returns_type_vis_def.hpp>
+#include <stan/lang/ast/fun/rewrite_sufficient_stats_def.hpp>
 #include <stan/lang/ast/fun/strip_prob_fun_suffix_def.hpp>
 #include <stan/lang/ast/fun/strip_ccdf_suffix_def.hpp>
 #include <stan/lang/ast/fun/strip_cdf_suffix_def.hpp>
+#include <stan/lang/ast/fun/sufficient_stats_sample_def.hpp>
 #include <stan/lang/ast/fun/total_dims_def.hpp>
 #include <stan/lang/ast/fun/write_base_expr_type_def.hpp>
 #include <stan/lang/ast/fun/var_decl_base_type_vis_def.hpp>
@@ -52,6 +67,9 @@
 #include <stan/lang/ast/fun/var_decl_dims_vis_def.hpp>
 #include <stan/lang/ast/fun/var_decl_has_def_vis_def.hpp>
 #include <stan/lang/ast/fun/var_occurs_vis_def.hpp>
+#include <stan/lang/ast/fun/vectorize_sampling_loop_def.hpp>
+#include <stan/lang/ast/fun/vectorize_sampling_loops_def.hpp>
+#include <stan/lang/ast/fun/vectorize_sampling_loops_vis_def.hpp>
 
 #include <stan/lang/ast/node/algebra_solver_def.hpp>
 #include <stan/lang/ast/node/algebra_solver_control_def.hpp>
@@ -98,6 +116,7 @@
 #include <stan/lang/ast/node/print_statement_def.hpp>
 #include <stan/lang/ast/node/program_def.hpp>
 #include <stan/lang/ast/node/range_def.hpp>
+#include <stan/lang/ast/node/reduce_sum_def.hpp>
 #include <stan/lang/ast/node/reject_statement_def.hpp>
 #include <stan/lang/ast/node/return_statement_def.hpp>
 #include <stan/lang/ast/node/matrix_expr_def.hpp>
@@ -13,12 +13,52 @@
 namespace stan {
   namespace lang {
 
+    /**
+     * Parse the Stan model specification read by the specified
+     * program reader into the specified program and apply the
+     * rewrites done before code is generated: sampling loops in the
+     * model block are vectorized, if the sufficient statistics flag
+     * is set the sampling statements that
+     * <code>sufficient_stats_sample</code> can rewrite are replaced
+     * by densities of statistics computed by the constructor, the
+     * data-only subexpressions of the model block are hoisted into
+     * the constructor and the loop-invariant subexpressions of its
+     * for loops are hoisted before the loops.
+     *
+     * @param msgs Output stream for warning messages
+     * @param reader program reader holding the model specification
+     * @param name Name of model class
+     * @param allow_undefined true if permits undefined functions
+     * @param sufficient_stats true if sampling statements are
+     *   rewritten to use sufficient statistics
+     * @param[out] prog program parsed and rewritten
+     * @return <code>false</code> if the program could not be parsed
+     *   due to syntax error in the Stan model; <code>true</code>
+     *   otherwise.
+     */
+    bool parse_and_rewrite(std::ostream* msgs,
+                           const io::program_reader& reader,
+                           const std::string& name,
+                           const bool allow_undefined,
+                           const bool sufficient_stats, program& prog) {
+      std::stringstream ss(reader.program());
+      if (!parse(msgs, ss, name, reader, prog, allow_undefined))
+        return false;
+      vectorize_sampling_loops(prog.statement_);
+      if (sufficient_stats)
+        rewrite_sufficient_stats(prog);
+      hoist_data_only_exprs(prog);
+      hoist_loop_invariant_exprs(prog);
+      return true;
+    }
+
     /**
      * Read a Stan model specification from the specified input, parse
      * it, and write the C++ code for it to the specified output,
      * allowing undefined function declarations if the flag is set to
      * true and searching the specified include path for included
-     * files.
+     * files.  The program is rewritten before code is generated as
+     * described for <code>parse_and_rewrite</code>.
      *
      * @param msgs Output stream for warning messages
      * @param in Stan model specification
@@ -28,6 +68,8 @@ namespace stan {
      * @param filename name of file or other source from which input
      *   stream was derived
      * @param include_paths array of paths to search for included files
+     * @param sufficient_stats true if sampling statements are
+     *   rewritten to use sufficient statistics
      * @return <code>false</code> if code could not be generated due
      *   to syntax error in the Stan model; <code>true</code>
      *   otherwise.
@@ -36,19 +78,74 @@ namespace stan {
                  const std::string& name, const bool allow_undefined = false,
                  const std::string& filename = "unknown file name",
                  const std::vector<std::string>& include_paths
-                  = std::vector<std::string>()) {
+                  = std::vector<std::string>(),
+                 const bool sufficient_stats = false) {
       io::program_reader reader(in, filename, include_paths);
-      std::string s = reader.program();
-      std::stringstream ss(s);
       program prog;
-      bool parse_succeeded = parse(msgs, ss, name, reader, prog,
-                                   allow_undefined);
-      if (!parse_succeeded)
+      if (!parse_and_rewrite(msgs, reader, name, allow_undefined,
+                             sufficient_stats, prog))
         return false;
       generate_cpp(prog, name, reader.history(), out);
       return true;
     }
 
+    /**
+     * Read a Stan model specification from the specified input, parse
+     * it, and write the C++ code for it split into a header and
+     * separately compilable translation units, as described for
+     * <code>generate_cpp_split</code>.  Arguments other than the
+     * output streams are as for <code>compile</code>.
+     *
+     * @param msgs Output stream for warning messages
+     * @param in Stan model specification
+     * @param header_name name by which the translation units include
+     *   the header
+     * @param header_out output stream for the header
+     * @param functions_out output stream for user-defined functions
+     * @param ctor_out output stream for the constructor
+     * @param log_prob_var_out output stream for the reverse-mode log
+     *   density
+     * @param log_prob_double_out output stream for the double log
+     *   density
+     * @param log_prob_fvar_out output stream for the forward-mode log
+     *   density
+     * @param write_array_out output stream for write_array
+     * @param name Name of model class
+     * @param allow_undefined true if permits undefined functions
+     * @param filename name of file or other source from which input
+     *   stream was derived
+     * @param include_paths array of paths to search for included files
+     * @param sufficient_stats true if sampling statements are
+     *   rewritten to use sufficient statistics
+     * @return <code>false</code> if code could not be generated due
+     *   to syntax error in the Stan model; <code>true</code>
+     *   otherwise.
+     */
+    bool compile_split(std::ostream* msgs, std::istream& in,
+                       const std::string& header_name,
+                       std::ostream& header_out, std::ostream& functions_out,
+                       std::ostream& ctor_out, std::ostream& log_prob_var_out,
+                       std::ostream& log_prob_double_out,
+                       std::ostream& log_prob_fvar_out,
+                       std::ostream& write_array_out,
+                       const std::string& name,
+                       const bool allow_undefined = false,
+                       const std::string& filename = "unknown file name",
+                       const std::vector<std::string>& include_paths
+                        = std::vector<std::string>(),
+                       const bool sufficient_stats = false) {
+      io::program_reader reader(in, filename, include_paths);
+      program prog;
+      if (!parse_and_rewrite(msgs, reader, name, allow_undefined,
+                             sufficient_stats, prog))
+        return false;
+      generate_cpp_split(prog, name, reader.history(), header_name,
+                         header_out, functions_out, ctor_out,
+                         log_prob_var_out, log_prob_double_out,
+                         log_prob_fvar_out, write_array_out);
+      return true;
+    }
+
   }
 }
 #endif
@@ -13,6 +13,9 @@
 // utilities
 #include <stan/lang/generator/constants.hpp>
 #include <stan/lang/generator/fun_scalar_type.hpp>
+#include <stan/lang/generator/is_rvalue_view.hpp>
+#include <stan/lang/generator/is_template_function.hpp>
+#include <stan/lang/generator/log_prob_value_accum_type.hpp>
 
 // visitor classes for tests
 #include <stan/lang/generator/is_numbered_statement_vis.hpp>
@@ -47,6 +50,7 @@
 #include <stan/lang/generator/generate_arg_decl.hpp>
 #include <stan/lang/generator/generate_array_var_type.hpp>
 #include <stan/lang/generator/generate_array_builder_adds.hpp>
+#include <stan/lang/generator/generate_assign_view.hpp>
 #include <stan/lang/generator/generate_bare_type.hpp>
 #include <stan/lang/generator/generate_catch_throw_located.hpp>
 #include <stan/lang/generator/generate_class_decl.hpp>
@@ -54,7 +58,10 @@
 #include <stan/lang/generator/generate_comment.hpp>
 #include <stan/lang/generator/generate_constrained_param_names_method.hpp>
 #include <stan/lang/generator/generate_constructor.hpp>
+#include <stan/lang/generator/generate_constructor_overloads.hpp>
 #include <stan/lang/generator/generate_cpp.hpp>
+#include <stan/lang/generator/generate_cpp_split.hpp>
+#include <stan/lang/generator/generate_ctor_body.hpp>
 #include <stan/lang/generator/generate_destructor.hpp>
 #include <stan/lang/generator/generate_dims_method.hpp>
 #include <stan/lang/generator/generate_eigen_index_expression.hpp>
@@ -68,6 +75,7 @@
 #include <stan/lang/generator/generate_function_template_parameters.hpp>
 #include <stan/lang/generator/generate_functor_arguments.hpp>
 #include <stan/lang/generator/generate_globals.hpp>
+#include <stan/lang/generator/generate_hoisted_var_decls.hpp>
 #include <stan/lang/generator/generate_idx.hpp>
 #include <stan/lang/generator/generate_idxs.hpp>
 #include <stan/lang/generator/generate_idxs_user.hpp>
@@ -83,6 +91,10 @@
 #include <stan/lang/generator/generate_local_var_decls.hpp>
 #include <stan/lang/generator/generate_local_var_inits.hpp>
 #include <stan/lang/generator/generate_log_prob.hpp>
+#include <stan/lang/generator/generate_log_prob_impl.hpp>
+#include <stan/lang/generator/generate_log_prob_instantiations.hpp>
+#include <stan/lang/generator/generate_log_prob_value.hpp>
+#include <stan/lang/generator/generate_log_prob_wrappers.hpp>
 #include <stan/lang/generator/generate_member_var_decls.hpp>
 #include <stan/lang/generator/generate_member_var_decls_all.hpp>
 #include <stan/lang/generator/generate_member_var_inits.hpp>
@@ -100,7 +112,9 @@
 #include <stan/lang/generator/generate_quoted_expression.hpp>
 #include <stan/lang/generator/generate_quoted_string.hpp>
 #include <stan/lang/generator/generate_real_var_type.hpp>
+#include <stan/lang/generator/generate_rvalue_view.hpp>
 #include <stan/lang/generator/generate_set_param_ranges.hpp>
+#include <stan/lang/generator/generate_split_method_decls.hpp>
 #include <stan/lang/generator/generate_statement.hpp>
 #include <stan/lang/generator/generate_statements.hpp>
 #include <stan/lang/generator/generate_type.hpp>
@@ -120,5 +134,7 @@
 #include <stan/lang/generator/generate_version_comment.hpp>
 #include <stan/lang/generator/generate_void_statement.hpp>
 #include <stan/lang/generator/generate_write_array_method.hpp>
+#include <stan/lang/generator/generate_write_array_impl.hpp>
+#include <stan/lang/generator/generate_write_array_wrapper.hpp>
 
 #endif
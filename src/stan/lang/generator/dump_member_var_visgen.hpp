@@ -57,7 +57,7 @@ namespace stan {
         var_size_validator_(x);
         var_resizer_(x);
         generate_indent(indent_, o_);
-        o_ << "vals_i__ = context__.vals_i(\"" << x.name_ << "\");" << EOL;
+        o_ << "vals_i__ = context__.vals_i_view(\"" << x.name_ << "\");" << EOL;
         generate_indent(indent_, o_);
         o_ << "pos__ = 0;" << EOL;
         size_t indentation = indent_;
@@ -89,7 +89,7 @@ namespace stan {
         var_size_validator_(x);
         var_resizer_(x);
         generate_indent(indent_, o_);
-        o_ << "vals_r__ = context__.vals_r(\"" << x.name_ << "\");" << EOL;
+        o_ << "vals_r__ = context__.vals_r_view(\"" << x.name_ << "\");" << EOL;
         generate_indent(indent_, o_);
         o_ << "pos__ = 0;" << EOL;
         size_t indentation = indent_;
@@ -121,7 +121,7 @@ namespace stan {
         var_size_validator_(x);
         var_resizer_(x);
         generate_indent(indent_, o_);
-        o_ << "vals_r__ = context__.vals_r(\"" << x.name_ << "\");" << EOL;
+        o_ << "vals_r__ = context__.vals_r_view(\"" << x.name_ << "\");" << EOL;
         generate_indent(indent_, o_);
         o_ << "pos__ = 0;" << EOL;
         generate_indent(indent_, o_);
@@ -163,7 +163,7 @@ namespace stan {
         var_size_validator_(x);
         var_resizer_(x);
         generate_indent(indent_, o_);
-        o_ << "vals_r__ = context__.vals_r(\"" << x.name_ << "\");" << EOL;
+        o_ << "vals_r__ = context__.vals_r_view(\"" << x.name_ << "\");" << EOL;
         generate_indent(indent_, o_);
         o_ << "pos__ = 0;" << EOL;
         generate_indent(indent_, o_);
@@ -205,7 +205,7 @@ namespace stan {
         var_size_validator_(x);
         var_resizer_(x);
         generate_indent(indent_, o_);
-        o_ << "vals_r__ = context__.vals_r(\"" << x.name_ << "\");" << EOL;
+        o_ << "vals_r__ = context__.vals_r_view(\"" << x.name_ << "\");" << EOL;
         generate_indent(indent_, o_);
         o_ << "pos__ = 0;" << EOL;
         generate_indent(indent_, o_);
@@ -247,7 +247,7 @@ namespace stan {
         var_size_validator_(x);
         var_resizer_(x);
         generate_indent(indent_, o_);
-        o_ << "vals_r__ = context__.vals_r(\"" << x.name_ << "\");" << EOL;
+        o_ << "vals_r__ = context__.vals_r_view(\"" << x.name_ << "\");" << EOL;
         generate_indent(indent_, o_);
         o_ << "pos__ = 0;" << EOL;
         generate_indent(indent_, o_);
@@ -289,7 +289,7 @@ namespace stan {
         var_size_validator_(x);
         var_resizer_(x);
         generate_indent(indent_, o_);
-        o_ << "vals_r__ = context__.vals_r(\"" << x.name_ << "\");" << EOL;
+        o_ << "vals_r__ = context__.vals_r_view(\"" << x.name_ << "\");" << EOL;
         generate_indent(indent_, o_);
         o_ << "pos__ = 0;" << EOL;
         generate_indent(indent_, o_);
@@ -331,7 +331,7 @@ namespace stan {
         var_size_validator_(x);
         var_resizer_(x);
         generate_indent(indent_, o_);
-        o_ << "vals_r__ = context__.vals_r(\"" << x.name_ << "\");" << EOL;
+        o_ << "vals_r__ = context__.vals_r_view(\"" << x.name_ << "\");" << EOL;
         generate_indent(indent_, o_);
         o_ << "pos__ = 0;" << EOL;
         generate_indent(indent_, o_);
@@ -373,7 +373,7 @@ namespace stan {
         var_size_validator_(x);
         var_resizer_(x);
         generate_indent(indent_, o_);
-        o_ << "vals_r__ = context__.vals_r(\""
+        o_ << "vals_r__ = context__.vals_r_view(\""
            << x.name_ << "\");" << EOL;
         generate_indent(indent_, o_);
         o_ << "pos__ = 0;" << EOL;
@@ -425,7 +425,7 @@ namespace stan {
         var_size_validator_(x);
         var_resizer_(x);
         generate_indent(indent_, o_);
-        o_ << "vals_r__ = context__.vals_r(\"" << x.name_ << "\");" << EOL;
+        o_ << "vals_r__ = context__.vals_r_view(\"" << x.name_ << "\");" << EOL;
         generate_indent(indent_, o_);
         o_ << "pos__ = 0;" << EOL;
         generate_indent(indent_, o_);
@@ -472,7 +472,7 @@ namespace stan {
         var_size_validator_(x);
         var_resizer_(x);
         generate_indent(indent_, o_);
-        o_ << "vals_r__ = context__.vals_r(\""
+        o_ << "vals_r__ = context__.vals_r_view(\""
            << x.name_ << "\");" << EOL;
         generate_indent(indent_, o_);
         o_ << "pos__ = 0;" << EOL;
@@ -524,7 +524,7 @@ namespace stan {
         var_size_validator_(x);
         var_resizer_(x);
         generate_indent(indent_, o_);
-        o_ << "vals_r__ = context__.vals_r(\""
+        o_ << "vals_r__ = context__.vals_r_view(\""
            << x.name_ << "\");" << EOL;
         generate_indent(indent_, o_);
         o_ << "pos__ = 0;" << EOL;
@@ -576,7 +576,7 @@ namespace stan {
         var_size_validator_(x);
         var_resizer_(x);
         generate_indent(indent_, o_);
-        o_ << "vals_r__ = context__.vals_r(\"" << x.name_ << "\");"
+        o_ << "vals_r__ = context__.vals_r_view(\"" << x.name_ << "\");"
            << EOL;
         generate_indent(indent_, o_);
         o_ << "pos__ = 0;" << EOL;
@@ -220,6 +220,23 @@ namespace stan {
         o_ << ")";
       }
 
+      void operator()(const reduce_sum& fx) const {
+        o_ << "stan::model::reduce_sum"
+           << '('
+           << fx.partial_sum_function_name_
+           << "_functor__(), ";
+        generate_expression(fx.n_, NOT_USER_FACING, o_);
+        o_ << ", ";
+        generate_expression(fx.grainsize_, NOT_USER_FACING, o_);
+        o_ << ", ";
+        generate_expression(fx.theta_, user_facing_, o_);
+        o_ << ", ";
+        generate_expression(fx.x_r_, NOT_USER_FACING, o_);
+        o_ << ", ";
+        generate_expression(fx.x_i_, NOT_USER_FACING, o_);
+        o_ << ", pstream__)";
+      }
+
       void operator()(const fun& fx) const {
         // first test if short-circuit op (binary && and || applied to
         // primitives; overloads are eager, not short-circuiting)
@@ -0,0 +1,47 @@
+#ifndef STAN_LANG_GENERATOR_GENERATE_ASSIGN_VIEW_HPP
+#define STAN_LANG_GENERATOR_GENERATE_ASSIGN_VIEW_HPP
+
+#include <stan/lang/ast.hpp>
+#include <stan/lang/generator/generate_rvalue_view.hpp>
+#include <stan/lang/generator/is_rvalue_view.hpp>
+#include <ostream>
+#include <string>
+
+namespace stan {
+  namespace lang {
+
+    /**
+     * Return true if assigning the specified expression to the
+     * variable with the specified name may be generated with
+     * <code>generate_assign_view()</code>, which copies the elements
+     * of a slice straight into the variable.  The expression must
+     * be a view-able slice that does not refer to the variable.
+     *
+     * @param[in] var_name name of assigned variable
+     * @param[in] e expression assigned
+     * @return true if assignment may read through a view
+     */
+    bool is_assign_view(const std::string& var_name, const expression& e) {
+      return is_rvalue_view(e) && is_loop_invariant(e, var_name);
+    }
+
+    /**
+     * Generate a call to <code>stan::model::assign_view()</code> to
+     * assign a view of the specified sliced expression to the
+     * variable with the specified name, without a trailing
+     * semicolon.
+     *
+     * @param[in] var_name name of assigned variable
+     * @param[in] e sliced expression assigned
+     * @param[in,out] o stream for generating
+     */
+    void generate_assign_view(const std::string& var_name,
+                              const expression& e, std::ostream& o) {
+      o << "stan::model::assign_view(" << var_name << ", ";
+      generate_rvalue_view(e, o);
+      o << ", \"assigning variable " << var_name << "\")";
+    }
+
+  }
+}
+#endif
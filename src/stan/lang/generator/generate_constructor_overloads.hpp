@@ -0,0 +1,38 @@
+#ifndef STAN_LANG_GENERATOR_GENERATE_CONSTRUCTOR_OVERLOADS_HPP
+#define STAN_LANG_GENERATOR_GENERATE_CONSTRUCTOR_OVERLOADS_HPP
+
+#include <stan/lang/generator/constants.hpp>
+#include <ostream>
+#include <string>
+
+namespace stan {
+  namespace lang {
+
+    /**
+     * Generate the constructors for the model with the specified
+     * name, which delegate to <code>ctor_body</code>, to the
+     * specified stream.
+     *
+     * @param[in] model_name name of model for class name
+     * @param[in,out] o stream for generating
+     */
+    void generate_constructor_overloads(const std::string& model_name,
+                                        std::ostream& o) {
+      // constructor without seed or template parameter
+      o << INDENT << model_name << "(stan::io::var_context& context__," << EOL;
+      o << INDENT << "    std::ostream* pstream__ = 0)" << EOL;
+      o << INDENT2 << ": prob_grad(0) {" << EOL;
+      o << INDENT2 << "ctor_body(context__, 0, pstream__);" << EOL;
+      o << INDENT << "}" << EOL2;
+      // constructor with specified seed
+      o << INDENT << model_name << "(stan::io::var_context& context__," << EOL;
+      o << INDENT << "    unsigned int random_seed__," << EOL;
+      o << INDENT << "    std::ostream* pstream__ = 0)" << EOL;
+      o << INDENT2 << ": prob_grad(0) {" << EOL;
+      o << INDENT2 << "ctor_body(context__, random_seed__, pstream__);" << EOL;
+      o << INDENT << "}" << EOL2;
+    }
+
+  }
+}
+#endif
@@ -14,6 +14,7 @@
 #include <stan/lang/generator/generate_includes.hpp>
 #include <stan/lang/generator/generate_init_method.hpp>
 #include <stan/lang/generator/generate_log_prob.hpp>
+#include <stan/lang/generator/generate_log_prob_value.hpp>
 #include <stan/lang/generator/generate_member_var_decls_all.hpp>
 #include <stan/lang/generator/generate_model_name_method.hpp>
 #include <stan/lang/generator/generate_model_typedef.hpp>
@@ -68,6 +69,7 @@ namespace stan {
       // generate_set_param_ranges(prog.parameter_decl_, o);
       generate_init_method(prog.parameter_decl_, o);
       generate_log_prob(prog, o);
+      generate_log_prob_value(prog, o);
       generate_param_names_method(prog, o);
       generate_dims_method(prog, o);
       generate_write_array_method(prog, model_name, o);
@@ -0,0 +1,198 @@
+#ifndef STAN_LANG_GENERATOR_GENERATE_CPP_SPLIT_HPP
+#define STAN_LANG_GENERATOR_GENERATE_CPP_SPLIT_HPP
+
+#include <stan/io/program_reader.hpp>
+#include <stan/lang/ast.hpp>
+#include <stan/lang/generator/constants.hpp>
+#include <stan/lang/generator/generate_class_decl.hpp>
+#include <stan/lang/generator/generate_class_decl_end.hpp>
+#include <stan/lang/generator/generate_constrained_param_names_method.hpp>
+#include <stan/lang/generator/generate_constructor_overloads.hpp>
+#include <stan/lang/generator/generate_ctor_body.hpp>
+#include <stan/lang/generator/generate_destructor.hpp>
+#include <stan/lang/generator/generate_dims_method.hpp>
+#include <stan/lang/generator/generate_function.hpp>
+#include <stan/lang/generator/generate_function_functor.hpp>
+#include <stan/lang/generator/generate_globals.hpp>
+#include <stan/lang/generator/generate_includes.hpp>
+#include <stan/lang/generator/generate_init_method.hpp>
+#include <stan/lang/generator/generate_log_prob_impl.hpp>
+#include <stan/lang/generator/generate_log_prob_instantiations.hpp>
+#include <stan/lang/generator/generate_log_prob_value.hpp>
+#include <stan/lang/generator/generate_log_prob_wrappers.hpp>
+#include <stan/lang/generator/generate_member_var_decls_all.hpp>
+#include <stan/lang/generator/generate_model_name_method.hpp>
+#include <stan/lang/generator/generate_model_typedef.hpp>
+#include <stan/lang/generator/generate_namespace_end.hpp>
+#include <stan/lang/generator/generate_namespace_start.hpp>
+#include <stan/lang/generator/generate_param_names_method.hpp>
+#include <stan/lang/generator/generate_private_decl.hpp>
+#include <stan/lang/generator/generate_program_reader_fun.hpp>
+#include <stan/lang/generator/generate_public_decl.hpp>
+#include <stan/lang/generator/generate_split_method_decls.hpp>
+#include <stan/lang/generator/generate_unconstrained_param_names_method.hpp>
+#include <stan/lang/generator/generate_usings.hpp>
+#include <stan/lang/generator/generate_version_comment.hpp>
+#include <stan/lang/generator/generate_write_array_impl.hpp>
+#include <stan/lang/generator/generate_write_array_wrapper.hpp>
+#include <stan/lang/generator/is_template_function.hpp>
+#include <stan/lang/generator/log_prob_value_accum_type.hpp>
+#include <ostream>
+#include <string>
+#include <vector>
+
+namespace stan {
+  namespace lang {
+
+    /**
+     * Generate the C++ code for the specified program split into a
+     * header and separate translation units, so that the expensive
+     * parts of the model can be compiled in parallel.
+     *
+     * <p>The header declares the model class as
+     * <code>generate_cpp</code> does, except that the constructor
+     * body, <code>log_prob_impl__</code> and the
+     * <code>write_array</code> method taking standard vectors are
+     * only declared, as are user-defined functions that are not
+     * templates.  Each translation unit includes the header and
+     * defines one part: the non-template functions and the program
+     * reader; the constructor body; <code>log_prob_impl__</code>
+     * explicitly instantiated for <code>stan::math::var</code>; the
+     * same for <code>double</code>, including the value-only path;
+     * the same for the forward-mode types
+     * <code>stan::math::fvar&lt;stan::math::var&gt;</code> and
+     * <code>stan::math::fvar&lt;double&gt;</code> used for Hessians
+     * and directional derivatives; and <code>write_array</code>
+     * explicitly instantiated for the <code>boost::ecuyer1988</code>
+     * generator used by the services.  Other scalar types, such as
+     * the nested forward-mode types of third-order derivatives,
+     * require the single-file output.
+     *
+     * @param[in] prog program from which to generate
+     * @param[in] model_name name of model for generating namespace
+     *   and class name
+     * @param[in] history I/O include history for text underlying
+     *   program
+     * @param[in] header_name name by which the translation units
+     *   include the header
+     * @param[in,out] header_o stream for the header
+     * @param[in,out] functions_o stream for the functions
+     * @param[in,out] ctor_o stream for the constructor body
+     * @param[in,out] log_prob_var_o stream for the reverse-mode
+     *   log density
+     * @param[in,out] log_prob_double_o stream for the double log
+     *   density
+     * @param[in,out] log_prob_fvar_o stream for the forward-mode log
+     *   density
+     * @param[in,out] write_array_o stream for
+     *   <code>write_array</code>
+     */
+    void generate_cpp_split(const program& prog,
+                            const std::string& model_name,
+                            const std::vector<io::preproc_event>& history,
+                            const std::string& header_name,
+                            std::ostream& header_o,
+                            std::ostream& functions_o,
+                            std::ostream& ctor_o,
+                            std::ostream& log_prob_var_o,
+                            std::ostream& log_prob_double_o,
+                            std::ostream& log_prob_fvar_o,
+                            std::ostream& write_array_o) {
+      std::string scope = model_name + "::";
+      std::vector<std::ostream*> units;
+      units.push_back(&functions_o);
+      units.push_back(&ctor_o);
+      units.push_back(&log_prob_var_o);
+      units.push_back(&log_prob_double_o);
+      units.push_back(&log_prob_fvar_o);
+      units.push_back(&write_array_o);
+      for (size_t i = 0; i < units.size(); ++i) {
+        generate_version_comment(*units[i]);
+        *units[i] << "#include \"" << header_name << "\"" << EOL2;
+        generate_namespace_start(model_name, *units[i]);
+      }
+
+      generate_version_comment(header_o);
+      generate_includes(header_o);
+      generate_namespace_start(model_name, header_o);
+      generate_usings(header_o);
+      generate_globals(header_o);
+      header_o << "stan::io::program_reader prog_reader__();" << EOL2;
+      generate_program_reader_fun(history, functions_o);
+      for (size_t i = 0; i < prog.function_decl_defs_.size(); ++i) {
+        const function_decl_def& fun = prog.function_decl_defs_[i];
+        if (is_template_function(fun) || fun.body_.is_no_op_statement()) {
+          generate_function(fun, header_o);
+        } else {
+          function_decl_def decl(fun);
+          decl.body_ = statement(no_op_statement());
+          generate_function(decl, header_o);
+          generate_function(fun, functions_o);
+        }
+        generate_function_functor(fun, header_o);
+      }
+      generate_class_decl(model_name, header_o);
+      generate_private_decl(header_o);
+      generate_member_var_decls_all(prog, header_o);
+      generate_public_decl(header_o);
+      generate_constructor_overloads(model_name, header_o);
+      generate_split_method_decls(header_o);
+      generate_destructor(model_name, header_o);
+      generate_init_method(prog.parameter_decl_, header_o);
+      generate_log_prob_wrappers(header_o);
+      generate_log_prob_value(prog, header_o);
+      generate_param_names_method(prog, header_o);
+      generate_dims_method(prog, header_o);
+      generate_write_array_wrapper(header_o);
+      generate_model_name_method(model_name, header_o);
+      generate_constrained_param_names_method(prog, header_o);
+      generate_unconstrained_param_names_method(prog, header_o);
+      generate_class_decl_end(header_o);
+      generate_namespace_end(header_o);
+      generate_model_typedef(model_name, header_o);
+
+      generate_ctor_body(prog, model_name, scope, ctor_o);
+
+      generate_log_prob_impl(prog, scope, log_prob_var_o);
+      generate_log_prob_instantiations(model_name, "stan::math::var",
+                                       "stan::math::accumulator<"
+                                       "stan::math::var>",
+                                       log_prob_var_o);
+
+      std::string value_accum_type = log_prob_value_accum_type(prog);
+      generate_log_prob_impl(prog, scope, log_prob_double_o);
+      generate_log_prob_instantiations(model_name, "double",
+                                       "stan::math::accumulator<double>",
+                                       log_prob_double_o);
+      if (value_accum_type != "stan::math::accumulator<double>")
+        generate_log_prob_instantiations(model_name, "double",
+                                         value_accum_type,
+                                         log_prob_double_o);
+
+      generate_log_prob_impl(prog, scope, log_prob_fvar_o);
+      generate_log_prob_instantiations(model_name,
+                                       "stan::math::fvar<stan::math::var>",
+                                       "stan::math::accumulator<"
+                                       "stan::math::fvar<stan::math::var> >",
+                                       log_prob_fvar_o);
+      generate_log_prob_instantiations(model_name,
+                                       "stan::math::fvar<double>",
+                                       "stan::math::accumulator<"
+                                       "stan::math::fvar<double> >",
+                                       log_prob_fvar_o);
+
+      generate_write_array_impl(prog, model_name, scope, write_array_o);
+      write_array_o << "template void " << scope
+                    << "write_array<boost::ecuyer1988>" << EOL;
+      write_array_o << INDENT << "(boost::ecuyer1988&, std::vector<double>&,"
+                    << " std::vector<int>&," << EOL;
+      write_array_o << INDENT << " std::vector<double>&, bool, bool,"
+                    << " std::ostream*) const;" << EOL2;
+
+      for (size_t i = 0; i < units.size(); ++i)
+        generate_namespace_end(*units[i]);
+    }
+
+  }
+}
+#endif
@@ -0,0 +1,34 @@
+#ifndef STAN_LANG_GENERATOR_GENERATE_HOISTED_VAR_DECLS_HPP
+#define STAN_LANG_GENERATOR_GENERATE_HOISTED_VAR_DECLS_HPP
+
+#include <stan/lang/ast.hpp>
+#include <stan/lang/generator/constants.hpp>
+#include <stan/lang/generator/generate_bare_type.hpp>
+#include <stan/lang/generator/generate_indent.hpp>
+#include <ostream>
+#include <vector>
+
+namespace stan {
+  namespace lang {
+
+    /**
+     * Generate member variable declarations for the specified
+     * variables holding hoisted data-only expressions at the
+     * specified indentation level to the specified stream.
+     *
+     * @param[in] vs variables holding hoisted expressions
+     * @param[in] indent indentation level
+     * @param[in,out] o stream for generating
+     */
+    void generate_hoisted_var_decls(const std::vector<variable>& vs,
+                                    int indent, std::ostream& o) {
+      for (size_t i = 0; i < vs.size(); ++i) {
+        generate_indent(indent, o);
+        generate_bare_type(vs[i].type_, "double", o);
+        o << " " << vs[i].name_ << ";" << EOL;
+      }
+    }
+
+  }
+}
+#endif
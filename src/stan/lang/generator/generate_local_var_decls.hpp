@@ -3,6 +3,7 @@
 
 #include <stan/lang/ast.hpp>
 #include <stan/lang/generator/constants.hpp>
+#include <stan/lang/generator/generate_assign_view.hpp>
 #include <stan/lang/generator/generate_indent.hpp>
 #include <stan/lang/generator/init_vars_visgen.hpp>
 #include <stan/lang/generator/local_var_decl_visgen.hpp>
@@ -22,12 +23,20 @@ namespace stan {
      * `current_statement_begin__` to src file line number where
      * variable is declared.
      *
+     * <p>The not-a-number fill is skipped for variables that are
+     * assigned in full before their values can be read, as
+     * determined by <code>is_assigned_before_use</code>; the fill is
+     * still generated for those variables, but only compiled when
+     * <code>STAN_DEBUG_INIT_LOCALS</code> is defined.
+     *
      * @param[in] vs variable declarations
+     * @param[in] stmts statements following the declarations
      * @param[in] indent indentation level
      * @param[in,out] o stream for generating
      */
-    void generate_local_var_decls(const std::vector<var_decl>& vs, int indent,
-                                  std::ostream& o) {
+    void generate_local_var_decls(const std::vector<var_decl>& vs,
+                                  const std::vector<statement>& stmts,
+                                  int indent, std::ostream& o) {
       local_var_decl_visgen vis_decl(indent, o);
       local_var_init_nan_visgen vis_init(indent, o);
       init_vars_visgen vis_filler(indent, o);
@@ -36,9 +45,18 @@ namespace stan {
         o << "current_statement_begin__ = " <<  vs[i].begin_line_ << ";"
           << EOL;
         boost::apply_visitor(vis_decl, vs[i].decl_);
+        bool assigned = is_assigned_before_use(vs, i, stmts);
+        if (assigned)
+          o << "#ifdef STAN_DEBUG_INIT_LOCALS" << EOL;
         boost::apply_visitor(vis_init, vs[i].decl_);
         boost::apply_visitor(vis_filler, vs[i].decl_);
-        if (vs[i].has_def()) {
+        if (assigned)
+          o << "#endif" << EOL;
+        if (vs[i].has_def() && is_assign_view(vs[i].name(), vs[i].def())) {
+          generate_indent(indent, o);
+          generate_assign_view(vs[i].name(), vs[i].def(), o);
+          o << ";" << EOL;
+        } else if (vs[i].has_def()) {
           generate_indent(indent, o);
           o << "stan::math::assign("
             << vs[i].name()
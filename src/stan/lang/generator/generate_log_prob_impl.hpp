@@ -0,0 +1,103 @@
+#ifndef STAN_LANG_GENERATOR_GENERATE_LOG_PROB_IMPL_HPP
+#define STAN_LANG_GENERATOR_GENERATE_LOG_PROB_IMPL_HPP
+
+#include <stan/lang/ast.hpp>
+#include <stan/lang/generator/constants.hpp>
+#include <stan/lang/generator/generate_catch_throw_located.hpp>
+#include <stan/lang/generator/generate_comment.hpp>
+#include <stan/lang/generator/generate_local_var_decls.hpp>
+#include <stan/lang/generator/generate_local_var_inits.hpp>
+#include <stan/lang/generator/generate_statement.hpp>
+#include <stan/lang/generator/generate_statements.hpp>
+#include <stan/lang/generator/generate_try.hpp>
+#include <stan/lang/generator/generate_validate_transformed_params.hpp>
+#include <stan/lang/generator/generate_validate_var_decls.hpp>
+#include <ostream>
+#include <string>
+
+namespace stan {
+  namespace lang {
+
+    /**
+     * Generate the definition of the <code>log_prob_impl__</code>
+     * method, which holds the body of the log density, for the
+     * specified program on the specified stream.  The method is
+     * templated on the type of the log density accumulator so that
+     * <code>log_prob</code> and <code>log_prob_value</code> can share
+     * it.  The scope qualifies the method name; it is empty for a
+     * definition inside the class body and the class name followed by
+     * <code>::</code> for a definition outside it.
+     *
+     * @param p program
+     * @param scope qualification of the method name
+     * @param o stream for generating
+     */
+    void generate_log_prob_impl(const program& p, const std::string& scope,
+                                std::ostream& o) {
+      o << INDENT << "template <bool propto__, bool jacobian__, typename T__,"
+        << EOL;
+      o << INDENT << "          typename T_lp_accum__>"
+        << EOL;
+      o << INDENT << "T__ " << scope
+        << "log_prob_impl__(vector<T__>& params_r__," << EOL;
+      o << INDENT << "                    vector<int>& params_i__,"
+        << EOL;
+      o << INDENT << "                    std::ostream* pstream__) const {"
+        << EOL2;
+      o << INDENT2 << "typedef T__ local_scalar_t__;" << EOL2;
+
+      // use this dummy for inits
+      o << INDENT2
+        << "local_scalar_t__ DUMMY_VAR__"
+        << "(std::numeric_limits<double>::quiet_NaN());"
+        << EOL;
+      o << INDENT2 << "(void) DUMMY_VAR__;  // suppress unused var warning"
+        << EOL2;
+
+      o << INDENT2 << "T__ lp__(0.0);"
+        << EOL;
+      o << INDENT2 << "T_lp_accum__ lp_accum__;"
+        << EOL2;
+
+      bool gen_local_vars = true;
+
+      generate_try(2, o);
+
+      generate_comment("model parameters", 3, o);
+      generate_local_var_inits(p.parameter_decl_, gen_local_vars, 3, o);
+      o << EOL;
+
+      generate_comment("transformed parameters", 3, o);
+      generate_local_var_decls(p.derived_decl_.first, p.derived_decl_.second,
+                               3, o);
+      o << EOL;
+
+      generate_statements(p.derived_decl_.second, 3, o);
+      o << EOL;
+
+      generate_validate_transformed_params(p.derived_decl_.first, 3, o);
+      o << INDENT3
+        << "const char* function__ = \"validate transformed params\";"
+        << EOL;
+      o << INDENT3
+        << "(void) function__;  // dummy to suppress unused var warning"
+        << EOL;
+
+      generate_validate_var_decls(p.derived_decl_.first, 3, o);
+
+      o << EOL;
+      generate_comment("model body", 3, o);
+
+      generate_statement(p.statement_, 3, o);
+      o << EOL;
+      generate_catch_throw_located(2, o);
+
+      o << EOL;
+      o << INDENT2 << "lp_accum__.add(lp__);" << EOL;
+      o << INDENT2 << "return lp_accum__.sum();" << EOL2;
+      o << INDENT << "} // log_prob_impl__()" << EOL2;
+    }
+
+  }
+}
+#endif
@@ -0,0 +1,43 @@
+#ifndef STAN_LANG_GENERATOR_GENERATE_LOG_PROB_INSTANTIATIONS_HPP
+#define STAN_LANG_GENERATOR_GENERATE_LOG_PROB_INSTANTIATIONS_HPP
+
+#include <stan/lang/generator/constants.hpp>
+#include <ostream>
+#include <string>
+
+namespace stan {
+  namespace lang {
+
+    /**
+     * Generate explicit instantiations of <code>log_prob_impl__</code>
+     * of the model with the specified name for every combination of
+     * the <code>propto__</code> and <code>jacobian__</code> flags,
+     * with the specified scalar and accumulator types, on the
+     * specified stream.
+     *
+     * @param[in] model_name name of model
+     * @param[in] scalar_type scalar type of parameters
+     * @param[in] accum_type type of log density accumulator
+     * @param[in,out] o stream for generating
+     */
+    void generate_log_prob_instantiations(const std::string& model_name,
+                                          const std::string& scalar_type,
+                                          const std::string& accum_type,
+                                          std::ostream& o) {
+      const char* flags[] = { "false", "true" };
+      for (int propto = 0; propto < 2; ++propto) {
+        for (int jacobian = 0; jacobian < 2; ++jacobian) {
+          o << "template " << scalar_type << " " << model_name
+            << "::log_prob_impl__<" << flags[propto] << ", "
+            << flags[jacobian] << ", " << scalar_type << ", "
+            << accum_type << " >" << EOL;
+          o << INDENT << "(std::vector<" << scalar_type << " >&, "
+            << "std::vector<int>&, std::ostream*) const;" << EOL;
+        }
+      }
+      o << EOL;
+    }
+
+  }
+}
+#endif
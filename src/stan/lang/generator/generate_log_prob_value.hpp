@@ -0,0 +1,70 @@
+#ifndef STAN_LANG_GENERATOR_GENERATE_LOG_PROB_VALUE_HPP
+#define STAN_LANG_GENERATOR_GENERATE_LOG_PROB_VALUE_HPP
+
+#include <stan/lang/ast.hpp>
+#include <stan/lang/generator/constants.hpp>
+#include <stan/lang/generator/log_prob_value_accum_type.hpp>
+#include <ostream>
+#include <string>
+
+namespace stan {
+  namespace lang {
+
+    /**
+     * Generate the value-only log_prob_value method for the model
+     * class for the specified program on the specified stream,
+     * along with the flag advertising it to
+     * <code>stan::model::log_prob_value</code>.
+     *
+     * <p>The method instantiates the shared body
+     * <code>log_prob_impl__</code> with <code>double</code> scalars
+     * only, so terms dropped under <code>propto__</code> are elided
+     * at compile time, the grouped checks for undefined transformed
+     * parameters are skipped (see
+     * <code>generate_validate_transformed_params</code>), and it
+     * accumulates into a running sum rather than a buffer of terms
+     * where possible; see <code>log_prob_value_accum_type</code>.
+     *
+     * @param p program
+     * @param o stream for generating
+     */
+    void generate_log_prob_value(const program& p, std::ostream& o) {
+      std::string accum_type = log_prob_value_accum_type(p);
+
+      o << INDENT << "static const bool has_log_prob_value__ = true;" << EOL2;
+
+      o << INDENT << "template <bool propto__, bool jacobian__>" << EOL;
+      o << INDENT << "double log_prob_value(vector<double>& params_r__,"
+        << EOL;
+      o << INDENT << "                      vector<int>& params_i__,"
+        << EOL;
+      o << INDENT
+        << "                      std::ostream* pstream__ = 0) const {"
+        << EOL;
+      o << INDENT2 << "return log_prob_impl__<propto__, jacobian__, double,"
+        << EOL;
+      o << INDENT2 << "                       " << accum_type << " >"
+        << EOL;
+      o << INDENT2 << "  (params_r__, params_i__, pstream__);" << EOL;
+      o << INDENT << "} // log_prob_value()" << EOL2;
+
+      o << INDENT << "template <bool propto, bool jacobian>" << EOL;
+      o << INDENT
+        << "double log_prob_value(Eigen::Matrix<double,Eigen::Dynamic,1>&"
+        << " params_r," << EOL;
+      o << INDENT << "                      std::ostream* pstream = 0) const {"
+        << EOL;
+      o << INDENT << "  std::vector<double> vec_params_r;" << EOL;
+      o << INDENT << "  vec_params_r.reserve(params_r.size());" << EOL;
+      o << INDENT << "  for (int i = 0; i < params_r.size(); ++i)" << EOL;
+      o << INDENT << "    vec_params_r.push_back(params_r(i));" << EOL;
+      o << INDENT << "  std::vector<int> vec_params_i;" << EOL;
+      o << INDENT
+        << "  return log_prob_value<propto,jacobian>(vec_params_r, "
+        << "vec_params_i, pstream);" << EOL;
+      o << INDENT << "}" << EOL2;
+    }
+
+  }
+}
+#endif
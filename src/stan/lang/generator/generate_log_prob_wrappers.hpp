@@ -0,0 +1,51 @@
+#ifndef STAN_LANG_GENERATOR_GENERATE_LOG_PROB_WRAPPERS_HPP
+#define STAN_LANG_GENERATOR_GENERATE_LOG_PROB_WRAPPERS_HPP
+
+#include <stan/lang/generator/constants.hpp>
+#include <ostream>
+
+namespace stan {
+  namespace lang {
+
+    /**
+     * Generate the <code>log_prob</code> methods of the model class,
+     * which forward to <code>log_prob_impl__</code>, on the specified
+     * stream.
+     *
+     * @param o stream for generating
+     */
+    void generate_log_prob_wrappers(std::ostream& o) {
+      o << INDENT << "template <bool propto__, bool jacobian__, typename T__>"
+        << EOL;
+      o << INDENT << "T__ log_prob(vector<T__>& params_r__,"
+        << EOL;
+      o << INDENT << "             vector<int>& params_i__,"
+        << EOL;
+      o << INDENT << "             std::ostream* pstream__ = 0) const {"
+        << EOL;
+      o << INDENT2 << "return log_prob_impl__<propto__, jacobian__, T__,"
+        << EOL;
+      o << INDENT2 << "                       stan::math::accumulator<T__> >"
+        << EOL;
+      o << INDENT2 << "  (params_r__, params_i__, pstream__);" << EOL;
+      o << INDENT << "} // log_prob()" << EOL2;
+
+      o << INDENT
+        << "template <bool propto, bool jacobian, typename T_>" << EOL;
+      o << INDENT
+        << "T_ log_prob(Eigen::Matrix<T_,Eigen::Dynamic,1>& params_r," << EOL;
+      o << INDENT << "           std::ostream* pstream = 0) const {" << EOL;
+      o << INDENT << "  std::vector<T_> vec_params_r;" << EOL;
+      o << INDENT << "  vec_params_r.reserve(params_r.size());" << EOL;
+      o << INDENT << "  for (int i = 0; i < params_r.size(); ++i)" << EOL;
+      o << INDENT << "    vec_params_r.push_back(params_r(i));" << EOL;
+      o << INDENT << "  std::vector<int> vec_params_i;" << EOL;
+      o << INDENT
+        << "  return log_prob<propto,jacobian,T_>(vec_params_r, "
+        << "vec_params_i, pstream);" << EOL;
+      o << INDENT << "}" << EOL2;
+    }
+
+  }
+}
+#endif
@@ -2,6 +2,7 @@
 #define STAN_LANG_GENERATOR_GENERATE_MEMBER_VAR_DECLS_ALL_HPP
 
 #include <stan/lang/ast.hpp>
+#include <stan/lang/generator/generate_hoisted_var_decls.hpp>
 #include <stan/lang/generator/generate_member_var_decls.hpp>
 #include <ostream>
 
@@ -10,8 +11,9 @@ namespace stan {
 
     /**
      * Generate member variable declarations for the data and
-     * transformed data blocks for the specified program, writing to
-     * the specified stream.
+     * transformed data blocks and for the hoisted model block
+     * expressions for the specified program, writing to the specified
+     * stream.
      *
      * @param[in] prog program from which to generate
      * @param[in,out] o stream for generating
@@ -20,6 +22,7 @@ namespace stan {
                                        std::ostream& o) {
       generate_member_var_decls(prog.data_decl_, 1, o);
       generate_member_var_decls(prog.derived_data_decl_.first, 1, o);
+      generate_hoisted_var_decls(prog.hoisted_decl_.first, 1, o);
     }
 
   }
@@ -0,0 +1,37 @@
+#ifndef STAN_LANG_GENERATOR_GENERATE_RVALUE_VIEW_HPP
+#define STAN_LANG_GENERATOR_GENERATE_RVALUE_VIEW_HPP
+
+#include <stan/lang/ast.hpp>
+#include <stan/lang/generator/constants.hpp>
+#include <stan/lang/generator/generate_expression.hpp>
+#include <stan/lang/generator/generate_idxs.hpp>
+#include <boost/variant/get.hpp>
+#include <ostream>
+
+namespace stan {
+  namespace lang {
+
+    /**
+     * Generate a call to <code>stan::model::rvalue_view()</code> for
+     * the specified indexed expression, which must satisfy
+     * <code>is_rvalue_view()</code>.
+     *
+     * @param[in] e sliced variable expression
+     * @param[in,out] o stream for generating
+     */
+    void generate_rvalue_view(const expression& e, std::ostream& o) {
+      const index_op_sliced& x = boost::get<index_op_sliced>(e.expr_);
+      o << "stan::model::rvalue_view(";
+      generate_expression(x.expr_, NOT_USER_FACING, o);
+      o << ", ";
+      generate_idxs(x.idxs_, o);
+      o << ", ";
+      o << '"';
+      generate_expression(x.expr_, USER_FACING, o);
+      o << '"';
+      o << ")";
+    }
+
+  }
+}
+#endif
@@ -0,0 +1,44 @@
+#ifndef STAN_LANG_GENERATOR_GENERATE_SPLIT_METHOD_DECLS_HPP
+#define STAN_LANG_GENERATOR_GENERATE_SPLIT_METHOD_DECLS_HPP
+
+#include <stan/lang/generator/constants.hpp>
+#include <ostream>
+
+namespace stan {
+  namespace lang {
+
+    /**
+     * Generate declarations of the model class methods whose
+     * definitions are written to separate translation units by
+     * <code>generate_cpp_split</code>, on the specified stream.
+     *
+     * @param[in,out] o stream for generating
+     */
+    void generate_split_method_decls(std::ostream& o) {
+      o << INDENT << "void ctor_body(stan::io::var_context& context__,"
+        << EOL;
+      o << INDENT << "               unsigned int random_seed__," << EOL;
+      o << INDENT << "               std::ostream* pstream__);" << EOL2;
+
+      o << INDENT << "template <bool propto__, bool jacobian__, typename T__,"
+        << EOL;
+      o << INDENT << "          typename T_lp_accum__>" << EOL;
+      o << INDENT << "T__ log_prob_impl__(vector<T__>& params_r__," << EOL;
+      o << INDENT << "                    vector<int>& params_i__," << EOL;
+      o << INDENT << "                    std::ostream* pstream__) const;"
+        << EOL2;
+
+      o << INDENT << "template <typename RNG>" << EOL;
+      o << INDENT << "void write_array(RNG& base_rng__," << EOL;
+      o << INDENT << "                 std::vector<double>& params_r__," << EOL;
+      o << INDENT << "                 std::vector<int>& params_i__," << EOL;
+      o << INDENT << "                 std::vector<double>& vars__," << EOL;
+      o << INDENT << "                 bool include_tparams__ = true," << EOL;
+      o << INDENT << "                 bool include_gqs__ = true," << EOL;
+      o << INDENT << "                 std::ostream* pstream__ = 0) const;"
+        << EOL2;
+    }
+
+  }
+}
+#endif
@@ -4,6 +4,7 @@
 #include <stan/lang/ast.hpp>
 #include <stan/lang/generator/constants.hpp>
 #include <stan/lang/generator/generate_comment.hpp>
+#include <stan/lang/generator/generate_indent.hpp>
 #include <stan/lang/generator/validate_transformed_params_visgen.hpp>
 #include <boost/variant/apply_visitor.hpp>
 #include <ostream>
@@ -17,6 +18,12 @@ namespace stan {
      * generating at the specified indentation level to the specified
      * stream.
      *
+     * <p>The checks for undefined values are grouped in a single
+     * block that is skipped when the local scalar type is
+     * <code>double</code>, which has no undefined state, so the
+     * value-only <code>log_prob_value</code> instantiation does not
+     * loop over the elements of the transformed parameters.
+     *
      * @param[in] vs variable declarations
      * @param[in] indent indentation level
      * @param[in,out] o stream for generating
@@ -24,9 +31,16 @@ namespace stan {
     void generate_validate_transformed_params(const std::vector<var_decl>& vs,
                                               int indent, std::ostream& o) {
       generate_comment("validate transformed parameters", indent, o);
-      validate_transformed_params_visgen vis(indent, o);
-      for (size_t i = 0; i < vs.size(); ++i)
-        boost::apply_visitor(vis, vs[i].decl_);
+      if (!vs.empty()) {
+        generate_indent(indent, o);
+        o << "if (!boost::is_same<local_scalar_t__, double>::value) {"
+          << EOL;
+        validate_transformed_params_visgen vis(indent + 1, o);
+        for (size_t i = 0; i < vs.size(); ++i)
+          boost::apply_visitor(vis, vs[i].decl_);
+        generate_indent(indent, o);
+        o << "}" << EOL;
+      }
       o << EOL;
     }
 
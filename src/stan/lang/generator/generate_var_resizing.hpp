@@ -3,6 +3,7 @@
 
 #include <stan/lang/ast.hpp>
 #include <stan/lang/generator/constants.hpp>
+#include <stan/lang/generator/generate_assign_view.hpp>
 #include <stan/lang/generator/init_vars_visgen.hpp>
 #include <stan/lang/generator/generate_indent.hpp>
 #include <stan/lang/generator/var_resizing_visgen.hpp>
@@ -35,7 +36,11 @@ namespace stan {
           << EOL;
         boost::apply_visitor(vis_resizer, vs[i].decl_);
         boost::apply_visitor(vis_filler, vs[i].decl_);
-        if (vs[i].has_def()) {
+        if (vs[i].has_def() && is_assign_view(vs[i].name(), vs[i].def())) {
+          generate_indent(indent, o);
+          generate_assign_view(vs[i].name(), vs[i].def(), o);
+          o << ";" << EOL;
+        } else if (vs[i].has_def()) {
           generate_indent(indent, o);
           o << "stan::math::assign(" << vs[i].name() << ",";
           generate_expression(vs[i].def(), NOT_USER_FACING, o);
@@ -0,0 +1,51 @@
+#ifndef STAN_LANG_GENERATOR_IS_RVALUE_VIEW_HPP
+#define STAN_LANG_GENERATOR_IS_RVALUE_VIEW_HPP
+
+#include <stan/lang/ast.hpp>
+#include <boost/variant/get.hpp>
+#include <vector>
+
+namespace stan {
+  namespace lang {
+
+    /**
+     * Return true if the specified expression can be generated as a
+     * call to <code>stan::model::rvalue_view()</code>, which returns
+     * a view of its argument rather than a copy.  This is the case
+     * for a vector, row vector or matrix variable indexed by one or
+     * two indexes that are single or contiguous (omni, lower bound,
+     * upper bound or range) and select more than a single element.
+     *
+     * @param e expression to test
+     * @return true if expression is a view-able slice of a variable
+     */
+    bool is_rvalue_view(const expression& e) {
+      const index_op_sliced* x = boost::get<index_op_sliced>(&e.expr_);
+      if (!x || !boost::get<variable>(&x->expr_.expr_))
+        return false;
+      expr_type type = x->expr_.expression_type();
+      if (type.num_dims_ != 0)
+        return false;
+      size_t max_idxs;
+      if (type.base_type_.is_vector_type()
+          || type.base_type_.is_row_vector_type())
+        max_idxs = 1;
+      else if (type.base_type_.is_matrix_type())
+        max_idxs = 2;
+      else
+        return false;
+      if (x->idxs_.size() == 0 || x->idxs_.size() > max_idxs)
+        return false;
+      size_t num_uni = 0;
+      for (size_t i = 0; i < x->idxs_.size(); ++i) {
+        if (boost::get<multi_idx>(&x->idxs_[i].idx_))
+          return false;
+        if (boost::get<uni_idx>(&x->idxs_[i].idx_))
+          ++num_uni;
+      }
+      return num_uni < max_idxs;
+    }
+
+  }
+}
+#endif
@@ -0,0 +1,31 @@
+#ifndef STAN_LANG_GENERATOR_IS_TEMPLATE_FUNCTION_HPP
+#define STAN_LANG_GENERATOR_IS_TEMPLATE_FUNCTION_HPP
+
+#include <stan/lang/ast.hpp>
+#include <stan/lang/generator/has_only_int_args.hpp>
+
+namespace stan {
+  namespace lang {
+
+    /**
+     * Return true if the C++ function generated for the specified
+     * function declaration is a template.  Only functions with
+     * integer arguments that are not random number generators, do
+     * not access the log density and are not probability functions
+     * are generated as plain functions.
+     *
+     * @param[in] fun function declaration
+     * @return true if the generated function is a template
+     */
+    bool is_template_function(const function_decl_def& fun) {
+      return !has_only_int_args(fun)
+        || ends_with("_rng", fun.name_)
+        || ends_with("_lp", fun.name_)
+        || ends_with("_log", fun.name_)
+        || ends_with("_lpdf", fun.name_)
+        || ends_with("_lpmf", fun.name_);
+    }
+
+  }
+}
+#endif
@@ -0,0 +1,30 @@
+#ifndef STAN_LANG_GENERATOR_LOG_PROB_VALUE_ACCUM_TYPE_HPP
+#define STAN_LANG_GENERATOR_LOG_PROB_VALUE_ACCUM_TYPE_HPP
+
+#include <stan/lang/ast.hpp>
+#include <string>
+
+namespace stan {
+  namespace lang {
+
+    /**
+     * Return the type of log density accumulator used by the
+     * value-only <code>log_prob_value</code> method of the model
+     * generated for the specified program.  This is the running sum
+     * <code>stan::model::value_accumulator</code> unless the program
+     * defines <code>_lp</code> functions, which may require the
+     * accumulator type of <code>log_prob</code>.
+     *
+     * @param[in] p program
+     * @return accumulator type
+     */
+    std::string log_prob_value_accum_type(const program& p) {
+      for (size_t i = 0; i < p.function_decl_defs_.size(); ++i)
+        if (has_lp_suffix(p.function_decl_defs_[i].name_))
+          return "stan::math::accumulator<double>";
+      return "stan::model::value_accumulator";
+    }
+
+  }
+}
+#endif
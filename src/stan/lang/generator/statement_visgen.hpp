@@ -3,6 +3,7 @@
 
 #include <stan/lang/ast.hpp>
 #include <stan/lang/generator/constants.hpp>
+#include <stan/lang/generator/generate_assign_view.hpp>
 #include <stan/lang/generator/generate_indent.hpp>
 #include <stan/lang/generator/generate_indexed_expr.hpp>
 #include <stan/lang/generator/generate_local_var_decls.hpp>
@@ -170,6 +171,12 @@ namespace stan {
 
       void operator()(const assignment& x) const {
         generate_indent(indent_, o_);
+        if (x.var_dims_.dims_.empty()
+            && is_assign_view(x.var_dims_.name_, x.expr_)) {
+          generate_assign_view(x.var_dims_.name_, x.expr_, o_);
+          o_ << ";" << EOL;
+          return;
+        }
         o_ << "stan::math::assign(";
         generate_indexed_expr<true>(x.var_dims_.name_,
                                     x.var_dims_.dims_,
@@ -274,7 +281,8 @@ namespace stan {
         if (has_local_vars) {
           generate_indent(indent_, o_);
           o_ << "{" << EOL;
-          generate_local_var_decls(x.local_decl_, indent_, o_);
+          generate_local_var_decls(x.local_decl_, x.statements_, indent_,
+                                 o_);
         }
         o_ << EOL;
         for (size_t i = 0; i < x.statements_.size(); ++i) {
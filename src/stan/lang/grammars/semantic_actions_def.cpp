@@ -251,6 +251,8 @@ namespace stan {
     template void assign_lhs::operator()(expression&,
                                          const algebra_solver_control&)
       const;
+    template void assign_lhs::operator()(expression&, const reduce_sum&)
+      const;
     template void assign_lhs::operator()(array_expr&,
                                          const array_expr&) const;
     template void assign_lhs::operator()(matrix_expr&,
@@ -1943,6 +1945,87 @@ namespace stan {
     boost::phoenix::function<validate_algebra_solver_control>
     validate_algebra_solver_control_f;
 
+    void validate_reduce_sum::operator()(const reduce_sum& red_fun,
+                                         const variable_map& var_map,
+                                         bool& pass,
+                                         std::ostream& error_msgs) const {
+      pass = true;
+      // test function argument type
+      expr_type sum_result_type(double_type(), 0);
+      std::vector<function_arg_type> sum_arg_types;
+      sum_arg_types.push_back(function_arg_type(expr_type(int_type(),
+                                                          0)));  // start
+      sum_arg_types.push_back(function_arg_type(expr_type(int_type(),
+                                                          0)));  // end
+      sum_arg_types.push_back(function_arg_type(expr_type(vector_type(),
+                                                          0)));  // theta
+      sum_arg_types.push_back(function_arg_type(expr_type(double_type(),
+                                                          1), true));  // x_r
+      sum_arg_types.push_back(function_arg_type(expr_type(int_type(),
+                                                          1)));  // x_i
+      function_signature_t sum_signature(sum_result_type, sum_arg_types);
+      if (!function_signatures::instance()
+          .is_defined(red_fun.partial_sum_function_name_, sum_signature)) {
+        error_msgs << "first argument to reduce_sum"
+                   << " must be the name of a function with signature"
+                   << " (int, int, vector, real[], int[]) : real "
+                   << std::endl;
+        pass = false;
+      }
+
+      // test regular argument types
+      if (red_fun.n_.expression_type() != expr_type(int_type(), 0)) {
+        error_msgs << "second argument to reduce_sum"
+                   << " must have type int for number of terms;"
+                   << " found type = "
+                   << red_fun.n_.expression_type()
+                   << ". " << std::endl;
+        pass = false;
+      }
+      if (red_fun.grainsize_.expression_type() != expr_type(int_type(), 0)) {
+        error_msgs << "third argument to reduce_sum"
+                   << " must have type int for grainsize;"
+                   << " found type = "
+                   << red_fun.grainsize_.expression_type()
+                   << ". " << std::endl;
+        pass = false;
+      }
+      if (red_fun.theta_.expression_type() != expr_type(vector_type(), 0)) {
+        error_msgs << "fourth argument to reduce_sum"
+                   << " must have type vector for parameters;"
+                   << " found type = "
+                   << red_fun.theta_.expression_type()
+                   << ". " << std::endl;
+        pass = false;
+      }
+      if (red_fun.x_r_.expression_type() != expr_type(double_type(), 1)) {
+        error_msgs << "fifth argument to reduce_sum"
+                   << " must have type real[] for real data;"
+                   << " found type = "
+                   << red_fun.x_r_.expression_type()
+                   << ". " << std::endl;
+        pass = false;
+      }
+      if (red_fun.x_i_.expression_type() != expr_type(int_type(), 1)) {
+        error_msgs << "sixth argument to reduce_sum"
+                   << " must have type int[] for integer data;"
+                   << " found type = "
+                   << red_fun.x_i_.expression_type()
+                   << ". " << std::endl;
+        pass = false;
+      }
+
+      // test data-only variables do not have parameters (int locals OK)
+      if (has_var(red_fun.x_r_, var_map)) {
+        error_msgs << "fifth argument to reduce_sum"
+                   << " (real data)"
+                   << " must be data only and not reference parameters"
+                   << std::endl;
+        pass = false;
+      }
+    }
+    boost::phoenix::function<validate_reduce_sum> validate_reduce_sum_f;
+
 
     void set_fun_type_named::operator()(expression& fun_result, fun& fun,
                                         const scope& var_scope,
@@ -2655,6 +2738,12 @@ namespace stan {
       const {
       return boost::apply_visitor(*this, x.theta_.expr_);
     }
+    bool data_only_expression::operator()(const reduce_sum& x) const {
+      return boost::apply_visitor(*this, x.n_.expr_)
+        && boost::apply_visitor(*this, x.grainsize_.expr_)
+        && boost::apply_visitor(*this, x.theta_.expr_)
+        && boost::apply_visitor(*this, x.x_i_.expr_);
+    }
     bool data_only_expression::operator()(const fun& x) const {
       for (size_t i = 0; i < x.args_.size(); ++i)
         if (!boost::apply_visitor(*this, x.args_[i].expr_))
@@ -2810,6 +2899,7 @@ namespace stan {
       reserve("corr_matrix");
 
       reserve("target");
+      reserve("reduce_sum");
 
       reserve("model");
       reserve("data");
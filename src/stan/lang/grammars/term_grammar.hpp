@@ -105,6 +105,11 @@ namespace stan {
                               whitespace_grammar<Iterator> >
       algebra_solver_control_r;
 
+      boost::spirit::qi::rule<Iterator,
+                              reduce_sum(scope),
+                              whitespace_grammar<Iterator> >
+      reduce_sum_r;
+
       boost::spirit::qi::rule<Iterator,
                               std::string(),
                               whitespace_grammar<Iterator> >
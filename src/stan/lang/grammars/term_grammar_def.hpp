@@ -62,6 +62,14 @@ BOOST_FUSION_ADAPT_STRUCT(stan::lang::algebra_solver_control,
                            (stan::lang::expression, fun_tol_)
                            (stan::lang::expression, max_num_steps_) )
 
+BOOST_FUSION_ADAPT_STRUCT(stan::lang::reduce_sum,
+                           (std::string, partial_sum_function_name_)
+                           (stan::lang::expression, n_)
+                           (stan::lang::expression, grainsize_)
+                           (stan::lang::expression, theta_)
+                           (stan::lang::expression, x_r_)
+                           (stan::lang::expression, x_i_) )
+
 BOOST_FUSION_ADAPT_STRUCT(stan::lang::fun,
                           (std::string, name_)
                           (std::vector<stan::lang::expression>, args_) )
@@ -262,12 +270,32 @@ namespace stan {
           [validate_algebra_solver_f(_val, boost::phoenix::ref(var_map_),
                                      _pass, boost::phoenix::ref(error_msgs_))];
 
+      reduce_sum_r.name("expression");
+      reduce_sum_r
+        %= (lit("reduce_sum") >> no_skip[!char_("a-zA-Z0-9_")])
+        > lit('(')
+        > identifier_r          // 1) partial sum function name
+        > lit(',')
+        > expression_g(_r1)     // 2) N (data only)
+        > lit(',')
+        > expression_g(_r1)     // 3) grainsize (data only)
+        > lit(',')
+        > expression_g(_r1)     // 4) theta
+        > lit(',')
+        > expression_g(_r1)     // 5) x_r (data only)
+        > lit(',')
+        > expression_g(_r1)     // 6) x_i (data only)
+        > lit(')')
+          [validate_reduce_sum_f(_val, boost::phoenix::ref(var_map_),
+                                 _pass, boost::phoenix::ref(error_msgs_))];
+
       factor_r.name("expression");
       factor_r =
         integrate_ode_control_r(_r1)[assign_lhs_f(_val, _1)]
         | integrate_ode_r(_r1)[assign_lhs_f(_val, _1)]
         | algebra_solver_control_r(_r1)[assign_lhs_f(_val, _1)]
         | algebra_solver_r(_r1)[assign_lhs_f(_val, _1)]
+        | reduce_sum_r(_r1)[assign_lhs_f(_val, _1)]
         | (fun_r(_r1)[assign_lhs_f(_b, _1)]
            > eps[set_fun_type_named_f(_val, _b, _r1, _pass,
                                       boost::phoenix::ref(var_map_),
@@ -0,0 +1,173 @@
+#ifndef STAN_MCMC_AUTOCOVARIANCE_FFT_HPP
+#define STAN_MCMC_AUTOCOVARIANCE_FFT_HPP
+
+#include <stan/math/prim/mat.hpp>
+#include <stan/services/util/parallel_for.hpp>
+#include <Eigen/Dense>
+#include <unsupported/Eigen/FFT>
+#include <algorithm>
+#include <complex>
+#include <cstddef>
+#include <vector>
+
+namespace stan {
+  namespace mcmc {
+
+    /**
+     * Computes autocovariances of many series of the same length
+     * with one FFT plan and one set of buffers.
+     *
+     * <p>The estimates match <code>stan::math::autocovariance</code>:
+     * the series is centered, padded with zeros to twice the next
+     * FFT-friendly length and the autocovariance at lag
+     * <code>k</code> is the sum of lagged products divided by
+     * <code>N - k</code>.  Unlike that function, the series is read
+     * in place, only the half spectrum of the real signal is
+     * transformed, and the padded length, plan and buffers are set
+     * up once for the first series of each length rather than on
+     * every call.
+     *
+     * <p>An object may not be used concurrently by several threads;
+     * each thread should use its own.
+     */
+    class autocovariance_fft {
+    private:
+      typedef Eigen::FFT<double> fft_t;
+
+      fft_t fft_;
+      int n_;
+      int padded_size_;
+      std::vector<double> signal_;
+      std::vector<std::complex<double> > spectrum_;
+
+      void resize(int n) {
+        n_ = n;
+        padded_size_ = 2 * stan::math::fft_next_good_size(n);
+        signal_.assign(padded_size_, 0.0);
+        spectrum_.resize(padded_size_ / 2 + 1);
+      }
+
+    public:
+      autocovariance_fft() : n_(0), padded_size_(0) {
+        fft_.SetFlag(fft_t::HalfSpectrum);
+        fft_.SetFlag(fft_t::Unscaled);
+      }
+
+      /**
+       * Write the autocovariances of the specified series at lags
+       * <code>0</code> to <code>N - 1</code> into the specified
+       * vector, resizing it to the length <code>N</code> of the
+       * series.
+       *
+       * @param[in] x Series, of length at least 2.
+       * @param[out] acov Autocovariances.
+       */
+      void operator()(const Eigen::Ref<const Eigen::VectorXd>& x,
+                      Eigen::VectorXd& acov) {
+        int n = x.size();
+        if (n != n_)
+          resize(n);
+        double mean = x.mean();
+        for (int i = 0; i < n; ++i)
+          signal_[i] = x(i) - mean;
+        fft_.fwd(&spectrum_[0], &signal_[0], padded_size_);
+        for (size_t i = 0; i < spectrum_.size(); ++i)
+          spectrum_[i] = std::norm(spectrum_[i]);
+        fft_.inv(&signal_[0], &spectrum_[0], padded_size_);
+
+        // the inverse is unscaled, so divide by the padded size too
+        double scale = 1.0 / padded_size_;
+        acov.resize(n);
+        for (int k = 0; k < n; ++k)
+          acov(k) = signal_[k] * scale / (n - k);
+        // restore the zero padding the inverse overwrote
+        for (int i = n; i < padded_size_; ++i)
+          signal_[i] = 0;
+      }
+    };
+
+    /**
+     * Functor computing the autocovariances of a contiguous block of
+     * the selected columns of a matrix, with one
+     * <code>autocovariance_fft</code> for the block.
+     */
+    class autocovariance_block_functor {
+    private:
+      const Eigen::Ref<const Eigen::MatrixXd>& x_;
+      const std::vector<int>& cols_;
+      Eigen::MatrixXd& acov_;
+      size_t num_blocks_;
+
+    public:
+      autocovariance_block_functor(const Eigen::Ref<const Eigen::MatrixXd>& x,
+                                   const std::vector<int>& cols,
+                                   Eigen::MatrixXd& acov,
+                                   size_t num_blocks)
+        : x_(x), cols_(cols), acov_(acov), num_blocks_(num_blocks) { }
+
+      /**
+       * Compute the autocovariances of the selected columns in the
+       * b-th block.
+       *
+       * @param[in] b index of block
+       */
+      void operator()(size_t b) {
+        size_t begin = b * cols_.size() / num_blocks_;
+        size_t end = (b + 1) * cols_.size() / num_blocks_;
+        autocovariance_fft autocovariance;
+        Eigen::VectorXd acov;
+        for (size_t j = begin; j < end; ++j) {
+          autocovariance(x_.col(cols_[j]), acov);
+          acov_.col(j) = acov;
+        }
+      }
+    };
+
+    /**
+     * Return the autocovariances of the specified columns of the
+     * specified matrix, as computed by
+     * <code>autocovariance_fft</code>.  The columns are split into
+     * one block per thread and each block reuses a single FFT plan
+     * and set of buffers.
+     *
+     * @param[in] x Series, one per column, of at least 2 rows.
+     * @param[in] cols Indexes of the columns to use.
+     * @param[in] num_threads Maximum number of threads to use.
+     * @return Autocovariances, column <code>j</code> at lags
+     * <code>0</code> to <code>N - 1</code> for column
+     * <code>cols[j]</code> of <code>x</code>.
+     */
+    inline Eigen::MatrixXd
+    autocovariances(const Eigen::Ref<const Eigen::MatrixXd>& x,
+                    const std::vector<int>& cols,
+                    int num_threads) {
+      Eigen::MatrixXd acov(x.rows(), cols.size());
+      int num_blocks = std::min(static_cast<int>(cols.size()),
+                                std::max(num_threads, 1));
+      autocovariance_block_functor compute(x, cols, acov, num_blocks);
+      stan::services::util::parallel_for(num_blocks, num_blocks, compute);
+      return acov;
+    }
+
+    /**
+     * Return the autocovariances of every column of the specified
+     * matrix, as computed by <code>autocovariance_fft</code>.
+     *
+     * @param[in] x Series, one per column, of at least 2 rows.
+     * @param[in] num_threads Maximum number of threads to use.
+     * @return Autocovariances, column <code>j</code> at lags
+     * <code>0</code> to <code>N - 1</code> for column <code>j</code>
+     * of <code>x</code>.
+     */
+    inline Eigen::MatrixXd
+    autocovariances(const Eigen::Ref<const Eigen::MatrixXd>& x,
+                    int num_threads) {
+      std::vector<int> cols(x.cols());
+      for (size_t j = 0; j < cols.size(); ++j)
+        cols[j] = j;
+      return autocovariances(x, cols, num_threads);
+    }
+
+  }
+}
+#endif
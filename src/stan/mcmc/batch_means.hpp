@@ -0,0 +1,186 @@
+#ifndef STAN_MCMC_BATCH_MEANS_HPP
+#define STAN_MCMC_BATCH_MEANS_HPP
+
+#include <cmath>
+#include <cstddef>
+#include <limits>
+#include <vector>
+
+namespace stan {
+  namespace mcmc {
+
+    /**
+     * Running count, mean and sum of squared deviations of a
+     * sequence of values, which can be merged with those of another
+     * sequence (Chan, Golub and LeVeque, 1979).
+     */
+    struct running_moments {
+      double n_;
+      double mean_;
+      double m2_;
+
+      running_moments() : n_(0), mean_(0), m2_(0) { }
+
+      /**
+       * Add the specified value.
+       *
+       * @param x Value.
+       */
+      void add(double x) {
+        n_ += 1;
+        double delta = x - mean_;
+        mean_ += delta / n_;
+        m2_ += delta * (x - mean_);
+      }
+
+      /**
+       * Add the moments of the specified sequence, which follows
+       * this one.
+       *
+       * @param other Moments to merge.
+       */
+      void merge(const running_moments& other) {
+        if (other.n_ == 0)
+          return;
+        double n = n_ + other.n_;
+        double delta = other.mean_ - mean_;
+        mean_ += delta * other.n_ / n;
+        m2_ += other.m2_ + delta * delta * n_ * other.n_ / n;
+        n_ = n;
+      }
+
+      /**
+       * Return the sample variance, or NaN for fewer than two values.
+       *
+       * @return Sample variance.
+       */
+      double variance() const {
+        if (n_ < 2)
+          return std::numeric_limits<double>::quiet_NaN();
+        return m2_ / (n_ - 1);
+      }
+    };
+
+    /**
+     * Batch means of a stream of values in memory independent of the
+     * length of the stream.
+     *
+     * <p>Values are grouped into consecutive batches of equal size
+     * and the moments of each full batch are kept.  When the number
+     * of batches reaches its maximum, adjacent batches are merged and
+     * the batch size doubles, so there are always between half the
+     * maximum and the maximum number of batches once enough values
+     * have been seen.  The variance of the batch means, scaled by the
+     * batch size, estimates the asymptotic variance of the mean of
+     * the stream, as needed for effective sample sizes, and the
+     * batches give the moments of the first and second half of the
+     * stream, as needed for split potential scale reduction.
+     */
+    class batch_means {
+    private:
+      size_t max_batches_;
+      size_t batch_size_;
+      std::vector<running_moments> batches_;
+      running_moments current_;
+      running_moments total_;
+
+    public:
+      /**
+       * Construct batch means keeping at most the specified number of
+       * batches.
+       *
+       * @param max_batches Maximum number of batches, rounded up to
+       * an even number of at least 4.
+       */
+      explicit batch_means(size_t max_batches = 64)
+        : max_batches_(max_batches < 4 ? 4 : max_batches + max_batches % 2),
+          batch_size_(1) { }
+
+      /**
+       * Add the specified value.
+       *
+       * @param x Value.
+       */
+      void add(double x) {
+        total_.add(x);
+        current_.add(x);
+        if (current_.n_ < batch_size_)
+          return;
+        batches_.push_back(current_);
+        current_ = running_moments();
+        if (batches_.size() < max_batches_)
+          return;
+        for (size_t b = 0; b < batches_.size() / 2; ++b) {
+          batches_[b] = batches_[2 * b];
+          batches_[b].merge(batches_[2 * b + 1]);
+        }
+        batches_.resize(batches_.size() / 2);
+        batch_size_ *= 2;
+      }
+
+      /**
+       * Return the moments of all values added.
+       *
+       * @return Moments of all values.
+       */
+      const running_moments& moments() const {
+        return total_;
+      }
+
+      /**
+       * Return the number of full batches.
+       *
+       * @return Number of batches.
+       */
+      size_t num_batches() const {
+        return batches_.size();
+      }
+
+      /**
+       * Return the current batch size.
+       *
+       * @return Batch size.
+       */
+      size_t batch_size() const {
+        return batch_size_;
+      }
+
+      /**
+       * Return the batch means estimate of the asymptotic variance of
+       * the mean, that is, the batch size times the sample variance
+       * of the means of the full batches.  This is NaN with fewer
+       * than two full batches.
+       *
+       * @return Asymptotic variance.
+       */
+      double asymptotic_variance() const {
+        running_moments means;
+        for (size_t b = 0; b < batches_.size(); ++b)
+          means.add(batches_[b].mean_);
+        return batch_size_ * means.variance();
+      }
+
+      /**
+       * Set the specified moments to those of the leading full
+       * batches holding at most half of the values and of the
+       * remaining values.
+       *
+       * @param[out] first Moments of the first half.
+       * @param[out] second Moments of the second half.
+       */
+      void split(running_moments& first, running_moments& second) const {
+        first = running_moments();
+        second = running_moments();
+        size_t b = 0;
+        for (; b < batches_.size()
+               && first.n_ + batches_[b].n_ <= total_.n_ / 2; ++b)
+          first.merge(batches_[b]);
+        for (; b < batches_.size(); ++b)
+          second.merge(batches_[b]);
+        second.merge(current_);
+      }
+    };
+
+  }
+}
+#endif
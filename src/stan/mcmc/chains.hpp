@@ -2,6 +2,7 @@
 #define STAN_MCMC_CHAINS_HPP
 
 #include <stan/io/stan_csv_reader.hpp>
+#include <stan/mcmc/autocovariance_fft.hpp>
 #include <stan/math/prim/mat.hpp>
 #include <boost/accumulators/accumulators.hpp>
 #include <boost/accumulators/statistics/stats.hpp>
@@ -13,10 +14,13 @@
 #include <boost/accumulators/statistics/variates/covariate.hpp>
 #include <boost/random/uniform_int_distribution.hpp>
 #include <boost/random/additive_combine.hpp>
+#include <boost/shared_ptr.hpp>
 #include <algorithm>
 #include <cmath>
 #include <iostream>
+#include <limits>
 #include <map>
+#include <mutex>
 #include <stdexcept>
 #include <string>
 #include <sstream>
@@ -38,33 +42,64 @@ namespace stan {
      * chains.  Readers for single chains need only be read/write locked
      * with writers of that chain.  For reading across chains, full
      * read/write locking is required.  Thus methods will be classified
-     * as global or single-chain read or write methods.
+     * as global or single-chain read or write methods.  Read methods
+     * may run concurrently with each other; the autocovariance cache
+     * they share is locked internally.
      *
      * <p><b>Storage Order</b>: Storage is column/last-index major.
+     * The samples of each chain are held in a column-major matrix, so
+     * the samples of a parameter within a chain are contiguous and
+     * per-parameter statistics read them in place rather than
+     * copying them out.  The mean and variance of the kept samples of
+     * every parameter in every chain are computed when samples or
+     * warmup change, and the autocovariances used for effective
+     * sample sizes are cached per parameter on first use.
      */
     template <class RNG = boost::random::ecuyer1988>
     class chains {
     private:
+      typedef Eigen::Map<const Eigen::VectorXd> column_map;
+      typedef Eigen::Ref<const Eigen::VectorXd> vector_ref;
+      typedef Eigen::Matrix<Eigen::VectorXd, Dynamic, 1> chain_vectors;
+
+      /**
+       * A mutex that is not copied along with the object holding it,
+       * so that chains remain copyable.
+       */
+      struct cache_mutex {
+        std::mutex mutex_;
+        cache_mutex() { }
+        cache_mutex(const cache_mutex&) { }
+        cache_mutex& operator=(const cache_mutex&) {
+          return *this;
+        }
+      };
+
       Eigen::Matrix<std::string, Dynamic, 1> param_names_;
       Eigen::Matrix<Eigen::MatrixXd, Dynamic, 1> samples_;
       Eigen::VectorXi warmup_;
+      Eigen::MatrixXd chain_means_;
+      Eigen::MatrixXd chain_variances_;
+      mutable std::vector<boost::shared_ptr<const chain_vectors> >
+        autocovariances_;
+      mutable cache_mutex cache_mutex_;
 
-      static double mean(const Eigen::VectorXd& x) {
+      static double mean(const vector_ref& x) {
         return (x.array() / x.size()).sum();
       }
 
-      static double variance(const Eigen::VectorXd& x) {
+      static double variance(const vector_ref& x) {
         double m = mean(x);
         return ((x.array() - m) / std::sqrt((x.size() - 1.0))).square().sum();
       }
 
-      static double sd(const Eigen::VectorXd& x) {
+      static double sd(const vector_ref& x) {
         return std::sqrt(variance(x));
       }
 
 
-      static double covariance(const Eigen::VectorXd& x,
-                               const Eigen::VectorXd& y,
+      static double covariance(const vector_ref& x,
+                               const vector_ref& y,
                                std::ostream* err = 0) {
         if (x.rows() != y.rows() && err)
           *err << "warning: covariance of different length chains";
@@ -83,8 +118,8 @@ namespace stan {
         return boost::accumulators::covariance(acc) * M / (M-1);
       }
 
-      static double correlation(const Eigen::VectorXd& x,
-                                const Eigen::VectorXd& y,
+      static double correlation(const vector_ref& x,
+                                const vector_ref& y,
                                 std::ostream* err = 0) {
         if (x.rows() != y.rows() && err)
           *err << "warning: covariance of different length chains";
@@ -111,7 +146,22 @@ namespace stan {
                                * boost::accumulators::variance(acc_y));
       }
 
-      static double quantile(const Eigen::VectorXd& x, const double prob) {
+      static size_t total_size(const std::vector<column_map>& xs) {
+        size_t M = 0;
+        for (size_t k = 0; k < xs.size(); ++k)
+          M += xs[k].size();
+        return M;
+      }
+
+      template <class Acc>
+      static void accumulate(const std::vector<column_map>& xs, Acc& acc) {
+        for (size_t k = 0; k < xs.size(); ++k)
+          for (int i = 0; i < xs[k].size(); i++)
+            acc(xs[k](i));
+      }
+
+      static double quantile(const std::vector<column_map>& xs,
+                             const double prob) {
         using boost::accumulators::accumulator_set;
         using boost::accumulators::left;
         using boost::accumulators::quantile;
@@ -120,26 +170,24 @@ namespace stan {
         using boost::accumulators::stats;
         using boost::accumulators::tag::tail;
         using boost::accumulators::tag::tail_quantile;
-        double M = x.rows();
         // size_t cache_size = std::min(prob, 1-prob)*M + 2;
-        size_t cache_size = M;
+        size_t cache_size = total_size(xs);
 
         if (prob < 0.5) {
           accumulator_set<double, stats<tail_quantile<left> > >
             acc(tail<left>::cache_size = cache_size);
-          for (int i = 0; i < M; i++)
-            acc(x(i));
+          accumulate(xs, acc);
           return quantile(acc, quantile_probability = prob);
         }
         accumulator_set<double, stats<tail_quantile<right> > >
           acc(tail<right>::cache_size = cache_size);
-        for (int i = 0; i < M; i++)
-          acc(x(i));
+        accumulate(xs, acc);
         return quantile(acc, quantile_probability = prob);
       }
 
       static Eigen::VectorXd
-      quantiles(const Eigen::VectorXd& x, const Eigen::VectorXd& probs) {
+      quantiles(const std::vector<column_map>& xs,
+                const Eigen::VectorXd& probs) {
         using boost::accumulators::accumulator_set;
         using boost::accumulators::left;
         using boost::accumulators::quantile_probability;
@@ -148,20 +196,17 @@ namespace stan {
         using boost::accumulators::stats;
         using boost::accumulators::tag::tail;
         using boost::accumulators::tag::tail_quantile;
-        double M = x.rows();
 
         // size_t cache_size = M/2 + 2;
-        size_t cache_size = M;  // 2 + 2;
+        size_t cache_size = total_size(xs);  // 2 + 2;
 
         accumulator_set<double, stats<tail_quantile<left> > >
           acc_left(tail<left>::cache_size = cache_size);
         accumulator_set<double, stats<tail_quantile<right> > >
           acc_right(tail<right>::cache_size = cache_size);
 
-        for (int i = 0; i < M; i++) {
-          acc_left(x(i));
-          acc_right(x(i));
-        }
+        accumulate(xs, acc_left);
+        accumulate(xs, acc_right);
 
         Eigen::VectorXd q(probs.size());
         for (int i = 0; i < probs.size(); i++) {
@@ -175,38 +220,91 @@ namespace stan {
         return q;
       }
 
-      static Eigen::VectorXd autocorrelation(const Eigen::VectorXd& x) {
-        using std::vector;
-        using stan::math::index_type;
-        typedef typename index_type<vector<double> >::type idx_t;
-
-        std::vector<double> ac;
-        std::vector<double> sample(x.size());
-        for (int i = 0; i < x.size(); i++)
-          sample[i] = x(i);
-        stan::math::autocorrelation(sample, ac);
+      /**
+       * Return a map of the kept samples of the specified parameter
+       * in the specified chain, which are contiguous in storage.
+       *
+       * @param chain Chain.
+       * @param index Parameter index.
+       * @return Map of kept samples.
+       */
+      column_map kept_samples(const int chain, const int index) const {
+        int n = std::max(num_kept_samples(chain), 0);
+        return column_map(samples_(chain).col(index).data()
+                          + num_samples(chain) - n, n);
+      }
 
-        Eigen::VectorXd ac2(ac.size());
-        for (idx_t i = 0; i < ac.size(); i++)
-          ac2(i) = ac[i];
-        return ac2;
+      /**
+       * Return maps of the kept samples of the specified parameter in
+       * every chain.
+       *
+       * @param index Parameter index.
+       * @return Maps of kept samples, one per chain.
+       */
+      std::vector<column_map> kept_samples(const int index) const {
+        std::vector<column_map> xs;
+        for (int chain = 0; chain < num_chains(); chain++)
+          xs.push_back(kept_samples(chain, index));
+        return xs;
       }
 
-      static Eigen::VectorXd autocovariance(const Eigen::VectorXd& x) {
-        using std::vector;
-        using stan::math::index_type;
-        typedef typename index_type<vector<double> >::type idx_t;
+      /**
+       * Recompute the means and variances of the kept samples of
+       * every parameter in the specified chain and drop cached
+       * autocovariances.
+       *
+       * @param chain Chain.
+       */
+      void update_moments(const int chain) {
+        if (chain_means_.cols() != num_chains()) {
+          chain_means_.conservativeResize(num_params(), num_chains());
+          chain_variances_.conservativeResize(num_params(), num_chains());
+        }
+        for (int index = 0; index < num_params(); index++) {
+          column_map x = kept_samples(chain, index);
+          chain_means_(index, chain) = mean(x);
+          chain_variances_(index, chain) = variance(x);
+        }
+        std::lock_guard<std::mutex> lock(cache_mutex_.mutex_);
+        autocovariances_.clear();
+      }
 
-        std::vector<double> ac;
-        std::vector<double> sample(x.size());
-        for (int i = 0; i < x.size(); i++)
-          sample[i] = x(i);
-        stan::math::autocovariance(sample, ac);
+      /**
+       * Return the autocovariances of the kept samples of the
+       * specified parameter in every chain, from the cache if they
+       * are there.  Otherwise they are computed and, if requested,
+       * stored in the cache.
+       *
+       * @param index Parameter index.
+       * @param store Whether to cache computed autocovariances.
+       * @param fft Engine used to compute autocovariances.
+       * @return Autocovariances, one vector per chain.
+       */
+      boost::shared_ptr<const chain_vectors>
+      autocovariances(const int index, bool store,
+                      autocovariance_fft& fft) const {
+        {
+          std::lock_guard<std::mutex> lock(cache_mutex_.mutex_);
+          if (index < static_cast<int>(autocovariances_.size())
+              && autocovariances_[index])
+            return autocovariances_[index];
+        }
+        boost::shared_ptr<chain_vectors> acov(new chain_vectors(num_chains()));
+        for (int chain = 0; chain < num_chains(); chain++)
+          fft(kept_samples(chain, index), (*acov)(chain));
+        if (store) {
+          std::lock_guard<std::mutex> lock(cache_mutex_.mutex_);
+          if (autocovariances_.size() != static_cast<size_t>(num_params()))
+            autocovariances_.resize(num_params());
+          autocovariances_[index] = acov;
+        }
+        return acov;
+      }
 
-        Eigen::VectorXd ac2(ac.size());
-        for (idx_t i = 0; i < ac.size(); i++)
-          ac2(i) = ac[i];
-        return ac2;
+      boost::shared_ptr<const chain_vectors>
+      autocovariances(const int index, bool store) const {
+        autocovariance_fft fft;
+        return autocovariances(index, store, fft);
       }
 
       /**
@@ -218,34 +316,30 @@ namespace stan {
        * Current implementation takes the minimum number of samples
        * across chains as the number of samples per chain.
        *
-       * @param VectorXd
-       * @param Dynamic
-       * @param samples
-       *
-       * @return
+       * @param index Parameter index.
+       * @param store Whether to cache computed autocovariances.
+       * @param fft Engine used to compute autocovariances.
+       * @return Effective sample size.
        */
-      double effective_sample_size(const Eigen::Matrix<Eigen::VectorXd,
-                                   Dynamic, 1> &samples) const {
-        int chains = samples.size();
+      double effective_sample_size(const int index, bool store,
+                                   autocovariance_fft& fft) const {
+        int chains = num_chains();
+        boost::shared_ptr<const chain_vectors> acov
+          = autocovariances(index, store, fft);
 
         // need to generalize to each jagged samples per chain
-        int n_samples = samples(0).size();
+        int n_samples = num_kept_samples(0);
         for (int chain = 1; chain < chains; chain++) {
-          n_samples = std::min(n_samples,
-                               static_cast<int>(samples(chain).size()));
-        }
-
-        Eigen::Matrix<Eigen::VectorXd, Dynamic, 1> acov(chains);
-        for (int chain = 0; chain < chains; chain++) {
-          acov(chain) = autocovariance(samples(chain));
+          n_samples = std::min(n_samples, num_kept_samples(chain));
         }
 
         Eigen::VectorXd chain_mean(chains);
         Eigen::VectorXd chain_var(chains);
         for (int chain = 0; chain < chains; chain++) {
           double n_kept_samples = num_kept_samples(chain);
-          chain_mean(chain) = mean(samples(chain));
-          chain_var(chain) = acov(chain)(0)*n_kept_samples/(n_kept_samples-1);
+          chain_mean(chain) = chain_means_(index, chain);
+          chain_var(chain)
+            = (*acov)(chain)(0) * n_kept_samples / (n_kept_samples - 1);
         }
 
         double mean_var = mean(chain_var);
@@ -259,7 +353,7 @@ namespace stan {
         for (int t = 1; (t < n_samples && rho_hat >= 0); t++) {
           Eigen::VectorXd acov_t(chains);
           for (int chain = 0; chain < chains; chain++) {
-            acov_t(chain) = acov(chain)(t);
+            acov_t(chain) = (*acov)(chain)(t);
           }
           rho_hat = 1 - (mean_var - mean(acov_t)) / var_plus;
           if (rho_hat >= 0)
@@ -273,51 +367,10 @@ namespace stan {
         return ess;
       }
 
-      /**
-       * Return the split potential scale reduction (split R hat)
-       * for the specified parameter.
-       *
-       * Current implementation takes the minimum number of samples
-       * across chains as the number of samples per chain.
-       *
-       * @param VectorXd
-       * @param Dynamic
-       * @param samples
-       *
-       * @return
-       */
-      double
-      split_potential_scale_reduction(
-                                      const Eigen::Matrix<Eigen::VectorXd,
-                                      Dynamic, 1> &samples) const {
-        int chains = samples.size();
-        int n_samples = samples(0).size();
-        for (int chain = 1; chain < chains; chain++) {
-          n_samples = std::min(n_samples,
-                               static_cast<int>(samples(chain).size()));
-        }
-        if (n_samples % 2 == 1)
-          n_samples--;
-        int n = n_samples / 2;
-
-        Eigen::VectorXd split_chain_mean(2*chains);
-        Eigen::VectorXd split_chain_var(2*chains);
-
-        for (int chain = 0; chain < chains; chain++) {
-          split_chain_mean(2*chain) = mean(samples(chain).topRows(n));
-          split_chain_mean(2*chain+1) = mean(samples(chain).bottomRows(n));
-
-          split_chain_var(2*chain) = variance(samples(chain).topRows(n));
-          split_chain_var(2*chain+1) = variance(samples(chain).bottomRows(n));
-        }
-
-        double var_between = n * variance(split_chain_mean);
-        double var_within = mean(split_chain_var);
-
-        // rewrote [(n-1)*W/n + B/n]/W as (n-1+ B/W)/n
-        return sqrt((var_between/var_within + n-1)/n);
+      double effective_sample_size(const int index, bool store) const {
+        autocovariance_fft fft;
+        return effective_sample_size(index, store, fft);
       }
-
     public:
       explicit chains(const Eigen::Matrix<std::string, Dynamic, 1>& param_names)
         : param_names_(param_names) { }
@@ -360,10 +413,13 @@ namespace stan {
 
       void set_warmup(const int chain, const int warmup) {
         warmup_(chain) = warmup;
+        update_moments(chain);
       }
 
       void set_warmup(const int warmup) {
         warmup_.setConstant(warmup);
+        for (int chain = 0; chain < num_chains(); chain++)
+          update_moments(chain);
       }
 
       const Eigen::VectorXi& warmup() const {
@@ -401,8 +457,10 @@ namespace stan {
         if (sample.cols() != num_params())
           throw std::invalid_argument("add(chain, sample): number of columns"
                                       " in sample does not match chains");
+        int first_changed = chain;
         if (num_chains() == 0 || chain >= num_chains()) {
           int n = num_chains();
+          first_changed = n;
 
           // Need this block for Windows. conservativeResize
           // does not keep the references.
@@ -429,6 +487,8 @@ namespace stan {
         Eigen::MatrixXd new_samples(row+sample.rows(), num_params());
         new_samples << samples_(chain), sample;
         samples_(chain) = new_samples;
+        for (int i = first_changed; i <= chain; i++)
+          update_moments(i);
       }
 
       void add(const Eigen::MatrixXd& sample) {
@@ -497,11 +557,21 @@ namespace stan {
       }
 
       double mean(const int chain, const int index) const {
-        return mean(samples(chain, index));
+        return chain_means_(index, chain);
       }
 
       double mean(const int index) const {
-        return mean(samples(index));
+        double n = num_kept_samples();
+        if (n <= 0)
+          return std::numeric_limits<double>::quiet_NaN();
+        double m = 0;
+        for (int chain = 0; chain < num_chains(); chain++) {
+          // chains without kept samples have an undefined (NaN) mean
+          if (num_kept_samples(chain) <= 0)
+            continue;
+          m += chain_means_(index, chain) * (num_kept_samples(chain) / n);
+        }
+        return m;
       }
 
       double mean(const int chain, const std::string& name) const {
@@ -513,11 +583,11 @@ namespace stan {
       }
 
       double sd(const int chain, const int index) const {
-        return sd(samples(chain, index));
+        return std::sqrt(variance(chain, index));
       }
 
       double sd(const int index) const {
-        return sd(samples(index));
+        return std::sqrt(variance(index));
       }
 
       double sd(const int chain, const std::string& name) const {
@@ -529,11 +599,22 @@ namespace stan {
       }
 
       double variance(const int chain, const int index) const {
-        return variance(samples(chain, index));
+        return chain_variances_(index, chain);
       }
 
       double variance(const int index) const {
-        return variance(samples(index));
+        if (num_kept_samples() <= 1)
+          return std::numeric_limits<double>::quiet_NaN();
+        double m = mean(index);
+        double scale = std::sqrt(num_kept_samples() - 1.0);
+        double var = 0;
+        for (int chain = 0; chain < num_chains(); chain++) {
+          if (num_kept_samples(chain) <= 0)
+            continue;
+          var += ((kept_samples(chain, index).array() - m) / scale)
+            .square().sum();
+        }
+        return var;
       }
 
       double variance(const int chain, const std::string& name) const {
@@ -546,7 +627,8 @@ namespace stan {
 
       double
       covariance(const int chain, const int index1, const int index2) const {
-        return covariance(samples(chain, index1), samples(chain, index2));
+        return covariance(kept_samples(chain, index1),
+                          kept_samples(chain, index2));
       }
 
       double covariance(const int index1, const int index2) const {
@@ -565,7 +647,8 @@ namespace stan {
 
       double
       correlation(const int chain, const int index1, const int index2) const {
-        return correlation(samples(chain, index1), samples(chain, index2));
+        return correlation(kept_samples(chain, index1),
+                           kept_samples(chain, index2));
       }
 
       double correlation(const int index1, const int index2) const {
@@ -584,11 +667,12 @@ namespace stan {
 
       double
       quantile(const int chain, const int index, const double prob) const {
-        return quantile(samples(chain, index), prob);
+        return quantile(std::vector<column_map>(1, kept_samples(chain, index)),
+                        prob);
       }
 
       double quantile(const int index, const double prob) const {
-        return quantile(samples(index), prob);
+        return quantile(kept_samples(index), prob);
       }
 
       double quantile(int chain, const std::string& name, double prob) const {
@@ -601,11 +685,13 @@ namespace stan {
 
       Eigen::VectorXd
       quantiles(int chain, int index, const Eigen::VectorXd& probs) const {
-        return quantiles(samples(chain, index), probs);
+        return quantiles(std::vector<column_map>(1,
+                                                 kept_samples(chain, index)),
+                         probs);
       }
 
       Eigen::VectorXd quantiles(int index, const Eigen::VectorXd& probs) const {
-        return quantiles(samples(index), probs);
+        return quantiles(kept_samples(index), probs);
       }
 
       Eigen::VectorXd
@@ -652,7 +738,8 @@ namespace stan {
       }
 
       Eigen::VectorXd autocorrelation(const int chain, const int index) const {
-        return autocorrelation(samples(chain, index));
+        const Eigen::VectorXd& acov = (*autocovariances(index, true))(chain);
+        return acov / acov(0);
       }
 
       Eigen::VectorXd autocorrelation(int chain,
@@ -661,39 +748,155 @@ namespace stan {
       }
 
       Eigen::VectorXd autocovariance(const int chain, const int index) const {
-        return autocovariance(samples(chain, index));
+        return (*autocovariances(index, true))(chain);
       }
 
       Eigen::VectorXd autocovariance(int chain, const std::string& name) const {
         return autocovariance(chain, index(name));
       }
 
-      // FIXME: reimplement using autocorrelation.
-      double effective_sample_size(const int index) const {
-        Eigen::Matrix<Eigen::VectorXd, Dynamic, 1>
-          samples(num_chains());
+      /**
+       * Compute the autocovariances of every parameter not yet in the
+       * cache and store them, on up to the specified number of
+       * threads.  Only the missing parameters are computed, with one
+       * FFT plan and set of buffers per thread rather than per
+       * parameter, so this is much faster than computing effective
+       * sample sizes one parameter at a time when there are many
+       * parameters.  The cache then holds a copy the size of the kept
+       * samples, so callers that only need summaries should use
+       * <code>summary()</code>, which does not fill it.
+       *
+       * @param num_threads Maximum number of threads to use.
+       */
+      void cache_autocovariances(int num_threads) const {
+        std::vector<int> missing;
+        {
+          std::lock_guard<std::mutex> lock(cache_mutex_.mutex_);
+          for (int index = 0; index < num_params(); index++)
+            if (index >= static_cast<int>(autocovariances_.size())
+                || !autocovariances_[index])
+              missing.push_back(index);
+        }
+        if (missing.empty())
+          return;
+
+        std::vector<boost::shared_ptr<chain_vectors> > acovs(missing.size());
+        for (size_t i = 0; i < missing.size(); i++)
+          acovs[i].reset(new chain_vectors(num_chains()));
         for (int chain = 0; chain < num_chains(); chain++) {
-          samples(chain) = this->samples(chain, index);
+          int n = std::max(num_kept_samples(chain), 0);
+          Eigen::MatrixXd acov = stan::mcmc::autocovariances(
+              samples_(chain).bottomRows(n), missing, num_threads);
+          for (size_t i = 0; i < missing.size(); i++)
+            (*acovs[i])(chain) = acov.col(i);
         }
-        return effective_sample_size(samples);
+
+        std::lock_guard<std::mutex> lock(cache_mutex_.mutex_);
+        if (autocovariances_.size() != static_cast<size_t>(num_params()))
+          autocovariances_.resize(num_params());
+        for (size_t i = 0; i < missing.size(); i++)
+          if (!autocovariances_[missing[i]])
+            autocovariances_[missing[i]] = acovs[i];
+      }
+
+      double effective_sample_size(const int index) const {
+        return effective_sample_size(index, true);
       }
 
       double effective_sample_size(const std::string& name) const {
         return effective_sample_size(index(name));
       }
 
+      /**
+       * Return the split potential scale reduction (split R hat)
+       * for the specified parameter.
+       *
+       * Current implementation takes the minimum number of samples
+       * across chains as the number of samples per chain.
+       *
+       * @param index Parameter index.
+       * @return Split potential scale reduction.
+       */
       double split_potential_scale_reduction(const int index) const {
-        Eigen::Matrix<Eigen::VectorXd, Dynamic, 1>
-          samples(num_chains());
-        for (int chain = 0; chain < num_chains(); chain++) {
-          samples(chain) = this->samples(chain, index);
+        int chains = num_chains();
+        int n_samples = num_kept_samples(0);
+        for (int chain = 1; chain < chains; chain++) {
+          n_samples = std::min(n_samples, num_kept_samples(chain));
         }
-        return split_potential_scale_reduction(samples);
+        if (n_samples % 2 == 1)
+          n_samples--;
+        int n = n_samples / 2;
+
+        Eigen::VectorXd split_chain_mean(2*chains);
+        Eigen::VectorXd split_chain_var(2*chains);
+
+        for (int chain = 0; chain < chains; chain++) {
+          column_map x = kept_samples(chain, index);
+          split_chain_mean(2*chain) = mean(x.head(n));
+          split_chain_mean(2*chain+1) = mean(x.tail(n));
+
+          split_chain_var(2*chain) = variance(x.head(n));
+          split_chain_var(2*chain+1) = variance(x.tail(n));
+        }
+
+        double var_between = n * variance(split_chain_mean);
+        double var_within = mean(split_chain_var);
+
+        // rewrote [(n-1)*W/n + B/n]/W as (n-1+ B/W)/n
+        return sqrt((var_between/var_within + n-1)/n);
       }
 
       double split_potential_scale_reduction(const std::string& name) const {
         return split_potential_scale_reduction(index(name));
       }
+
+      /**
+       * Return the summary of the specified parameter across all
+       * kept samples, computing the statistics together.  The
+       * elements are the mean, the Monte Carlo standard error of the
+       * mean, the standard deviation, the quantiles at each of the
+       * specified probabilities, the effective sample size and the
+       * split potential scale reduction.
+       *
+       * <p>Means and variances come from the per-chain moments and
+       * all quantiles from a single pass over the samples.
+       * Autocovariances are taken from the cache if present but are
+       * not added to it, so summarizing every parameter does not keep
+       * a copy of the samples' autocovariances.
+       *
+       * @param index Parameter index.
+       * @param probs Probabilities of quantiles.
+       * @param fft Engine used to compute autocovariances, which may
+       * be reused across calls on the same thread.
+       * @return Summary of parameter.
+       */
+      Eigen::VectorXd summary(const int index,
+                              const Eigen::VectorXd& probs,
+                              autocovariance_fft& fft) const {
+        int num_probs = probs.size();
+        Eigen::VectorXd s(5 + num_probs);
+        double sd = this->sd(index);
+        double n_eff = effective_sample_size(index, false, fft);
+        s(0) = mean(index);
+        s(1) = sd / std::sqrt(n_eff);
+        s(2) = sd;
+        if (num_probs > 0)
+          s.segment(3, num_probs) = quantiles(index, probs);
+        s(3 + num_probs) = n_eff;
+        s(4 + num_probs) = split_potential_scale_reduction(index);
+        return s;
+      }
+
+      Eigen::VectorXd summary(const int index,
+                              const Eigen::VectorXd& probs) const {
+        autocovariance_fft fft;
+        return summary(index, probs, fft);
+      }
+
+      Eigen::VectorXd summary(const std::string& name,
+                              const Eigen::VectorXd& probs) const {
+        return summary(index(name), probs);
+      }
     };
 
   }
@@ -0,0 +1,143 @@
+#ifndef STAN_MCMC_QUANTILE_SKETCH_HPP
+#define STAN_MCMC_QUANTILE_SKETCH_HPP
+
+#include <algorithm>
+#include <cmath>
+#include <limits>
+#include <utility>
+#include <vector>
+
+namespace stan {
+  namespace mcmc {
+
+    /**
+     * A mergeable sketch of a stream of values from which quantiles
+     * can be estimated in memory logarithmic in the number of values.
+     *
+     * <p>Values are kept in levels, where a value at level
+     * <code>h</code> stands for <code>2^h</code> values of the stream.
+     * When a level holds <code>k</code> values they are sorted and
+     * every other one is promoted to the next level, alternating
+     * between the odd and even positions so that the errors do not
+     * accumulate in one direction.  This is the compactor scheme of
+     * Karnin, Lang and Liberty (2016) with equal capacities and
+     * deterministic compaction.  The rank error of a quantile is of
+     * the order of <code>log2(n / k) / k</code> of the number of
+     * values <code>n</code>, and quantiles are exact until
+     * <code>k</code> values have been added.
+     *
+     * <p>Sketches of parts of a stream, such as separate chains, can
+     * be merged into a sketch of the whole.
+     */
+    class quantile_sketch {
+    private:
+      size_t k_;
+      size_t count_;
+      std::vector<std::vector<double> > levels_;
+      std::vector<int> offsets_;
+
+      void compact(size_t h) {
+        if (levels_.size() == h + 1) {
+          levels_.push_back(std::vector<double>());
+          offsets_.push_back(0);
+        }
+        std::vector<double>& level = levels_[h];
+        std::sort(level.begin(), level.end());
+        size_t n = level.size() - level.size() % 2;
+        for (size_t i = offsets_[h]; i < n; i += 2)
+          levels_[h + 1].push_back(level[i]);
+        offsets_[h] = 1 - offsets_[h];
+        level.erase(level.begin(), level.begin() + n);
+      }
+
+      void compact_full_levels() {
+        for (size_t h = 0; h < levels_.size(); ++h)
+          if (levels_[h].size() >= k_)
+            compact(h);
+      }
+
+    public:
+      /**
+       * Construct an empty sketch that keeps up to the specified
+       * number of values per level.
+       *
+       * @param k Capacity of each level, at least 2.
+       */
+      explicit quantile_sketch(size_t k = 256)
+        : k_(std::max(k, static_cast<size_t>(2))), count_(0),
+          levels_(1), offsets_(1, 0) { }
+
+      /**
+       * Add the specified value.
+       *
+       * @param x Value.
+       */
+      void add(double x) {
+        levels_[0].push_back(x);
+        ++count_;
+        if (levels_[0].size() >= k_)
+          compact_full_levels();
+      }
+
+      /**
+       * Add the values held by the specified sketch to this one.
+       *
+       * @param other Sketch to merge.
+       */
+      void merge(const quantile_sketch& other) {
+        while (levels_.size() < other.levels_.size()) {
+          levels_.push_back(std::vector<double>());
+          offsets_.push_back(0);
+        }
+        for (size_t h = 0; h < other.levels_.size(); ++h)
+          levels_[h].insert(levels_[h].end(), other.levels_[h].begin(),
+                            other.levels_[h].end());
+        count_ += other.count_;
+        compact_full_levels();
+      }
+
+      /**
+       * Return the number of values added.
+       *
+       * @return Number of values.
+       */
+      size_t count() const {
+        return count_;
+      }
+
+      /**
+       * Return the estimate of the quantile at the specified
+       * probability, the smallest kept value whose weighted rank is
+       * at least <code>prob</code> of the values, or NaN if no values
+       * have been added.
+       *
+       * @param prob Probability.
+       * @return Quantile.
+       */
+      double quantile(double prob) const {
+        std::vector<std::pair<double, double> > weighted;
+        double weight = 1;
+        for (size_t h = 0; h < levels_.size(); ++h, weight *= 2)
+          for (size_t i = 0; i < levels_[h].size(); ++i)
+            weighted.push_back(std::make_pair(levels_[h][i], weight));
+        if (weighted.empty())
+          return std::numeric_limits<double>::quiet_NaN();
+        std::sort(weighted.begin(), weighted.end());
+
+        double total = 0;
+        for (size_t i = 0; i < weighted.size(); ++i)
+          total += weighted[i].second;
+        double target = prob * total;
+        double rank = 0;
+        for (size_t i = 0; i < weighted.size(); ++i) {
+          rank += weighted[i].second;
+          if (rank >= target)
+            return weighted[i].first;
+        }
+        return weighted.back().first;
+      }
+    };
+
+  }
+}
+#endif
@@ -0,0 +1,114 @@
+#ifndef STAN_MCMC_READ_CHAINS_HPP
+#define STAN_MCMC_READ_CHAINS_HPP
+
+#include <stan/io/stan_csv_reader.hpp>
+#include <stan/mcmc/chains.hpp>
+#include <stan/services/util/parallel_for.hpp>
+#include <fstream>
+#include <ostream>
+#include <sstream>
+#include <stdexcept>
+#include <string>
+#include <vector>
+
+namespace stan {
+  namespace mcmc {
+
+    /**
+     * Functor parsing the n-th of a list of Stan output csv files,
+     * collecting messages in a buffer per file so they can be written
+     * in file order.
+     */
+    class stan_csv_parse_functor {
+    private:
+      const std::vector<std::string>& paths_;
+      std::vector<stan::io::stan_csv>& csvs_;
+      std::vector<std::string> messages_;
+
+    public:
+      stan_csv_parse_functor(const std::vector<std::string>& paths,
+                             std::vector<stan::io::stan_csv>& csvs)
+        : paths_(paths), csvs_(csvs), messages_(paths.size()) { }
+
+      /**
+       * Parse the n-th file.
+       *
+       * @param[in] n index of file
+       * @throw std::invalid_argument if the file cannot be opened or
+       * its header cannot be read
+       */
+      void operator()(size_t n) {
+        std::ifstream in(paths_[n].c_str());
+        if (!in)
+          throw std::invalid_argument("Can't open file " + paths_[n]);
+        std::stringstream msg;
+        csvs_[n] = stan::io::stan_csv_reader::parse(in, &msg);
+        messages_[n] = msg.str();
+      }
+
+      /**
+       * Return the messages written while parsing the n-th file.
+       *
+       * @param[in] n index of file
+       * @return messages
+       */
+      const std::string& messages(size_t n) const {
+        return messages_[n];
+      }
+    };
+
+    /**
+     * Parse the specified Stan output csv files, concurrently on up
+     * to the specified number of threads, and return their contents
+     * in the order of the paths.  Messages from the parser are
+     * written to the output stream file by file, in the same order.
+     *
+     * @param[in] paths paths of files to parse
+     * @param[in] num_threads maximum number of threads to use
+     * @param[out] out output stream for messages, or null
+     * @return parsed files
+     * @throw std::invalid_argument if a file cannot be opened or its
+     * header cannot be read
+     */
+    inline std::vector<stan::io::stan_csv>
+    parse_stan_csv_files(const std::vector<std::string>& paths,
+                         int num_threads, std::ostream* out) {
+      std::vector<stan::io::stan_csv> csvs(paths.size());
+      stan_csv_parse_functor parse(paths, csvs);
+      stan::services::util::parallel_for(paths.size(), num_threads, parse);
+      if (out)
+        for (size_t n = 0; n < paths.size(); ++n)
+          *out << parse.messages(n);
+      return csvs;
+    }
+
+    /**
+     * Read the specified Stan output csv files, parsing them
+     * concurrently on up to the specified number of threads, and
+     * return them as chains in the order of the paths.  Every file
+     * must have the same header as the first.
+     *
+     * @param[in] paths paths of files to read, at least one
+     * @param[in] num_threads maximum number of threads to use
+     * @param[out] out output stream for messages, or null
+     * @return chains holding one chain per file
+     * @throw std::invalid_argument if there are no paths, a file
+     * cannot be read or the headers do not match
+     */
+    inline chains<> read_chains(const std::vector<std::string>& paths,
+                                int num_threads, std::ostream* out) {
+      if (paths.empty())
+        throw std::invalid_argument("read_chains: no files to read");
+      std::vector<stan::io::stan_csv> csvs
+        = parse_stan_csv_files(paths, num_threads, out);
+      chains<> result(csvs[0].header);
+      for (size_t n = 0; n < csvs.size(); ++n) {
+        result.add(csvs[n]);
+        csvs[n].samples.resize(0, 0);
+      }
+      return result;
+    }
+
+  }
+}
+#endif
@@ -0,0 +1,308 @@
+#ifndef STAN_MCMC_STREAMING_CHAINS_HPP
+#define STAN_MCMC_STREAMING_CHAINS_HPP
+
+#include <stan/mcmc/batch_means.hpp>
+#include <stan/mcmc/quantile_sketch.hpp>
+#include <Eigen/Dense>
+#include <algorithm>
+#include <cmath>
+#include <limits>
+#include <stdexcept>
+#include <string>
+#include <vector>
+
+namespace stan {
+  namespace mcmc {
+
+    /**
+     * A <code>streaming_chains</code> object summarizes draws from
+     * multiple chains as they are added, without keeping them, so
+     * that diagnostics can be queried at any time in memory that does
+     * not grow with the number of draws.
+     *
+     * <p>For every parameter of every chain it keeps batch means (see
+     * <code>batch_means</code>) and a quantile sketch (see
+     * <code>quantile_sketch</code>).  The diagnostics are streaming
+     * counterparts of those of <code>mcmc::chains</code>:
+     *
+     * <ul>
+     * <li>Means and variances are exact.</li>
+     * <li>Quantiles are estimated from the merged sketches of all
+     * chains.</li>
+     * <li>Effective sample sizes replace the autocorrelation sum of
+     * <code>chains</code> by the batch means estimate of each chain's
+     * asymptotic variance, combined across chains with the same
+     * between- and within-chain variance as
+     * <code>chains</code>.</li>
+     * <li>Split potential scale reduction splits each chain at the
+     * batch boundary nearest its middle.</li>
+     * </ul>
+     *
+     * <p>As in <code>chains</code>, the number of draws per chain
+     * used to combine chains is the minimum over chains.  All draws
+     * added are treated as kept draws.
+     */
+    class streaming_chains {
+    private:
+      std::vector<std::string> param_names_;
+      size_t max_batches_;
+      size_t sketch_size_;
+      std::vector<std::vector<batch_means> > batches_;
+      std::vector<std::vector<quantile_sketch> > sketches_;
+
+      static double mean(const Eigen::VectorXd& x) {
+        return (x.array() / x.size()).sum();
+      }
+
+      static double variance(const Eigen::VectorXd& x) {
+        double m = mean(x);
+        return ((x.array() - m) / std::sqrt((x.size() - 1.0))).square().sum();
+      }
+
+      double min_num_samples() const {
+        double n = num_samples(0);
+        for (int chain = 1; chain < num_chains(); chain++)
+          n = std::min(n, static_cast<double>(num_samples(chain)));
+        return n;
+      }
+
+    public:
+      /**
+       * Construct streaming chains for parameters with the specified
+       * names.
+       *
+       * @param param_names Names of parameters.
+       * @param max_batches Maximum number of batches per parameter
+       * and chain.
+       * @param sketch_size Capacity of each level of the quantile
+       * sketches.
+       */
+      explicit streaming_chains(const std::vector<std::string>& param_names,
+                                size_t max_batches = 64,
+                                size_t sketch_size = 256)
+        : param_names_(param_names), max_batches_(max_batches),
+          sketch_size_(sketch_size) { }
+
+      explicit streaming_chains(const Eigen::Matrix<std::string,
+                                                    Eigen::Dynamic, 1>&
+                                param_names,
+                                size_t max_batches = 64,
+                                size_t sketch_size = 256)
+        : param_names_(param_names.data(),
+                       param_names.data() + param_names.size()),
+          max_batches_(max_batches), sketch_size_(sketch_size) { }
+
+      int num_chains() const {
+        return batches_.size();
+      }
+
+      int num_params() const {
+        return param_names_.size();
+      }
+
+      const std::vector<std::string>& param_names() const {
+        return param_names_;
+      }
+
+      const std::string& param_name(int j) const {
+        return param_names_[j];
+      }
+
+      int index(const std::string& name) const {
+        for (int i = 0; i < num_params(); i++)
+          if (param_names_[i] == name)
+            return i;
+        return -1;
+      }
+
+      int num_samples(const int chain) const {
+        return batches_[chain].empty() ? 0
+          : static_cast<int>(batches_[chain][0].moments().n_);
+      }
+
+      int num_samples() const {
+        int n = 0;
+        for (int chain = 0; chain < num_chains(); chain++)
+          n += num_samples(chain);
+        return n;
+      }
+
+      /**
+       * Add a draw to the specified chain, creating it and any chains
+       * before it that do not exist yet.
+       *
+       * @param chain Chain.
+       * @param draw Values of all parameters.
+       * @throw std::invalid_argument if the number of values does not
+       * match the number of parameters
+       */
+      void add(const int chain, const Eigen::VectorXd& draw) {
+        if (draw.size() != num_params())
+          throw std::invalid_argument("add(chain, draw): number of values"
+                                      " in draw does not match chains");
+        while (num_chains() <= chain) {
+          batches_.push_back(std::vector<batch_means>
+                             (num_params(), batch_means(max_batches_)));
+          sketches_.push_back(std::vector<quantile_sketch>
+                              (num_params(), quantile_sketch(sketch_size_)));
+        }
+        for (int index = 0; index < num_params(); index++) {
+          batches_[chain][index].add(draw(index));
+          sketches_[chain][index].add(draw(index));
+        }
+      }
+
+      /**
+       * Add each row of the specified matrix as a draw of the
+       * specified chain.
+       *
+       * @param chain Chain.
+       * @param sample Draws, one per row.
+       */
+      void add(const int chain, const Eigen::MatrixXd& sample) {
+        for (int row = 0; row < sample.rows(); row++)
+          add(chain, Eigen::VectorXd(sample.row(row).transpose()));
+      }
+
+      double mean(const int chain, const int index) const {
+        return batches_[chain][index].moments().mean_;
+      }
+
+      double mean(const int index) const {
+        running_moments all;
+        for (int chain = 0; chain < num_chains(); chain++)
+          all.merge(batches_[chain][index].moments());
+        return all.mean_;
+      }
+
+      double variance(const int chain, const int index) const {
+        return batches_[chain][index].moments().variance();
+      }
+
+      double variance(const int index) const {
+        running_moments all;
+        for (int chain = 0; chain < num_chains(); chain++)
+          all.merge(batches_[chain][index].moments());
+        return all.variance();
+      }
+
+      double sd(const int chain, const int index) const {
+        return std::sqrt(variance(chain, index));
+      }
+
+      double sd(const int index) const {
+        return std::sqrt(variance(index));
+      }
+
+      double quantile(const int chain, const int index,
+                      const double prob) const {
+        return sketches_[chain][index].quantile(prob);
+      }
+
+      /**
+       * Return the estimated quantile of the specified parameter
+       * across all chains, from the merged sketches of the chains.
+       *
+       * @param index Parameter index.
+       * @param prob Probability.
+       * @return Quantile.
+       */
+      double quantile(const int index, const double prob) const {
+        quantile_sketch all(sketch_size_);
+        for (int chain = 0; chain < num_chains(); chain++)
+          all.merge(sketches_[chain][index]);
+        return all.quantile(prob);
+      }
+
+      Eigen::VectorXd quantiles(const int index,
+                                const Eigen::VectorXd& probs) const {
+        quantile_sketch all(sketch_size_);
+        for (int chain = 0; chain < num_chains(); chain++)
+          all.merge(sketches_[chain][index]);
+        Eigen::VectorXd q(probs.size());
+        for (int i = 0; i < probs.size(); i++)
+          q(i) = all.quantile(probs(i));
+        return q;
+      }
+
+      /**
+       * Return the effective sample size of the specified parameter
+       * across all chains, estimated from batch means.
+       *
+       * @param index Parameter index.
+       * @return Effective sample size.
+       */
+      double effective_sample_size(const int index) const {
+        int chains = num_chains();
+        double n_samples = min_num_samples();
+        Eigen::VectorXd chain_mean(chains);
+        Eigen::VectorXd chain_var(chains);
+        Eigen::VectorXd chain_asymptotic_var(chains);
+        for (int chain = 0; chain < chains; chain++) {
+          const batch_means& batches = batches_[chain][index];
+          chain_mean(chain) = batches.moments().mean_;
+          chain_var(chain) = batches.moments().variance();
+          chain_asymptotic_var(chain) = batches.asymptotic_variance();
+        }
+        double mean_var = mean(chain_var);
+        double var_plus = mean_var * (n_samples - 1) / n_samples;
+        if (chains > 1)
+          var_plus += variance(chain_mean);
+        return chains * n_samples * var_plus / mean(chain_asymptotic_var);
+      }
+
+      /**
+       * Return the split potential scale reduction (split R hat) of
+       * the specified parameter, splitting each chain at the batch
+       * boundary nearest its middle.
+       *
+       * @param index Parameter index.
+       * @return Split potential scale reduction.
+       */
+      double split_potential_scale_reduction(const int index) const {
+        int chains = num_chains();
+        Eigen::VectorXd split_chain_mean(2 * chains);
+        Eigen::VectorXd split_chain_var(2 * chains);
+        double n = std::numeric_limits<double>::infinity();
+        for (int chain = 0; chain < chains; chain++) {
+          running_moments first;
+          running_moments second;
+          batches_[chain][index].split(first, second);
+          split_chain_mean(2 * chain) = first.mean_;
+          split_chain_mean(2 * chain + 1) = second.mean_;
+          split_chain_var(2 * chain) = first.variance();
+          split_chain_var(2 * chain + 1) = second.variance();
+          n = std::min(n, std::min(first.n_, second.n_));
+        }
+
+        double var_between = n * variance(split_chain_mean);
+        double var_within = mean(split_chain_var);
+
+        // rewrote [(n-1)*W/n + B/n]/W as (n-1+ B/W)/n
+        return std::sqrt((var_between / var_within + n - 1) / n);
+      }
+
+      double effective_sample_size(const std::string& name) const {
+        return effective_sample_size(index(name));
+      }
+
+      double split_potential_scale_reduction(const std::string& name) const {
+        return split_potential_scale_reduction(index(name));
+      }
+
+      double quantile(const std::string& name, const double prob) const {
+        return quantile(index(name), prob);
+      }
+
+      double mean(const std::string& name) const {
+        return mean(index(name));
+      }
+
+      double sd(const std::string& name) const {
+        return sd(index(name));
+      }
+    };
+
+  }
+}
+#endif
@@ -0,0 +1,89 @@
+#ifndef STAN_MCMC_SUMMARIZE_CHAINS_HPP
+#define STAN_MCMC_SUMMARIZE_CHAINS_HPP
+
+#include <stan/mcmc/autocovariance_fft.hpp>
+#include <stan/mcmc/chains.hpp>
+#include <stan/services/util/parallel_for.hpp>
+#include <Eigen/Dense>
+#include <algorithm>
+
+namespace stan {
+  namespace mcmc {
+
+    /**
+     * Functor writing the summaries of a contiguous block of the
+     * parameters of a set of chains into the matching rows of a
+     * matrix, with one <code>autocovariance_fft</code> for the block.
+     *
+     * @tparam RNG type of random number generator of the chains
+     */
+    template <class RNG>
+    class summarize_parameter_functor {
+    private:
+      const chains<RNG>& chains_;
+      const Eigen::VectorXd& probs_;
+      Eigen::MatrixXd& summaries_;
+      size_t num_blocks_;
+
+    public:
+      summarize_parameter_functor(const chains<RNG>& chains,
+                                  const Eigen::VectorXd& probs,
+                                  Eigen::MatrixXd& summaries,
+                                  size_t num_blocks)
+        : chains_(chains), probs_(probs), summaries_(summaries),
+          num_blocks_(num_blocks) { }
+
+      /**
+       * Summarize the parameters in the b-th block.
+       *
+       * @param[in] b index of block
+       */
+      void operator()(size_t b) {
+        size_t begin = b * chains_.num_params() / num_blocks_;
+        size_t end = (b + 1) * chains_.num_params() / num_blocks_;
+        autocovariance_fft fft;
+        for (size_t n = begin; n < end; ++n)
+          summaries_.row(n)
+            = chains_.summary(static_cast<int>(n), probs_, fft);
+      }
+    };
+
+    /**
+     * Return summaries of every parameter of the specified chains,
+     * computed concurrently for different parameters on up to the
+     * specified number of threads.
+     *
+     * <p>Row <code>n</code> summarizes parameter <code>n</code>.  Its
+     * columns are the mean, the Monte Carlo standard error of the
+     * mean, the standard deviation, the quantiles at each of the
+     * specified probabilities, the effective sample size and the
+     * split potential scale reduction, as computed by
+     * <code>chains::summary()</code>.
+     *
+     * <p>The parameters are split into one block per thread and each
+     * block reuses a single FFT plan and set of buffers.
+     * Autocovariances are computed one parameter at a time and not
+     * cached, so no copy of the draws is kept.
+     *
+     * @tparam RNG type of random number generator of the chains
+     * @param[in] chains chains to summarize, with at least one chain
+     * @param[in] probs probabilities of quantiles
+     * @param[in] num_threads maximum number of threads to use
+     * @return matrix of summaries, one row per parameter
+     */
+    template <class RNG>
+    Eigen::MatrixXd summarize_chains(const chains<RNG>& chains,
+                                     const Eigen::VectorXd& probs,
+                                     int num_threads) {
+      Eigen::MatrixXd summaries(chains.num_params(), 5 + probs.size());
+      int num_blocks = std::min(chains.num_params(),
+                                std::max(num_threads, 1));
+      summarize_parameter_functor<RNG> summarize(chains, probs, summaries,
+                                                 num_blocks);
+      stan::services::util::parallel_for(num_blocks, num_blocks, summarize);
+      return summaries;
+    }
+
+  }
+}
+#endif
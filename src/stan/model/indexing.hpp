@@ -7,5 +7,6 @@
 #include <stan/model/indexing/lvalue.hpp>
 #include <stan/model/indexing/rvalue.hpp>
 #include <stan/model/indexing/rvalue_return.hpp>
+#include <stan/model/indexing/rvalue_view.hpp>
 
 #endif
@@ -0,0 +1,307 @@
+#ifndef STAN_MODEL_INDEXING_RVALUE_VIEW_HPP
+#define STAN_MODEL_INDEXING_RVALUE_VIEW_HPP
+
+#include <boost/utility/enable_if.hpp>
+#include <boost/type_traits/integral_constant.hpp>
+#include <Eigen/Dense>
+#include <stan/math/prim/mat.hpp>
+#include <stan/model/indexing/index.hpp>
+#include <stan/model/indexing/index_list.hpp>
+#include <stan/model/indexing/rvalue_at.hpp>
+#include <stan/model/indexing/rvalue_index_size.hpp>
+
+namespace stan {
+
+  namespace model {
+
+    // views share storage with the indexed container, which must
+    // outlive them; indexing from 1 as for rvalue()
+
+    /**
+     * Metaprogram to determine whether an index selects a contiguous
+     * range of positions.  True for omni, min, max and min-max
+     * indexes, false otherwise.
+     *
+     * @tparam I Index type.
+     */
+    template <typename I>
+    struct is_contiguous_index : boost::false_type { };
+
+    template <>
+    struct is_contiguous_index<index_omni> : boost::true_type { };
+
+    template <>
+    struct is_contiguous_index<index_min> : boost::true_type { };
+
+    template <>
+    struct is_contiguous_index<index_max> : boost::true_type { };
+
+    template <>
+    struct is_contiguous_index<index_min_max> : boost::true_type { };
+
+    /**
+     * Return the zero-based start of the positions selected by the
+     * specified contiguous index in a dimension of the specified
+     * size, setting the number of positions selected.
+     *
+     * @tparam I Contiguous index type.
+     * @param[in] idx Index.
+     * @param[in] size Size of dimension being indexed.
+     * @param[out] n Number of positions selected.
+     * @param[in] function Name of indexing operation for errors.
+     * @param[in] name String form of expression being evaluated.
+     * @return Zero-based start of positions selected.
+     * @throw std::out_of_range If the first or last selected position
+     * is out of bounds.
+     */
+    template <typename I>
+    inline int rvalue_view_start(const I& idx, int size, int& n,
+                                 const char* function, const char* name) {
+      n = rvalue_index_size(idx, size);
+      if (n <= 0) {
+        n = 0;
+        return 0;
+      }
+      int first = rvalue_at(0, idx);
+      math::check_range(function, name, size, first);
+      math::check_range(function, name, size, first + n - 1);
+      return first - 1;
+    }
+
+    /**
+     * Return a view of the specified Eigen vector under a contiguous
+     * index without copying its elements.
+     *
+     * Types:  vec[contiguous] : vec
+     *
+     * @tparam T Scalar type.
+     * @tparam I Contiguous index type.
+     * @param[in] v Vector being indexed.
+     * @param[in] idx Index consisting of one contiguous index.
+     * @param[in] name String form of expression being evaluated.
+     * @param[in] depth Depth of indexing dimension.
+     * @return View of selected elements of vector.
+     */
+    template <typename T, typename I>
+    inline typename boost::enable_if<is_contiguous_index<I>,
+                  Eigen::VectorBlock<const Eigen::Matrix<T, Eigen::Dynamic, 1>
+                                     > >::type
+    rvalue_view(const Eigen::Matrix<T, Eigen::Dynamic, 1>& v,
+                const cons_index_list<I, nil_index_list>& idx,
+                const char* name = "ANON", int depth = 0) {
+      int n;
+      int start = rvalue_view_start(idx.head_, v.size(), n,
+                                    "vector[multi] indexing", name);
+      return v.segment(start, n);
+    }
+
+    /**
+     * Return a view of the specified Eigen row vector under a
+     * contiguous index without copying its elements.
+     *
+     * Types:  rowvec[contiguous] : rowvec
+     *
+     * @tparam T Scalar type.
+     * @tparam I Contiguous index type.
+     * @param[in] rv Row vector being indexed.
+     * @param[in] idx Index consisting of one contiguous index.
+     * @param[in] name String form of expression being evaluated.
+     * @param[in] depth Depth of indexing dimension.
+     * @return View of selected elements of row vector.
+     */
+    template <typename T, typename I>
+    inline typename boost::enable_if<is_contiguous_index<I>,
+                  Eigen::VectorBlock<const Eigen::Matrix<T, 1, Eigen::Dynamic>
+                                     > >::type
+    rvalue_view(const Eigen::Matrix<T, 1, Eigen::Dynamic>& rv,
+                const cons_index_list<I, nil_index_list>& idx,
+                const char* name = "ANON", int depth = 0) {
+      int n;
+      int start = rvalue_view_start(idx.head_, rv.size(), n,
+                                    "row_vector[multi] indexing", name);
+      return rv.segment(start, n);
+    }
+
+    /**
+     * Return a view of a row of the specified Eigen matrix without
+     * copying its elements.
+     *
+     * Types:  mat[single] : rowvec
+     *
+     * @tparam T Scalar type.
+     * @param[in] a Matrix being indexed.
+     * @param[in] idx Index consisting of one single index.
+     * @param[in] name String form of expression being evaluated.
+     * @param[in] depth Depth of indexing dimension.
+     * @return View of row of matrix.
+     */
+    template <typename T>
+    inline Eigen::Block<const Eigen::Matrix<T, Eigen::Dynamic,
+                                            Eigen::Dynamic> >
+    rvalue_view(const Eigen::Matrix<T, Eigen::Dynamic, Eigen::Dynamic>& a,
+                const cons_index_list<index_uni, nil_index_list>& idx,
+                const char* name = "ANON", int depth = 0) {
+      int m = idx.head_.n_;
+      math::check_range("matrix[uni] indexing", name, a.rows(), m);
+      return a.block(m - 1, 0, 1, a.cols());
+    }
+
+    /**
+     * Return a view of a contiguous range of rows of the specified
+     * Eigen matrix without copying its elements.
+     *
+     * Types:  mat[contiguous] : mat
+     *
+     * @tparam T Scalar type.
+     * @tparam I Contiguous index type.
+     * @param[in] a Matrix being indexed.
+     * @param[in] idx Index consisting of one contiguous index.
+     * @param[in] name String form of expression being evaluated.
+     * @param[in] depth Depth of indexing dimension.
+     * @return View of selected rows of matrix.
+     */
+    template <typename T, typename I>
+    inline typename boost::enable_if<is_contiguous_index<I>,
+                  Eigen::Block<const Eigen::Matrix<T, Eigen::Dynamic,
+                                                   Eigen::Dynamic> > >::type
+    rvalue_view(const Eigen::Matrix<T, Eigen::Dynamic, Eigen::Dynamic>& a,
+                const cons_index_list<I, nil_index_list>& idx,
+                const char* name = "ANON", int depth = 0) {
+      int n;
+      int start = rvalue_view_start(idx.head_, a.rows(), n,
+                                    "matrix[multi] indexing", name);
+      return a.block(start, 0, n, a.cols());
+    }
+
+    /**
+     * Return a view of part of a row of the specified Eigen matrix
+     * without copying its elements.
+     *
+     * Types:  mat[single, contiguous] : rowvec
+     *
+     * @tparam T Scalar type.
+     * @tparam I Contiguous index type.
+     * @param[in] a Matrix being indexed.
+     * @param[in] idx Single row index and contiguous column index.
+     * @param[in] name String form of expression being evaluated.
+     * @param[in] depth Depth of indexing dimension.
+     * @return View of selected elements of matrix.
+     */
+    template <typename T, typename I>
+    inline typename boost::enable_if<is_contiguous_index<I>,
+                  Eigen::Block<const Eigen::Matrix<T, Eigen::Dynamic,
+                                                   Eigen::Dynamic> > >::type
+    rvalue_view(const Eigen::Matrix<T, Eigen::Dynamic, Eigen::Dynamic>& a,
+                const cons_index_list<index_uni,
+                                      cons_index_list<I, nil_index_list> >&
+                idx,
+                const char* name = "ANON", int depth = 0) {
+      int m = idx.head_.n_;
+      math::check_range("matrix[uni,multi] indexing, row", name, a.rows(), m);
+      int n;
+      int start = rvalue_view_start(idx.tail_.head_, a.cols(), n,
+                                    "matrix[uni,multi] indexing, col", name);
+      return a.block(m - 1, start, 1, n);
+    }
+
+    /**
+     * Return a view of part of a column of the specified Eigen matrix
+     * without copying its elements.
+     *
+     * Types:  mat[contiguous, single] : vec
+     *
+     * @tparam T Scalar type.
+     * @tparam I Contiguous index type.
+     * @param[in] a Matrix being indexed.
+     * @param[in] idx Contiguous row index and single column index.
+     * @param[in] name String form of expression being evaluated.
+     * @param[in] depth Depth of indexing dimension.
+     * @return View of selected elements of matrix.
+     */
+    template <typename T, typename I>
+    inline typename boost::enable_if<is_contiguous_index<I>,
+                  Eigen::Block<const Eigen::Matrix<T, Eigen::Dynamic,
+                                                   Eigen::Dynamic> > >::type
+    rvalue_view(const Eigen::Matrix<T, Eigen::Dynamic, Eigen::Dynamic>& a,
+                const cons_index_list<I,
+                                      cons_index_list<index_uni,
+                                                      nil_index_list> >& idx,
+                const char* name = "ANON", int depth = 0) {
+      int n = idx.tail_.head_.n_;
+      math::check_range("matrix[multi,uni] index col", name, a.cols(), n);
+      int m;
+      int start = rvalue_view_start(idx.head_, a.rows(), m,
+                                    "matrix[multi,uni] index row", name);
+      return a.block(start, n - 1, m, 1);
+    }
+
+    /**
+     * Return a view of a block of the specified Eigen matrix without
+     * copying its elements.
+     *
+     * Types:  mat[contiguous, contiguous] : mat
+     *
+     * @tparam T Scalar type.
+     * @tparam I1 Contiguous row index type.
+     * @tparam I2 Contiguous column index type.
+     * @param[in] a Matrix being indexed.
+     * @param[in] idx Contiguous row and column indexes.
+     * @param[in] name String form of expression being evaluated.
+     * @param[in] depth Depth of indexing dimension.
+     * @return View of selected elements of matrix.
+     */
+    template <typename T, typename I1, typename I2>
+    inline typename boost::enable_if_c<is_contiguous_index<I1>::value
+                                       && is_contiguous_index<I2>::value,
+                  Eigen::Block<const Eigen::Matrix<T, Eigen::Dynamic,
+                                                   Eigen::Dynamic> > >::type
+    rvalue_view(const Eigen::Matrix<T, Eigen::Dynamic, Eigen::Dynamic>& a,
+                const cons_index_list<I1,
+                                      cons_index_list<I2, nil_index_list> >&
+                idx,
+                const char* name = "ANON", int depth = 0) {
+      int m;
+      int row_start = rvalue_view_start(idx.head_, a.rows(), m,
+                                        "matrix[multi,multi] row indexing",
+                                        name);
+      int n;
+      int col_start = rvalue_view_start(idx.tail_.head_, a.cols(), n,
+                                        "matrix[multi,multi] col indexing",
+                                        name);
+      return a.block(row_start, col_start, m, n);
+    }
+
+    /**
+     * Assign the specified Eigen expression, such as a view returned
+     * by <code>rvalue_view()</code>, to the specified Eigen matrix
+     * element by element, without evaluating the expression into a
+     * temporary.  The sizes must match.
+     *
+     * Types:  x <- y
+     *
+     * @tparam T Assigned matrix scalar type.
+     * @tparam R Assigned matrix rows at compile time.
+     * @tparam C Assigned matrix columns at compile time.
+     * @tparam Derived Type of Eigen expression (scalar must be
+     * assignable to T).
+     * @param[in] x Matrix variable to be assigned.
+     * @param[in] y Value expression.
+     * @param[in] name Name of variable (default "ANON").
+     * @throw std::invalid_argument If the sizes do not match.
+     */
+    template <typename T, int R, int C, typename Derived>
+    inline void assign_view(Eigen::Matrix<T, R, C>& x,
+                            const Eigen::MatrixBase<Derived>& y,
+                            const char* name = "ANON") {
+      math::check_size_match(name, "left-hand side rows", x.rows(),
+                             "right-hand side rows", y.rows());
+      math::check_size_match(name, "left-hand side cols", x.cols(),
+                             "right-hand side cols", y.cols());
+      for (int j = 0; j < y.cols(); ++j)
+        for (int i = 0; i < y.rows(); ++i)
+          x(i, j) = y(i, j);
+    }
+
+  }
+}
+#endif
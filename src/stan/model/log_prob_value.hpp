@@ -0,0 +1,115 @@
+#ifndef STAN_MODEL_LOG_PROB_VALUE_HPP
+#define STAN_MODEL_LOG_PROB_VALUE_HPP
+
+#include <stan/math/prim/mat/fun/Eigen.hpp>
+#include <boost/utility/enable_if.hpp>
+#include <iostream>
+#include <vector>
+
+namespace stan {
+
+  namespace model {
+
+    /**
+     * Trait whose value is true if the model class provides the
+     * value-only method <code>log_prob_value</code>, which models
+     * signal by setting the static member
+     * <code>has_log_prob_value__</code> to true.
+     *
+     * @tparam M class of model
+     */
+    template <class M, class Enable = void>
+    struct has_log_prob_value {
+      static const bool value = false;
+    };
+
+    template <class M>
+    struct has_log_prob_value
+    <M, typename boost::enable_if_c<M::has_log_prob_value__>::type> {
+      static const bool value = true;
+    };
+
+    template <bool propto, bool jacobian, bool value_only>
+    struct log_prob_value_impl {
+      template <class M, class V>
+      static double apply(const M& model, V& params_r,
+                          std::vector<int>& params_i, std::ostream* msgs) {
+        return model.template log_prob<propto, jacobian>(params_r, params_i,
+                                                         msgs);
+      }
+
+      template <class M, class V>
+      static double apply(const M& model, V& params_r, std::ostream* msgs) {
+        return model.template log_prob<propto, jacobian>(params_r, msgs);
+      }
+    };
+
+    template <bool propto, bool jacobian>
+    struct log_prob_value_impl<propto, jacobian, true> {
+      template <class M, class V>
+      static double apply(const M& model, V& params_r,
+                          std::vector<int>& params_i, std::ostream* msgs) {
+        return model.template log_prob_value<propto, jacobian>(params_r,
+                                                               params_i,
+                                                               msgs);
+      }
+
+      template <class M, class V>
+      static double apply(const M& model, V& params_r, std::ostream* msgs) {
+        return model.template log_prob_value<propto, jacobian>(params_r,
+                                                               msgs);
+      }
+    };
+
+    /**
+     * Return the log density of the specified model at the
+     * specified parameters without computing gradients.  Models
+     * generated with a value-only evaluation path are evaluated
+     * through it; other models fall back to
+     * <code>log_prob</code> instantiated with <code>double</code>.
+     *
+     * @tparam propto true if terms not depending on parameters are
+     * dropped
+     * @tparam jacobian true if the Jacobian adjustment is included
+     * @tparam M class of model
+     * @param[in] model model
+     * @param[in] params_r real-valued parameters
+     * @param[in] params_i integer-valued parameters
+     * @param[in,out] msgs stream for messages
+     * @return log density
+     */
+    template <bool propto, bool jacobian, class M>
+    double log_prob_value(const M& model,
+                          std::vector<double>& params_r,
+                          std::vector<int>& params_i,
+                          std::ostream* msgs = 0) {
+      return log_prob_value_impl<propto, jacobian,
+                                 has_log_prob_value<M>::value>
+        ::apply(model, params_r, params_i, msgs);
+    }
+
+    /**
+     * Return the log density of the specified model at the
+     * specified parameters without computing gradients.
+     *
+     * @tparam propto true if terms not depending on parameters are
+     * dropped
+     * @tparam jacobian true if the Jacobian adjustment is included
+     * @tparam M class of model
+     * @param[in] model model
+     * @param[in] params_r real-valued parameters
+     * @param[in,out] msgs stream for messages
+     * @return log density
+     */
+    template <bool propto, bool jacobian, class M>
+    double log_prob_value(const M& model,
+                          Eigen::VectorXd& params_r,
+                          std::ostream* msgs = 0) {
+      return log_prob_value_impl<propto, jacobian,
+                                 has_log_prob_value<M>::value>
+        ::apply(model, params_r, msgs);
+    }
+
+  }
+}
+#endif
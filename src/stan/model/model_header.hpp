@@ -11,6 +11,9 @@
 
 #include <stan/lang/rethrow_located.hpp>
 #include <stan/model/prob_grad.hpp>
+#include <stan/model/reduce_sum.hpp>
+#include <stan/model/sufficient_stats.hpp>
+#include <stan/model/value_accumulator.hpp>
 #include <stan/model/indexing.hpp>
 #include <stan/services/util/create_rng.hpp>
 
@@ -20,6 +20,13 @@ namespace stan {
       std::vector<std::pair<int, int> > param_ranges_i__;
 
     public:
+      /**
+       * True if the model provides the value-only method
+       * <code>log_prob_value</code>; generated models that do
+       * redefine this flag.  See <code>stan::model::log_prob_value</code>.
+       */
+      static const bool has_log_prob_value__ = false;
+
       explicit prob_grad(size_t num_params_r)
         : num_params_r__(num_params_r),
           param_ranges_i__(std::vector<std::pair<int, int> >(0)) {
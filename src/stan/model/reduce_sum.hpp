@@ -0,0 +1,344 @@
+#ifndef STAN_MODEL_REDUCE_SUM_HPP
+#define STAN_MODEL_REDUCE_SUM_HPP
+
+#include <stan/math/rev/core.hpp>
+#include <stan/math/prim/mat/fun/Eigen.hpp>
+#include <stan/math/prim/scal/err/check_nonnegative.hpp>
+#include <stan/math/prim/scal/err/check_positive.hpp>
+#include <stan/services/util/parallel_for.hpp>
+#include <algorithm>
+#include <cstddef>
+#include <cstdlib>
+#include <ostream>
+#include <sstream>
+#include <string>
+#include <thread>
+#include <vector>
+
+namespace stan {
+
+  namespace model {
+
+    /**
+     * Return the number of threads requested by the specified value
+     * of the environment variable <code>STAN_NUM_THREADS</code>.  A
+     * value of -1 requests one thread per hardware thread; a null,
+     * invalid or smaller value requests one thread.
+     *
+     * @param env value of <code>STAN_NUM_THREADS</code>, or null if
+     * it is not set
+     * @return number of threads
+     */
+    inline int reduce_sum_parse_num_threads(const char* env) {
+      if (env == 0)
+        return 1;
+      int num_threads = std::atoi(env);
+      if (num_threads == -1)
+        return std::max(1, static_cast<int>(
+                               std::thread::hardware_concurrency()));
+      return std::max(1, num_threads);
+    }
+
+    /**
+     * Return the number of threads used to evaluate the chunks of a
+     * <code>reduce_sum</code>, read from the environment variable
+     * <code>STAN_NUM_THREADS</code> as described for
+     * <code>reduce_sum_parse_num_threads</code>.  The variable is
+     * read once, on the first call, rather than on every log density
+     * evaluation.
+     *
+     * @return number of threads
+     */
+    inline int reduce_sum_num_threads() {
+      static const int num_threads
+        = reduce_sum_parse_num_threads(std::getenv("STAN_NUM_THREADS"));
+      return num_threads;
+    }
+
+    /**
+     * Functor evaluating one chunk of positions of a
+     * <code>reduce_sum</code> for <code>parallel_for</code>.  Chunk
+     * <code>c</code> covers positions <code>c * grainsize + 1</code>
+     * through <code>min((c + 1) * grainsize, N)</code>.
+     *
+     * <p>For <code>double</code> parameters the partial sums are
+     * plain values.  For <code>var</code> parameters each chunk is
+     * evaluated with nested autodiff on copies of the parameter
+     * values, recording its value and gradient and recovering the
+     * nested memory before returning, so that chunks share nothing
+     * on the autodiff stack.  Messages are written to a stream per
+     * chunk and copied to the output stream in chunk order by
+     * <code>write_messages()</code>.
+     *
+     * @tparam F type of partial sum functor
+     * @tparam T scalar type of parameters
+     */
+    template <class F, typename T>
+    struct reduce_sum_chunk {
+      const F& f_;
+      int n_;
+      int grainsize_;
+      const Eigen::Matrix<T, Eigen::Dynamic, 1>& theta_;
+      const std::vector<double>& x_r_;
+      const std::vector<int>& x_i_;
+      std::ostream* msgs_;
+      std::vector<double> sums_;
+      std::vector<Eigen::VectorXd> grads_;
+      std::vector<std::string> messages_;
+
+      reduce_sum_chunk(const F& f, int n, int grainsize,
+                       const Eigen::Matrix<T, Eigen::Dynamic, 1>& theta,
+                       const std::vector<double>& x_r,
+                       const std::vector<int>& x_i, std::ostream* msgs,
+                       std::size_t num_chunks)
+        : f_(f), n_(n), grainsize_(grainsize), theta_(theta), x_r_(x_r),
+          x_i_(x_i), msgs_(msgs), sums_(num_chunks), grads_(num_chunks),
+          messages_(num_chunks) {
+      }
+
+      int start(std::size_t c) const {
+        return static_cast<int>(c) * grainsize_ + 1;
+      }
+
+      int end(std::size_t c) const {
+        return std::min(start(c) + grainsize_ - 1, n_);
+      }
+
+      /**
+       * Return the partial sum of the c-th chunk for the specified
+       * parameters, keeping the messages it prints for
+       * <code>write_messages()</code>.
+       *
+       * @tparam S scalar type of parameters
+       * @param c index of chunk
+       * @param theta parameters
+       * @return partial sum
+       */
+      template <typename S>
+      S partial_sum(std::size_t c,
+                    const Eigen::Matrix<S, Eigen::Dynamic, 1>& theta) {
+        std::stringstream msgs;
+        try {
+          S sum = f_(start(c), end(c), theta, x_r_, x_i_,
+                     msgs_ ? &msgs : 0);
+          messages_[c] = msgs.str();
+          return sum;
+        } catch (...) {
+          messages_[c] = msgs.str();
+          throw;
+        }
+      }
+
+      /**
+       * Write the messages of every chunk to the output stream, if
+       * there is one, in chunk order.
+       */
+      void write_messages() const {
+        if (!msgs_)
+          return;
+        for (std::size_t c = 0; c < messages_.size(); ++c)
+          *msgs_ << messages_[c];
+      }
+
+      void operator()(std::size_t c) {
+        sums_[c] = partial_sum(c, theta_);
+      }
+    };
+
+    template <class F>
+    struct reduce_sum_chunk<F, math::var>
+      : public reduce_sum_chunk<F, double> {
+      reduce_sum_chunk(const F& f, int n, int grainsize,
+                       const Eigen::VectorXd& theta_val,
+                       const std::vector<double>& x_r,
+                       const std::vector<int>& x_i, std::ostream* msgs,
+                       std::size_t num_chunks)
+        : reduce_sum_chunk<F, double>(f, n, grainsize, theta_val, x_r, x_i,
+                                      msgs, num_chunks) {
+      }
+
+      void operator()(std::size_t c) {
+        math::start_nested();
+        try {
+          Eigen::Matrix<math::var, Eigen::Dynamic, 1>
+            theta(this->theta_.size());
+          for (int k = 0; k < theta.size(); ++k)
+            theta(k) = this->theta_(k);
+          math::var sum = this->partial_sum(c, theta);
+          this->sums_[c] = sum.val();
+          math::set_zero_all_adjoints_nested();
+          math::grad(sum.vi_);
+          this->grads_[c].resize(theta.size());
+          for (int k = 0; k < theta.size(); ++k)
+            this->grads_[c](k) = theta(k).adj();
+        } catch (...) {
+          math::recover_memory_nested();
+          throw;
+        }
+        math::recover_memory_nested();
+      }
+    };
+
+    /**
+     * Return the number of chunks of the specified size covering the
+     * specified number of positions, validating the arguments of a
+     * <code>reduce_sum</code>.
+     *
+     * @param n number of positions
+     * @param grainsize number of positions per chunk
+     * @return number of chunks
+     * @throw std::domain_error if the number of positions is
+     * negative or the grainsize is not positive
+     */
+    inline std::size_t reduce_sum_num_chunks(int n, int grainsize) {
+      static const char* function = "reduce_sum";
+      math::check_nonnegative(function, "number of terms", n);
+      math::check_positive(function, "grainsize", grainsize);
+      return (static_cast<std::size_t>(n) + grainsize - 1) / grainsize;
+    }
+
+    /**
+     * Return the sum of <code>f(start, end, theta, x_r, x_i,
+     * msgs)</code> over chunks <code>[start, end]</code> of the
+     * positions <code>1:N</code>, each holding
+     * <code>grainsize</code> positions except possibly the last.
+     * Chunks are evaluated on <code>reduce_sum_num_threads()</code>
+     * threads and their sums added in chunk order, so the result does
+     * not depend on the number of threads.  As the partial sum
+     * functor may use nested autodiff even for <code>double</code>
+     * parameters, chunks run in parallel only if the math library is
+     * built with <code>STAN_THREADS</code>.
+     *
+     * <p>The partial sum functor must not depend on any state shared
+     * between chunks.  Messages it prints are buffered per chunk and
+     * written to <code>msgs</code> in chunk order after the chunks
+     * are evaluated, including when one of them throws.
+     *
+     * @tparam F type of partial sum functor
+     * @param f partial sum functor
+     * @param n number of positions
+     * @param grainsize number of positions per chunk
+     * @param theta parameters
+     * @param x_r real data
+     * @param x_i integer data
+     * @param msgs stream for messages
+     * @return sum over all positions
+     * @throw std::domain_error if the number of positions is
+     * negative or the grainsize is not positive
+     */
+    template <class F>
+    double reduce_sum(const F& f, int n, int grainsize,
+                      const Eigen::Matrix<double, Eigen::Dynamic, 1>& theta,
+                      const std::vector<double>& x_r,
+                      const std::vector<int>& x_i, std::ostream* msgs) {
+      std::size_t num_chunks = reduce_sum_num_chunks(n, grainsize);
+      reduce_sum_chunk<F, double> chunk(f, n, grainsize, theta, x_r, x_i,
+                                        msgs, num_chunks);
+      try {
+        services::util::parallel_for(
+            num_chunks,
+            services::util::num_autodiff_threads(reduce_sum_num_threads()),
+            chunk);
+      } catch (...) {
+        chunk.write_messages();
+        throw;
+      }
+      chunk.write_messages();
+      double sum = 0;
+      for (std::size_t c = 0; c < num_chunks; ++c)
+        sum += chunk.sums_[c];
+      return sum;
+    }
+
+    /**
+     * Return the sum over chunks of the positions <code>1:N</code>
+     * as for the <code>double</code> overload, with its gradient with
+     * respect to the parameters.  Each chunk is differentiated with
+     * nested autodiff and the gradients are added in chunk order and
+     * attached to the result as precomputed gradients.  Chunks run in
+     * parallel only if the math library is built with
+     * <code>STAN_THREADS</code>, which gives each thread its own
+     * autodiff stack.
+     *
+     * @tparam F type of partial sum functor
+     * @param f partial sum functor
+     * @param n number of positions
+     * @param grainsize number of positions per chunk
+     * @param theta parameters
+     * @param x_r real data
+     * @param x_i integer data
+     * @param msgs stream for messages
+     * @return sum over all positions
+     * @throw std::domain_error if the number of positions is
+     * negative or the grainsize is not positive
+     */
+    template <class F>
+    math::var
+    reduce_sum(const F& f, int n, int grainsize,
+               const Eigen::Matrix<math::var, Eigen::Dynamic, 1>& theta,
+               const std::vector<double>& x_r, const std::vector<int>& x_i,
+               std::ostream* msgs) {
+      std::size_t num_chunks = reduce_sum_num_chunks(n, grainsize);
+      Eigen::VectorXd theta_val(theta.size());
+      for (int k = 0; k < theta.size(); ++k)
+        theta_val(k) = theta(k).val();
+      reduce_sum_chunk<F, math::var> chunk(f, n, grainsize, theta_val, x_r,
+                                           x_i, msgs, num_chunks);
+      try {
+        services::util::parallel_for(
+            num_chunks,
+            services::util::num_autodiff_threads(reduce_sum_num_threads()),
+            chunk);
+      } catch (...) {
+        chunk.write_messages();
+        throw;
+      }
+      chunk.write_messages();
+
+      double sum = 0;
+      std::vector<double> gradients(theta.size(), 0.0);
+      for (std::size_t c = 0; c < num_chunks; ++c) {
+        sum += chunk.sums_[c];
+        for (int k = 0; k < theta.size(); ++k)
+          gradients[k] += chunk.grads_[c](k);
+      }
+      std::vector<math::var> operands(theta.data(),
+                                      theta.data() + theta.size());
+      return math::precomputed_gradients(sum, operands, gradients);
+    }
+
+    /**
+     * Return the sum over chunks of the positions <code>1:N</code>
+     * for other autodiff types, evaluating the chunks serially.
+     *
+     * @tparam F type of partial sum functor
+     * @tparam T scalar type of parameters
+     * @param f partial sum functor
+     * @param n number of positions
+     * @param grainsize number of positions per chunk
+     * @param theta parameters
+     * @param x_r real data
+     * @param x_i integer data
+     * @param msgs stream for messages
+     * @return sum over all positions
+     * @throw std::domain_error if the number of positions is
+     * negative or the grainsize is not positive
+     */
+    template <class F, typename T>
+    T reduce_sum(const F& f, int n, int grainsize,
+                 const Eigen::Matrix<T, Eigen::Dynamic, 1>& theta,
+                 const std::vector<double>& x_r, const std::vector<int>& x_i,
+                 std::ostream* msgs) {
+      std::size_t num_chunks = reduce_sum_num_chunks(n, grainsize);
+      T sum(0);
+      for (std::size_t c = 0; c < num_chunks; ++c) {
+        int start = static_cast<int>(c) * grainsize + 1;
+        sum += f(start, std::min(start + grainsize - 1, n), theta, x_r, x_i,
+                 msgs);
+      }
+      return sum;
+    }
+
+  }
+}
+#endif
@@ -0,0 +1,272 @@
+#ifndef STAN_MODEL_SUFFICIENT_STATS_HPP
+#define STAN_MODEL_SUFFICIENT_STATS_HPP
+
+#include <stan/math/prim/scal.hpp>
+#include <cmath>
+#include <cstddef>
+#include <limits>
+
+namespace stan {
+
+  namespace model {
+
+    // statistics of a data vector (std::vector, Eigen vector or row
+    // vector) computed once by the constructor of models compiled
+    // with stanc --sufficient_stats; all are zero for empty data
+
+    /**
+     * Return the mean of the elements of the specified container,
+     * or zero if it is empty.  The mean is not a number if an
+     * element is not a number and is otherwise infinite if an
+     * element is infinite, even if elements of both signs are.
+     *
+     * @tparam C Type of container.
+     * @param[in] y Container.
+     * @return Mean of elements.
+     */
+    template <typename C>
+    inline double sufficient_mean(const C& y) {
+      if (y.size() == 0)
+        return 0;
+      double sum = 0;
+      double inf = 0;
+      for (size_t i = 0; i < static_cast<size_t>(y.size()); ++i) {
+        if (std::isnan(y[i]))
+          return y[i];
+        if (std::isinf(y[i]))
+          inf = y[i];
+        else
+          sum += y[i];
+      }
+      return inf != 0 ? inf : sum / y.size();
+    }
+
+    /**
+     * Return the sum of squared deviations of the elements of the
+     * specified container from their mean, or zero if it is empty.
+     * The deviations are computed from the mean rather than from the
+     * sum of squares to avoid cancellation.  The sum is infinite if
+     * an element is infinite and none is not a number.
+     *
+     * @tparam C Type of container.
+     * @param[in] y Container.
+     * @return Sum of squared deviations from the mean.
+     */
+    template <typename C>
+    inline double sufficient_sq_dev(const C& y) {
+      double y_bar = sufficient_mean(y);
+      if (std::isinf(y_bar))
+        return std::numeric_limits<double>::infinity();
+      double ss = 0;
+      for (size_t i = 0; i < static_cast<size_t>(y.size()); ++i)
+        ss += (y[i] - y_bar) * (y[i] - y_bar);
+      return ss;
+    }
+
+    /**
+     * Return the sum of the elements of the specified container of
+     * counts.  The sum is accumulated in a double because the sum of
+     * many large counts may not fit in an int.
+     *
+     * @tparam C Type of container.
+     * @param[in] y Container.
+     * @return Sum of elements.
+     */
+    template <typename C>
+    inline double sufficient_sum(const C& y) {
+      double sum = 0;
+      for (size_t i = 0; i < static_cast<size_t>(y.size()); ++i)
+        sum += y[i];
+      return sum;
+    }
+
+    /**
+     * Return the sum of the log factorials of the elements of the
+     * specified container of counts.
+     *
+     * @tparam C Type of container.
+     * @param[in] y Container.
+     * @return Sum of <code>lgamma(y[i] + 1)</code>.
+     */
+    template <typename C>
+    inline double sufficient_log_factorial(const C& y) {
+      double sum = 0;
+      for (size_t i = 0; i < static_cast<size_t>(y.size()); ++i)
+        sum += std::lgamma(y[i] + 1.0);
+      return sum;
+    }
+
+    /**
+     * Return the smallest element of the specified container of
+     * integers, or zero if it is empty.
+     *
+     * @tparam C Type of container.
+     * @param[in] y Container.
+     * @return Smallest element.
+     */
+    template <typename C>
+    inline int sufficient_min(const C& y) {
+      int min = y.size() == 0 ? 0 : y[0];
+      for (size_t i = 1; i < static_cast<size_t>(y.size()); ++i)
+        if (y[i] < min)
+          min = y[i];
+      return min;
+    }
+
+    /**
+     * Return the largest element of the specified container of
+     * integers, or zero if it is empty.
+     *
+     * @tparam C Type of container.
+     * @param[in] y Container.
+     * @return Largest element.
+     */
+    template <typename C>
+    inline int sufficient_max(const C& y) {
+      int max = y.size() == 0 ? 0 : y[0];
+      for (size_t i = 1; i < static_cast<size_t>(y.size()); ++i)
+        if (y[i] > max)
+          max = y[i];
+      return max;
+    }
+
+    /**
+     * Return the log of the normal density of <code>n</code> data
+     * points with the specified mean and sum of squared deviations
+     * given a scalar location and scale.  The result and the errors
+     * thrown are those of <code>normal_log&lt;propto&gt;</code>
+     * applied to the data, so terms are dropped in the same way,
+     * nothing is checked for empty data and infinite data have
+     * log density negative infinity.
+     *
+     * @tparam propto <code>true</code> to drop constant terms.
+     * @tparam T_loc Type of location.
+     * @tparam T_scale Type of scale.
+     * @param[in] n Number of data points.
+     * @param[in] y_bar Mean of data.
+     * @param[in] ss Sum of squared deviations of data from mean.
+     * @param[in] mu Location.
+     * @param[in] sigma Scale.
+     * @return Log density of data.
+     * @throw std::domain_error If the data are not a number, the
+     * location is not finite or the scale is not positive.
+     */
+    template <bool propto, typename T_loc, typename T_scale>
+    typename return_type<T_loc, T_scale>::type
+    normal_sufficient_log(int n, double y_bar, double ss, const T_loc& mu,
+                          const T_scale& sigma) {
+      static const char* function = "normal_lpdf";
+      using stan::math::include_summand;
+      using std::log;
+      typedef typename return_type<T_loc, T_scale>::type T_return;
+
+      if (n == 0)
+        return 0.0;
+      math::check_not_nan(function, "Random variable", y_bar);
+      math::check_not_nan(function, "Random variable", ss);
+      math::check_finite(function, "Location parameter", mu);
+      math::check_positive(function, "Scale parameter", sigma);
+      if (!include_summand<propto, T_loc, T_scale>::value)
+        return 0.0;
+      if (std::isinf(y_bar) || std::isinf(ss))
+        return math::LOG_ZERO;
+
+      T_return logp(0.0);
+      if (include_summand<propto>::value)
+        logp += math::NEG_LOG_SQRT_TWO_PI * n;
+      if (include_summand<propto, T_scale>::value)
+        logp -= n * log(sigma);
+      T_return diff = y_bar - mu;
+      logp -= 0.5 * (ss + n * diff * diff) / (sigma * sigma);
+      return logp;
+    }
+
+    /**
+     * Return the log of the Poisson mass of <code>n</code> counts
+     * with the specified sum, sum of log factorials and smallest
+     * element given a scalar rate.  The result and the errors thrown
+     * are those of <code>poisson_log&lt;propto&gt;</code> applied to
+     * the counts.
+     *
+     * @tparam propto <code>true</code> to drop constant terms.
+     * @tparam T_rate Type of rate.
+     * @param[in] n Number of counts.
+     * @param[in] sum Sum of counts.
+     * @param[in] log_factorial Sum of log factorials of counts.
+     * @param[in] min Smallest count.
+     * @param[in] lambda Rate.
+     * @return Log mass of counts.
+     * @throw std::domain_error If a count or the rate is negative or
+     * the rate is not a number.
+     */
+    template <bool propto, typename T_rate>
+    typename return_type<T_rate>::type
+    poisson_sufficient_log(int n, double sum, double log_factorial,
+                           int min, const T_rate& lambda) {
+      static const char* function = "poisson_lpmf";
+      using stan::math::include_summand;
+      using stan::math::multiply_log;
+      using stan::math::value_of;
+      typedef typename return_type<T_rate>::type T_return;
+
+      math::check_nonnegative(function, "Random variable", min);
+      math::check_nonnegative(function, "Rate parameter", lambda);
+      if (n == 0 || !include_summand<propto, T_rate>::value)
+        return 0.0;
+      if (std::isinf(value_of(lambda)))
+        return math::LOG_ZERO;
+      if (value_of(lambda) == 0)
+        return sum == 0 ? 0.0 : math::LOG_ZERO;
+
+      T_return logp(0.0);
+      if (include_summand<propto>::value)
+        logp -= log_factorial;
+      logp += multiply_log(sum, lambda) - n * lambda;
+      return logp;
+    }
+
+    /**
+     * Return the log of the Bernoulli mass of <code>n</code>
+     * outcomes with the specified sum and smallest and largest
+     * elements given a scalar chance of success.  The result and the
+     * errors thrown are those of <code>bernoulli_log&lt;propto&gt;</code>
+     * applied to the outcomes.
+     *
+     * @tparam propto <code>true</code> to drop constant terms.
+     * @tparam T_prob Type of chance of success.
+     * @param[in] n Number of outcomes.
+     * @param[in] sum Number of successes.
+     * @param[in] min Smallest outcome.
+     * @param[in] max Largest outcome.
+     * @param[in] theta Chance of success.
+     * @return Log mass of outcomes.
+     * @throw std::domain_error If an outcome is not 0 or 1 or the
+     * chance of success is not in [0, 1].
+     */
+    template <bool propto, typename T_prob>
+    typename return_type<T_prob>::type
+    bernoulli_sufficient_log(int n, int sum, int min, int max,
+                             const T_prob& theta) {
+      static const char* function = "bernoulli_lpmf";
+      using stan::math::include_summand;
+      using stan::math::log1m;
+      using std::log;
+
+      math::check_bounded(function, "n", min, 0, 1);
+      math::check_bounded(function, "n", max, 0, 1);
+      math::check_finite(function, "Probability parameter", theta);
+      math::check_bounded(function, "Probability parameter", theta,
+                          0.0, 1.0);
+      if (n == 0 || !include_summand<propto, T_prob>::value)
+        return 0.0;
+
+      if (sum == n)
+        return n * log(theta);
+      if (sum == 0)
+        return n * log1m(theta);
+      return sum * log(theta) + (n - sum) * log1m(theta);
+    }
+
+  }
+}
+#endif
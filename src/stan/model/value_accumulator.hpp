@@ -0,0 +1,82 @@
+#ifndef STAN_MODEL_VALUE_ACCUMULATOR_HPP
+#define STAN_MODEL_VALUE_ACCUMULATOR_HPP
+
+#include <stan/math/prim/mat/fun/Eigen.hpp>
+#include <cstddef>
+#include <vector>
+
+namespace stan {
+
+  namespace model {
+
+    /**
+     * Accumulator of log density terms for value-only evaluation.
+     * It has the interface of <code>stan::math::accumulator</code>
+     * used by generated code, but keeps a running sum instead of
+     * buffering the terms, so no memory is allocated.
+     */
+    class value_accumulator {
+    private:
+      double sum_;
+
+    public:
+      value_accumulator() : sum_(0) { }
+
+      /**
+       * Add the specified term to the sum.
+       *
+       * @param x term
+       */
+      inline void add(double x) {
+        sum_ += x;
+      }
+
+      /**
+       * Add the elements of the specified matrix or matrix
+       * expression to the sum.
+       *
+       * @tparam Derived type of matrix expression
+       * @param m matrix of terms
+       */
+      template <typename Derived>
+      inline void add(const Eigen::DenseBase<Derived>& m) {
+        sum_ += m.sum();
+      }
+
+      /**
+       * Add the elements of the specified array to the sum.
+       *
+       * @tparam T type of elements
+       * @param xs array of terms
+       */
+      template <typename T>
+      inline void add(const std::vector<T>& xs) {
+        for (size_t i = 0; i < xs.size(); ++i)
+          add(xs[i]);
+      }
+
+      /**
+       * Return the sum of the terms added so far.
+       *
+       * @return sum of terms
+       */
+      inline double sum() const {
+        return sum_;
+      }
+    };
+
+    /**
+     * Return the current value of the log density for the specified
+     * term and accumulator, as used for <code>target()</code>.
+     *
+     * @param lp log density term
+     * @param lp_accum accumulated terms
+     * @return sum of term and accumulated terms
+     */
+    inline double get_lp(double lp, const value_accumulator& lp_accum) {
+      return lp + lp_accum.sum();
+    }
+
+  }
+}
+#endif
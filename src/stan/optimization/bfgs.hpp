@@ -284,7 +284,18 @@ namespace stan {
       }
     };
 
-    template <class M>
+    /**
+     * Adapts a model to the functor interface of the BFGS minimizer,
+     * evaluating the negative log density.  The Jacobian adjustment
+     * for constrained parameters is included when
+     * <code>jacobian</code> is true, as needed when approximating the
+     * posterior on the unconstrained scale rather than finding the
+     * mode of the constrained density.
+     *
+     * @tparam M model class
+     * @tparam jacobian true to include the Jacobian adjustment
+     */
+    template <class M, bool jacobian = false>
     class ModelAdaptor {
     private:
       M& _model;
@@ -313,7 +324,7 @@ namespace stan {
           _x[i] = x[i];
 
         try {
-          f = - log_prob_propto<false>(_model, _x, _params_i, _msgs);
+          f = - log_prob_propto<jacobian>(_model, _x, _params_i, _msgs);
         } catch (const std::exception& e) {
           if (_msgs)
             (*_msgs) << e.what() << std::endl;
@@ -345,7 +356,8 @@ namespace stan {
         _fevals++;
 
         try {
-          f = - log_prob_grad<true, false>(_model, _x, _params_i, _g, _msgs);
+          f = - log_prob_grad<true, jacobian>(_model, _x, _params_i, _g,
+                                             _msgs);
         } catch (const std::exception& e) {
           if (_msgs)
             (*_msgs) << e.what() << std::endl;
@@ -381,15 +393,16 @@ namespace stan {
     };
 
     template<typename M, typename QNUpdateType, typename Scalar = double,
-             int DimAtCompile = Eigen::Dynamic>
+             int DimAtCompile = Eigen::Dynamic, bool jacobian = false>
     class BFGSLineSearch
-      : public BFGSMinimizer<ModelAdaptor<M>, QNUpdateType,
+      : public BFGSMinimizer<ModelAdaptor<M, jacobian>, QNUpdateType,
                              Scalar, DimAtCompile> {
     private:
-      ModelAdaptor<M> _adaptor;
+      ModelAdaptor<M, jacobian> _adaptor;
 
     public:
-      typedef BFGSMinimizer<ModelAdaptor<M>, QNUpdateType, Scalar, DimAtCompile>
+      typedef BFGSMinimizer<ModelAdaptor<M, jacobian>, QNUpdateType, Scalar,
+                            DimAtCompile>
       BFGSBase;
       typedef typename BFGSBase::VectorT vector_t;
       typedef typename stan::math::index_type<vector_t>::type idx_t;
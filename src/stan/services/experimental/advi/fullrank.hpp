@@ -19,7 +19,8 @@ namespace stan {
       namespace advi {
 
         /**
-         * Runs full rank ADVI.
+         * Runs full rank ADVI, evaluating the Monte Carlo estimates
+         * on up to <code>num_threads</code> threads.
          *
          * @tparam Model A model implementation
          * @param[in] model Input model to test (with data already instantiated)
@@ -40,6 +41,8 @@ namespace stan {
          * @param[in] eval_elbo evaluate ELBO every Nth iteration
          * @param[in] output_samples number of posterior samples to draw and
          *   save
+         * @param[in] num_threads maximum number of threads for the Monte
+         *   Carlo estimates of the ELBO and its gradient
          * @param[in,out] interrupt callback to be called every iteration
          * @param[in,out] logger Logger for messages
          * @param[in,out] init_writer Writer callback for unconstrained inits
@@ -53,7 +56,7 @@ namespace stan {
                      double init_radius, int grad_samples, int elbo_samples,
                      int max_iterations, double tol_rel_obj, double eta,
                      bool adapt_engaged, int adapt_iterations, int eval_elbo,
-                     int output_samples,
+                     int output_samples, int num_threads,
                      callbacks::interrupt& interrupt,
                      callbacks::logger& logger,
                      callbacks::writer& init_writer,
@@ -81,13 +84,62 @@ namespace stan {
                                   stan::variational::normal_fullrank,
                                   boost::ecuyer1988>
             cmd_advi(model, cont_params, rng, grad_samples,
-                     elbo_samples, eval_elbo, output_samples);
+                     elbo_samples, eval_elbo, output_samples,
+                     num_threads);
           cmd_advi.run(eta, adapt_engaged, adapt_iterations,
                        tol_rel_obj, max_iterations,
                        logger, parameter_writer, diagnostic_writer);
 
           return 0;
         }
+
+        /**
+         * Runs full rank ADVI.
+         *
+         * @tparam Model A model implementation
+         * @param[in] model Input model to test (with data already instantiated)
+         * @param[in] init var context for initialization
+         * @param[in] random_seed random seed for the random number generator
+         * @param[in] chain chain id to advance the random number generator
+         * @param[in] init_radius radius to initialize
+         * @param[in] grad_samples number of samples for Monte Carlo estimate
+         *   of gradients
+         * @param[in] elbo_samples number of samples for Monte Carlo estimate
+         *   of ELBO
+         * @param[in] max_iterations maximum number of iterations
+         * @param[in] tol_rel_obj convergence tolerance on the relative norm of
+         *   the objective
+         * @param[in] eta stepsize scaling parameter for variational inference
+         * @param[in] adapt_engaged adaptation engaged?
+         * @param[in] adapt_iterations number of iterations for eta adaptation
+         * @param[in] eval_elbo evaluate ELBO every Nth iteration
+         * @param[in] output_samples number of posterior samples to draw and
+         *   save
+         * @param[in,out] interrupt callback to be called every iteration
+         * @param[in,out] logger Logger for messages
+         * @param[in,out] init_writer Writer callback for unconstrained inits
+         * @param[in,out] parameter_writer output for parameter values
+         * @param[in,out] diagnostic_writer output for diagnostic values
+         * @return error_codes::OK if successful
+         */
+        template <class Model>
+        int fullrank(Model& model, stan::io::var_context& init,
+                     unsigned int random_seed, unsigned int chain,
+                     double init_radius, int grad_samples, int elbo_samples,
+                     int max_iterations, double tol_rel_obj, double eta,
+                     bool adapt_engaged, int adapt_iterations, int eval_elbo,
+                     int output_samples,
+                     callbacks::interrupt& interrupt,
+                     callbacks::logger& logger,
+                     callbacks::writer& init_writer,
+                     callbacks::writer& parameter_writer,
+                     callbacks::writer& diagnostic_writer) {
+          return fullrank(model, init, random_seed, chain, init_radius,
+                          grad_samples, elbo_samples, max_iterations,
+                          tol_rel_obj, eta, adapt_engaged, adapt_iterations,
+                          eval_elbo, output_samples, 1, interrupt, logger,
+                          init_writer, parameter_writer, diagnostic_writer);
+        }
       }
     }
   }
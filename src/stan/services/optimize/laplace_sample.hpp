@@ -0,0 +1,233 @@
+#ifndef STAN_SERVICES_OPTIMIZE_LAPLACE_SAMPLE_HPP
+#define STAN_SERVICES_OPTIMIZE_LAPLACE_SAMPLE_HPP
+
+#include <stan/io/var_context.hpp>
+#include <stan/callbacks/interrupt.hpp>
+#include <stan/callbacks/logger.hpp>
+#include <stan/callbacks/writer.hpp>
+#include <stan/model/hessian.hpp>
+#include <stan/model/log_prob_value.hpp>
+#include <stan/services/error_codes.hpp>
+#include <stan/services/util/create_rng.hpp>
+#include <stan/services/util/parallel_for.hpp>
+#include <boost/random/normal_distribution.hpp>
+#include <boost/random/variate_generator.hpp>
+#include <Eigen/Dense>
+#include <algorithm>
+#include <limits>
+#include <sstream>
+#include <string>
+#include <vector>
+
+namespace stan {
+  namespace services {
+    namespace optimize {
+
+      /**
+       * Functor evaluating one batch of Laplace draws.  For draw
+       * <code>n</code> it computes the log density of the model on the
+       * unconstrained scale and the constrained values through
+       * <code>write_array</code>, using the draw's own RNG substream
+       * so that results do not depend on the number of threads.
+       *
+       * Only double-valued model methods are called, but those may
+       * still use nested autodiff (for example in the algebraic and
+       * ODE solvers), so draws are evaluated concurrently only when
+       * the autodiff stack is thread local.
+       *
+       * @tparam Model model class
+       */
+      template <class Model>
+      class laplace_draw_functor {
+      private:
+        const Model& model_;
+        unsigned int random_seed_;
+        unsigned int chain_;
+        int offset_;
+
+      public:
+        std::vector<std::vector<double> > draws_;
+        std::vector<std::vector<double> > values_;
+        std::vector<double> log_p_;
+        std::vector<std::string> messages_;
+        std::vector<int> ok_;
+
+        /**
+         * Constructor.
+         *
+         * @param[in] model model to evaluate
+         * @param[in] random_seed random seed
+         * @param[in] chain chain id
+         * @param[in] size number of draws in the batch
+         * @param[in] offset index of the first draw of the batch
+         */
+        laplace_draw_functor(const Model& model, unsigned int random_seed,
+                             unsigned int chain, int size, int offset)
+          : model_(model), random_seed_(random_seed), chain_(chain),
+            offset_(offset), draws_(size), values_(size), log_p_(size),
+            messages_(size), ok_(size, 1) { }
+
+        void operator()(std::size_t n) {
+          std::vector<int> disc_vector;
+          std::stringstream msg;
+          try {
+            log_p_[n] = stan::model::log_prob_value<false, true>
+              (model_, draws_[n], disc_vector, &msg);
+          } catch (const std::exception& e) {
+            msg << "Error evaluating the log density of a draw: "
+                << e.what() << std::endl;
+            log_p_[n] = -std::numeric_limits<double>::infinity();
+          }
+          // substream 0 of the chain generates the normal draws
+          boost::ecuyer1988 rng
+            = util::create_rng(random_seed_, chain_, offset_ + n + 1);
+          try {
+            model_.write_array(rng, draws_[n], disc_vector, values_[n],
+                               true, true, &msg);
+          } catch (const std::exception& e) {
+            msg << e.what();
+            ok_[n] = 0;
+          }
+          messages_[n] = msg.str();
+        }
+      };
+
+      /**
+       * Draws from the Laplace approximation to the posterior at a
+       * mode, typically the one found by <code>lbfgs</code>.
+       *
+       * The Hessian of the log density (with Jacobian) is computed on
+       * the unconstrained scale at the mode and its negation is
+       * Cholesky factored once as <code>U' * U</code>.  Each draw is
+       * <code>mode + U \ z</code> for standard normal <code>z</code>,
+       * which is then transformed to the constrained scale with the
+       * model's <code>write_array</code>; these evaluations run in
+       * parallel over up to <code>num_threads</code> threads if the
+       * math library is built with <code>STAN_THREADS</code>.  Draws
+       * whose log density cannot be evaluated are written with
+       * <code>log_p__</code> set to negative infinity and the error
+       * is logged.
+       *
+       * The sample writer receives the columns <code>log_p__</code>
+       * (log density of the model), <code>log_g__</code> (unnormalized
+       * log density of the approximation) followed by the constrained
+       * parameters, transformed parameters and generated quantities.
+       *
+       * @tparam Model A model implementation
+       * @param[in] model Input model (with data already instantiated)
+       * @param[in] mode var context with the constrained parameter
+       *   values at the mode
+       * @param[in] num_draws number of approximate draws
+       * @param[in] random_seed random seed for the random number generator
+       * @param[in] chain chain id to advance the pseudo random number
+       *   generator
+       * @param[in] num_threads maximum number of threads used to
+       *   evaluate the draws
+       * @param[in,out] interrupt callback to be called every batch of draws
+       * @param[in,out] logger Logger for messages
+       * @param[in,out] sample_writer Writer for draws
+       * @return error_codes::OK if successful
+       */
+      template <class Model>
+      int laplace_sample(const Model& model, stan::io::var_context& mode,
+                         int num_draws, unsigned int random_seed,
+                         unsigned int chain, int num_threads,
+                         callbacks::interrupt& interrupt,
+                         callbacks::logger& logger,
+                         callbacks::writer& sample_writer) {
+        if (num_draws < 1) {
+          logger.error("Number of draws must be positive.");
+          return error_codes::CONFIG;
+        }
+
+        std::vector<int> disc_vector;
+        std::vector<double> cont_vector;
+        std::stringstream msg;
+        try {
+          model.transform_inits(mode, disc_vector, cont_vector, &msg);
+        } catch (const std::exception& e) {
+          if (msg.str().length() > 0)
+            logger.info(msg);
+          logger.error(e.what());
+          return error_codes::DATAERR;
+        }
+        if (msg.str().length() > 0)
+          logger.info(msg);
+
+        Eigen::VectorXd theta_hat(cont_vector.size());
+        for (size_t i = 0; i < cont_vector.size(); ++i)
+          theta_hat(i) = cont_vector[i];
+
+        double lp(0);
+        Eigen::VectorXd grad;
+        Eigen::MatrixXd hess;
+        std::stringstream hessian_msg;
+        try {
+          stan::model::hessian(model, theta_hat, lp, grad, hess,
+                               &hessian_msg);
+        } catch (const std::exception& e) {
+          if (hessian_msg.str().length() > 0)
+            logger.info(hessian_msg);
+          logger.error("Error evaluating the Hessian at the mode.");
+          logger.error(e.what());
+          return error_codes::SOFTWARE;
+        }
+        if (hessian_msg.str().length() > 0)
+          logger.info(hessian_msg);
+
+        Eigen::LLT<Eigen::MatrixXd> llt(-hess);
+        if (llt.info() != Eigen::Success || !hess.allFinite()) {
+          logger.error("Hessian at the mode is not negative definite;"
+                       " the Laplace approximation is not defined.");
+          return error_codes::SOFTWARE;
+        }
+
+        std::vector<std::string> names;
+        names.push_back("log_p__");
+        names.push_back("log_g__");
+        model.constrained_param_names(names, true, true);
+        sample_writer(names);
+
+        boost::ecuyer1988 rng = util::create_rng(random_seed, chain);
+        boost::variate_generator<boost::ecuyer1988&,
+                                 boost::normal_distribution<> >
+          rand_unit_gaus(rng, boost::normal_distribution<>());
+
+        // bounds the memory held between evaluation and writing
+        num_threads = util::num_autodiff_threads(num_threads);
+        const int batch_size = 64 * std::max(num_threads, 1);
+        Eigen::VectorXd z(theta_hat.size());
+        for (int start = 0; start < num_draws; start += batch_size) {
+          interrupt();
+          int size = std::min(batch_size, num_draws - start);
+          laplace_draw_functor<Model> batch(model, random_seed, chain,
+                                            size, start);
+          std::vector<double> log_g(size);
+          for (int n = 0; n < size; ++n) {
+            for (int i = 0; i < z.size(); ++i)
+              z(i) = rand_unit_gaus();
+            log_g[n] = -0.5 * z.squaredNorm();
+            Eigen::VectorXd theta = theta_hat + llt.matrixU().solve(z);
+            batch.draws_[n].assign(theta.data(), theta.data() + theta.size());
+          }
+
+          util::parallel_for(size, num_threads, batch);
+
+          for (int n = 0; n < size; ++n) {
+            if (batch.messages_[n].length() > 0)
+              logger.info(batch.messages_[n]);
+            if (!batch.ok_[n])
+              continue;
+            std::vector<double>& values = batch.values_[n];
+            values.insert(values.begin(), log_g[n]);
+            values.insert(values.begin(), batch.log_p_[n]);
+            sample_writer(values);
+          }
+        }
+        return error_codes::OK;
+      }
+
+    }
+  }
+}
+#endif
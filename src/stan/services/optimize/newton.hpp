@@ -7,6 +7,7 @@
 #include <stan/callbacks/interrupt.hpp>
 #include <stan/callbacks/logger.hpp>
 #include <stan/callbacks/writer.hpp>
+#include <stan/model/log_prob_value.hpp>
 #include <stan/optimization/newton.hpp>
 #include <stan/services/error_codes.hpp>
 #include <stan/services/util/initialize.hpp>
@@ -58,8 +59,9 @@ namespace stan {
         double lp(0);
         try {
           std::stringstream message;
-          lp = model.template log_prob<false, false>(cont_vector, disc_vector,
-                                                     &message);
+          lp = stan::model::log_prob_value<false, false>(model, cont_vector,
+                                                         disc_vector,
+                                                         &message);
           logger.info(message);
         } catch (const std::exception& e) {
           logger.info("");
@@ -7,6 +7,9 @@
 #include <stan/services/error_codes.hpp>
 #include <stan/services/util/create_rng.hpp>
 #include <stan/services/util/gq_writer.hpp>
+#include <stan/services/util/parallel_for.hpp>
+#include <algorithm>
+#include <sstream>
 #include <string>
 #include <vector>
 
@@ -32,26 +35,20 @@ namespace stan {
     }
 
     /**
-     * Given a set of draws from a fitted model, generate corresponding
-     * quantities of interest.  Data written to callback writer.
-     * Return code indicates success or type of error.
+     * Check that there are draws and that the model generates
+     * quantities of interest, logging an error otherwise.
      *
      * @tparam Model model class
      * @param[in] model instantiated model
      * @param[in] draws sequence of draws of unconstrained parameters
-     * @param[in] seed seed to use for randomization
-     * @param[in, out] interrupt called every iteration
-     * @param[in, out] logger logger to which to write warning and error messages
-     * @param[in, out] sample_writer writer to which draws are written
+     * @param[in, out] logger logger to which to write error messages
      * @return error code
      */
     template <class Model>
-    int standalone_generate(const Model& model,
-                            const std::vector<std::vector<double> >& draws,
-                            unsigned int seed,
-                            callbacks::interrupt& interrupt,
-                            callbacks::logger& logger,
-                            callbacks::writer& sample_writer) {
+    int check_standalone_generate(const Model& model,
+                                  const std::vector<std::vector<double> >&
+                                  draws,
+                                  callbacks::logger& logger) {
       if (draws.empty()) {
         logger.error("Empty set of draws from fitted model.");
         return error_codes::DATAERR;
@@ -66,6 +63,34 @@ namespace stan {
         logger.error("Model doesn't generate any quantities of interest.");
         return error_codes::CONFIG;
       }
+      return error_codes::OK;
+    }
+
+    /**
+     * Given a set of draws from a fitted model, generate corresponding
+     * quantities of interest.  Data written to callback writer.
+     * Return code indicates success or type of error.
+     *
+     * @tparam Model model class
+     * @param[in] model instantiated model
+     * @param[in] draws sequence of draws of unconstrained parameters
+     * @param[in] seed seed to use for randomization
+     * @param[in, out] interrupt called every iteration
+     * @param[in, out] logger logger to which to write warning and error messages
+     * @param[in, out] sample_writer writer to which draws are written
+     * @return error code
+     */
+    template <class Model>
+    int standalone_generate(const Model& model,
+                            const std::vector<std::vector<double> >& draws,
+                            unsigned int seed,
+                            callbacks::interrupt& interrupt,
+                            callbacks::logger& logger,
+                            callbacks::writer& sample_writer) {
+      int num_params = num_constrained_params(model);
+      int return_code = check_standalone_generate(model, draws, logger);
+      if (return_code != error_codes::OK)
+        return return_code;
 
       util::gq_writer writer(sample_writer, logger, num_params);
       boost::ecuyer1988 rng = util::create_rng(seed, 1);
@@ -87,6 +112,150 @@ namespace stan {
       return error_codes::OK;
     }
 
+    /**
+     * Functor generating the quantities of interest for one batch of
+     * draws.  Draw <code>n</code> of the batch uses its own RNG
+     * substream, numbered by the draw's position in the full set of
+     * draws, so results do not depend on the number of threads.
+     *
+     * Only double-valued model methods are called, but those may
+     * still use nested autodiff (for example in the algebraic and
+     * ODE solvers), so draws are evaluated concurrently only when
+     * the autodiff stack is thread local.
+     *
+     * @tparam Model model class
+     */
+    template <class Model>
+    class gq_draw_functor {
+    private:
+      const Model& model_;
+      const std::vector<std::vector<double> >& draws_;
+      unsigned int seed_;
+      int num_params_;
+      int offset_;
+
+    public:
+      std::vector<std::vector<double> > values_;
+      std::vector<std::string> messages_;
+      std::vector<std::string> errors_;
+      std::vector<int> ok_;
+
+      /**
+       * Constructor.
+       *
+       * @param[in] model model to evaluate
+       * @param[in] draws all draws of unconstrained parameters
+       * @param[in] seed random seed
+       * @param[in] num_params number of constrained parameters
+       * @param[in] size number of draws in the batch
+       * @param[in] offset index of the first draw of the batch
+       */
+      gq_draw_functor(const Model& model,
+                      const std::vector<std::vector<double> >& draws,
+                      unsigned int seed, int num_params, int size,
+                      int offset)
+        : model_(model), draws_(draws), seed_(seed),
+          num_params_(num_params), offset_(offset), values_(size),
+          messages_(size), errors_(size), ok_(size, 1) { }
+
+      /**
+       * Generate the quantities of interest for the n-th draw of the
+       * batch.
+       *
+       * @param[in] n index of draw within the batch
+       */
+      void operator()(std::size_t n) {
+        boost::ecuyer1988 rng = util::create_rng(seed_, 1, offset_ + n);
+        ok_[n] = util::gq_writer::generate_gq_values(model_, rng,
+                                                     draws_[offset_ + n],
+                                                     num_params_,
+                                                     values_[n],
+                                                     messages_[n],
+                                                     errors_[n]);
+      }
+    };
+
+    /**
+     * Given a set of draws from a fitted model, generate corresponding
+     * quantities of interest, evaluating draws in parallel on up to
+     * the specified number of threads if the math library is built
+     * with <code>STAN_THREADS</code>.  Data written to callback
+     * writer in the order of the draws.  Return code indicates
+     * success or type of error.
+     *
+     * Draw <code>n</code> uses RNG substream <code>n</code> of chain
+     * 1 (see <code>util::create_rng</code>), so the output is the same
+     * for every number of threads, though it differs from the serial
+     * <code>standalone_generate</code>, which uses a single stream for
+     * all draws.  There are pow(2, 20) substreams, which bounds the
+     * number of draws with independent streams.  Draws are evaluated
+     * in batches; the interrupt is called and the values written once
+     * per batch.
+     *
+     * @tparam Model model class
+     * @param[in] model instantiated model
+     * @param[in] draws sequence of draws of unconstrained parameters
+     * @param[in] seed seed to use for randomization
+     * @param[in] num_threads maximum number of threads to use
+     * @param[in, out] interrupt called every batch of draws
+     * @param[in, out] logger logger to which to write warning and error messages
+     * @param[in, out] sample_writer writer to which draws are written
+     * @return error code
+     */
+    template <class Model>
+    int standalone_generate(const Model& model,
+                            const std::vector<std::vector<double> >& draws,
+                            unsigned int seed,
+                            int num_threads,
+                            callbacks::interrupt& interrupt,
+                            callbacks::logger& logger,
+                            callbacks::writer& sample_writer) {
+      int num_params = num_constrained_params(model);
+      int return_code = check_standalone_generate(model, draws, logger);
+      if (return_code != error_codes::OK)
+        return return_code;
+
+      util::gq_writer writer(sample_writer, logger, num_params);
+      writer.write_gq_names(model);
+
+      // bounds the memory held between evaluation and writing
+      num_threads = util::num_autodiff_threads(num_threads);
+      const int batch_size = 64 * std::max(num_threads, 1);
+      int num_draws = draws.size();
+      for (int start = 0; start < num_draws; start += batch_size) {
+        interrupt();
+        int size = std::min(batch_size, num_draws - start);
+        // as in the serial version, draws before a wrongly sized one
+        // are still written
+        int bad = start;
+        while (bad < start + size
+               && draws[bad].size() == static_cast<size_t>(num_params))
+          ++bad;
+
+        gq_draw_functor<Model> batch(model, draws, seed, num_params,
+                                     bad - start, start);
+        util::parallel_for(bad - start, num_threads, batch);
+        for (int n = 0; n < bad - start; ++n) {
+          if (batch.messages_[n].length() > 0)
+            logger.info(batch.messages_[n]);
+          if (batch.ok_[n])
+            sample_writer(batch.values_[n]);
+          else
+            logger.info(batch.errors_[n]);
+        }
+
+        if (bad < start + size) {
+          std::stringstream msg;
+          msg << "Wrong number of params in draws from fitted model.  ";
+          msg << "Expecting " << num_params << " columns, ";
+          msg << "found " << draws[bad].size() << " columns.";
+          logger.error(msg.str());
+          return error_codes::DATAERR;
+        }
+      }
+      return error_codes::OK;
+    }
+
   }
 }
 #endif
@@ -31,6 +31,32 @@ namespace stan {
         return rng;
       }
 
+      /**
+       * Creates a pseudo random number generator for one substream
+       * of a chain.  The generator is initialized as by
+       * <code>create_rng(seed, chain)</code> and then advanced past
+       * pow(2, 30) times the substream id draws, so up to pow(2, 20)
+       * substreams fit inside the segment reserved for each chain.
+       *
+       * Giving every unit of parallel work (e.g., every draw) its own
+       * substream makes results independent of how the work is
+       * split across threads.
+       *
+       * @param[in] seed the random seed
+       * @param[in] chain the chain id
+       * @param[in] substream the substream id within the chain
+       * @return a boost::ecuyer1988 instance
+       */
+      inline boost::ecuyer1988 create_rng(unsigned int seed,
+                                          unsigned int chain,
+                                          unsigned int substream) {
+        using boost::uintmax_t;
+        static uintmax_t SUBSTREAM_STRIDE = static_cast<uintmax_t>(1) << 30;
+        boost::ecuyer1988 rng = create_rng(seed, chain);
+        rng.discard(SUBSTREAM_STRIDE * substream);
+        return rng;
+      }
+
     }
   }
 }
@@ -58,43 +58,81 @@ namespace stan {
         }
 
         /**
-         * Calls model's `write_array` method and writes values of
-         * variables defined in the generated quantities block
-         * to stream `sample_writer_`.
+         * Calls model's `write_array` method and returns the values of
+         * variables defined in the generated quantities block, along
+         * with any messages written by the model.  Nothing is logged
+         * or written, so it may be called concurrently for different
+         * draws with different RNGs.
          *
          * @tparam M model class
          * @tparam RNG pseudo random number generator class
          * @param[in] model instantiated model
          * @param[in] rng instantiated RNG
          * @param[in] draw sequence unconstrained parameters values.
+         * @param[in] num_constrained_params offset into write_array gqs
+         * @param[out] gq_values generated quantities
+         * @param[out] messages messages written by the model
+         * @param[out] error message of the exception thrown by
+         * `write_array`, if any
+         * @return true if `write_array` succeeded
          */
         template <class Model, class RNG>
-        void write_gq_values(const Model& model,
-                             RNG& rng,
-                             const std::vector<double>& draw) {
-          std::vector<double> values;
+        static bool generate_gq_values(const Model& model,
+                                       RNG& rng,
+                                       const std::vector<double>& draw,
+                                       int num_constrained_params,
+                                       std::vector<double>& gq_values,
+                                       std::string& messages,
+                                       std::string& error) {
           std::vector<int> params_i;  // unused - no discrete params
           std::stringstream ss;
+          bool ok = true;
           try {
             model.write_array(rng,
                               const_cast<std::vector<double>&>(draw),
                               params_i,
-                              values,
+                              gq_values,
                               false,
                               true,
                               &ss);
+            gq_values.erase(gq_values.begin(),
+                            gq_values.begin() + num_constrained_params);
           } catch (const std::exception& e) {
-            if (ss.str().length() > 0)
-              logger_.info(ss);
-            logger_.info(e.what());
-            return;
+            gq_values.clear();
+            error = e.what();
+            ok = false;
           }
-          if (ss.str().length() > 0)
-            logger_.info(ss);
+          messages = ss.str();
+          return ok;
+        }
 
-          std::vector<double> gq_values(values.begin()
-                                        + num_constrained_params_,
-                                        values.end());
+        /**
+         * Calls model's `write_array` method and writes values of
+         * variables defined in the generated quantities block
+         * to stream `sample_writer_`.
+         *
+         * @tparam M model class
+         * @tparam RNG pseudo random number generator class
+         * @param[in] model instantiated model
+         * @param[in] rng instantiated RNG
+         * @param[in] draw sequence unconstrained parameters values.
+         */
+        template <class Model, class RNG>
+        void write_gq_values(const Model& model,
+                             RNG& rng,
+                             const std::vector<double>& draw) {
+          std::vector<double> gq_values;
+          std::string messages;
+          std::string error;
+          bool ok = generate_gq_values(model, rng, draw,
+                                       num_constrained_params_,
+                                       gq_values, messages, error);
+          if (messages.length() > 0)
+            logger_.info(messages);
+          if (!ok) {
+            logger_.info(error);
+            return;
+          }
           sample_writer_(gq_values);
         }
       };
@@ -7,6 +7,7 @@
 #include <stan/io/random_var_context.hpp>
 #include <stan/io/chained_var_context.hpp>
 #include <stan/model/log_prob_grad.hpp>
+#include <stan/model/log_prob_value.hpp>
 #include <limits>
 #include <sstream>
 #include <string>
@@ -111,8 +112,8 @@ namespace stan {
           double log_prob(0);
           std::stringstream msg;
           try {
-            log_prob = model.template log_prob<false, true>
-              (unconstrained, disc_vector, &msg);
+            log_prob = stan::model::log_prob_value<false, true>
+              (model, unconstrained, disc_vector, &msg);
             if (msg.str().length() > 0)
               logger.info(msg);
           } catch (std::domain_error& e) {
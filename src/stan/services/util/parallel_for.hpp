@@ -0,0 +1,97 @@
+#ifndef STAN_SERVICES_UTIL_PARALLEL_FOR_HPP
+#define STAN_SERVICES_UTIL_PARALLEL_FOR_HPP
+
+#include <algorithm>
+#include <cstddef>
+#include <exception>
+#include <functional>
+#include <thread>
+#include <vector>
+
+namespace stan {
+  namespace services {
+    namespace util {
+
+      /**
+       * Calls <code>f(n)</code> for every index <code>n</code> in
+       * <code>[0, size)</code>, splitting the range into contiguous
+       * blocks which run on up to <code>num_threads</code> threads.
+       * The calling thread processes the first block.
+       *
+       * The functor must be safe to call concurrently for distinct
+       * indexes.  Reverse-mode autodiff uses a global stack unless
+       * the math library is built with <code>STAN_THREADS</code>, so
+       * callers evaluating gradients must only request more than one
+       * thread in that configuration.
+       *
+       * If any call throws, the remaining indexes of that block are
+       * skipped, all threads are joined and the first exception (in
+       * block order) is rethrown on the calling thread.
+       *
+       * @tparam F type of functor with signature
+       *   <code>void(std::size_t)</code>
+       * @param[in] size number of indexes
+       * @param[in] num_threads maximum number of threads to use;
+       *   values less than 2 run serially on the calling thread
+       * @param[in,out] f functor to apply
+       */
+      template <class F>
+      void parallel_for(std::size_t size, int num_threads, F& f) {
+        std::size_t num_blocks
+          = std::min(size, static_cast<std::size_t>(std::max(num_threads, 1)));
+        if (num_blocks <= 1) {
+          for (std::size_t n = 0; n < size; ++n)
+            f(n);
+          return;
+        }
+
+        std::vector<std::exception_ptr> errors(num_blocks);
+        struct block {
+          static void run(F& f, std::size_t begin, std::size_t end,
+                          std::exception_ptr& error) {
+            try {
+              for (std::size_t n = begin; n < end; ++n)
+                f(n);
+            } catch (...) {
+              error = std::current_exception();
+            }
+          }
+        };
+
+        std::vector<std::thread> threads;
+        threads.reserve(num_blocks - 1);
+        for (std::size_t b = 1; b < num_blocks; ++b)
+          threads.push_back(std::thread(&block::run, std::ref(f),
+                                        b * size / num_blocks,
+                                        (b + 1) * size / num_blocks,
+                                        std::ref(errors[b])));
+        block::run(f, 0, size / num_blocks, errors[0]);
+        for (size_t t = 0; t < threads.size(); ++t)
+          threads[t].join();
+
+        for (size_t b = 0; b < errors.size(); ++b)
+          if (errors[b])
+            std::rethrow_exception(errors[b]);
+      }
+
+      /**
+       * Returns the number of threads that may evaluate gradients of
+       * a model concurrently.  Without <code>STAN_THREADS</code> the
+       * autodiff stack is shared by all threads, so gradient
+       * evaluations must stay on a single thread.
+       *
+       * @param[in] num_threads requested number of threads
+       * @return number of threads to use for autodiff work
+       */
+      inline int num_autodiff_threads(int num_threads) {
+#ifdef STAN_THREADS
+        return num_threads;
+#else
+        return 1;
+#endif
+      }
+
+    }
+  }
+}
+#endif
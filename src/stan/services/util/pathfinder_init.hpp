@@ -0,0 +1,198 @@
+#ifndef STAN_SERVICES_UTIL_PATHFINDER_INIT_HPP
+#define STAN_SERVICES_UTIL_PATHFINDER_INIT_HPP
+
+#include <stan/callbacks/logger.hpp>
+#include <stan/callbacks/writer.hpp>
+#include <stan/io/var_context.hpp>
+#include <stan/services/util/create_rng.hpp>
+#include <stan/services/util/initialize.hpp>
+#include <stan/services/util/parallel_for.hpp>
+#include <stan/variational/pathfinder.hpp>
+#include <Eigen/Dense>
+#include <sstream>
+#include <string>
+#include <vector>
+
+namespace stan {
+  namespace services {
+    namespace util {
+
+      /**
+       * Functor running the Pathfinder paths of
+       * <code>pathfinder_init</code>, one path per index.
+       *
+       * @tparam Model model class
+       */
+      template <class Model>
+      class pathfinder_paths_functor {
+      private:
+        Model& model_;
+        std::vector<boost::ecuyer1988>& rngs_;
+        const std::vector<std::vector<double> >& inits_;
+
+      public:
+        std::vector<stan::variational::pathfinder_draws> results_;
+        std::vector<int> ok_;
+        std::vector<std::string> messages_;
+
+        pathfinder_paths_functor(Model& model,
+                                 std::vector<boost::ecuyer1988>& rngs,
+                                 const std::vector<std::vector<double> >&
+                                 inits)
+          : model_(model), rngs_(rngs), inits_(inits),
+            results_(inits.size()), ok_(inits.size(), 0),
+            messages_(inits.size()) { }
+
+        void operator()(std::size_t n) {
+          // L-BFGS history size, iteration limit and draws per ELBO
+          // estimate follow the Pathfinder reference implementation
+          std::stringstream msg;
+          try {
+            ok_[n] = stan::variational::pathfinder_path(model_, inits_[n],
+                                                        rngs_[n], 6, 1000,
+                                                        25, 100,
+                                                        results_[n], &msg);
+          } catch (const std::exception& e) {
+            msg << e.what();
+          }
+          messages_[n] = msg.str();
+        }
+      };
+
+      /**
+       * Initializes a sampler with Pathfinder.  Runs
+       * <code>num_paths</code> Pathfinder paths from independent
+       * initial values, in parallel when autodiff is thread safe,
+       * and importance resamples the pooled draws.  The first
+       * resampled draw becomes the initial value of the chain; all of
+       * them can be used to estimate an initial metric.
+       *
+       * Path <code>p</code> uses RNG substream <code>p + 1</code> of
+       * the chain, so the chain's own generator is left untouched.
+       *
+       * @tparam Model model class
+       * @param[in] model the model
+       * @param[in] init var context with initial values for the paths
+       * @param[in] random_seed random seed
+       * @param[in] chain chain id
+       * @param[in] init_radius radius for random initial values
+       * @param[in] num_paths number of Pathfinder paths
+       * @param[in] num_threads maximum number of threads
+       * @param[in,out] logger logger for messages
+       * @param[in,out] init_writer writer for the chosen unconstrained
+       *   initial value
+       * @param[out] cont_vector initial value on the unconstrained scale
+       * @param[out] draws resampled draws, one per column
+       * @return true if at least one path produced an approximation
+       */
+      template <class Model>
+      bool pathfinder_init(Model& model, stan::io::var_context& init,
+                           unsigned int random_seed, unsigned int chain,
+                           double init_radius, int num_paths,
+                           int num_threads,
+                           callbacks::logger& logger,
+                           callbacks::writer& init_writer,
+                           std::vector<double>& cont_vector,
+                           Eigen::MatrixXd& draws) {
+        if (num_paths < 1) {
+          logger.info("Pathfinder initialization requires at least"
+                      " one path.");
+          return false;
+        }
+
+        callbacks::writer path_init_writer;
+        std::vector<boost::ecuyer1988> rngs;
+        std::vector<std::vector<double> > inits;
+        try {
+          for (int p = 0; p < num_paths; ++p) {
+            rngs.push_back(create_rng(random_seed, chain, p + 1));
+            inits.push_back(initialize(model, init, rngs.back(),
+                                       init_radius, false,
+                                       logger, path_init_writer));
+          }
+        } catch (const std::exception& e) {
+          logger.info(e.what());
+          logger.info("Pathfinder initialization failed.");
+          return false;
+        }
+
+        pathfinder_paths_functor<Model> paths(model, rngs, inits);
+        parallel_for(num_paths, num_autodiff_threads(num_threads), paths);
+
+        std::vector<stan::variational::pathfinder_draws> succeeded;
+        for (int p = 0; p < num_paths; ++p) {
+          if (paths.messages_[p].length() > 0)
+            logger.info(paths.messages_[p]);
+          std::stringstream msg;
+          msg << "Pathfinder path " << (p + 1) << ": ";
+          if (paths.ok_[p]) {
+            msg << "best ELBO = " << paths.results_[p].elbo;
+            succeeded.push_back(paths.results_[p]);
+          } else {
+            msg << "no usable approximation";
+          }
+          logger.info(msg);
+        }
+        if (succeeded.empty()) {
+          logger.info("Pathfinder initialization failed.");
+          return false;
+        }
+
+        boost::ecuyer1988 rng
+          = create_rng(random_seed, chain, num_paths + 1);
+        try {
+          stan::variational::pathfinder_resample(succeeded, 1000, rng, draws);
+        } catch (const std::domain_error& e) {
+          logger.info(e.what());
+          logger.info("Pathfinder initialization failed.");
+          return false;
+        }
+
+        cont_vector.assign(draws.col(0).data(),
+                           draws.col(0).data() + draws.rows());
+        init_writer(cont_vector);
+        return true;
+      }
+
+      /**
+       * Returns the diagonal inverse metric estimated from Pathfinder
+       * draws, regularized toward a small multiple of the identity the
+       * same way warmup regularizes its variance estimates.
+       *
+       * @param[in] draws draws, one per column
+       * @return diagonal inverse metric
+       */
+      inline Eigen::VectorXd
+      pathfinder_diag_inv_metric(const Eigen::MatrixXd& draws) {
+        double n = static_cast<double>(draws.cols());
+        Eigen::VectorXd mean = draws.rowwise().mean();
+        Eigen::VectorXd var
+          = (draws.colwise() - mean).rowwise().squaredNorm() / (n - 1.0);
+        return (n / (n + 5.0)) * var
+          + 1e-3 * (5.0 / (n + 5.0)) * Eigen::VectorXd::Ones(var.size());
+      }
+
+      /**
+       * Returns the dense inverse metric estimated from Pathfinder
+       * draws, regularized toward a small multiple of the identity the
+       * same way warmup regularizes its covariance estimates.
+       *
+       * @param[in] draws draws, one per column
+       * @return dense inverse metric
+       */
+      inline Eigen::MatrixXd
+      pathfinder_dense_inv_metric(const Eigen::MatrixXd& draws) {
+        double n = static_cast<double>(draws.cols());
+        Eigen::MatrixXd centered
+          = draws.colwise() - draws.rowwise().mean();
+        Eigen::MatrixXd covar
+          = centered * centered.transpose() / (n - 1.0);
+        return (n / (n + 5.0)) * covar
+          + 1e-3 * (5.0 / (n + 5.0))
+          * Eigen::MatrixXd::Identity(covar.rows(), covar.cols());
+      }
+
+    }
+  }
+}
+#endif
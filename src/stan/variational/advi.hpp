@@ -4,16 +4,23 @@
 #include <stan/math.hpp>
 #include <stan/callbacks/logger.hpp>
 #include <stan/callbacks/writer.hpp>
+#include <stan/callbacks/stream_logger.hpp>
 #include <stan/callbacks/stream_writer.hpp>
 #include <stan/io/dump.hpp>
 #include <stan/services/error_codes.hpp>
+#include <stan/services/util/parallel_for.hpp>
 #include <stan/variational/print_progress.hpp>
 #include <stan/variational/families/normal_fullrank.hpp>
+#include <stan/variational/families/normal_lowrank.hpp>
 #include <stan/variational/families/normal_meanfield.hpp>
+#include <stan/variational/monte_carlo.hpp>
 #include <boost/circular_buffer.hpp>
 #include <boost/lexical_cast.hpp>
+#include <boost/random/additive_combine.hpp>
 #include <algorithm>
+#include <atomic>
 #include <limits>
+#include <mutex>
 #include <numeric>
 #include <ostream>
 #include <vector>
@@ -24,6 +31,90 @@ namespace stan {
 
   namespace variational {
 
+    /**
+     * Returns the index of the last eta candidate that
+     * <code>advi::adapt_eta</code> needs, given the ELBOs of the
+     * candidates finished so far.  The search stops at the first
+     * candidate whose ELBO is below that of its predecessor while the
+     * predecessor improved on the initial ELBO, so only the finished
+     * prefix of the sequence can decide it.
+     *
+     * @param[in] elbos ELBO of each candidate
+     * @param[in] done whether each candidate has finished
+     * @param[in] elbo_init ELBO of the initial approximation
+     * @return index of the last candidate needed
+     */
+    inline int adapt_eta_last_needed(const std::vector<double>& elbos,
+                                     const std::vector<int>& done,
+                                     double elbo_init) {
+      int size = elbos.size();
+      for (int i = 1; i < size && done[i - 1] && done[i]; ++i)
+        if (elbos[i] < elbos[i - 1] && elbos[i - 1] > elbo_init)
+          return i;
+      return size - 1;
+    }
+
+    /**
+     * Functor running the eta candidates of
+     * <code>advi::adapt_eta</code> concurrently, one candidate per
+     * index.  Each candidate buffers its messages and, when it
+     * finishes, cancels the candidates that are no longer needed.
+     *
+     * @tparam A class of ADVI
+     * @tparam Q class of variational distribution
+     * @tparam R class of random number generator
+     */
+    template <class A, class Q, class R>
+    class adapt_eta_functor {
+    private:
+      const A& advi_;
+      const Q& variational_;
+      const double* eta_sequence_;
+      int adapt_iterations_;
+      double elbo_init_;
+      std::vector<R>& rngs_;
+      std::vector<int> done_;
+      std::atomic<int> last_needed_;
+      std::mutex mutex_;
+
+    public:
+      std::vector<double> elbos_;
+      std::vector<std::string> messages_;
+
+      adapt_eta_functor(const A& advi, const Q& variational,
+                        const double* eta_sequence, int eta_sequence_size,
+                        int adapt_iterations, double elbo_init,
+                        std::vector<R>& rngs)
+        : advi_(advi), variational_(variational),
+          eta_sequence_(eta_sequence), adapt_iterations_(adapt_iterations),
+          elbo_init_(elbo_init), rngs_(rngs), done_(eta_sequence_size, 0),
+          last_needed_(eta_sequence_size - 1),
+          elbos_(eta_sequence_size, -std::numeric_limits<double>::max()),
+          messages_(eta_sequence_size) { }
+
+      int last_needed() const {
+        return last_needed_;
+      }
+
+      void operator()(std::size_t i) {
+        int index = i;
+        std::stringstream log;
+        callbacks::stream_logger logger(log, log, log, log, log);
+        // the Monte Carlo estimates of one candidate run serially
+        double elbo
+          = advi_.adapt_eta_candidate(variational_, index,
+                                      eta_sequence_[index],
+                                      adapt_iterations_, done_.size(),
+                                      rngs_[index], 1, last_needed_,
+                                      logger);
+        std::lock_guard<std::mutex> lock(mutex_);
+        messages_[index] = log.str();
+        elbos_[index] = elbo;
+        done_[index] = 1;
+        last_needed_ = adapt_eta_last_needed(elbos_, done_, elbo_init_);
+      }
+    };
+
     /**
      * Automatic Differentiation Variational Inference
      *
@@ -38,16 +129,51 @@ namespace stan {
     template <class Model, class Q, class BaseRNG>
     class advi {
     public:
+      /**
+       * Constructor for families that can be initialized from the
+       * continuous parameters alone.
+       *
+       * @param[in] m stan model
+       * @param[in] cont_params initialization of continuous parameters
+       * @param[in,out] rng random number generator
+       * @param[in] n_monte_carlo_grad number of samples for gradient computation
+       * @param[in] n_monte_carlo_elbo number of samples for ELBO computation
+       * @param[in] eval_elbo evaluate ELBO at every "eval_elbo" iters
+       * @param[in] n_posterior_samples number of samples to draw from posterior
+       * @param[in] num_threads maximum number of threads for the Monte
+       * Carlo estimates of the ELBO and its gradient
+       * @throw std::runtime_error if n_monte_carlo_grad is not positive
+       * @throw std::runtime_error if n_monte_carlo_elbo is not positive
+       * @throw std::runtime_error if eval_elbo is not positive
+       * @throw std::runtime_error if n_posterior_samples is not positive
+       */
+      advi(Model& m,
+           Eigen::VectorXd& cont_params,
+           BaseRNG& rng,
+           int n_monte_carlo_grad,
+           int n_monte_carlo_elbo,
+           int eval_elbo,
+           int n_posterior_samples,
+           int num_threads = 1)
+        : advi(m, cont_params, rng, Q(cont_params), n_monte_carlo_grad,
+               n_monte_carlo_elbo, eval_elbo, n_posterior_samples,
+               num_threads) {
+      }
+
       /**
        * Constructor
        *
        * @param[in] m stan model
        * @param[in] cont_params initialization of continuous parameters
        * @param[in,out] rng random number generator
+       * @param[in] variational_init initial variational distribution;
+       * its mean is reset to the continuous parameters when ADVI runs
        * @param[in] n_monte_carlo_grad number of samples for gradient computation
        * @param[in] n_monte_carlo_elbo number of samples for ELBO computation
        * @param[in] eval_elbo evaluate ELBO at every "eval_elbo" iters
        * @param[in] n_posterior_samples number of samples to draw from posterior
+       * @param[in] num_threads maximum number of threads for the Monte
+       * Carlo estimates of the ELBO and its gradient
        * @throw std::runtime_error if n_monte_carlo_grad is not positive
        * @throw std::runtime_error if n_monte_carlo_elbo is not positive
        * @throw std::runtime_error if eval_elbo is not positive
@@ -56,17 +182,21 @@ namespace stan {
       advi(Model& m,
            Eigen::VectorXd& cont_params,
            BaseRNG& rng,
+           const Q& variational_init,
            int n_monte_carlo_grad,
            int n_monte_carlo_elbo,
            int eval_elbo,
-           int n_posterior_samples)
+           int n_posterior_samples,
+           int num_threads)
         : model_(m),
           cont_params_(cont_params),
           rng_(rng),
+          variational_init_(variational_init),
           n_monte_carlo_grad_(n_monte_carlo_grad),
           n_monte_carlo_elbo_(n_monte_carlo_elbo),
           eval_elbo_(eval_elbo),
-          n_posterior_samples_(n_posterior_samples) {
+          n_posterior_samples_(n_posterior_samples),
+          num_threads_(num_threads) {
         static const char* function = "stan::variational::advi";
         math::check_positive(function,
                              "Number of Monte Carlo samples for gradients",
@@ -80,6 +210,9 @@ namespace stan {
         math::check_positive(function,
                              "Number of posterior samples for output",
                              n_posterior_samples_);
+        math::check_positive(function,
+                             "Number of threads",
+                             num_threads_);
       }
 
       /**
@@ -95,41 +228,41 @@ namespace stan {
        * from the variational distribution all give non-finite log joint
        * evaluations. This means that the model is severly ill conditioned or
        * that the variational distribution has somehow collapsed.
+       *
+       * The draws are split over up to num_threads_ threads if the
+       * math library is built with STAN_THREADS.
        */
       double calc_ELBO(const Q& variational,
                        callbacks::logger& logger)
         const {
+        return calc_ELBO(variational, rng_, num_threads_, logger);
+      }
+
+      /**
+       * Calculates the ELBO with draws from the specified random
+       * number generator on up to the specified number of threads.
+       *
+       * @tparam R class of random number generator
+       * @param[in] variational variational approximation at which to evaluate
+       * the ELBO.
+       * @param[in,out] rng random number generator
+       * @param[in] num_threads maximum number of threads
+       * @param logger logger for messages
+       * @return the evidence lower bound.
+       * @throw std::domain_error If, after n_monte_carlo_elbo_ number of draws
+       * from the variational distribution all give non-finite log joint
+       * evaluations.
+       */
+      template <class R>
+      double calc_ELBO(const Q& variational, R& rng, int num_threads,
+                       callbacks::logger& logger)
+        const {
         static const char* function =
           "stan::variational::advi::calc_ELBO";
 
-        double elbo = 0.0;
-        int dim = variational.dimension();
-        Eigen::VectorXd zeta(dim);
-
-        int n_dropped_evaluations = 0;
-        for (int i = 0; i < n_monte_carlo_elbo_;) {
-          variational.sample(rng_, zeta);
-          try {
-            std::stringstream ss;
-            double log_prob = model_.template log_prob<false, true>(zeta, &ss);
-            if (ss.str().length() > 0)
-              logger.info(ss);
-            stan::math::check_finite(function, "log_prob", log_prob);
-            elbo += log_prob;
-            ++i;
-          } catch (const std::domain_error& e) {
-            ++n_dropped_evaluations;
-            if (n_dropped_evaluations >= n_monte_carlo_elbo_) {
-              const char* name = "The number of dropped evaluations";
-              const char* msg1 = "has reached its maximum amount (";
-              const char* msg2 = "). Your model may be either severely "
-                "ill-conditioned or misspecified.";
-              stan::math::domain_error(function, name, n_monte_carlo_elbo_,
-                                       msg1, msg2);
-            }
-          }
-        }
-        elbo /= n_monte_carlo_elbo_;
+        double elbo
+          = mc_expected_log_prob(variational, model_, n_monte_carlo_elbo_,
+                                 rng, num_threads, function, logger);
         elbo += variational.entropy();
         return elbo;
       }
@@ -145,6 +278,26 @@ namespace stan {
        */
       void calc_ELBO_grad(const Q& variational, Q& elbo_grad,
                           callbacks::logger& logger) const {
+        calc_ELBO_grad(variational, elbo_grad, rng_, num_threads_, logger);
+      }
+
+      /**
+       * Calculates the "black box" gradient of the ELBO with draws
+       * from the specified random number generator on up to the
+       * specified number of threads.
+       *
+       * @tparam R class of random number generator
+       * @param[in] variational variational approximation at which to evaluate
+       * the ELBO.
+       * @param[out] elbo_grad gradient of ELBO with respect to variational
+       * approximation.
+       * @param[in,out] rng random number generator
+       * @param[in] num_threads maximum number of threads
+       * @param logger logger for messages
+       */
+      template <class R>
+      void calc_ELBO_grad(const Q& variational, Q& elbo_grad, R& rng,
+                          int num_threads, callbacks::logger& logger) const {
         static const char* function =
           "stan::variational::advi::calc_ELBO_grad";
 
@@ -160,13 +313,130 @@ namespace stan {
                                      cont_params_.size());
 
         variational.calc_grad(elbo_grad,
-                              model_, cont_params_, n_monte_carlo_grad_, rng_,
-                              logger);
+                              model_, cont_params_, n_monte_carlo_grad_, rng,
+                              logger, num_threads);
+      }
+
+      /**
+       * Returns the initial variational distribution, centered at the
+       * continuous parameters.
+       *
+       * @return initial variational distribution
+       */
+      Q init_variational() const {
+        Q variational(variational_init_);
+        variational.set_mu(cont_params_);
+        return variational;
+      }
+
+      /**
+       * Returns a variational distribution of the same shape as the
+       * initial one with all parameters set to zero, used to hold
+       * gradients and step-size history.
+       *
+       * @return zero variational distribution
+       */
+      Q zero_variational() const {
+        Q variational(variational_init_);
+        variational.set_to_zero();
+        return variational;
+      }
+
+      /**
+       * Runs the stochastic gradient ascent of one eta candidate of
+       * <code>adapt_eta</code> and returns the ELBO it reaches.
+       *
+       * The candidate is cancelled, returning the lowest double, as
+       * soon as its index exceeds <code>last_needed</code> (the
+       * search has already been decided by earlier candidates) or the
+       * mean of the approximation stops being finite (the candidate
+       * diverged and its ELBO could not be computed anyway).
+       *
+       * @tparam R class of random number generator
+       * @param[in] variational initial variational distribution
+       * @param[in] index index of the candidate in the eta sequence
+       * @param[in] eta candidate eta
+       * @param[in] adapt_iterations number of iterations of stochastic
+       * gradient ascent
+       * @param[in] num_candidates number of candidates, for progress
+       * @param[in,out] rng random number generator
+       * @param[in] num_threads maximum number of threads for the Monte
+       * Carlo estimates
+       * @param[in] last_needed index of the last candidate still needed
+       * @param[in,out] logger logger for messages
+       * @return ELBO after the iterations or the lowest double if the
+       * ELBO could not be computed or the candidate was cancelled
+       */
+      template <class R>
+      double adapt_eta_candidate(const Q& variational, int index, double eta,
+                                 int adapt_iterations, int num_candidates,
+                                 R& rng, int num_threads,
+                                 const std::atomic<int>& last_needed,
+                                 callbacks::logger& logger) const {
+        Q candidate(variational);
+
+        // Variational family to store gradients
+        Q elbo_grad = zero_variational();
+
+        // Adaptive step-size sequence
+        Q history_grad_squared = zero_variational();
+        double tau = 1.0;
+        double pre_factor  = 0.9;
+        double post_factor = 0.1;
+        double eta_scaled;
+
+        for (int iter_tune = 1; iter_tune <= adapt_iterations; ++iter_tune) {
+          if (index > last_needed || !candidate.mean().allFinite())
+            return -std::numeric_limits<double>::max();
+          variational
+            ::print_progress(index * adapt_iterations + iter_tune, 0,
+                             adapt_iterations * num_candidates,
+                             adapt_iterations, true, "", "", logger);
+
+          // (ROBUST) Compute gradient of ELBO. It's OK if it diverges.
+          // We'll try a smaller eta.
+          try {
+            calc_ELBO_grad(candidate, elbo_grad, rng, num_threads, logger);
+          } catch (const std::domain_error& e) {
+            elbo_grad.set_to_zero();
+          }
+
+          // Update step-size
+          if (iter_tune == 1) {
+            history_grad_squared += elbo_grad.square();
+          } else {
+            history_grad_squared = pre_factor * history_grad_squared
+              + post_factor * elbo_grad.square();
+          }
+          eta_scaled = eta / sqrt(static_cast<double>(iter_tune));
+          // Stochastic gradient update
+          candidate += eta_scaled * elbo_grad
+            / (tau + history_grad_squared.sqrt());
+        }
+
+        // (ROBUST) Compute ELBO. It's OK if it has diverged.
+        try {
+          return calc_ELBO(candidate, rng, num_threads, logger);
+        } catch (const std::domain_error& e) {
+          return -std::numeric_limits<double>::max();
+        }
       }
 
       /**
        * Heuristic grid search to adapt eta to the scale of the problem.
        *
+       * Each eta candidate runs stochastic gradient ascent from a copy
+       * of the initial variational distribution.  The search walks the
+       * sequence while the ELBO keeps improving, so once the ELBOs of
+       * a prefix of candidates decide the result the remaining
+       * candidates are cancelled.
+       *
+       * When autodiff is thread safe and more than one thread is
+       * available, the candidates run concurrently, each with its own
+       * substream of the random number generator; their messages are
+       * logged once the search is done.  Otherwise they run in order
+       * on the calling thread.
+       *
        * @param[in] variational initial variational distribution.
        * @param[in] adapt_iterations number of iterations to spend doing stochastic
        * gradient ascent at each proposed eta value.
@@ -193,8 +463,6 @@ namespace stan {
         double eta_sequence[eta_sequence_size] = {100, 10, 1, 0.1, 0.01};
 
         // Initialize ELBO tracking variables
-        double elbo      = -std::numeric_limits<double>::max();
-        double elbo_best = -std::numeric_limits<double>::max();
         double elbo_init;
         try {
           elbo_init = calc_ELBO(variational, logger);
@@ -206,61 +474,47 @@ namespace stan {
           stan::math::domain_error(function, name, "", msg1);
         }
 
-        // Variational family to store gradients
-        Q elbo_grad = Q(model_.num_params_r());
-
-        // Adaptive step-size sequence
-        Q history_grad_squared = Q(model_.num_params_r());
-        double tau = 1.0;
-        double pre_factor  = 0.9;
-        double post_factor = 0.1;
-
-        double eta_best = 0.0;
-        double eta;
-        double eta_scaled;
-
-        bool do_more_tuning = true;
-        int eta_sequence_index = 0;
-        while (do_more_tuning) {
-          // Try next eta
-          eta = eta_sequence[eta_sequence_index];
-
-          int print_progress_m;
-          for (int iter_tune = 1; iter_tune <= adapt_iterations; ++iter_tune) {
-            print_progress_m = eta_sequence_index
-              * adapt_iterations + iter_tune;
-            variational
-              ::print_progress(print_progress_m, 0,
-                               adapt_iterations * eta_sequence_size,
-                               adapt_iterations, true, "", "", logger);
-
-            // (ROBUST) Compute gradient of ELBO. It's OK if it diverges.
-            // We'll try a smaller eta.
-            try {
-              calc_ELBO_grad(variational, elbo_grad, logger);
-            } catch (const std::domain_error& e) {
-              elbo_grad.set_to_zero();
-            }
-
-            // Update step-size
-            if (iter_tune == 1) {
-              history_grad_squared += elbo_grad.square();
-            } else {
-              history_grad_squared = pre_factor * history_grad_squared
-                + post_factor * elbo_grad.square();
-            }
-            eta_scaled = eta / sqrt(static_cast<double>(iter_tune));
-            // Stochastic gradient update
-            variational += eta_scaled * elbo_grad
-              / (tau + history_grad_squared.sqrt());
+        int num_threads = std::min(
+          stan::services::util::num_autodiff_threads(num_threads_),
+          eta_sequence_size);
+        std::vector<double> elbos;
+        if (num_threads > 1) {
+          std::vector<boost::ecuyer1988> rngs;
+          split_rng(rng_, eta_sequence_size, rngs);
+          adapt_eta_functor<advi, Q, boost::ecuyer1988>
+            candidates(*this, variational, eta_sequence, eta_sequence_size,
+                       adapt_iterations, elbo_init, rngs);
+          stan::services::util::parallel_for(eta_sequence_size, num_threads,
+                                             candidates);
+          // messages of cancelled candidates are dropped so the log
+          // reads as if the candidates had run in order
+          for (int i = 0; i <= candidates.last_needed(); ++i) {
+            std::stringstream messages(candidates.messages_[i]);
+            std::string line;
+            while (std::getline(messages, line))
+              logger.info(line);
           }
-
-          // (ROBUST) Compute ELBO. It's OK if it has diverged.
-          try {
-            elbo = calc_ELBO(variational, logger);
-          } catch (const std::domain_error& e) {
-            elbo = -std::numeric_limits<double>::max();
+          elbos = candidates.elbos_;
+        } else {
+          std::atomic<int> last_needed(eta_sequence_size - 1);
+          elbos.assign(eta_sequence_size, 0.0);
+          std::vector<int> done(eta_sequence_size, 0);
+          for (int i = 0; i <= last_needed; ++i) {
+            elbos[i] = adapt_eta_candidate(variational, i, eta_sequence[i],
+                                           adapt_iterations,
+                                           eta_sequence_size, rng_,
+                                           num_threads_, last_needed, logger);
+            done[i] = 1;
+            last_needed = adapt_eta_last_needed(elbos, done, elbo_init);
           }
+        }
+        variational = init_variational();
+
+        double elbo_best = -std::numeric_limits<double>::max();
+        double eta_best = 0.0;
+        for (int i = 0; i < eta_sequence_size; ++i) {
+          double eta = eta_sequence[i];
+          double elbo = elbos[i];
 
           // Check if:
           // (1) ELBO at current eta is worse than the best ELBO
@@ -270,42 +524,33 @@ namespace stan {
             ss << "Success!"
                << " Found best value [eta = " << eta_best
                << "]";
-            if (eta_sequence_index < eta_sequence_size - 1)
+            if (i < eta_sequence_size - 1)
               ss << (" earlier than expected.");
             else
               ss << ".";
             logger.info(ss);
             logger.info("");
-            do_more_tuning = false;
+            return eta_best;
+          }
+          if (i < eta_sequence_size - 1) {
+            elbo_best = elbo;
+            eta_best = eta;
+          } else if (elbo > elbo_init) {
+            // No more eta values to try, so use current eta if it
+            // didn't diverge or fail if it did diverge
+            std::stringstream ss;
+            ss << "Success!"
+               << " Found best value [eta = " << eta_best
+               << "].";
+            logger.info(ss);
+            logger.info("");
+            eta_best = eta;
           } else {
-            if (eta_sequence_index < eta_sequence_size - 1) {
-              // Reset
-              elbo_best = elbo;
-              eta_best = eta;
-            } else {
-              // No more eta values to try, so use current eta if it
-              // didn't diverge or fail if it did diverge
-              if (elbo > elbo_init) {
-                std::stringstream ss;
-                ss << "Success!"
-                   << " Found best value [eta = " << eta_best
-                   << "].";
-                logger.info(ss);
-                logger.info("");
-                eta_best = eta;
-                do_more_tuning = false;
-              } else {
-                const char* name = "All proposed step-sizes";
-                const char* msg1 = "failed. Your model may be either "
-                  "severely ill-conditioned or misspecified.";
-                stan::math::domain_error(function, name, "", msg1);
-              }
-            }
-            // Reset
-            history_grad_squared.set_to_zero();
+            const char* name = "All proposed step-sizes";
+            const char* msg1 = "failed. Your model may be either "
+              "severely ill-conditioned or misspecified.";
+            stan::math::domain_error(function, name, "", msg1);
           }
-          ++eta_sequence_index;
-          variational = Q(cont_params_);
         }
         return eta_best;
       }
@@ -341,10 +586,10 @@ namespace stan {
                                    max_iterations);
 
         // Gradient parameters
-        Q elbo_grad = Q(model_.num_params_r());
+        Q elbo_grad = zero_variational();
 
         // Stepsize sequence parameters
-        Q history_grad_squared = Q(model_.num_params_r());
+        Q history_grad_squared = zero_variational();
         double tau = 1.0;
         double pre_factor  = 0.9;
         double post_factor = 0.1;
@@ -491,7 +736,7 @@ namespace stan {
         diagnostic_writer("iter,time_in_seconds,ELBO");
 
         // Initialize variational approximation
-        Q variational = Q(cont_params_);
+        Q variational = init_variational();
 
         if (adapt_engaged) {
           eta = adapt_eta(variational, adapt_iterations, logger);
@@ -583,10 +828,12 @@ namespace stan {
       Model& model_;
       Eigen::VectorXd& cont_params_;
       BaseRNG& rng_;
+      Q variational_init_;
       int n_monte_carlo_grad_;
       int n_monte_carlo_elbo_;
       int eval_elbo_;
       int n_posterior_samples_;
+      int num_threads_;
     };
   }  // variational
 }  // stan
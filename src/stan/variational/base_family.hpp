@@ -28,6 +28,7 @@ namespace stan {
       // Distribution-based operations
       const Eigen::VectorXd& mean() const;
       double entropy() const;
+      int eta_dimension() const;
       Eigen::VectorXd transform(const Eigen::VectorXd& eta) const;
       template <class BaseRNG>
       void sample(BaseRNG& rng, Eigen::VectorXd& eta) const;
@@ -37,7 +38,8 @@ namespace stan {
                      Eigen::VectorXd& cont_params,
                      int n_monte_carlo_grad,
                      BaseRNG& rng,
-                     callbacks::logger& logger)
+                     callbacks::logger& logger,
+                     int num_threads)
         const;
 
     protected:
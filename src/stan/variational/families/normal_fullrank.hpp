@@ -5,6 +5,7 @@
 #include <stan/math/prim/mat.hpp>
 #include <stan/model/gradient.hpp>
 #include <stan/variational/base_family.hpp>
+#include <stan/variational/monte_carlo.hpp>
 #include <algorithm>
 #include <ostream>
 #include <vector>
@@ -132,6 +133,12 @@ namespace stan {
        */
       int dimension() const { return dimension_; }
 
+      /**
+       * Return the number of standard normal variates that
+       * <code>transform</code> maps to one draw.
+       */
+      int eta_dimension() const { return dimension_; }
+
       /**
        * Return the mean vector.
        */
@@ -379,11 +386,33 @@ namespace stan {
         eta = transform(eta);
       }
 
+      /**
+       * Adds the contribution of one Monte Carlo draw to the gradient
+       * with respect to the Cholesky factor, without the entropy
+       * term.  Only the lower triangle is updated.
+       *
+       * @param[in] eta Draw from the standard normal.
+       * @param[in] grad_log_prob Gradient of the model's log density
+       * at the transformed draw.
+       * @param[in,out] L_grad Running sum of contributions.
+       */
+      void accumulate_grad(const Eigen::VectorXd& eta,
+                           const Eigen::VectorXd& grad_log_prob,
+                           Eigen::MatrixXd& L_grad) const {
+        for (int ii = 0; ii < dimension_; ++ii) {
+          for (int jj = 0; jj <= ii; ++jj) {
+            L_grad(ii, jj) += grad_log_prob(ii) * eta(jj);
+          }
+        }
+      }
+
       /**
        * Calculates the "blackbox" gradient with respect to BOTH the
        * location vector (mu) and the cholesky factor of the scale
        * matrix (L_chol) in parallel. It uses the same gradient
-       * computed from a set of Monte Carlo samples
+       * computed from a set of Monte Carlo samples, which are split
+       * over up to <code>num_threads</code> threads when autodiff is
+       * thread safe.
        *
        * @tparam M Model class.
        * @tparam BaseRNG Class of base random number generator.
@@ -393,6 +422,7 @@ namespace stan {
        * @param[in] n_monte_carlo_grad Sample size for gradient computation.
        * @param[in,out] rng Random number generator.
        * @param[in,out] logger logger for messages
+       * @param[in] num_threads Maximum number of threads.
        * @throw std::domain_error If the number of divergent
        * iterations exceeds its specified bounds.
        */
@@ -402,7 +432,8 @@ namespace stan {
                      Eigen::VectorXd& cont_params,
                      int n_monte_carlo_grad,
                      BaseRNG& rng,
-                     callbacks::logger& logger)
+                     callbacks::logger& logger,
+                     int num_threads = 1)
         const {
         static const char* function =
           "stan::variational::normal_fullrank::calc_grad";
@@ -415,47 +446,10 @@ namespace stan {
 
         Eigen::VectorXd mu_grad = Eigen::VectorXd::Zero(dimension_);
         Eigen::MatrixXd L_grad  = Eigen::MatrixXd::Zero(dimension_, dimension_);
-        double tmp_lp = 0.0;
-        Eigen::VectorXd tmp_mu_grad = Eigen::VectorXd::Zero(dimension_);
-        Eigen::VectorXd eta = Eigen::VectorXd::Zero(dimension_);
-        Eigen::VectorXd zeta = Eigen::VectorXd::Zero(dimension_);
 
         // Naive Monte Carlo integration
-        static const int n_retries = 10;
-        for (int i = 0, n_monte_carlo_drop = 0; i < n_monte_carlo_grad; ) {
-          // Draw from standard normal and transform to real-coordinate space
-          for (int d = 0; d < dimension_; ++d) {
-            eta(d) = stan::math::normal_rng(0, 1, rng);
-          }
-          zeta = transform(eta);
-          try {
-            std::stringstream ss;
-            stan::model::gradient(m, zeta, tmp_lp, tmp_mu_grad, &ss);
-            if (ss.str().length() > 0)
-              logger.info(ss);
-            stan::math::check_finite(function, "Gradient of mu", tmp_mu_grad);
-
-            mu_grad += tmp_mu_grad;
-            for (int ii = 0; ii < dimension_; ++ii) {
-              for (int jj = 0; jj <= ii; ++jj) {
-                L_grad(ii, jj) += tmp_mu_grad(ii) * eta(jj);
-              }
-            }
-            ++i;
-          } catch (const std::exception& e) {
-            ++n_monte_carlo_drop;
-            if (n_monte_carlo_drop >= n_retries * n_monte_carlo_grad) {
-              const char* name = "The number of dropped evaluations";
-              const char* msg1 = "has reached its maximum amount (";
-              int y = n_retries * n_monte_carlo_grad;
-              const char* msg2 = "). Your model may be either severely "
-                "ill-conditioned or misspecified.";
-              stan::math::domain_error(function, name, y, msg1, msg2);
-            }
-          }
-        }
-        mu_grad /= static_cast<double>(n_monte_carlo_grad);
-        L_grad  /= static_cast<double>(n_monte_carlo_grad);
+        mc_grad(*this, m, n_monte_carlo_grad, rng, num_threads, function,
+                logger, mu_grad, L_grad);
 
         // Add gradient of entropy term
         L_grad.diagonal().array() += L_chol_.diagonal().array().inverse();
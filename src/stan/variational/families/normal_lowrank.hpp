@@ -0,0 +1,598 @@
+#ifndef STAN_VARIATIONAL_NORMAL_LOWRANK_HPP
+#define STAN_VARIATIONAL_NORMAL_LOWRANK_HPP
+
+#include <stan/callbacks/logger.hpp>
+#include <stan/math/prim/mat.hpp>
+#include <stan/model/gradient.hpp>
+#include <stan/variational/base_family.hpp>
+#include <stan/variational/monte_carlo.hpp>
+#include <algorithm>
+#include <ostream>
+#include <vector>
+
+namespace stan {
+
+  namespace variational {
+
+    /**
+     * Variational family approximation with multivariate normal
+     * distribution whose covariance is a diagonal plus a low rank
+     * factor,
+     *
+     *   Sigma = B * B' + diag(exp(2 * omega)).
+     *
+     * With rank k, the approximation has d * (k + 2) parameters and a
+     * draw costs O(d * k), so correlations can be modeled when the
+     * d^2 parameters of the full rank family do not fit in memory.
+     */
+    class normal_lowrank : public base_family {
+    private:
+      /**
+       * Mean vector.
+       */
+      Eigen::VectorXd mu_;
+
+      /**
+       * Log standard deviation (log scale) vector of the diagonal.
+       */
+      Eigen::VectorXd omega_;
+
+      /**
+       * Low rank factor of the covariance (dimension x rank).
+       */
+      Eigen::MatrixXd B_;
+
+      /**
+       * Dimensionality of distribution.
+       */
+      const int dimension_;
+
+      /**
+       * Rank of the factor.
+       */
+      const int rank_;
+
+      /**
+       * Returns the Cholesky factor of the capacitance matrix
+       * I + B' * diag(exp(-2 * omega)) * B, which gives the
+       * determinant and inverse of the covariance through the
+       * Woodbury identity in O(d * k^2).
+       */
+      Eigen::LLT<Eigen::MatrixXd> capacitance() const {
+        Eigen::MatrixXd D_inv_B
+          = (-omega_).array().exp().matrix().asDiagonal() * B_;
+        Eigen::MatrixXd C = Eigen::MatrixXd::Identity(rank_, rank_);
+        C.selfadjointView<Eigen::Lower>().rankUpdate(D_inv_B.transpose());
+        return Eigen::LLT<Eigen::MatrixXd>(C);
+      }
+
+    public:
+      /**
+       * Construct a variational distribution of the specified
+       * dimensionality and rank with a zero mean, zero log standard
+       * deviation and zero factor.
+       *
+       * @param[in] dimension Dimensionality of distribution.
+       * @param[in] rank Rank of the factor.
+       */
+      normal_lowrank(size_t dimension, size_t rank)
+        : mu_(Eigen::VectorXd::Zero(dimension)),
+          omega_(Eigen::VectorXd::Zero(dimension)),
+          B_(Eigen::MatrixXd::Zero(dimension, rank)),
+          dimension_(dimension), rank_(rank) {
+      }
+
+      /**
+       * Construct a variational distribution of the specified rank
+       * with the specified mean vector, zero log standard deviation
+       * (unit standard deviation) and zero factor.
+       *
+       * @param[in] cont_params Mean vector.
+       * @param[in] rank Rank of the factor.
+       */
+      normal_lowrank(const Eigen::VectorXd& cont_params, size_t rank)
+        : mu_(cont_params),
+          omega_(Eigen::VectorXd::Zero(cont_params.size())),
+          B_(Eigen::MatrixXd::Zero(cont_params.size(), rank)),
+          dimension_(cont_params.size()), rank_(rank) {
+      }
+
+      /**
+       * Construct a variational distribution with the specified mean,
+       * log standard deviation vector and factor.
+       *
+       * @param[in] mu Mean vector.
+       * @param[in] omega Log standard deviation vector.
+       * @param[in] B Low rank factor, one row per dimension.
+       * @throw std::domain_error If the sizes of the mean, log
+       * standard deviation and rows of the factor are different, or
+       * if any contains a not-a-number value.
+       */
+      normal_lowrank(const Eigen::VectorXd& mu,
+                     const Eigen::VectorXd& omega,
+                     const Eigen::MatrixXd& B)
+        : mu_(mu), omega_(omega), B_(B), dimension_(mu.size()),
+          rank_(B.cols()) {
+        static const char* function = "stan::variational::normal_lowrank";
+        stan::math::check_size_match(function,
+                             "Dimension of mean vector", dimension_,
+                             "Dimension of log std vector", omega_.size());
+        stan::math::check_size_match(function,
+                             "Dimension of mean vector", dimension_,
+                             "Rows of factor", B_.rows());
+        stan::math::check_not_nan(function, "Mean vector", mu_);
+        stan::math::check_not_nan(function, "Log std vector", omega_);
+        stan::math::check_not_nan(function, "Factor", B_);
+      }
+
+      /**
+       * Return the dimensionality of the approximation.
+       */
+      int dimension() const { return dimension_; }
+
+      /**
+       * Return the rank of the factor.
+       */
+      int rank() const { return rank_; }
+
+      /**
+       * Return the number of standard normal variates that
+       * <code>transform</code> maps to one draw.
+       */
+      int eta_dimension() const { return dimension_ + rank_; }
+
+      /**
+       * Return the mean vector.
+       */
+      const Eigen::VectorXd& mu() const { return mu_; }
+
+      /**
+       * Return the log standard deviation vector of the diagonal.
+       */
+      const Eigen::VectorXd& omega() const { return omega_; }
+
+      /**
+       * Return the low rank factor.
+       */
+      const Eigen::MatrixXd& B() const { return B_; }
+
+      /**
+       * Set the mean vector to the specified value.
+       *
+       * @param[in] mu Mean vector.
+       * @throw std::domain_error If the mean vector's size does not
+       * match this approximation's dimensionality, or if it contains
+       * not-a-number values.
+       */
+      void set_mu(const Eigen::VectorXd& mu) {
+        static const char* function =
+          "stan::variational::normal_lowrank::set_mu";
+
+        stan::math::check_size_match(function,
+                               "Dimension of input vector", mu.size(),
+                               "Dimension of current vector", dimension_);
+        stan::math::check_not_nan(function, "Input vector", mu);
+        mu_ = mu;
+      }
+
+      /**
+       * Set the log standard deviation vector to the specified
+       * value.
+       *
+       * @param[in] omega Log standard deviation vector.
+       * @throw std::domain_error If the log standard deviation
+       * vector's size does not match this approximation's
+       * dimensionality, or if it contains not-a-number values.
+       */
+      void set_omega(const Eigen::VectorXd& omega) {
+        static const char* function =
+          "stan::variational::normal_lowrank::set_omega";
+
+        stan::math::check_size_match(function,
+                               "Dimension of input vector", omega.size(),
+                               "Dimension of current vector", dimension_);
+        stan::math::check_not_nan(function, "Input vector", omega);
+        omega_ = omega;
+      }
+
+      /**
+       * Set the low rank factor to the specified value.
+       *
+       * @param[in] B Low rank factor.
+       * @throw std::domain_error If the factor's size does not match
+       * this approximation's dimensionality and rank, or if it
+       * contains not-a-number values.
+       */
+      void set_B(const Eigen::MatrixXd& B) {
+        static const char* function =
+          "stan::variational::normal_lowrank::set_B";
+
+        stan::math::check_size_match(function,
+                               "Rows of input matrix", B.rows(),
+                               "Dimension of current vector", dimension_);
+        stan::math::check_size_match(function,
+                               "Columns of input matrix", B.cols(),
+                               "Rank of current factor", rank_);
+        stan::math::check_not_nan(function, "Input matrix", B);
+        B_ = B;
+      }
+
+      /**
+       * Sets the mean, log standard deviation and factor of this
+       * approximation to zero.
+       */
+      void set_to_zero() {
+        mu_ = Eigen::VectorXd::Zero(dimension_);
+        omega_ = Eigen::VectorXd::Zero(dimension_);
+        B_ = Eigen::MatrixXd::Zero(dimension_, rank_);
+      }
+
+      /**
+       * Return a new low rank approximation resulting from squaring
+       * the entries in the mean, log standard deviation and factor.
+       * The new approximation does not hold any references to this
+       * approximation.
+       */
+      normal_lowrank square() const {
+        return normal_lowrank(Eigen::VectorXd(mu_.array().square()),
+                              Eigen::VectorXd(omega_.array().square()),
+                              Eigen::MatrixXd(B_.array().square()));
+      }
+
+      /**
+       * Return a new low rank approximation resulting from taking the
+       * square root of the entries in the mean, log standard
+       * deviation and factor.  The new approximation does not hold
+       * any references to this approximation.
+       *
+       * <b>Warning:</b>  No checks are carried out to ensure the
+       * entries are non-negative before taking square roots, so
+       * not-a-number values may result.
+       */
+      normal_lowrank sqrt() const {
+        return normal_lowrank(Eigen::VectorXd(mu_.array().sqrt()),
+                              Eigen::VectorXd(omega_.array().sqrt()),
+                              Eigen::MatrixXd(B_.array().sqrt()));
+      }
+
+      /**
+       * Return this approximation after setting its mean, log
+       * standard deviation and factor to the values given by the
+       * specified approximation.
+       *
+       * @param[in] rhs Approximation from which to gather the values.
+       * @return This approximation after assignment.
+       * @throw std::domain_error If the dimensionality or rank of the
+       * specified approximation does not match this approximation's.
+       */
+      normal_lowrank& operator=(const normal_lowrank& rhs) {
+        static const char* function =
+          "stan::variational::normal_lowrank::operator=";
+        stan::math::check_size_match(function,
+                             "Dimension of lhs", dimension_,
+                             "Dimension of rhs", rhs.dimension());
+        stan::math::check_size_match(function,
+                             "Rank of lhs", rank_,
+                             "Rank of rhs", rhs.rank());
+        mu_ = rhs.mu();
+        omega_ = rhs.omega();
+        B_ = rhs.B();
+        return *this;
+      }
+
+      /**
+       * Add the mean, log standard deviation and factor of the
+       * specified approximation to this approximation.
+       *
+       * @param[in] rhs Approximation from which to gather the values.
+       * @return This approximation after adding the specified
+       * approximation.
+       * @throw std::domain_error If the dimensionality or rank of the
+       * specified approximation does not match this approximation's.
+       */
+      normal_lowrank& operator+=(const normal_lowrank& rhs) {
+        static const char* function =
+          "stan::variational::normal_lowrank::operator+=";
+        stan::math::check_size_match(function,
+                             "Dimension of lhs", dimension_,
+                             "Dimension of rhs", rhs.dimension());
+        stan::math::check_size_match(function,
+                             "Rank of lhs", rank_,
+                             "Rank of rhs", rhs.rank());
+        mu_ += rhs.mu();
+        omega_ += rhs.omega();
+        B_ += rhs.B();
+        return *this;
+      }
+
+      /**
+       * Return this approximation after elementwise division by the
+       * specified approximation's mean, log standard deviation and
+       * factor.
+       *
+       * @param[in] rhs Approximation from which to gather the values.
+       * @return This approximation after elementwise division by the
+       * specified approximation.
+       * @throw std::domain_error If the dimensionality or rank of the
+       * specified approximation does not match this approximation's.
+       */
+      normal_lowrank& operator/=(const normal_lowrank& rhs) {
+        static const char* function =
+          "stan::variational::normal_lowrank::operator/=";
+        stan::math::check_size_match(function,
+                             "Dimension of lhs", dimension_,
+                             "Dimension of rhs", rhs.dimension());
+        stan::math::check_size_match(function,
+                             "Rank of lhs", rank_,
+                             "Rank of rhs", rhs.rank());
+        mu_.array() /= rhs.mu().array();
+        omega_.array() /= rhs.omega().array();
+        B_.array() /= rhs.B().array();
+        return *this;
+      }
+
+      /**
+       * Return this approximation after adding the specified scalar
+       * to each entry in the mean, log standard deviation and factor.
+       *
+       * <b>Warning:</b> No finiteness check is made on the scalar, so
+       * it may introduce NaNs.
+       *
+       * @param[in] scalar Scalar to add.
+       * @return This approximation after elementwise addition of the
+       * specified scalar.
+       */
+      normal_lowrank& operator+=(double scalar) {
+        mu_.array() += scalar;
+        omega_.array() += scalar;
+        B_.array() += scalar;
+        return *this;
+      }
+
+      /**
+       * Return this approximation after multiplying each entry in
+       * the mean, log standard deviation and factor by the specified
+       * scalar.
+       *
+       * <b>Warning:</b> No finiteness check is made on the scalar, so
+       * it may introduce NaNs.
+       *
+       * @param[in] scalar Scalar to multiply by.
+       * @return This approximation after elementwise multiplication by
+       * the specified scalar.
+       */
+      normal_lowrank& operator*=(double scalar) {
+        mu_ *= scalar;
+        omega_ *= scalar;
+        B_ *= scalar;
+        return *this;
+      }
+
+      /**
+       * Returns the mean vector for this approximation.
+       *
+       * See: <code>mu()</code>.
+       *
+       * @return Mean vector for this approximation.
+       */
+      const Eigen::VectorXd& mean() const {
+        return mu();
+      }
+
+      /**
+       * Return the entropy of the approximation.
+       *
+       * <p>By the matrix determinant lemma the entropy is
+       *   0.5 * dim * (1+log2pi) + 0.5 * log det Sigma
+       * = 0.5 * dim * (1+log2pi) + sum(omega)
+       *   + 0.5 * log det (I + B' diag(exp(-2 * omega)) B),
+       * which costs O(dim * rank^2).
+       *
+       * @return Entropy of this approximation.
+       */
+      double entropy() const {
+        Eigen::LLT<Eigen::MatrixXd> llt = capacitance();
+        return 0.5 * static_cast<double>(dimension_) *
+               (1.0 + stan::math::LOG_TWO_PI) + omega_.sum()
+          + llt.matrixLLT().diagonal().array().log().sum();
+      }
+
+      /**
+       * Return the transform of the specified vector of standard
+       * normal variates.
+       *
+       * The first <code>dimension()</code> entries of eta scale the
+       * diagonal and the last <code>rank()</code> entries the factor,
+       * S^{-1}(eta) = mu + exp(omega) * eta_1 + B * eta_2,
+       * which costs O(dim * rank).
+       *
+       * @param[in] eta Vector to transform.
+       * @throw std::domain_error If the specified vector's size does
+       * not match <code>eta_dimension()</code>.
+       * @return Transformed vector.
+       */
+      Eigen::VectorXd transform(const Eigen::VectorXd& eta) const {
+        static const char* function =
+          "stan::variational::normal_lowrank::transform";
+        stan::math::check_size_match(function,
+                         "Dimension of standard normal vector",
+                         eta_dimension(),
+                         "Dimension of input vector", eta.size());
+        stan::math::check_not_nan(function, "Input vector", eta);
+        Eigen::VectorXd zeta
+          = eta.head(dimension_).cwiseProduct(omega_.array().exp().matrix())
+          + mu_;
+        zeta.noalias() += B_ * eta.tail(rank_);
+        return zeta;
+      }
+
+      /**
+       * Assign a draw from this low rank approximation to the
+       * specified vector using the specified random number generator.
+       *
+       * @tparam BaseRNG Class of random number generator.
+       * @param[in] rng Base random number generator.
+       * @param[in,out] eta Vector to which the draw is assigned.
+       */
+      template <class BaseRNG>
+      void sample(BaseRNG& rng, Eigen::VectorXd& eta) const {
+        // Draw from standard normal and transform to real-coordinate space
+        Eigen::VectorXd z(eta_dimension());
+        for (int d = 0; d < z.size(); ++d)
+          z(d) = stan::math::normal_rng(0, 1, rng);
+        eta = transform(z);
+      }
+
+      /**
+       * Adds the contribution of one Monte Carlo draw to the gradient
+       * with respect to the log standard deviation (first column,
+       * before it is scaled by the standard deviation) and the factor
+       * (remaining columns).
+       *
+       * @param[in] eta Draw from the standard normal.
+       * @param[in] grad_log_prob Gradient of the model's log density
+       * at the transformed draw.
+       * @param[in,out] scale_grad Running sum of contributions.
+       */
+      void accumulate_grad(const Eigen::VectorXd& eta,
+                           const Eigen::VectorXd& grad_log_prob,
+                           Eigen::MatrixXd& scale_grad) const {
+        scale_grad.col(0).array()
+          += grad_log_prob.array().cwiseProduct(eta.head(dimension_).array());
+        scale_grad.rightCols(rank_).noalias()
+          += grad_log_prob * eta.tail(rank_).transpose();
+      }
+
+      /**
+       * Calculates the "blackbox" gradient with respect to the
+       * location vector (mu), the log-std vector (omega) and the
+       * factor (B).  It uses the same gradient computed from a set of
+       * Monte Carlo samples, which are split over up to
+       * <code>num_threads</code> threads when autodiff is thread
+       * safe.  Each draw costs O(dim * rank) beyond the gradient of
+       * the model; the entropy gradient costs O(dim * rank^2).
+       *
+       * @tparam M Model class.
+       * @tparam BaseRNG Class of base random number generator.
+       * @param[in] elbo_grad Parameters to store "blackbox" gradient
+       * @param[in] m Model.
+       * @param[in] cont_params Continuous parameters.
+       * @param[in] n_monte_carlo_grad Number of samples for gradient
+       * computation.
+       * @param[in,out] rng Random number generator.
+       * @param[in,out] logger logger for messages
+       * @param[in] num_threads Maximum number of threads.
+       * @throw std::domain_error If the number of divergent
+       * iterations exceeds its specified bounds.
+       */
+      template <class M, class BaseRNG>
+      void calc_grad(normal_lowrank& elbo_grad,
+                     M& m,
+                     Eigen::VectorXd& cont_params,
+                     int n_monte_carlo_grad,
+                     BaseRNG& rng,
+                     callbacks::logger& logger,
+                     int num_threads = 1)
+        const {
+        static const char* function =
+          "stan::variational::normal_lowrank::calc_grad";
+
+        stan::math::check_size_match(function,
+                        "Dimension of elbo_grad", elbo_grad.dimension(),
+                        "Dimension of variational q", dimension_);
+        stan::math::check_size_match(function,
+                        "Rank of elbo_grad", elbo_grad.rank(),
+                        "Rank of variational q", rank_);
+        stan::math::check_size_match(function,
+                        "Dimension of variational q", dimension_,
+                        "Dimension of variables in model", cont_params.size());
+
+        Eigen::VectorXd mu_grad = Eigen::VectorXd::Zero(dimension_);
+        Eigen::MatrixXd scale_grad
+          = Eigen::MatrixXd::Zero(dimension_, rank_ + 1);
+
+        // Naive Monte Carlo integration
+        mc_grad(*this, m, n_monte_carlo_grad, rng, num_threads, function,
+                logger, mu_grad, scale_grad);
+
+        // Gradient of the entropy through the capacitance matrix C:
+        // d/dB = Sigma^{-1} B = D^{-2} B C^{-1} and
+        // d/domega_i = 1 - exp(-2 omega_i) * B_i C^{-1} B_i'
+        Eigen::LLT<Eigen::MatrixXd> llt = capacitance();
+        Eigen::VectorXd inv_var = (-2.0 * omega_).array().exp();
+        Eigen::MatrixXd B_C_inv = llt.solve(B_.transpose()).transpose();
+
+        Eigen::VectorXd omega_grad
+          = scale_grad.col(0).cwiseProduct(omega_.array().exp().matrix());
+        omega_grad.array() += 1.0;
+        omega_grad.array()
+          -= inv_var.array() * B_C_inv.cwiseProduct(B_).rowwise().sum().array();
+
+        Eigen::MatrixXd B_grad = scale_grad.rightCols(rank_);
+        B_grad += inv_var.asDiagonal() * B_C_inv;
+
+        elbo_grad.set_mu(mu_grad);
+        elbo_grad.set_omega(omega_grad);
+        elbo_grad.set_B(B_grad);
+      }
+    };
+
+    /**
+     * Return a new approximation resulting from adding the mean, log
+     * standard deviation and factor of the specified approximations.
+     *
+     * @param[in] lhs First approximation.
+     * @param[in] rhs Second approximation.
+     * @return Sum of the specified approximations.
+     * @throw std::domain_error If the dimensionalities do not match.
+     */
+    inline
+    normal_lowrank operator+(normal_lowrank lhs, const normal_lowrank& rhs) {
+      return lhs += rhs;
+    }
+
+    /**
+     * Return a new approximation resulting from elementwise division of
+     * of the first specified approximation by the second.
+     *
+     * @param[in] lhs First approximation.
+     * @param[in] rhs Second approximation.
+     * @return Elementwise division of the specified approximations.
+     * @throw std::domain_error If the dimensionalities do not match.
+     */
+    inline
+    normal_lowrank operator/(normal_lowrank lhs, const normal_lowrank& rhs) {
+      return lhs /= rhs;
+    }
+
+    /**
+     * Return a new approximation resulting from elementwise addition
+     * of the specified scalar to the mean, log standard deviation and
+     * factor of the specified approximation.
+     *
+     * @param[in] scalar Scalar value
+     * @param[in] rhs Approximation.
+     * @return Addition of scalar to specified approximation.
+     */
+    inline
+    normal_lowrank operator+(double scalar, normal_lowrank rhs) {
+      return rhs += scalar;
+    }
+
+    /**
+     * Return a new approximation resulting from elementwise
+     * multiplication of the mean, log standard deviation and factor
+     * of the specified approximation by the specified scalar.
+     *
+     * @param[in] scalar Scalar value
+     * @param[in] rhs Approximation.
+     * @return Multiplication of specified approximation by scalar.
+     */
+    inline
+    normal_lowrank operator*(double scalar, normal_lowrank rhs) {
+      return rhs *= scalar;
+    }
+
+  }
+}
+#endif
@@ -5,6 +5,7 @@
 #include <stan/math/prim/mat.hpp>
 #include <stan/model/gradient.hpp>
 #include <stan/variational/base_family.hpp>
+#include <stan/variational/monte_carlo.hpp>
 #include <algorithm>
 #include <ostream>
 #include <vector>
@@ -88,6 +89,12 @@ namespace stan {
        */
       int dimension() const { return dimension_; }
 
+      /**
+       * Return the number of standard normal variates that
+       * <code>transform</code> maps to one draw.
+       */
+      int eta_dimension() const { return dimension_; }
+
       /**
        * Return the mean vector.
        */
@@ -342,11 +349,29 @@ namespace stan {
         eta = transform(eta);
       }
 
+      /**
+       * Adds the contribution of one Monte Carlo draw to the gradient
+       * with respect to the log standard deviation, before it is
+       * scaled by the standard deviation.
+       *
+       * @param[in] eta Draw from the standard normal.
+       * @param[in] grad_log_prob Gradient of the model's log density
+       * at the transformed draw.
+       * @param[in,out] omega_grad Running sum of contributions.
+       */
+      void accumulate_grad(const Eigen::VectorXd& eta,
+                           const Eigen::VectorXd& grad_log_prob,
+                           Eigen::VectorXd& omega_grad) const {
+        omega_grad.array() += grad_log_prob.array().cwiseProduct(eta.array());
+      }
+
       /**
        * Calculates the "blackbox" gradient with respect to both the
        * location vector (mu) and the log-std vector (omega) in
        * parallel.  It uses the same gradient computed from a set of
-       * Monte Carlo samples.
+       * Monte Carlo samples, which are split over up to
+       * <code>num_threads</code> threads when autodiff is thread
+       * safe.
        *
        * @tparam M Model class.
        * @tparam BaseRNG Class of base random number generator.
@@ -357,6 +382,7 @@ namespace stan {
        * computation.
        * @param[in,out] rng Random number generator.
        * @param[in,out] logger logger for messages
+       * @param[in] num_threads Maximum number of threads.
        * @throw std::domain_error If the number of divergent
        * iterations exceeds its specified bounds.
        */
@@ -366,7 +392,8 @@ namespace stan {
                      Eigen::VectorXd& cont_params,
                      int n_monte_carlo_grad,
                      BaseRNG& rng,
-                     callbacks::logger& logger)
+                     callbacks::logger& logger,
+                     int num_threads = 1)
         const {
         static const char* function =
           "stan::variational::normal_meanfield::calc_grad";
@@ -380,41 +407,10 @@ namespace stan {
 
         Eigen::VectorXd mu_grad    = Eigen::VectorXd::Zero(dimension_);
         Eigen::VectorXd omega_grad = Eigen::VectorXd::Zero(dimension_);
-        double tmp_lp = 0.0;
-        Eigen::VectorXd tmp_mu_grad = Eigen::VectorXd::Zero(dimension_);
-        Eigen::VectorXd eta  = Eigen::VectorXd::Zero(dimension_);
-        Eigen::VectorXd zeta = Eigen::VectorXd::Zero(dimension_);
 
         // Naive Monte Carlo integration
-        static const int n_retries = 10;
-        for (int i = 0, n_monte_carlo_drop = 0; i < n_monte_carlo_grad; ) {
-          // Draw from standard normal and transform to real-coordinate space
-          for (int d = 0; d < dimension_; ++d)
-            eta(d) = stan::math::normal_rng(0, 1, rng);
-          zeta = transform(eta);
-          try {
-            std::stringstream ss;
-            stan::model::gradient(m, zeta, tmp_lp, tmp_mu_grad, &ss);
-            if (ss.str().length() > 0)
-              logger.info(ss);
-            stan::math::check_finite(function, "Gradient of mu", tmp_mu_grad);
-            mu_grad += tmp_mu_grad;
-            omega_grad.array() += tmp_mu_grad.array().cwiseProduct(eta.array());
-            ++i;
-          } catch (const std::exception& e) {
-            ++n_monte_carlo_drop;
-            if (n_monte_carlo_drop >= n_retries * n_monte_carlo_grad) {
-              const char* name = "The number of dropped evaluations";
-              const char* msg1 = "has reached its maximum amount (";
-              int y = n_retries * n_monte_carlo_grad;
-              const char* msg2 = "). Your model may be either severely "
-                "ill-conditioned or misspecified.";
-              stan::math::domain_error(function, name, y, msg1, msg2);
-            }
-          }
-        }
-        mu_grad /= static_cast<double>(n_monte_carlo_grad);
-        omega_grad /= static_cast<double>(n_monte_carlo_grad);
+        mc_grad(*this, m, n_monte_carlo_grad, rng, num_threads, function,
+                logger, mu_grad, omega_grad);
 
         omega_grad.array()
           = omega_grad.array().cwiseProduct(omega_.array().exp());
@@ -0,0 +1,422 @@
+#ifndef STAN_VARIATIONAL_MONTE_CARLO_HPP
+#define STAN_VARIATIONAL_MONTE_CARLO_HPP
+
+#include <stan/callbacks/logger.hpp>
+#include <stan/math/prim/mat.hpp>
+#include <stan/model/gradient.hpp>
+#include <stan/model/log_prob_value.hpp>
+#include <stan/services/util/parallel_for.hpp>
+#include <boost/cstdint.hpp>
+#include <boost/random/additive_combine.hpp>
+#include <algorithm>
+#include <atomic>
+#include <exception>
+#include <sstream>
+#include <stdexcept>
+#include <string>
+#include <vector>
+
+namespace stan {
+
+  namespace variational {
+
+    /**
+     * Splits a random number generator into independent substreams
+     * for the blocks of a parallel Monte Carlo estimate.  Two draws
+     * of <code>rng</code> seed the two component generators of an
+     * L'Ecuyer generator, covering its full state rather than the 32
+     * bits of a single seed, and block <code>b</code> gets a copy of
+     * it advanced by <code>b</code> strides, so the blocks of one
+     * estimate never overlap and the next estimate starts from a
+     * fresh seed.
+     *
+     * Only two draws are taken from <code>rng</code>, so any
+     * generator accepted by ADVI can be split.
+     *
+     * @tparam BaseRNG class of random number generator
+     * @param[in,out] rng random number generator
+     * @param[in] num_blocks number of substreams
+     * @param[out] rngs generators for the substreams
+     */
+    template <class BaseRNG>
+    void split_rng(BaseRNG& rng, int num_blocks,
+                   std::vector<boost::ecuyer1988>& rngs) {
+      // 2^28 uniforms per block and estimate
+      static const boost::uintmax_t STRIDE
+        = static_cast<boost::uintmax_t>(1) << 28;
+      boost::uint32_t seed1 = static_cast<boost::uint32_t>(rng());
+      boost::uint32_t seed2 = static_cast<boost::uint32_t>(rng());
+      boost::ecuyer1988 block_rng(seed1, seed2);
+      rngs.assign(num_blocks, block_rng);
+      for (int b = 1; b < num_blocks; ++b)
+        rngs[b].discard(STRIDE * b);
+    }
+
+    /**
+     * Returns the number of Monte Carlo draws assigned to block
+     * <code>b</code> when <code>n</code> draws are split evenly into
+     * <code>num_blocks</code> contiguous blocks.
+     *
+     * @param[in] n total number of draws
+     * @param[in] num_blocks number of blocks
+     * @param[in] b block index
+     * @return number of draws of the block
+     */
+    inline int block_size(int n, int num_blocks, int b) {
+      return (b + 1) * n / num_blocks - b * n / num_blocks;
+    }
+
+    /**
+     * Throws the <code>std::domain_error</code> reported when too
+     * many Monte Carlo draws have been dropped.
+     *
+     * @param[in] function name of the calling function
+     * @param[in] max_dropped maximum number of dropped draws
+     * @throw std::domain_error always
+     */
+    inline void throw_max_dropped(const char* function, int max_dropped) {
+      const char* name = "The number of dropped evaluations";
+      const char* msg1 = "has reached its maximum amount (";
+      const char* msg2 = "). Your model may be either severely "
+        "ill-conditioned or misspecified.";
+      stan::math::domain_error(function, name, max_dropped, msg1, msg2);
+    }
+
+    /**
+     * Functor evaluating one block of the Monte Carlo estimate of the
+     * ELBO's expected log density.  Draws whose log density throws a
+     * <code>std::domain_error</code> are dropped and redrawn; the
+     * count of dropped draws is shared by all blocks.
+     *
+     * @tparam Q class of variational distribution
+     * @tparam M class of model
+     * @tparam BaseRNG class of random number generator
+     */
+    template <class Q, class M, class BaseRNG>
+    class elbo_block_functor {
+    private:
+      const Q& variational_;
+      M& model_;
+      std::vector<BaseRNG*>& rngs_;
+      int n_draws_;
+      int max_dropped_;
+      std::atomic<int>& n_dropped_;
+      const char* function_;
+
+    public:
+      std::vector<double> sums_;
+      std::vector<std::vector<std::string> > messages_;
+
+      elbo_block_functor(const Q& variational, M& model,
+                         std::vector<BaseRNG*>& rngs, int n_draws,
+                         int max_dropped, std::atomic<int>& n_dropped,
+                         const char* function)
+        : variational_(variational), model_(model), rngs_(rngs),
+          n_draws_(n_draws), max_dropped_(max_dropped),
+          n_dropped_(n_dropped), function_(function),
+          sums_(rngs.size(), 0.0), messages_(rngs.size()) { }
+
+      void operator()(std::size_t b) {
+        int size = block_size(n_draws_, static_cast<int>(rngs_.size()), b);
+        Eigen::VectorXd zeta(variational_.dimension());
+        for (int i = 0; i < size; ) {
+          // another block has already given up
+          if (n_dropped_ >= max_dropped_)
+            return;
+          variational_.sample(*rngs_[b], zeta);
+          try {
+            std::stringstream ss;
+            double log_prob
+              = stan::model::log_prob_value<false, true>(model_, zeta, &ss);
+            if (ss.str().length() > 0)
+              messages_[b].push_back(ss.str());
+            stan::math::check_finite(function_, "log_prob", log_prob);
+            sums_[b] += log_prob;
+            ++i;
+          } catch (const std::domain_error&) {
+            if (++n_dropped_ >= max_dropped_)
+              throw_max_dropped(function_, max_dropped_);
+          }
+        }
+      }
+    };
+
+    /**
+     * Functor evaluating one block of the Monte Carlo estimate of the
+     * ELBO gradient.  Each draw adds the gradient of the log density
+     * to the mean gradient and lets the variational family add its
+     * contribution to the gradient of its scale parameters through
+     * <code>Q::accumulate_grad</code>.  Draws that throw are dropped
+     * and redrawn; the count of dropped draws is shared by all
+     * blocks.
+     *
+     * @tparam Q class of variational distribution
+     * @tparam M class of model
+     * @tparam BaseRNG class of random number generator
+     * @tparam G class of the gradient of the scale parameters
+     */
+    template <class Q, class M, class BaseRNG, class G>
+    class grad_block_functor {
+    private:
+      const Q& variational_;
+      M& model_;
+      std::vector<BaseRNG*>& rngs_;
+      int n_draws_;
+      int max_dropped_;
+      std::atomic<int>& n_dropped_;
+      const char* function_;
+
+    public:
+      std::vector<Eigen::VectorXd> mu_grads_;
+      std::vector<G> scale_grads_;
+      std::vector<std::vector<std::string> > messages_;
+
+      grad_block_functor(const Q& variational, M& model,
+                         std::vector<BaseRNG*>& rngs, int n_draws,
+                         int max_dropped, std::atomic<int>& n_dropped,
+                         const char* function, const G& zero_scale_grad)
+        : variational_(variational), model_(model), rngs_(rngs),
+          n_draws_(n_draws), max_dropped_(max_dropped),
+          n_dropped_(n_dropped), function_(function),
+          mu_grads_(rngs.size(),
+                    Eigen::VectorXd::Zero(variational.dimension())),
+          scale_grads_(rngs.size(), zero_scale_grad),
+          messages_(rngs.size()) { }
+
+      void operator()(std::size_t b) {
+        int dim = variational_.dimension();
+        int eta_dim = variational_.eta_dimension();
+        int size = block_size(n_draws_, static_cast<int>(rngs_.size()), b);
+        double tmp_lp = 0.0;
+        Eigen::VectorXd tmp_mu_grad = Eigen::VectorXd::Zero(dim);
+        Eigen::VectorXd eta = Eigen::VectorXd::Zero(eta_dim);
+        Eigen::VectorXd zeta = Eigen::VectorXd::Zero(dim);
+        for (int i = 0; i < size; ) {
+          // another block has already given up
+          if (n_dropped_ >= max_dropped_)
+            return;
+          // Draw from standard normal and transform to real-coordinate space
+          for (int d = 0; d < eta_dim; ++d)
+            eta(d) = stan::math::normal_rng(0, 1, *rngs_[b]);
+          zeta = variational_.transform(eta);
+          try {
+            std::stringstream ss;
+            stan::model::gradient(model_, zeta, tmp_lp, tmp_mu_grad, &ss);
+            if (ss.str().length() > 0)
+              messages_[b].push_back(ss.str());
+            stan::math::check_finite(function_, "Gradient of mu", tmp_mu_grad);
+            mu_grads_[b] += tmp_mu_grad;
+            variational_.accumulate_grad(eta, tmp_mu_grad, scale_grads_[b]);
+            ++i;
+          } catch (const std::exception&) {
+            if (++n_dropped_ >= max_dropped_)
+              throw_max_dropped(function_, max_dropped_);
+          }
+        }
+      }
+    };
+
+    /**
+     * Runs the blocks of a Monte Carlo estimate over up to
+     * <code>num_threads</code> threads and then logs the messages of
+     * the model in block order, also when a block throws.
+     *
+     * @tparam F class of block functor
+     * @param[in,out] f block functor
+     * @param[in] num_blocks number of blocks
+     * @param[in] num_threads maximum number of threads
+     * @param[in,out] logger logger for messages
+     */
+    template <class F>
+    void run_blocks(F& f, int num_blocks, int num_threads,
+                    callbacks::logger& logger) {
+      std::exception_ptr error;
+      try {
+        stan::services::util::parallel_for(num_blocks, num_threads, f);
+      } catch (...) {
+        error = std::current_exception();
+      }
+      for (size_t b = 0; b < f.messages_.size(); ++b)
+        for (size_t m = 0; m < f.messages_[b].size(); ++m)
+          logger.info(f.messages_[b][m]);
+      if (error)
+        std::rethrow_exception(error);
+    }
+
+    /**
+     * Returns the sum of the log densities of the Monte Carlo draws
+     * of the ELBO, one block per generator.
+     *
+     * @tparam Q class of variational distribution
+     * @tparam M class of model
+     * @tparam R class of the block random number generators
+     * @param[in] variational variational distribution
+     * @param[in] m model
+     * @param[in] n_monte_carlo_elbo number of draws
+     * @param[in,out] rngs random number generator of each block
+     * @param[in] num_threads maximum number of threads
+     * @param[in] function name of the calling function for errors
+     * @param[in,out] logger logger for messages
+     * @return sum of the log densities
+     */
+    template <class Q, class M, class R>
+    double sum_log_prob_blocks(const Q& variational, M& m,
+                               int n_monte_carlo_elbo, std::vector<R*>& rngs,
+                               int num_threads, const char* function,
+                               callbacks::logger& logger) {
+      std::atomic<int> n_dropped(0);
+      elbo_block_functor<Q, M, R>
+        f(variational, m, rngs, n_monte_carlo_elbo, n_monte_carlo_elbo,
+          n_dropped, function);
+      run_blocks(f, rngs.size(), num_threads, logger);
+
+      double sum = 0.0;
+      for (size_t b = 0; b < rngs.size(); ++b)
+        sum += f.sums_[b];
+      return sum;
+    }
+
+    /**
+     * Returns the Monte Carlo estimate of the expected log density
+     * of the model under a variational distribution, the first term
+     * of the ELBO.
+     *
+     * With a single thread the draws come from <code>rng</code> in
+     * order.  Otherwise the draws are split into one block per
+     * thread, each with its own substream split from
+     * <code>rng</code>, so the estimate depends on the number of
+     * threads but not on scheduling.  Log density evaluations only
+     * use doubles but may still use nested autodiff, so the blocks
+     * run on one thread unless <code>STAN_THREADS</code> is defined.
+     *
+     * @tparam Q class of variational distribution
+     * @tparam M class of model
+     * @tparam BaseRNG class of random number generator
+     * @param[in] variational variational distribution
+     * @param[in] m model
+     * @param[in] n_monte_carlo_elbo number of draws
+     * @param[in,out] rng random number generator
+     * @param[in] num_threads maximum number of threads
+     * @param[in] function name of the calling function for errors
+     * @param[in,out] logger logger for messages
+     * @return estimate of the expected log density
+     * @throw std::domain_error if <code>n_monte_carlo_elbo</code>
+     *   draws have been dropped
+     */
+    template <class Q, class M, class BaseRNG>
+    double mc_expected_log_prob(const Q& variational, M& m,
+                                int n_monte_carlo_elbo, BaseRNG& rng,
+                                int num_threads, const char* function,
+                                callbacks::logger& logger) {
+      num_threads = stan::services::util::num_autodiff_threads(num_threads);
+      int num_blocks = std::max(1, std::min(num_threads, n_monte_carlo_elbo));
+      if (num_blocks == 1) {
+        std::vector<BaseRNG*> rngs(1, &rng);
+        return sum_log_prob_blocks(variational, m, n_monte_carlo_elbo, rngs,
+                                   1, function, logger)
+          / n_monte_carlo_elbo;
+      }
+      std::vector<boost::ecuyer1988> block_rngs;
+      split_rng(rng, num_blocks, block_rngs);
+      std::vector<boost::ecuyer1988*> rngs(num_blocks);
+      for (int b = 0; b < num_blocks; ++b)
+        rngs[b] = &block_rngs[b];
+      return sum_log_prob_blocks(variational, m, n_monte_carlo_elbo, rngs,
+                                 num_threads, function, logger)
+        / n_monte_carlo_elbo;
+    }
+
+    /**
+     * Adds the sums of the gradient contributions of the Monte Carlo
+     * draws of the ELBO gradient, one block per generator.
+     *
+     * @tparam Q class of variational distribution
+     * @tparam M class of model
+     * @tparam R class of the block random number generators
+     * @tparam G class of the gradient of the scale parameters
+     * @param[in] variational variational distribution
+     * @param[in] m model
+     * @param[in] n_monte_carlo_grad number of draws
+     * @param[in,out] rngs random number generator of each block
+     * @param[in] num_threads maximum number of threads
+     * @param[in] function name of the calling function for errors
+     * @param[in,out] logger logger for messages
+     * @param[in,out] mu_grad sum of gradients with respect to the mean
+     * @param[in,out] scale_grad sum of contributions to the scale
+     *   parameters
+     */
+    template <class Q, class M, class R, class G>
+    void sum_grad_blocks(const Q& variational, M& m, int n_monte_carlo_grad,
+                         std::vector<R*>& rngs, int num_threads,
+                         const char* function, callbacks::logger& logger,
+                         Eigen::VectorXd& mu_grad, G& scale_grad) {
+      static const int n_retries = 10;
+      std::atomic<int> n_dropped(0);
+      grad_block_functor<Q, M, R, G>
+        f(variational, m, rngs, n_monte_carlo_grad,
+          n_retries * n_monte_carlo_grad, n_dropped, function, scale_grad);
+      run_blocks(f, rngs.size(), num_threads, logger);
+
+      for (size_t b = 0; b < rngs.size(); ++b) {
+        mu_grad += f.mu_grads_[b];
+        scale_grad += f.scale_grads_[b];
+      }
+    }
+
+    /**
+     * Computes the Monte Carlo estimate of the gradient of the
+     * expected log density with respect to the parameters of a
+     * variational distribution, before the scale gradient is mapped
+     * to the family's parameterization and the entropy gradient is
+     * added.
+     *
+     * Blocks and substreams are assigned as in
+     * <code>mc_expected_log_prob</code>.  Gradients use reverse-mode
+     * autodiff, so more than one thread is only used when the math
+     * library is built with <code>STAN_THREADS</code>.
+     *
+     * @tparam Q class of variational distribution
+     * @tparam M class of model
+     * @tparam BaseRNG class of random number generator
+     * @tparam G class of the gradient of the scale parameters
+     * @param[in] variational variational distribution
+     * @param[in] m model
+     * @param[in] n_monte_carlo_grad number of draws
+     * @param[in,out] rng random number generator
+     * @param[in] num_threads maximum number of threads
+     * @param[in] function name of the calling function for errors
+     * @param[in,out] logger logger for messages
+     * @param[in,out] mu_grad zero on input, average gradient with
+     *   respect to the mean on output
+     * @param[in,out] scale_grad zero on input, average gradient
+     *   contribution to the scale parameters on output
+     * @throw std::domain_error if ten times
+     *   <code>n_monte_carlo_grad</code> draws have been dropped
+     */
+    template <class Q, class M, class BaseRNG, class G>
+    void mc_grad(const Q& variational, M& m, int n_monte_carlo_grad,
+                 BaseRNG& rng, int num_threads, const char* function,
+                 callbacks::logger& logger,
+                 Eigen::VectorXd& mu_grad, G& scale_grad) {
+      num_threads = stan::services::util::num_autodiff_threads(num_threads);
+      int num_blocks = std::max(1, std::min(num_threads, n_monte_carlo_grad));
+      if (num_blocks == 1) {
+        std::vector<BaseRNG*> rngs(1, &rng);
+        sum_grad_blocks(variational, m, n_monte_carlo_grad, rngs, 1,
+                        function, logger, mu_grad, scale_grad);
+      } else {
+        std::vector<boost::ecuyer1988> block_rngs;
+        split_rng(rng, num_blocks, block_rngs);
+        std::vector<boost::ecuyer1988*> rngs(num_blocks);
+        for (int b = 0; b < num_blocks; ++b)
+          rngs[b] = &block_rngs[b];
+        sum_grad_blocks(variational, m, n_monte_carlo_grad, rngs,
+                        num_threads, function, logger, mu_grad, scale_grad);
+      }
+      mu_grad /= static_cast<double>(n_monte_carlo_grad);
+      scale_grad /= static_cast<double>(n_monte_carlo_grad);
+    }
+
+  }  // variational
+}  // stan
+#endif
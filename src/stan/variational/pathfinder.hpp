@@ -0,0 +1,384 @@
+#ifndef STAN_VARIATIONAL_PATHFINDER_HPP
+#define STAN_VARIATIONAL_PATHFINDER_HPP
+
+#include <stan/math/prim/mat.hpp>
+#include <stan/model/log_prob_value.hpp>
+#include <stan/optimization/bfgs.hpp>
+#include <boost/random/normal_distribution.hpp>
+#include <boost/random/uniform_01.hpp>
+#include <boost/random/variate_generator.hpp>
+#include <Eigen/Dense>
+#include <algorithm>
+#include <cmath>
+#include <deque>
+#include <limits>
+#include <numeric>
+#include <ostream>
+#include <stdexcept>
+#include <vector>
+
+namespace stan {
+
+  namespace variational {
+
+    /**
+     * Multivariate normal approximation built from the history of an
+     * L-BFGS run, following Pathfinder (Zhang, Carpenter, Gelman and
+     * Vehtari, 2022).
+     *
+     * The covariance is the L-BFGS inverse Hessian estimate in compact
+     * form, <code>diag(alpha) + beta * gamma * beta'</code>, where
+     * <code>beta</code> has two columns per update pair.  When that is
+     * fewer than the dimension, draws and densities cost O(d m) through
+     * a thin QR factorization; otherwise the covariance is formed and
+     * Cholesky factored directly.
+     */
+    class lbfgs_normal {
+    public:
+      /**
+       * Construct the approximation at an L-BFGS iterate.
+       *
+       * @param[in] x current iterate
+       * @param[in] grad_f gradient of the minimized function (the
+       *   negative log density) at <code>x</code>
+       * @param[in] alpha diagonal of the initial inverse Hessian
+       * @param[in] S columns are the retained position differences
+       * @param[in] Y columns are the retained gradient differences
+       * @throw std::domain_error if the covariance is not positive
+       *   definite
+       */
+      lbfgs_normal(const Eigen::VectorXd& x, const Eigen::VectorXd& grad_f,
+                   const Eigen::VectorXd& alpha,
+                   const Eigen::MatrixXd& S, const Eigen::MatrixXd& Y)
+        : alpha_(alpha), dense_(2 * S.cols() >= x.size()) {
+        int d = x.size();
+        int m = S.cols();
+
+        Eigen::MatrixXd SY = S.transpose() * Y;
+        Eigen::MatrixXd R = SY.triangularView<Eigen::Upper>();
+        Eigen::MatrixXd R_inv
+          = R.triangularView<Eigen::Upper>()
+          .solve(Eigen::MatrixXd::Identity(m, m));
+        Eigen::MatrixXd Y_alpha = alpha.asDiagonal() * Y;
+        Eigen::MatrixXd DYY = Y.transpose() * Y_alpha;
+        DYY.diagonal() += SY.diagonal();
+
+        Eigen::MatrixXd beta(d, 2 * m);
+        beta << Y_alpha, S;
+        Eigen::MatrixXd gamma = Eigen::MatrixXd::Zero(2 * m, 2 * m);
+        gamma.topRightCorner(m, m) = -R_inv;
+        gamma.bottomLeftCorner(m, m) = -R_inv.transpose();
+        gamma.bottomRightCorner(m, m) = R_inv.transpose() * DYY * R_inv;
+
+        mu_ = x - (alpha.cwiseProduct(grad_f)
+                   + beta * (gamma * (beta.transpose() * grad_f)));
+
+        if (dense_) {
+          Eigen::MatrixXd H = beta * gamma * beta.transpose();
+          H.diagonal() += alpha;
+          Eigen::LLT<Eigen::MatrixXd> llt(H);
+          if (llt.info() != Eigen::Success)
+            throw std::domain_error("lbfgs_normal: covariance is not"
+                                    " positive definite");
+          L_ = llt.matrixL();
+          log_det_ = 2 * L_.diagonal().array().log().sum();
+        } else {
+          Eigen::MatrixXd B
+            = alpha.array().sqrt().inverse().matrix().asDiagonal() * beta;
+          Eigen::HouseholderQR<Eigen::MatrixXd> qr(B);
+          Q_ = qr.householderQ() * Eigen::MatrixXd::Identity(d, 2 * m);
+          Eigen::MatrixXd R_qr
+            = qr.matrixQR().topRows(2 * m).triangularView<Eigen::Upper>();
+          Eigen::MatrixXd M = R_qr * gamma * R_qr.transpose();
+          M.diagonal().array() += 1;
+          Eigen::LLT<Eigen::MatrixXd> llt(M);
+          if (llt.info() != Eigen::Success)
+            throw std::domain_error("lbfgs_normal: covariance is not"
+                                    " positive definite");
+          L_ = llt.matrixL();
+          log_det_ = alpha.array().log().sum()
+            + 2 * L_.diagonal().array().log().sum();
+        }
+        if (!mu_.allFinite() || !(log_det_ == log_det_))
+          throw std::domain_error("lbfgs_normal: approximation is not"
+                                  " finite");
+      }
+
+      /**
+       * Return the dimension of the approximation.
+       *
+       * @return dimension
+       */
+      int dimension() const { return mu_.size(); }
+
+      /**
+       * Return the mean of the approximation.
+       *
+       * @return mean vector
+       */
+      const Eigen::VectorXd& mean() const { return mu_; }
+
+      /**
+       * Draw from the approximation.
+       *
+       * @tparam BaseRNG class of random number generator
+       * @param[in,out] rng random number generator
+       * @param[out] eta draw
+       * @return log density of the approximation at the draw
+       */
+      template <class BaseRNG>
+      double sample(BaseRNG& rng, Eigen::VectorXd& eta) const {
+        boost::variate_generator<BaseRNG&, boost::normal_distribution<> >
+          rand_unit_gaus(rng, boost::normal_distribution<>());
+        int d = dimension();
+        Eigen::VectorXd u(d);
+        for (int i = 0; i < d; ++i)
+          u(i) = rand_unit_gaus();
+
+        if (dense_) {
+          eta = mu_ + L_ * u;
+        } else {
+          Eigen::VectorXd Qu = Q_.transpose() * u;
+          eta = mu_ + alpha_.array().sqrt().matrix()
+            .cwiseProduct(Q_ * (L_ * Qu) + u - Q_ * Qu);
+        }
+        return -0.5 * (log_det_ + u.squaredNorm()
+                       + d * std::log(2 * stan::math::pi()));
+      }
+
+      /**
+       * Update the diagonal of the initial inverse Hessian with a new
+       * pair of position and gradient differences, as in Pathfinder.
+       * The pair must satisfy the curvature condition
+       * <code>y' * s > 0</code>.
+       *
+       * @param[in,out] alpha diagonal to update
+       * @param[in] s position difference
+       * @param[in] y gradient difference
+       */
+      static void update_diagonal(Eigen::VectorXd& alpha,
+                                  const Eigen::VectorXd& s,
+                                  const Eigen::VectorXd& y) {
+        double y_alpha_y = y.dot(alpha.cwiseProduct(y));
+        double y_s = y.dot(s);
+        double s_inv_alpha_s = s.dot(s.cwiseQuotient(alpha));
+        alpha = (y_alpha_y / y_s * alpha.array().inverse()
+                 + y.array().square() / y_s
+                 - y_alpha_y / (y_s * s_inv_alpha_s)
+                 * (s.array() / alpha.array()).square())
+          .inverse().matrix();
+      }
+
+    private:
+      Eigen::VectorXd mu_;
+      Eigen::VectorXd alpha_;
+      Eigen::MatrixXd Q_;
+      Eigen::MatrixXd L_;
+      double log_det_;
+      bool dense_;
+    };
+
+    /**
+     * Draws produced by a Pathfinder run, on the unconstrained scale.
+     */
+    struct pathfinder_draws {
+      /**
+       * Draws, one per column.
+       */
+      Eigen::MatrixXd draws;
+
+      /**
+       * Log density of the model (with Jacobian) at each draw.
+       */
+      Eigen::VectorXd log_p;
+
+      /**
+       * Log density of the approximation at each draw.
+       */
+      Eigen::VectorXd log_q;
+
+      /**
+       * ELBO estimate of the approximation the draws come from.
+       */
+      double elbo;
+    };
+
+    /**
+     * Runs a single Pathfinder path.  L-BFGS maximizes the log density
+     * (with Jacobian) from the initial point; at every iterate a normal
+     * approximation is built from the L-BFGS history and its ELBO is
+     * estimated by Monte Carlo.  The draws are taken from the
+     * approximation with the largest ELBO.
+     *
+     * Messages are written to <code>msgs</code> only, so independent
+     * paths can run on separate threads when autodiff is thread safe.
+     *
+     * @tparam Model class of model
+     * @tparam BaseRNG class of random number generator
+     * @param[in] model model
+     * @param[in] init initial unconstrained parameters
+     * @param[in,out] rng random number generator
+     * @param[in] history_size number of L-BFGS update pairs to keep
+     * @param[in] max_iterations maximum number of L-BFGS iterations
+     * @param[in] num_elbo_draws number of draws for each ELBO estimate
+     * @param[in] num_draws number of draws to return
+     * @param[out] result draws from the best approximation
+     * @param[in,out] msgs stream for messages
+     * @return true if an approximation with finite ELBO was found
+     */
+    template <class Model, class BaseRNG>
+    bool pathfinder_path(Model& model, const std::vector<double>& init,
+                         BaseRNG& rng, int history_size, int max_iterations,
+                         int num_elbo_draws, int num_draws,
+                         pathfinder_draws& result, std::ostream* msgs) {
+      typedef stan::optimization::BFGSLineSearch
+        <Model, stan::optimization::LBFGSUpdate<>, double,
+         Eigen::Dynamic, true> Optimizer;
+
+      std::vector<int> disc_vector;
+      Optimizer lbfgs(model, init, disc_vector, msgs);
+      lbfgs.get_qnupdate().set_history_size(history_size);
+      lbfgs._conv_opts.maxIts = max_iterations;
+
+      int d = init.size();
+      Eigen::VectorXd alpha = Eigen::VectorXd::Ones(d);
+      std::deque<Eigen::VectorXd> S_history;
+      std::deque<Eigen::VectorXd> Y_history;
+      Eigen::VectorXd x_prev = lbfgs.curr_x();
+      Eigen::VectorXd g_prev = lbfgs.curr_g();
+
+      double elbo_best = -std::numeric_limits<double>::infinity();
+      std::vector<lbfgs_normal> best;
+      Eigen::VectorXd eta(d);
+
+      int ret = 0;
+      while (ret == 0) {
+        ret = lbfgs.step();
+        if (ret < 0)
+          break;
+        Eigen::VectorXd s = lbfgs.curr_x() - x_prev;
+        Eigen::VectorXd y = lbfgs.curr_g() - g_prev;
+        x_prev = lbfgs.curr_x();
+        g_prev = lbfgs.curr_g();
+        if (!(y.dot(s) > 1e-12 * y.squaredNorm()))
+          continue;
+        lbfgs_normal::update_diagonal(alpha, s, y);
+        S_history.push_back(s);
+        Y_history.push_back(y);
+        if (static_cast<int>(S_history.size()) > history_size) {
+          S_history.pop_front();
+          Y_history.pop_front();
+        }
+
+        Eigen::MatrixXd S(d, S_history.size());
+        Eigen::MatrixXd Y(d, Y_history.size());
+        for (size_t j = 0; j < S_history.size(); ++j) {
+          S.col(j) = S_history[j];
+          Y.col(j) = Y_history[j];
+        }
+        try {
+          lbfgs_normal approx(x_prev, g_prev, alpha, S, Y);
+          double elbo = 0;
+          for (int n = 0; n < num_elbo_draws; ++n) {
+            double log_q = approx.sample(rng, eta);
+            double log_p = -std::numeric_limits<double>::infinity();
+            try {
+              log_p = stan::model::log_prob_value<false, true>(model, eta,
+                                                               msgs);
+            } catch (const std::exception&) { }
+            elbo += (log_p - log_q) / num_elbo_draws;
+          }
+          if (elbo > elbo_best) {
+            elbo_best = elbo;
+            best.assign(1, approx);
+          }
+        } catch (const std::domain_error&) {
+          continue;
+        }
+      }
+
+      if (best.empty())
+        return false;
+
+      result.elbo = elbo_best;
+      result.draws.resize(d, num_draws);
+      result.log_p.resize(num_draws);
+      result.log_q.resize(num_draws);
+      for (int n = 0; n < num_draws; ++n) {
+        result.log_q(n) = best[0].sample(rng, eta);
+        result.draws.col(n) = eta;
+        result.log_p(n) = -std::numeric_limits<double>::infinity();
+        try {
+          result.log_p(n)
+            = stan::model::log_prob_value<false, true>(model, eta, msgs);
+        } catch (const std::exception&) { }
+      }
+      return true;
+    }
+
+    /**
+     * Resamples the pooled draws of several Pathfinder paths by
+     * importance resampling with replacement.  Importance ratios
+     * <code>exp(log_p - log_q)</code> are truncated at their mean times
+     * the square root of the number of draws, which keeps a single
+     * heavy draw from dominating (truncated importance sampling,
+     * Ionides 2008).
+     *
+     * @tparam BaseRNG class of random number generator
+     * @param[in] paths draws of the successful paths
+     * @param[in] num_draws number of draws to return
+     * @param[in,out] rng random number generator
+     * @param[out] draws resampled draws, one per column
+     * @throw std::domain_error if no draw has a finite importance ratio
+     */
+    template <class BaseRNG>
+    void pathfinder_resample(const std::vector<pathfinder_draws>& paths,
+                             int num_draws, BaseRNG& rng,
+                             Eigen::MatrixXd& draws) {
+      int total = 0;
+      for (size_t p = 0; p < paths.size(); ++p)
+        total += paths[p].draws.cols();
+
+      Eigen::VectorXd log_w(total);
+      for (size_t p = 0, k = 0; p < paths.size(); ++p)
+        for (int n = 0; n < paths[p].draws.cols(); ++n, ++k)
+          log_w(k) = paths[p].log_p(n) - paths[p].log_q(n);
+
+      double max_log_w = -std::numeric_limits<double>::infinity();
+      for (int k = 0; k < total; ++k)
+        if (log_w(k) == log_w(k))
+          max_log_w = std::max(max_log_w, log_w(k));
+      if (!(max_log_w > -std::numeric_limits<double>::infinity()))
+        throw std::domain_error("pathfinder_resample: no draw has a"
+                                " finite log density");
+
+      Eigen::VectorXd w(total);
+      for (int k = 0; k < total; ++k)
+        w(k) = log_w(k) == log_w(k) ? std::exp(log_w(k) - max_log_w) : 0;
+      w = w.cwiseMin(w.mean() * std::sqrt(static_cast<double>(total)));
+
+      std::vector<double> cumulative(total);
+      std::partial_sum(w.data(), w.data() + total, cumulative.begin());
+
+      boost::variate_generator<BaseRNG&, boost::uniform_01<> >
+        rand_uniform_01(rng, boost::uniform_01<>());
+      draws.resize(paths[0].draws.rows(), num_draws);
+      for (int n = 0; n < num_draws; ++n) {
+        double u = rand_uniform_01() * cumulative.back();
+        int k = std::min(static_cast<int>(std::upper_bound(cumulative.begin(),
+                                                           cumulative.end(),
+                                                           u)
+                                          - cumulative.begin()),
+                         total - 1);
+        int p = 0;
+        while (k >= paths[p].draws.cols()) {
+          k -= paths[p].draws.cols();
+          ++p;
+        }
+        draws.col(n) = paths[p].draws.col(k);
+      }
+    }
+
+  }  // variational
+}  // stan
+#endif
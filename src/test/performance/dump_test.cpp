@@ -0,0 +1,81 @@
+/**
+ * Performance test: reading R dump data.
+ *
+ * This test reads a dump text with a large real vector, a large
+ * integer vector and a large real matrix with
+ * <code>stan::io::dump</code> and checks the values read.  It reports
+ * the time taken, in seconds, on standard output.
+ */
+
+#include <gtest/gtest.h>
+#include <stan/io/dump.hpp>
+#include <boost/random/additive_combine.hpp>  // L'Ecuyer RNG
+#include <boost/random/normal_distribution.hpp>
+#include <boost/random/uniform_int_distribution.hpp>
+#include <ctime>
+#include <iomanip>
+#include <iostream>
+#include <sstream>
+#include <string>
+#include <vector>
+
+class performance_dump : public ::testing::Test {
+public:
+  static void SetUpTestCase() {
+    N = 1000000;
+    boost::ecuyer1988 rng(1234);
+    boost::random::normal_distribution<double> normal;
+    boost::random::uniform_int_distribution<int> uniform(-100000, 100000);
+
+    std::stringstream dump;
+    dump << std::setprecision(17) << "y <-\nc(";
+    for (int n = 0; n < N; ++n) {
+      y.push_back(normal(rng));
+      dump << (n > 0 ? ", " : "") << y.back();
+    }
+    dump << ")\nk <-\nc(";
+    for (int n = 0; n < N; ++n) {
+      k.push_back(uniform(rng));
+      dump << (n > 0 ? ", " : "") << k.back();
+    }
+    dump << ")\nX <-\nstructure(c(";
+    for (int n = 0; n < N; ++n) {
+      X.push_back(normal(rng));
+      dump << (n > 0 ? ", " : "") << X.back();
+    }
+    dump << "), .Dim = c(" << N / 10 << ", 10))\n";
+    text = dump.str();
+  }
+
+  static int N;
+  static std::string text;
+  static std::vector<double> y;
+  static std::vector<int> k;
+  static std::vector<double> X;
+};
+
+int performance_dump::N;
+std::string performance_dump::text;
+std::vector<double> performance_dump::y;
+std::vector<int> performance_dump::k;
+std::vector<double> performance_dump::X;
+
+TEST_F(performance_dump, read) {
+  std::stringstream in(text);
+  clock_t t = clock();
+  stan::io::dump data(in);
+  t = clock() - t;
+
+  std::cout << "dump text of " << text.size() << " bytes" << std::endl
+            << "  dump: " << static_cast<double>(t) / CLOCKS_PER_SEC
+            << " seconds" << std::endl;
+
+  ASSERT_TRUE(data.contains_r("y"));
+  ASSERT_TRUE(data.contains_i("k"));
+  ASSERT_TRUE(data.contains_r("X"));
+  EXPECT_TRUE(y == data.vals_r("y"));
+  EXPECT_TRUE(k == data.vals_i("k"));
+  EXPECT_TRUE(X == data.vals_r("X"));
+  ASSERT_EQ(2U, data.dims_r("X").size());
+  EXPECT_EQ(static_cast<size_t>(N / 10), data.dims_r("X")[0]);
+}
@@ -0,0 +1,89 @@
+/**
+ * Performance test: reading JSON data.
+ *
+ * This test reads a JSON text with a large real array, a large
+ * integer array and a large two-dimensional real array, first with
+ * the streaming <code>json_parser</code> and then with
+ * <code>json_data</code>, which reads the stream into a buffer and
+ * parses it with the <code>buffer_parser</code>.  It checks that both
+ * produce the same values and reports the time each took, in
+ * seconds, on standard output.
+ */
+
+#include <gtest/gtest.h>
+#include <stan/io/json/json_data.hpp>
+#include <stan/io/json/json_data_handler.hpp>
+#include <stan/io/json/json_parser.hpp>
+#include <boost/random/additive_combine.hpp>  // L'Ecuyer RNG
+#include <boost/random/normal_distribution.hpp>
+#include <boost/random/uniform_int_distribution.hpp>
+#include <ctime>
+#include <iomanip>
+#include <iostream>
+#include <sstream>
+#include <string>
+#include <vector>
+
+class performance_json : public ::testing::Test {
+public:
+  static void SetUpTestCase() {
+    N = 1000000;
+    boost::ecuyer1988 rng(1234);
+    boost::random::normal_distribution<double> normal;
+    boost::random::uniform_int_distribution<int> uniform(-100000, 100000);
+
+    std::stringstream json;
+    json << std::setprecision(17) << "{\n  \"y\" : [";
+    for (int n = 0; n < N; ++n)
+      json << (n > 0 ? ", " : "") << normal(rng);
+    json << "],\n  \"k\" : [";
+    for (int n = 0; n < N; ++n)
+      json << (n > 0 ? ", " : "") << uniform(rng);
+    json << "],\n  \"X\" : [";
+    for (int n = 0; n < N / 10; ++n) {
+      json << (n > 0 ? ", [" : "[");
+      for (int m = 0; m < 10; ++m)
+        json << (m > 0 ? ", " : "") << normal(rng);
+      json << "]";
+    }
+    json << "]\n}\n";
+    text = json.str();
+  }
+
+  static int N;
+  static std::string text;
+};
+
+int performance_json::N;
+std::string performance_json::text;
+
+TEST_F(performance_json, stream_parser_vs_json_data) {
+  clock_t t;
+
+  stan::json::vars_map_r vars_r;
+  stan::json::vars_map_i vars_i;
+  std::stringstream in_stream(text);
+  t = clock();
+  stan::json::json_data_handler handler(vars_r, vars_i);
+  stan::json::parse(in_stream, handler);
+  t = clock() - t;
+  double stream_seconds = static_cast<double>(t) / CLOCKS_PER_SEC;
+
+  std::stringstream in_buffer(text);
+  t = clock();
+  stan::json::json_data data(in_buffer);
+  t = clock() - t;
+  double buffer_seconds = static_cast<double>(t) / CLOCKS_PER_SEC;
+
+  std::cout << "JSON text of " << text.size() << " bytes" << std::endl
+            << "  json_parser: " << stream_seconds << " seconds" << std::endl
+            << "  json_data:   " << buffer_seconds << " seconds" << std::endl;
+
+  ASSERT_TRUE(data.contains_r("y"));
+  ASSERT_TRUE(data.contains_i("k"));
+  ASSERT_TRUE(data.contains_r("X"));
+  EXPECT_TRUE(vars_r["y"].first == data.vals_r("y"));
+  EXPECT_TRUE(vars_i["k"].first == data.vals_i("k"));
+  EXPECT_TRUE(vars_r["X"].first == data.vals_r("X"));
+  EXPECT_TRUE(vars_r["X"].second == data.dims_r("X"));
+}
@@ -149,3 +149,29 @@ TEST(array_var_context, invalid_input2) {
   FAIL();
 }
 
+
+TEST(array_var_context, views) {
+  std::vector<double> v;
+  v.push_back(1.5);
+  v.push_back(2.5);
+  std::vector<int> v_i;
+  v_i.push_back(3);
+  v_i.push_back(4);
+  std::vector<std::vector<size_t> > dims(1, std::vector<size_t>(1, 2));
+  std::vector<std::string> names_r(1, "alpha");
+  std::vector<std::string> names_i(1, "beta");
+  stan::io::array_var_context avc(names_r, v, dims, names_i, v_i, dims);
+
+  stan::io::array_view<double> alpha = avc.vals_r_view("alpha");
+  ASSERT_EQ(2U, alpha.size());
+  EXPECT_FLOAT_EQ(1.5, alpha[0]);
+  EXPECT_FLOAT_EQ(2.5, alpha[1]);
+  stan::io::array_view<int> beta = avc.vals_i_view("beta");
+  ASSERT_EQ(2U, beta.size());
+  EXPECT_EQ(4, beta[1]);
+  stan::io::array_view<double> beta_r = avc.vals_r_view("beta");
+  ASSERT_EQ(2U, beta_r.size());
+  EXPECT_FLOAT_EQ(4.0, beta_r[1]);
+  EXPECT_TRUE(avc.vals_i_view("alpha").empty());
+  EXPECT_TRUE(avc.vals_r_view("gamma").empty());
+}
@@ -0,0 +1,53 @@
+#include <stan/io/array_view.hpp>
+#include <gtest/gtest.h>
+#include <vector>
+
+TEST(io_array_view, empty) {
+  stan::io::array_view<double> view;
+  EXPECT_TRUE(view.empty());
+  EXPECT_EQ(0U, view.size());
+  EXPECT_EQ(0U, view.to_vector().size());
+}
+
+TEST(io_array_view, of) {
+  std::vector<double> x;
+  x.push_back(1.5);
+  x.push_back(-2.5);
+  stan::io::array_view<double> view = stan::io::array_view<double>::of(x);
+  ASSERT_EQ(2U, view.size());
+  EXPECT_FLOAT_EQ(1.5, view[0]);
+  EXPECT_FLOAT_EQ(-2.5, view[1]);
+
+  // views point into the viewed storage
+  x[1] = 3.0;
+  EXPECT_FLOAT_EQ(3.0, view[1]);
+}
+
+TEST(io_array_view, converting) {
+  std::vector<int> n;
+  n.push_back(3);
+  n.push_back(-7);
+  stan::io::array_view<double> view
+    = stan::io::array_view<double>::converting(n);
+  ASSERT_EQ(2U, view.size());
+  EXPECT_FLOAT_EQ(3.0, view[0]);
+  EXPECT_FLOAT_EQ(-7.0, view[1]);
+  std::vector<double> x = view.to_vector();
+  ASSERT_EQ(2U, x.size());
+  EXPECT_FLOAT_EQ(-7.0, x[1]);
+}
+
+TEST(io_array_view, owning) {
+  stan::io::array_view<int> copy;
+  {
+    std::vector<int> n;
+    n.push_back(4);
+    n.push_back(5);
+    stan::io::array_view<int> view = stan::io::array_view<int>::owning(n);
+    EXPECT_EQ(0U, n.size());
+    copy = view;
+  }
+  ASSERT_EQ(2U, copy.size());
+  EXPECT_EQ(4, copy[0]);
+  EXPECT_EQ(5, copy[1]);
+}
@@ -0,0 +1,142 @@
+#include <stan/io/binary_var_context.hpp>
+#include <stan/io/write_binary_var_context.hpp>
+#include <stan/io/dump.hpp>
+#include <stan/io/json/json_data.hpp>
+#include <gtest/gtest.h>
+#include <cstdio>
+#include <fstream>
+#include <limits>
+#include <sstream>
+#include <stdexcept>
+#include <string>
+#include <vector>
+
+std::string to_binary(const stan::io::var_context& context) {
+  std::stringstream out;
+  stan::io::write_binary_var_context(context, out);
+  return out.str();
+}
+
+void expect_same_context(const stan::io::var_context& expected,
+                         const stan::io::var_context& found) {
+  std::vector<std::string> names_expected;
+  std::vector<std::string> names_found;
+  expected.names_i(names_expected);
+  found.names_i(names_found);
+  EXPECT_EQ(names_expected, names_found);
+  for (size_t n = 0; n < names_expected.size(); ++n) {
+    const std::string& name = names_expected[n];
+    EXPECT_TRUE(found.contains_i(name));
+    EXPECT_EQ(expected.dims_i(name), found.dims_i(name));
+    EXPECT_EQ(expected.vals_i(name), found.vals_i(name));
+    EXPECT_EQ(expected.vals_r(name), found.vals_r(name));
+    EXPECT_EQ(expected.vals_i(name), found.vals_i_view(name).to_vector());
+  }
+
+  expected.names_r(names_expected);
+  found.names_r(names_found);
+  EXPECT_EQ(names_expected, names_found);
+  for (size_t n = 0; n < names_expected.size(); ++n) {
+    const std::string& name = names_expected[n];
+    EXPECT_TRUE(found.contains_r(name));
+    EXPECT_FALSE(found.contains_i(name));
+    EXPECT_EQ(expected.dims_r(name), found.dims_r(name));
+    std::vector<double> vals_expected = expected.vals_r(name);
+    std::vector<double> vals_found = found.vals_r(name);
+    ASSERT_EQ(vals_expected.size(), vals_found.size());
+    for (size_t i = 0; i < vals_expected.size(); ++i) {
+      if (vals_expected[i] != vals_expected[i])
+        EXPECT_NE(vals_found[i], vals_found[i]);
+      else
+        EXPECT_EQ(vals_expected[i], vals_found[i]);
+    }
+  }
+}
+
+TEST(binary_var_context, dump_round_trip) {
+  std::string text = "a <- 3\n"
+    "b <- c(1.5, -2, Inf, NaN)\n"
+    "c <- structure(1:6, .Dim = c(2L, 3L))\n"
+    "d <- integer(0)\n"
+    "e <- structure(c(0.1, 0.2, 0.3, 0.4), .Dim = c(2, 2))\n"
+    "f <- c(-2147483647, 2147483647, -7)\n";
+  std::stringstream in(text);
+  stan::io::dump dump(in);
+  std::string binary = to_binary(dump);
+  EXPECT_EQ(0U, binary.size() % 8);
+
+  stan::io::binary_var_context context(binary.data(),
+                                       binary.data() + binary.size());
+  expect_same_context(dump, context);
+
+  EXPECT_FALSE(context.contains_r("g"));
+  EXPECT_FALSE(context.contains_i("g"));
+  EXPECT_TRUE(context.vals_r("g").empty());
+  EXPECT_TRUE(context.dims_r("g").empty());
+  EXPECT_TRUE(context.vals_i_view("b").empty());
+  EXPECT_TRUE(context.dims_i("b").empty());
+
+  stan::io::array_view<double> b = context.vals_r_view("b");
+  ASSERT_EQ(4U, b.size());
+  EXPECT_EQ(-2.0, b[1]);
+  EXPECT_EQ(std::numeric_limits<double>::infinity(), b[2]);
+  stan::io::array_view<double> c = context.vals_r_view("c");
+  ASSERT_EQ(6U, c.size());
+  EXPECT_EQ(6.0, c[5]);
+}
+
+TEST(binary_var_context, json_round_trip) {
+  std::string text = "{ \"N\" : 2, \"y\" : [[1, 2.5], [3, 4]],"
+    " \"k\" : [[1, 2, 3], [4, 5, 6]], \"z\" : -0.5 }";
+  stan::json::json_data json(text.data(), text.data() + text.size());
+  std::string binary = to_binary(json);
+  stan::io::binary_var_context context(binary.data(),
+                                       binary.data() + binary.size());
+  expect_same_context(json, context);
+}
+
+TEST(binary_var_context, file) {
+  std::string text = "x <- c(1, 2, 3)\n"
+    "y <- structure(c(0.5, 1.5), .Dim = c(2))\n";
+  std::stringstream in(text);
+  stan::io::dump dump(in);
+  std::string path = "binary_var_context_test.bin";
+  {
+    std::ofstream out(path.c_str(), std::ios::out | std::ios::binary);
+    stan::io::write_binary_var_context(dump, out);
+  }
+  {
+    stan::io::binary_var_context context(path);
+    expect_same_context(dump, context);
+  }
+  std::remove(path.c_str());
+
+  EXPECT_THROW(stan::io::binary_var_context("no_such_file.bin"),
+               std::invalid_argument);
+}
+
+TEST(binary_var_context, invalid) {
+  std::stringstream in("x <- c(1, 2, 3)\n");
+  stan::io::dump dump(in);
+  std::string binary = to_binary(dump);
+
+  std::string bad = binary;
+  bad[0] = 'X';
+  EXPECT_THROW(stan::io::binary_var_context(bad.data(),
+                                            bad.data() + bad.size()),
+               std::invalid_argument);
+
+  bad = binary;
+  bad[8] = 2;
+  EXPECT_THROW(stan::io::binary_var_context(bad.data(),
+                                            bad.data() + bad.size()),
+               std::invalid_argument);
+
+  for (size_t n = 0; n + 4 < binary.size(); n += 4)
+    EXPECT_THROW(stan::io::binary_var_context(binary.data(),
+                                              binary.data() + n),
+                 std::invalid_argument) << n;
+  EXPECT_NO_THROW(stan::io::binary_var_context(binary.data(),
+                                               binary.data()
+                                               + binary.size()));
+}
@@ -51,3 +51,30 @@ TEST(chained_var_context, ctor) {
   std::vector<double> alpha(1, 0);
   EXPECT_EQ(alpha, vcc.vals_r("alpha"));
 }
+
+TEST(chained_var_context, views) {
+  std::vector<double> v;
+  v.push_back(1.5);
+  v.push_back(2.5);
+  std::vector<std::vector<size_t> > dims(1, std::vector<size_t>(1, 2));
+  std::vector<std::string> names(1, "alpha");
+  stan::io::array_var_context avc(names, v, dims);
+
+  std::vector<int> v2;
+  v2.push_back(3);
+  std::vector<std::vector<size_t> > dims2(1, std::vector<size_t>());
+  std::vector<std::string> names2(1, "beta");
+  stan::io::array_var_context avc2(names2, v2, dims2);
+
+  stan::io::chained_var_context cvc(avc, avc2);
+  stan::io::array_view<double> alpha = cvc.vals_r_view("alpha");
+  ASSERT_EQ(2U, alpha.size());
+  EXPECT_FLOAT_EQ(2.5, alpha[1]);
+  stan::io::array_view<int> beta = cvc.vals_i_view("beta");
+  ASSERT_EQ(1U, beta.size());
+  EXPECT_EQ(3, beta[0]);
+  stan::io::array_view<double> beta_r = cvc.vals_r_view("beta");
+  ASSERT_EQ(1U, beta_r.size());
+  EXPECT_FLOAT_EQ(3.0, beta_r[0]);
+  EXPECT_TRUE(cvc.vals_r_view("gamma").empty());
+}
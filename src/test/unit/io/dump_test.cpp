@@ -699,3 +699,56 @@ TEST(io_dump, too_large_zero_array) {
   test_exception("a <- structure(integer(999918446744073709551616L), .Dim = c(2,3))");
   test_exception("a <- structure(double(999918446744073709551616L), .Dim = c(2,3))");
 }
+
+TEST(io_dump, reader_ints_then_inf) {
+  std::vector<double> vs;
+  vs.push_back(1);
+  vs.push_back(std::numeric_limits<double>::infinity());
+  vs.push_back(2);
+  vs.push_back(std::numeric_limits<double>::quiet_NaN());
+  vs.push_back(3.5);
+  test_list("a",vs,"a <- c(1, Inf, 2, NaN, 3.5)");
+}
+
+TEST(io_dump, reader_buffer) {
+  std::string txt = "a <- c(1, 2.5)\nb <- structure(1:6, .Dim = c(2, 3))";
+  stan::io::dump_reader reader(txt.data(), txt.data() + txt.size());
+  std::vector<double> a_vals;
+  a_vals.push_back(1);
+  a_vals.push_back(2.5);
+  std::vector<size_t> a_dims;
+  a_dims.push_back(2U);
+  test_list2(reader,"a",a_vals,a_dims);
+  std::vector<int> b_vals;
+  for (int i = 1; i <= 6; ++i)
+    b_vals.push_back(i);
+  std::vector<size_t> b_dims;
+  b_dims.push_back(2U);
+  b_dims.push_back(3U);
+  test_list2(reader,"b",b_vals,b_dims);
+  EXPECT_FALSE(reader.next());
+
+  stan::io::dump dump(txt.data(), txt.data() + txt.size());
+  EXPECT_TRUE(dump.contains_r("a"));
+  EXPECT_TRUE(dump.contains_i("b"));
+  EXPECT_FLOAT_EQ(2.5, dump.vals_r("a")[1]);
+  EXPECT_EQ(6, dump.vals_i("b")[5]);
+  EXPECT_FLOAT_EQ(6.0, dump.vals_r("b")[5]);
+}
+
+TEST(io_dump, views) {
+  std::string txt = "a <- c(1, 2.5)\nb <- structure(1:6, .Dim = c(2, 3))";
+  std::stringstream in(txt);
+  stan::io::dump dump(in);
+  stan::io::array_view<double> a = dump.vals_r_view("a");
+  ASSERT_EQ(2U, a.size());
+  EXPECT_FLOAT_EQ(2.5, a[1]);
+  stan::io::array_view<int> b = dump.vals_i_view("b");
+  ASSERT_EQ(6U, b.size());
+  EXPECT_EQ(6, b[5]);
+  stan::io::array_view<double> b_r = dump.vals_r_view("b");
+  ASSERT_EQ(6U, b_r.size());
+  EXPECT_FLOAT_EQ(6.0, b_r[5]);
+  EXPECT_TRUE(dump.vals_i_view("a").empty());
+  EXPECT_TRUE(dump.vals_r_view("c").empty());
+}
@@ -0,0 +1,135 @@
+#include <gtest/gtest.h>
+
+#include <stan/io/json/json_buffer_parser.hpp>
+#include <stan/io/json/json_data.hpp>
+#include <stan/io/json/json_handler.hpp>
+#include <stan/io/json/json_parser.hpp>
+#include <iomanip>
+#include <sstream>
+#include <string>
+#include <vector>
+
+class recording_handler : public stan::json::json_handler {
+public:
+  std::stringstream os_;
+  size_t hint_;
+  recording_handler() : json_handler(), os_(), hint_(0) {
+    os_ << std::setprecision(17);
+  }
+  void start_text() {
+    os_ << "S:text";
+  }
+  void end_text() {
+    os_ << "E:text";
+  }
+  void start_array() {
+    os_ << "S:arr";
+  }
+  void end_array() {
+    os_ << "E:arr";
+  }
+  void array_size_hint(size_t n) {
+    hint_ = n;
+  }
+  void start_object() {
+    os_ << "S:obj";
+  }
+  void end_object() {
+    os_ << "E:obj";
+  }
+  void null() {
+    os_ << "NULL:null";
+  }
+  void boolean(bool p) {
+    os_ << "BOOL:" << p;
+  }
+  void string(const std::string& s) {
+    os_ << "STR:\"" << s << "\"";
+  }
+  void key(const std::string& key) {
+    os_ << "KEY:\"" << key << "\"";
+  }
+  void number_double(double x) {
+    os_ << "D(REAL):" << x;
+  }
+  void number_long(long n) {
+    os_ << "L(INT):" << n;
+  }
+  void number_unsigned_long(unsigned long n) {
+    os_ << "UL(INT):" << n;
+  }
+};
+
+std::string stream_events(const std::string& input) {
+  recording_handler handler;
+  std::stringstream s(input);
+  try {
+    stan::json::parse(s, handler);
+  } catch (const std::exception& e) {
+    std::string msg(e.what());
+    handler.os_ << "ERROR:" << msg.substr(msg.find('\n') + 1);
+  }
+  return handler.os_.str();
+}
+
+std::string buffer_events(const std::string& input) {
+  recording_handler handler;
+  try {
+    stan::json::parse(input.data(), input.data() + input.size(), handler);
+  } catch (const std::exception& e) {
+    std::string msg(e.what());
+    handler.os_ << "ERROR:" << msg.substr(msg.find('\n') + 1);
+  }
+  return handler.os_.str();
+}
+
+void test_same_events(const std::string& input) {
+  EXPECT_EQ(stream_events(input), buffer_events(input)) << input;
+}
+
+TEST(ioJson, bufferParserMatchesStreamParser) {
+  const char* inputs[] = {
+    "[0]", "[ 1, -1, 2, -2 ]", "{}", "{ \"foo\" : [] }",
+    "{ \"a\" : true, \"b\" : false, \"c\" : null }",
+    "{ \"s\" : \"a\\\"b\\\\c\\/d\\be\\ff\\ng\\rh\\ti\" }",
+    "{ \"u\" : \"\\u00e9\\u20ac\\ud834\\udd1e\" }",
+    "{ \"foo\" : [[1.5, 2], [3, 4.25e2]], \"bar\" : { \"baz\" : -0.5 } }",
+    "[ 0.1, 0.30000000000000004, 1e22, 1e23, 123456789012345678901234,"
+    " 2.2250738585072014e-308, 4.9e-324, 1.7976931348623157e308,"
+    " -0.0, 0e500, 9007199254740993.0, 3.14159265358979323846 ]",
+    "[ 18446744073709551615, -9223372036854775808, 9007199254740993 ]",
+    "[ 18446744073709551616 ]", "[ 1e400 ]", "[ 1e-400 ]",
+    "[ 00 ]", "[ 1. ]", "[ 1e ]", "[ - ]", "[ 1, ]", "[ 1 2 ]",
+    "{ \"a\" 1 }", "{ \"a\" : 1 ", "[ \"abc ]", "[ \"\\x\" ]",
+    "[ \"\\uZZZZ\" ]", "[ \"\\udd1e\" ]", "[ \"\\ud834x\" ]",
+    "[ tru ]", "[ nul ]", "1", ""
+  };
+  for (size_t i = 0; i < sizeof(inputs) / sizeof(inputs[0]); ++i)
+    test_same_events(inputs[i]);
+}
+
+TEST(ioJson, bufferParserArraySizeHint) {
+  recording_handler handler;
+  std::string input = "{ \"foo\" : [[1, 2, 3], [4, 5, 6]], \"bar\" : 1 }";
+  stan::json::parse(input.data(), input.data() + input.size(), handler);
+  EXPECT_LE(6U, handler.hint_);
+  EXPECT_GE(7U, handler.hint_);
+
+  input = "{ \"foo\" : [\"inf\", \"a,]b\", 2] }";
+  stan::json::parse(input.data(), input.data() + input.size(), handler);
+  EXPECT_EQ(3U, handler.hint_);
+}
+
+TEST(ioJson, jsonDataFromBuffer) {
+  std::string input = "{ \"foo\" : [[1, 2, 3], [4, 5.5, 6]], \"bar\" : 7 }";
+  stan::json::json_data jdata(input.data(), input.data() + input.size());
+  EXPECT_TRUE(jdata.contains_r("foo"));
+  EXPECT_FALSE(jdata.contains_i("foo"));
+  std::vector<double> foo = jdata.vals_r("foo");
+  double expected[] = { 1, 4, 2, 5.5, 3, 6 };
+  ASSERT_EQ(6U, foo.size());
+  for (size_t i = 0; i < foo.size(); ++i)
+    EXPECT_FLOAT_EQ(expected[i], foo[i]);
+  EXPECT_TRUE(jdata.contains_i("bar"));
+  EXPECT_EQ(7, jdata.vals_i("bar")[0]);
+}
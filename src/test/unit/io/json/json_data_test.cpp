@@ -401,3 +401,22 @@ TEST(ioJson,jsonData_parse_mult_objects) {
   EXPECT_EQ("foo",var_names[0]);
 }
 
+
+TEST(ioJson,jsonData_views) {
+  std::string txt = "{ \"foo\" : [[1, 2.5], [3, 4]], \"bar\" : [5, 6] }";
+  std::stringstream in(txt);
+  stan::json::json_data jdata(in);
+  stan::io::array_view<double> foo = jdata.vals_r_view("foo");
+  std::vector<double> foo_vals = jdata.vals_r("foo");
+  ASSERT_EQ(foo_vals.size(), foo.size());
+  for (size_t i = 0; i < foo.size(); ++i)
+    EXPECT_FLOAT_EQ(foo_vals[i], foo[i]);
+  stan::io::array_view<int> bar = jdata.vals_i_view("bar");
+  ASSERT_EQ(2U, bar.size());
+  EXPECT_EQ(6, bar[1]);
+  stan::io::array_view<double> bar_r = jdata.vals_r_view("bar");
+  ASSERT_EQ(2U, bar_r.size());
+  EXPECT_FLOAT_EQ(5.0, bar_r[0]);
+  EXPECT_TRUE(jdata.vals_i_view("foo").empty());
+  EXPECT_TRUE(jdata.vals_r_view("baz").empty());
+}
@@ -0,0 +1,134 @@
+#include <stan/io/stan_csv_stream_reader.hpp>
+#include <stan/io/stan_csv_column_summaries.hpp>
+#include <stan/io/stan_csv_reader.hpp>
+#include <gtest/gtest.h>
+#include <fstream>
+#include <sstream>
+#include <stdexcept>
+#include <string>
+#include <vector>
+
+class StanIoStanCsvStreamReader : public testing::Test {
+public:
+  void SetUp() {
+    std::ifstream blocker0_stream;
+    blocker0_stream.open("src/test/unit/io/test_csv_files/blocker.0.csv");
+    std::stringstream ss;
+    ss << blocker0_stream.rdbuf();
+    blocker0 = ss.str();
+    std::stringstream in(blocker0);
+    expected = stan::io::stan_csv_reader::parse(in, 0);
+  }
+
+  std::string blocker0;
+  stan::io::stan_csv expected;
+};
+
+TEST_F(StanIoStanCsvStreamReader, all_columns) {
+  std::stringstream in(blocker0);
+  stan::io::stan_csv_stream_reader reader(in, 0);
+  EXPECT_EQ(expected.metadata.model, reader.metadata().model);
+  EXPECT_EQ(expected.metadata.seed, reader.metadata().seed);
+  ASSERT_EQ(expected.header.size(), reader.header().size());
+  for (int col = 0; col < expected.header.size(); ++col)
+    EXPECT_EQ(expected.header(col), reader.header()(col));
+  EXPECT_FLOAT_EQ(expected.adaptation.step_size,
+                  reader.adaptation().step_size);
+  EXPECT_EQ(expected.header.size(), reader.selected_columns().size());
+
+  std::vector<double> values;
+  int row = 0;
+  for (; reader.next_row(values); ++row) {
+    ASSERT_LT(row, expected.samples.rows());
+    ASSERT_EQ(expected.samples.cols(), values.size());
+    for (int col = 0; col < expected.samples.cols(); ++col)
+      EXPECT_EQ(expected.samples(row, col), values[col]);
+  }
+  EXPECT_EQ(expected.samples.rows(), row);
+  EXPECT_EQ(expected.samples.rows(), reader.num_rows());
+  EXPECT_FLOAT_EQ(expected.timing.warmup, reader.timing().warmup);
+  EXPECT_FLOAT_EQ(expected.timing.sampling, reader.timing().sampling);
+  EXPECT_FALSE(reader.next_row(values));
+}
+
+TEST_F(StanIoStanCsvStreamReader, select_columns) {
+  // a small buffer splits lines across reads
+  std::stringstream in(blocker0);
+  stan::io::stan_csv_stream_reader reader(in, 0, 7);
+  std::vector<std::string> names;
+  names.push_back("sigma_delta");
+  names.push_back("mu");
+  names.push_back("d");
+  reader.select(names);
+
+  std::vector<std::string> selected = reader.selected_names();
+  ASSERT_EQ(24U, selected.size());
+  EXPECT_EQ("sigma_delta", selected[0]);
+  EXPECT_EQ("mu[1]", selected[1]);
+  EXPECT_EQ("mu[22]", selected[22]);
+  EXPECT_EQ("d", selected[23]);
+
+  std::vector<double> values;
+  int row = 0;
+  for (; reader.next_row(values); ++row) {
+    ASSERT_EQ(24U, values.size());
+    for (size_t k = 0; k < values.size(); ++k)
+      EXPECT_EQ(expected.samples(row, reader.selected_columns()[k]),
+                values[k]);
+  }
+  EXPECT_EQ(expected.samples.rows(), row);
+
+  names.push_back("mu[23]");
+  EXPECT_THROW(reader.select(names), std::invalid_argument);
+}
+
+TEST_F(StanIoStanCsvStreamReader, summaries) {
+  std::stringstream in(blocker0);
+  stan::io::stan_csv_stream_reader reader(in, 0);
+  std::vector<std::string> names;
+  names.push_back("d");
+  names.push_back("delta_new");
+  reader.select(names);
+  stan::io::stan_csv_column_summaries summaries
+    = stan::io::summarize_columns(reader);
+
+  ASSERT_EQ(2U, summaries.names().size());
+  EXPECT_EQ(expected.samples.rows(), summaries.num_rows());
+  for (size_t k = 0; k < 2; ++k) {
+    Eigen::VectorXd x = expected.samples.col(reader.selected_columns()[k]);
+    double mean = x.mean();
+    double var = (x.array() - mean).square().sum() / (x.size() - 1.0);
+    EXPECT_FLOAT_EQ(mean, summaries.mean(k));
+    EXPECT_FLOAT_EQ(var, summaries.variance(k));
+    EXPECT_FLOAT_EQ(std::sqrt(var), summaries.sd(k));
+    EXPECT_EQ(x.minCoeff(), summaries.min(k));
+    EXPECT_EQ(x.maxCoeff(), summaries.max(k));
+  }
+}
+
+TEST(StanIoStanCsvStreamReaderText, rows) {
+  std::stringstream in("lp__,a.1,a.2\r\n"
+                       "1, 2.5 ,-3e2\r\n"
+                       "\n"
+                       "# comment\n"
+                       "4,nan,inf\n"
+                       "7,8,9");
+  stan::io::stan_csv_stream_reader reader(in, 0);
+  std::vector<double> values;
+  ASSERT_TRUE(reader.next_row(values));
+  ASSERT_EQ(3U, values.size());
+  EXPECT_EQ(1, values[0]);
+  EXPECT_EQ(2.5, values[1]);
+  EXPECT_EQ(-300, values[2]);
+  ASSERT_TRUE(reader.next_row(values));
+  EXPECT_NE(values[1], values[1]);
+  EXPECT_EQ(std::numeric_limits<double>::infinity(), values[2]);
+  ASSERT_TRUE(reader.next_row(values));
+  EXPECT_EQ(9, values[2]);
+  EXPECT_FALSE(reader.next_row(values));
+
+  std::stringstream bad("lp__,a\n1,2\n3\n");
+  stan::io::stan_csv_stream_reader bad_reader(bad, 0);
+  EXPECT_TRUE(bad_reader.next_row(values));
+  EXPECT_THROW(bad_reader.next_row(values), std::invalid_argument);
+}
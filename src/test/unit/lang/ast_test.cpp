@@ -375,6 +375,49 @@ TEST(lang_ast, function_signatures_add) {
 
 }
 
+TEST(lang_ast, function_signatures_resolution_cache) {
+  stan::lang::function_signatures& fs
+    = stan::lang::function_signatures::instance();
+  std::stringstream error_msgs;
+
+  // lookup of unknown function does not declare it
+  EXPECT_EQ(expr_type(),
+            fs.get_result_type("baz__", expr_type_vec(), error_msgs));
+  EXPECT_FALSE(fs.has_key("baz__"));
+
+  // int argument promoted to real
+  fs.add("baz__", expr_type(double_type()), expr_type(double_type()));
+  fs.add("baz__", expr_type(vector_type()), expr_type(vector_type()),
+         expr_type(int_type()));
+  EXPECT_EQ(expr_type(double_type()),
+            fs.get_result_type("baz__", expr_type_vec(expr_type(int_type())),
+                               error_msgs));
+  EXPECT_EQ(expr_type(double_type()),
+            fs.get_result_type("baz__", expr_type_vec(expr_type(int_type())),
+                               error_msgs));
+
+  // adding an exact match replaces cached resolution
+  fs.add("baz__", expr_type(int_type()), expr_type(int_type()));
+  EXPECT_EQ(expr_type(int_type()),
+            fs.get_result_type("baz__", expr_type_vec(expr_type(int_type())),
+                               error_msgs));
+  stan::lang::function_signature_t sig;
+  EXPECT_EQ(1, fs.get_signature_matches("baz__",
+                                        expr_type_vec(expr_type(int_type())),
+                                        sig));
+  EXPECT_EQ(expr_type(int_type()), sig.first);
+  EXPECT_EQ(1, fs.get_signature_matches("baz__",
+                                        expr_type_vec(expr_type(vector_type()),
+                                                      expr_type(int_type())),
+                                        sig));
+  EXPECT_EQ(expr_type(vector_type()), sig.first);
+  EXPECT_EQ(0, fs.get_signature_matches("baz__",
+                                        expr_type_vec(expr_type(int_type()),
+                                                      expr_type(int_type()),
+                                                      expr_type(int_type())),
+                                        sig));
+}
+
 TEST(langAst, voidType) {
   std::stringstream ss;
   stan::lang::write_base_expr_type(ss, void_type());
@@ -595,6 +638,43 @@ TEST(langAst, solveAlgebra) {
     EXPECT_EQ(expr_type(vector_type(), 0), e2.expression_type());
 }
 
+TEST(langAst, reduceSum) {
+    using stan::lang::reduce_sum;
+    using stan::lang::variable;
+    using stan::lang::expr_type;
+    using stan::lang::expression;
+
+    reduce_sum rs;  // null ctor should work and not raise error
+    std::string partial_sum_function_name = "partial_sum";
+
+    variable n("n_var_name");
+    n.set_type(int_type(), 0);
+
+    variable grainsize("grainsize_var_name");
+    grainsize.set_type(int_type(), 0);
+
+    variable theta("theta_var_name");
+    theta.set_type(vector_type(), 0);
+
+    variable x_r("x_r_var_name");
+    x_r.set_type(double_type(), 1);
+
+    variable x_i("x_i_var_name");
+    x_i.set_type(int_type(), 1);
+
+    reduce_sum rs2(partial_sum_function_name, n, grainsize, theta, x_r, x_i);
+
+    EXPECT_EQ(partial_sum_function_name, rs2.partial_sum_function_name_);
+    EXPECT_EQ(n.type_, rs2.n_.expression_type());
+    EXPECT_EQ(grainsize.type_, rs2.grainsize_.expression_type());
+    EXPECT_EQ(theta.type_, rs2.theta_.expression_type());
+    EXPECT_EQ(x_r.type_, rs2.x_r_.expression_type());
+    EXPECT_EQ(x_i.type_, rs2.x_i_.expression_type());
+
+    expression e2(rs2);
+    EXPECT_EQ(expr_type(double_type(), 0), e2.expression_type());
+}
+
 void testTotalDims(int expected_total_dims,
                    const stan::lang::base_expr_type& base_type,
                    size_t num_dims) {
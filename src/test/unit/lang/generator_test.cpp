@@ -511,3 +511,307 @@ TEST(genArrayBuilderAdds, addScalars) {
   stan::lang::generate_array_builder_adds(elts, true, o2);
   EXPECT_EQ(3, count_matches(".add(", o2.str()));
 }
+
+TEST(langGenerator, vectorizeSamplingLoops) {
+  std::string cpp = model_to_cpp(
+      "data { int N; vector[N] y; }"
+      " parameters { real mu[N]; real<lower=0> sigma; }"
+      " model { for (n in 1:N) y[n] ~ normal(mu[n], sigma); }",
+      true);
+  EXPECT_EQ(0, count_matches("for (int n", cpp));
+  EXPECT_EQ(1, count_matches("if (as_bool(logical_lte(1,N))) {", cpp));
+  EXPECT_EQ(1, count_matches("lp_accum__.add(normal_log<propto__>("
+                             "stan::model::rvalue(y, stan::model::cons_list("
+                             "stan::model::index_min_max(1, N), "
+                             "stan::model::nil_index_list()), \"y\"), "
+                             "stan::model::rvalue(mu, stan::model::cons_list("
+                             "stan::model::index_min_max(1, N), "
+                             "stan::model::nil_index_list()), \"mu\"), "
+                             "sigma));", cpp));
+
+  cpp = model_to_cpp(
+      "data { int y[10]; } parameters { vector[10] alpha; }"
+      " model { for (n in 1:10) { y[n] ~ poisson_log(alpha[n]); } }",
+      true);
+  EXPECT_EQ(0, count_matches("for (int n", cpp));
+  EXPECT_EQ(0, count_matches("logical_lte", cpp));
+  EXPECT_EQ(1, count_matches("lp_accum__.add(poisson_log_log<propto__>(", cpp));
+}
+
+TEST(langGenerator, vectorizeSamplingLoopsSkipped) {
+  // nonscalar elements, truncation, nonlinear index, no slice,
+  // sliced subexpression, local declaration, log density read,
+  // user-defined function
+  const char* models[] = {
+    "data { int N; matrix[N, 2] y; } parameters { real mu; }"
+    " model { for (n in 1:N) y[n] ~ normal(mu, 1); }",
+    "data { int N; real y[N]; } parameters { real mu; }"
+    " model { for (n in 1:N) y[n] ~ normal(mu, 1) T[0, ]; }",
+    "data { int N; real y[N]; } parameters { real mu; }"
+    " model { for (n in 2:N) y[n] ~ normal(y[n - 1], 1); }",
+    "data { int N; } parameters { real mu; }"
+    " model { for (n in 1:N) mu ~ normal(0, 1); }",
+    "data { int N; real x[N]; } parameters { real mu; }"
+    " model { for (n in 1:N) mu ~ normal(mu + x[n], 1); }",
+    "data { int N; real y[N]; } parameters { real mu; }"
+    " model { for (n in 1:N) { real z; z = y[n]; z ~ normal(mu, 1); } }",
+    "data { int N; real y[N]; } parameters { real mu; }"
+    " model { for (n in 1:N) y[n] ~ normal(mu, exp(target())); }",
+    "functions { real f(real x) { print(x); return x; } }"
+    " data { int N; real y[N]; } parameters { real mu; }"
+    " model { for (n in 1:N) y[n] ~ normal(f(mu), 1); }"
+  };
+  for (size_t i = 0; i < sizeof(models) / sizeof(models[0]); ++i)
+    EXPECT_EQ(1, count_matches("for (int n",
+                               model_to_cpp(models[i], true)))
+      << models[i];
+}
+
+TEST(langGenerator, hoistDataOnlyExprs) {
+  std::string cpp = model_to_cpp(
+      "data { int N; vector[N] x; vector[N] y; real s; }"
+      " parameters { real mu; real<lower=0> sigma; }"
+      " model {"
+      "   mu ~ normal(0, 2 * s);"
+      "   y ~ normal(mu + log(x), sigma);"
+      "   for (n in 1:N) y[n] ~ normal(mu, sqrt(s));"
+      "   if (mu > 0) target += exp(s);"
+      " }",
+      false, true);
+  EXPECT_EQ(1, count_matches("    double hoisted_1__;", cpp));
+  EXPECT_EQ(1, count_matches("    Eigen::Matrix<double, Eigen::Dynamic,1>"
+                             " hoisted_2__;", cpp));
+  EXPECT_EQ(1, count_matches("    double hoisted_3__;", cpp));
+  EXPECT_EQ(0, count_matches("hoisted_4__", cpp));
+  EXPECT_EQ(1, count_matches("normal_log<propto__>(mu, 0, hoisted_1__)",
+                             cpp));
+  EXPECT_EQ(1, count_matches("add(mu,hoisted_2__)", cpp));
+  EXPECT_EQ(1, count_matches("if (as_bool(logical_lte(1,N))) {", cpp));
+  EXPECT_EQ(1, count_matches("stan::math::exp(s)", cpp));
+  EXPECT_EQ(1, count_matches("stan::math::log(x)", cpp));
+}
+
+TEST(langGenerator, hoistLoopInvariantExprs) {
+  std::string cpp = model_to_cpp(
+      "data { int N; vector[N] y; matrix[N, 3] X; }"
+      " parameters { real mu; real log_sigma; vector[3] beta; }"
+      " model {"
+      "   for (n in 1:N)"
+      "     y[n] ~ normal(mu + X[n] * softmax(beta), exp(log_sigma));"
+      "   for (i in 1:N)"
+      "     for (j in 1:N)"
+      "       target += exp(mu) * i * j;"
+      " }",
+      false, true);
+  EXPECT_EQ(1, count_matches("Eigen::Matrix<local_scalar_t__,"
+                             "Eigen::Dynamic,1>  loop_invariant_1__(",
+                             cpp));
+  EXPECT_EQ(1, count_matches("local_scalar_t__ loop_invariant_2__;", cpp));
+  EXPECT_EQ(1, count_matches("local_scalar_t__ loop_invariant_3__;", cpp));
+  EXPECT_EQ(1, count_matches("local_scalar_t__ loop_invariant_4__;", cpp));
+  EXPECT_EQ(0, count_matches("loop_invariant_5__", cpp));
+  EXPECT_EQ(1, count_matches("softmax(beta)", cpp));
+  EXPECT_EQ(1, count_matches("stan::math::exp(log_sigma)", cpp));
+  EXPECT_EQ(1, count_matches("multiply(get_base1(X,n,\"X\",1),"
+                             "loop_invariant_1__)), loop_invariant_2__)",
+                             cpp));
+  EXPECT_EQ(1, count_matches("stan::math::exp(mu)", cpp));
+  EXPECT_EQ(1, count_matches("(loop_invariant_4__ * i)", cpp));
+  EXPECT_EQ(1, count_matches("add((loop_invariant_3__ * j))", cpp));
+  EXPECT_EQ(5, count_matches("if (as_bool(logical_lte(1,N))) {", cpp));
+}
+
+TEST(langGenerator, hoistLoopInvariantExprsSkipped) {
+  // loop variable, variable changed by body, break, log density
+  // read, user-defined function, integer expression
+  const char* models[] = {
+    "data { int N; } parameters { real mu; }"
+    " model { for (n in 1:N) target += exp(mu * n); }",
+    "data { int N; } parameters { real mu; }"
+    " model { real a; a = mu;"
+    "   for (n in 1:N) { target += exp(a); a = a / 2; } }",
+    "data { int N; } parameters { real mu; }"
+    " model { for (n in 1:N) { if (n > 2) break; target += exp(mu); } }",
+    "data { int N; } parameters { real mu; }"
+    " model { for (n in 1:N) target += exp(target()); }",
+    "functions { real f(real x) { print(x); return x; } }"
+    " data { int N; } parameters { real mu; }"
+    " model { for (n in 1:N) target += f(mu); }",
+    "data { int N; real y[N]; } parameters { real mu; }"
+    " model { for (n in 1:N) y[n] ~ normal(mu, N * N); }"
+  };
+  for (size_t i = 0; i < sizeof(models) / sizeof(models[0]); ++i)
+    EXPECT_EQ(0, count_matches("loop_invariant_",
+                               model_to_cpp(models[i], false, true)))
+      << models[i];
+}
+
+TEST(langGenerator, rewriteSufficientStats) {
+  std::string cpp = model_to_cpp(
+      "data { int N; vector[N] y; int k[N]; int b[N]; real z[N]; }"
+      " parameters { real mu; real<lower=0> sigma; real<lower=0> lambda;"
+      "   real<lower=0, upper=1> theta; vector[N] nu; }"
+      " model {"
+      "   y ~ normal(mu, sigma);"
+      "   k ~ poisson(lambda);"
+      "   b ~ bernoulli(theta);"
+      "   for (n in 1:N) z[n] ~ normal(mu, 1);"
+      "   y ~ normal(nu, sigma);"
+      "   for (n in 1:N) y[n] ~ normal(mu, n);"
+      " }",
+      true, false, true);
+  EXPECT_EQ(1, count_matches("stan::model::normal_sufficient_log<propto__>"
+                             "(hoisted_1__, hoisted_2__, hoisted_3__, mu,"
+                             " sigma)", cpp));
+  EXPECT_EQ(1, count_matches("stan::model::poisson_sufficient_log<propto__>"
+                             "(hoisted_4__, hoisted_5__, hoisted_6__,"
+                             " hoisted_7__, lambda)", cpp));
+  EXPECT_EQ(1, count_matches("stan::model::bernoulli_sufficient_log"
+                             "<propto__>(hoisted_8__, hoisted_9__,"
+                             " hoisted_10__, hoisted_11__, theta)", cpp));
+  EXPECT_EQ(2, count_matches("normal_sufficient_log", cpp));
+  EXPECT_EQ(0, count_matches("hoisted_15__", cpp));
+  EXPECT_EQ(1, count_matches("    int hoisted_1__;", cpp));
+  EXPECT_EQ(1, count_matches("    double hoisted_5__;", cpp));
+  EXPECT_EQ(1, count_matches("stan::model::sufficient_sum(k)", cpp));
+  EXPECT_EQ(1, count_matches("    int hoisted_9__;", cpp));
+  EXPECT_EQ(1, count_matches("stan::model::sufficient_sq_dev(y)", cpp));
+  EXPECT_EQ(1, count_matches("stan::model::sufficient_log_factorial(k)",
+                             cpp));
+  EXPECT_EQ(1, count_matches("normal_log<propto__>(y, nu, sigma)", cpp));
+}
+
+TEST(langGenerator, skipInitOfAssignedLocals) {
+  std::string cpp = model_to_cpp(
+      "data { int N; vector[N] x; }"
+      " parameters { real mu; }"
+      " transformed parameters {"
+      "   vector[N] theta;"
+      "   vector[N] eta;"
+      "   theta = mu + x;"
+      "   eta[1] = mu;"
+      " }"
+      " model {"
+      "   matrix[N, N] m;"
+      "   real z;"
+      "   real w = mu;"
+      "   m = diag_matrix(theta);"
+      "   z = z + 1;"
+      " }");
+  // theta in log_prob and write_array, m and w in log_prob
+  EXPECT_EQ(4, count_matches("#ifdef STAN_DEBUG_INIT_LOCALS", cpp));
+  EXPECT_EQ(2, count_matches("stan::math::fill(theta,DUMMY_VAR__);", cpp));
+  EXPECT_EQ(2, count_matches("stan::math::fill(eta,DUMMY_VAR__);", cpp));
+  EXPECT_EQ(1, count_matches("#ifdef STAN_DEBUG_INIT_LOCALS\n"
+                             "            stan::math::initialize(m, "
+                             "DUMMY_VAR__);", cpp));
+}
+
+TEST(langGenerator, logProbValue) {
+  std::string cpp = model_to_cpp(
+      "parameters { real mu; }"
+      " model { mu ~ normal(0, 1); }");
+  EXPECT_EQ(1, count_matches("static const bool has_log_prob_value__ = true;",
+                             cpp));
+  EXPECT_EQ(1, count_matches("double log_prob_value(vector<double>&",
+                             cpp));
+  EXPECT_EQ(1, count_matches("T_lp_accum__ lp_accum__;", cpp));
+  EXPECT_EQ(1, count_matches("stan::math::accumulator<T__> >", cpp));
+  EXPECT_EQ(1, count_matches("stan::model::value_accumulator >", cpp));
+
+  cpp = model_to_cpp(
+      "functions { void foo_lp(real x) { x ~ normal(0, 1); } }"
+      " parameters { real mu; }"
+      " model { foo_lp(mu); }");
+  EXPECT_EQ(0, count_matches("stan::model::value_accumulator", cpp));
+  EXPECT_EQ(1, count_matches("stan::math::accumulator<double> >", cpp));
+
+  cpp = model_to_cpp(
+      "parameters { real mu; }"
+      " transformed parameters { vector[2] v; v[1] = mu; v[2] = -mu; }"
+      " model { v ~ normal(0, 1); }");
+  EXPECT_EQ(1, count_matches("if (!boost::is_same<local_scalar_t__, double>"
+                             "::value) {", cpp));
+  EXPECT_EQ(1, count_matches("is_uninitialized(v(i0__))", cpp));
+}
+
+TEST(langGenerator, generateCppSplit) {
+  std::string model_name = "foo";
+  std::stringstream ss("functions {"
+                       "   int twice(int k) { return 2 * k; }"
+                       "   real ident(real x) { return x; }"
+                       " }"
+                       " data { int N; }"
+                       " transformed data { int M = twice(N); }"
+                       " parameters { real mu; }"
+                       " model { mu ~ normal(ident(0), 1); }");
+  std::stringstream msgs;
+  stan::lang::program prog;
+  stan::io::program_reader reader = create_stub_reader();
+  EXPECT_TRUE(stan::lang::parse(&msgs, ss, model_name, reader, prog));
+  std::stringstream header, functions, ctor, lp_var, lp_double, lp_fvar,
+    write_array;
+  stan::lang::generate_cpp_split(prog, model_name, reader.history(),
+                                 "foo.hpp", header, functions, ctor,
+                                 lp_var, lp_double, lp_fvar, write_array);
+
+  // template user functions stay in the header, others only declared
+  EXPECT_EQ(1, count_matches("twice(const int& k, std::ostream* pstream__);",
+                             header.str()));
+  EXPECT_EQ(1, count_matches("ident(const T0__& x, std::ostream* pstream__) {",
+                             header.str()));
+  EXPECT_EQ(1, count_matches("twice(const int& k, std::ostream* pstream__) {",
+                             functions.str()));
+  EXPECT_EQ(0, count_matches("ident(", functions.str()));
+
+  // class methods are declared in the header, defined in the units
+  EXPECT_EQ(1, count_matches("void ctor_body(", header.str()));
+  EXPECT_EQ(0, count_matches("\"data initialization\"", header.str()));
+  EXPECT_EQ(1, count_matches("void foo::ctor_body(", ctor.str()));
+  EXPECT_EQ(1, count_matches("T__ foo::log_prob_impl__(",
+                             lp_var.str()));
+  EXPECT_EQ(4, count_matches("template stan::math::var", lp_var.str()));
+  EXPECT_EQ(4, count_matches("stan::math::accumulator<double> >",
+                             lp_double.str()));
+  EXPECT_EQ(4, count_matches("stan::model::value_accumulator >",
+                             lp_double.str()));
+  EXPECT_EQ(4, count_matches("template stan::math::fvar<stan::math::var> ",
+                             lp_fvar.str()));
+  EXPECT_EQ(4, count_matches("template stan::math::fvar<double> ",
+                             lp_fvar.str()));
+  EXPECT_EQ(1, count_matches("template void foo::write_array",
+                             write_array.str()));
+  EXPECT_EQ(1, count_matches("#include \"foo.hpp\"", write_array.str()));
+}
+
+TEST(langGenerator, assignRvalueView) {
+  std::string cpp = model_to_cpp(
+      "data { int N; vector[N] x; matrix[N, N] m; int ii[2]; }"
+      " parameters { vector[N] mu; }"
+      " model {"
+      "   vector[N - 1] a = mu[2:N];"
+      "   row_vector[N] b;"
+      "   vector[N] c;"
+      "   vector[2] d;"
+      "   vector[N - 1] e;"
+      "   b = m[1, :];"
+      "   c = m[:, 2];"
+      "   d = x[ii];"
+      "   e = e[1:(N - 1)];"
+      "   mu ~ normal(x[1:N], 1);"
+      " }");
+  EXPECT_EQ(1, count_matches("stan::model::assign_view(a, "
+                             "stan::model::rvalue_view(mu, "
+                             "stan::model::cons_list("
+                             "stan::model::index_min_max(2, N), "
+                             "stan::model::nil_index_list()), \"mu\"), "
+                             "\"assigning variable a\");", cpp));
+  EXPECT_EQ(1, count_matches("stan::model::assign_view(b, ", cpp));
+  EXPECT_EQ(1, count_matches("stan::model::assign_view(c, ", cpp));
+  // multi-index, aliased and function argument slices are copied
+  EXPECT_EQ(3, count_matches("stan::model::rvalue_view(", cpp));
+  EXPECT_EQ(1, count_matches("stan::math::assign(d, ", cpp));
+  EXPECT_EQ(1, count_matches("stan::math::assign(e, ", cpp));
+  EXPECT_EQ(1, count_matches("normal_log<propto__>(mu, "
+                             "stan::model::rvalue(x, ", cpp));
+}
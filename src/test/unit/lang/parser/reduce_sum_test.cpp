@@ -0,0 +1,17 @@
+#include <gtest/gtest.h>
+#include <test/unit/lang/utility.hpp>
+
+TEST(lang_parser, reduce_sum_good) {
+  test_parsable("reduce_sum_good");
+}
+
+TEST(lang_parser, reduce_sum_bad) {
+  test_throws("reduce_sum/bad_fun_type",
+              "first argument to reduce_sum must be the name of a function with signature");
+  test_throws("reduce_sum/bad_grainsize_type",
+              "third argument to reduce_sum must have type int for grainsize");
+  test_throws("reduce_sum/bad_theta_type",
+              "fourth argument to reduce_sum must have type vector");
+  test_throws("reduce_sum/bad_x_r_var_type",
+              "fifth argument to reduce_sum (real data) must be data only");
+}
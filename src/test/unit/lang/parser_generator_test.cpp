@@ -73,3 +73,15 @@ TEST(unitLang, algebra_solverTest) {
   test_pg("algebra_solver", expected);
   test_pg_count("algebra_solver", expected, 1);
 }
+
+TEST(unitLang, reduce_sumTest) {
+  std::string expected;
+  expected = "lp_accum__.add(stan::model::reduce_sum(partial_sum_functor__(), "
+    "N, 10, theta, y, x_i, pstream__));";
+  test_pg("reduce_sum", expected);
+  test_pg_count("reduce_sum", expected, 1);
+  expected = "stan::math::assign(s, "
+    "stan::model::reduce_sum(partial_sum_functor__(), "
+    "N, 10, theta, y, x_i, pstream__));";
+  test_pg_count("reduce_sum", expected, 1);
+}
@@ -148,3 +148,103 @@ TEST(commandStancHelper, readOnlyDirBadFile) {
   EXPECT_TRUE(rc != 0);
 }
 
+
+TEST(commandStancHelper, compileCacheRoundTrip) {
+  std::vector<std::string> outputs;
+  outputs.push_back("// header\n");
+  outputs.push_back("");
+  outputs.push_back("int main() { }\n");
+  write_compile_cache("src/test/test-models/temp.stanc", "Warning\n",
+                      outputs);
+  std::string messages;
+  std::vector<std::string> read_outputs;
+  EXPECT_TRUE(read_compile_cache("src/test/test-models/temp.stanc",
+                                 messages, read_outputs));
+  EXPECT_EQ("Warning\n", messages);
+  ASSERT_EQ(3U, read_outputs.size());
+  for (size_t i = 0; i < outputs.size(); ++i)
+    EXPECT_EQ(outputs[i], read_outputs[i]);
+  std::stringstream err;
+  delete_file(&err, "src/test/test-models/temp.stanc");
+  EXPECT_EQ(0, err.str().size());
+
+  EXPECT_FALSE(read_compile_cache("src/test/test-models/temp.stanc",
+                                  messages, read_outputs));
+}
+
+TEST(commandStancHelper, compileCacheKey) {
+  std::vector<std::string> include_paths;
+  include_paths.push_back("");
+  std::vector<std::string> options;
+  options.push_back("m_model");
+
+  std::stringstream in1("parameters { real y; }");
+  std::string key = compile_cache_key(in1, "m.stan", include_paths, options);
+  EXPECT_EQ(16U, key.size());
+  std::string program;
+  std::getline(in1, program);
+  EXPECT_EQ("parameters { real y; }", program);
+
+  std::stringstream in2("parameters { real y; }");
+  EXPECT_EQ(key, compile_cache_key(in2, "m.stan", include_paths, options));
+
+  std::stringstream in3("parameters { real z; }");
+  EXPECT_NE(key, compile_cache_key(in3, "m.stan", include_paths, options));
+
+  std::stringstream in4("parameters { real y; }");
+  options.push_back("allow_undefined");
+  EXPECT_NE(key, compile_cache_key(in4, "m.stan", include_paths, options));
+}
+
+TEST(commandStancHelper, compileCacheHit) {
+  std::ifstream model("src/test/test-models/good/stanc_helper.stan");
+  std::vector<std::string> include_paths;
+  include_paths.push_back("");
+  std::vector<std::string> options;
+  options.push_back("stanc_helper_model");
+  options.push_back("src/test/test-models/good/stanc_helper.stan");
+  options.push_back("");
+  options.push_back("");
+  options.push_back("");
+  std::string cache_file = "src/test/test-models/"
+    + compile_cache_key(model, "src/test/test-models/good/stanc_helper.stan",
+                        include_paths, options)
+    + ".stanc";
+
+  std::string cpp[2];
+  for (int n = 0; n < 2; ++n) {
+    std::stringstream out;
+    std::stringstream err;
+    int argc = 4;
+    std::vector<const char*> argv_vec;
+    argv_vec.push_back("main");
+    argv_vec.push_back("--cache_dir=src/test/test-models");
+    argv_vec.push_back("--o=src/test/test-models/cached.cpp");
+    argv_vec.push_back("src/test/test-models/good/stanc_helper.stan");
+    const char** argv = &argv_vec[0];
+    EXPECT_EQ(0, stanc_helper(argc, argv, &out, &err));
+    std::ifstream in("src/test/test-models/cached.cpp");
+    std::stringstream ss;
+    ss << in.rdbuf();
+    cpp[n] = ss.str();
+    delete_file(&err, "src/test/test-models/cached.cpp");
+
+    if (n == 0) {
+      // the first run fills the cache; replace the entry so that the
+      // second run can only produce its output by reading the cache
+      std::string messages;
+      std::vector<std::string> outputs;
+      EXPECT_TRUE(read_compile_cache(cache_file, messages, outputs));
+      ASSERT_EQ(1U, outputs.size());
+      EXPECT_EQ(cpp[0], outputs[0]);
+      outputs[0] = "// from cache\n";
+      write_compile_cache(cache_file, messages, outputs);
+    }
+  }
+  EXPECT_GT(cpp[0].size(), 0U);
+  EXPECT_EQ("// from cache\n", cpp[1]);
+
+  std::stringstream err;
+  delete_file(&err, cache_file);
+  EXPECT_EQ(0, err.str().size());
+}
@@ -189,7 +189,21 @@ void test_warning(const std::string& model_name,
     << std::endl;
 }
 
-std::string model_to_cpp(const std::string& model_text) {
+/**
+ * Return the C++ generated for the specified model text after
+ * running the selected rewrites in the order stanc runs them.
+ *
+ * @param model_text Stan program
+ * @param vectorize true to vectorize sampling loops
+ * @param hoist true to hoist data-only and loop-invariant
+ *   subexpressions
+ * @param suff_stats true to rewrite sampling statements to use
+ *   sufficient statistics
+ * @return generated C++
+ */
+std::string model_to_cpp(const std::string& model_text,
+                         bool vectorize = false, bool hoist = false,
+                         bool suff_stats = false) {
   std::string model_name = "foo";
   std::stringstream ss(model_text);
   std::stringstream msgs;
@@ -198,6 +212,14 @@ std::string model_to_cpp(const std::string& model_text) {
   stan::io::program_reader reader = create_stub_reader();
   bool parsable = stan::lang::parse(&msgs, ss, model_name, reader, prog);
   EXPECT_TRUE(parsable);
+  if (vectorize)
+    stan::lang::vectorize_sampling_loops(prog.statement_);
+  if (suff_stats)
+    stan::lang::rewrite_sufficient_stats(prog);
+  if (hoist) {
+    stan::lang::hoist_data_only_exprs(prog);
+    stan::lang::hoist_loop_invariant_exprs(prog);
+  }
 
   std::stringstream output;
   stan::lang::generate_cpp(prog, model_name, reader.history(), output);
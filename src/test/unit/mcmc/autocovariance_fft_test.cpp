@@ -0,0 +1,69 @@
+#include <stan/mcmc/autocovariance_fft.hpp>
+#include <gtest/gtest.h>
+#include <cmath>
+#include <vector>
+
+TEST(McmcAutocovarianceFft, matches_math_autocovariance) {
+  stan::mcmc::autocovariance_fft autocovariance;
+  // lengths with and without an FFT-friendly size, reusing the plan
+  int sizes[] = {1000, 1000, 37, 128, 1000};
+  for (int s = 0; s < 5; ++s) {
+    int n = sizes[s];
+    Eigen::VectorXd x(n);
+    for (int i = 0; i < n; ++i)
+      x(i) = std::sin(0.3 * i + s) + 0.01 * i;
+
+    std::vector<double> y(x.data(), x.data() + n);
+    std::vector<double> expected;
+    stan::math::autocovariance(y, expected);
+
+    Eigen::VectorXd acov;
+    autocovariance(x, acov);
+    ASSERT_EQ(n, acov.size());
+    for (int k = 0; k < n; ++k)
+      EXPECT_NEAR(expected[k], acov(k), 1e-12 * expected[0])
+        << "n = " << n << ", k = " << k;
+  }
+}
+
+TEST(McmcAutocovarianceFft, autocovariances) {
+  Eigen::MatrixXd x(200, 7);
+  for (int j = 0; j < x.cols(); ++j)
+    for (int i = 0; i < x.rows(); ++i)
+      x(i, j) = std::cos(0.1 * (j + 1) * i) + j;
+
+  stan::mcmc::autocovariance_fft autocovariance;
+  for (int num_threads = 1; num_threads <= 8; num_threads *= 2) {
+    Eigen::MatrixXd acov
+      = stan::mcmc::autocovariances(x.bottomRows(150), num_threads);
+    ASSERT_EQ(150, acov.rows());
+    ASSERT_EQ(7, acov.cols());
+    for (int j = 0; j < x.cols(); ++j) {
+      Eigen::VectorXd expected;
+      autocovariance(x.col(j).tail(150), expected);
+      EXPECT_TRUE(expected == acov.col(j)) << "column " << j;
+    }
+  }
+}
+
+TEST(McmcAutocovarianceFft, autocovariances_of_columns) {
+  Eigen::MatrixXd x(120, 6);
+  for (int j = 0; j < x.cols(); ++j)
+    for (int i = 0; i < x.rows(); ++i)
+      x(i, j) = std::sin(0.2 * (j + 1) * i) - j;
+
+  std::vector<int> cols;
+  cols.push_back(4);
+  cols.push_back(1);
+  cols.push_back(5);
+  Eigen::MatrixXd all = stan::mcmc::autocovariances(x, 1);
+  for (int num_threads = 1; num_threads <= 4; ++num_threads) {
+    Eigen::MatrixXd acov
+      = stan::mcmc::autocovariances(x, cols, num_threads);
+    ASSERT_EQ(120, acov.rows());
+    ASSERT_EQ(3, acov.cols());
+    for (size_t j = 0; j < cols.size(); ++j)
+      EXPECT_TRUE(all.col(cols[j]) == acov.col(j)) << "column " << cols[j];
+  }
+  EXPECT_EQ(0, stan::mcmc::autocovariances(x, std::vector<int>(), 2).cols());
+}
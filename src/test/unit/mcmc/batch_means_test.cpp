@@ -0,0 +1,96 @@
+#include <stan/mcmc/batch_means.hpp>
+#include <gtest/gtest.h>
+#include <boost/math/special_functions/fpclassify.hpp>
+#include <boost/random/additive_combine.hpp>
+#include <boost/random/normal_distribution.hpp>
+#include <boost/random/variate_generator.hpp>
+#include <cmath>
+#include <vector>
+
+TEST(McmcRunningMoments, add_merge) {
+  std::vector<double> x;
+  for (int i = 0; i < 50; ++i)
+    x.push_back(std::sin(i) * i);
+
+  double sum = 0;
+  for (size_t i = 0; i < x.size(); ++i)
+    sum += x[i];
+  double mean = sum / x.size();
+  double ss = 0;
+  for (size_t i = 0; i < x.size(); ++i)
+    ss += (x[i] - mean) * (x[i] - mean);
+
+  stan::mcmc::running_moments all;
+  stan::mcmc::running_moments first;
+  stan::mcmc::running_moments second;
+  for (size_t i = 0; i < x.size(); ++i) {
+    all.add(x[i]);
+    if (i < 17)
+      first.add(x[i]);
+    else
+      second.add(x[i]);
+  }
+  first.merge(second);
+
+  EXPECT_FLOAT_EQ(50, all.n_);
+  EXPECT_FLOAT_EQ(mean, all.mean_);
+  EXPECT_FLOAT_EQ(ss / 49, all.variance());
+  EXPECT_FLOAT_EQ(50, first.n_);
+  EXPECT_FLOAT_EQ(mean, first.mean_);
+  EXPECT_FLOAT_EQ(ss / 49, first.variance());
+
+  stan::mcmc::running_moments one;
+  one.add(1);
+  EXPECT_TRUE(boost::math::isnan(one.variance()));
+}
+
+TEST(McmcBatchMeans, batches) {
+  stan::mcmc::batch_means batches(16);
+  EXPECT_TRUE(boost::math::isnan(batches.asymptotic_variance()));
+  for (int i = 0; i < 1000; ++i) {
+    batches.add(i);
+    if (i >= 16) {
+      EXPECT_GE(batches.num_batches(), 8U);
+      EXPECT_LT(batches.num_batches(), 16U);
+    }
+  }
+  EXPECT_FLOAT_EQ(1000, batches.moments().n_);
+  EXPECT_FLOAT_EQ(499.5, batches.moments().mean_);
+  EXPECT_EQ(64U, batches.batch_size());
+  EXPECT_EQ(15U, batches.num_batches());
+}
+
+TEST(McmcBatchMeans, split) {
+  stan::mcmc::batch_means batches(16);
+  for (int i = 0; i < 1001; ++i)
+    batches.add(i);
+  stan::mcmc::running_moments first;
+  stan::mcmc::running_moments second;
+  batches.split(first, second);
+  EXPECT_FLOAT_EQ(1001, first.n_ + second.n_);
+  EXPECT_LE(first.n_, 500);
+  EXPECT_GE(first.n_, 500 - 64);
+  EXPECT_FLOAT_EQ((first.n_ - 1) / 2, first.mean_);
+  EXPECT_FLOAT_EQ((first.n_ + 1000) / 2, second.mean_);
+}
+
+TEST(McmcBatchMeans, asymptotic_variance) {
+  boost::ecuyer1988 rng(1234);
+  boost::variate_generator<boost::ecuyer1988&,
+                           boost::normal_distribution<> >
+    normal(rng, boost::normal_distribution<>());
+
+  // independent draws: asymptotic variance is the variance
+  stan::mcmc::batch_means iid;
+  // AR(1) with coefficient 0.5: asymptotic variance is three times
+  // the variance
+  stan::mcmc::batch_means ar;
+  double y = 0;
+  for (int i = 0; i < 100000; ++i) {
+    iid.add(normal());
+    y = 0.5 * y + normal();
+    ar.add(y);
+  }
+  EXPECT_NEAR(1, iid.asymptotic_variance(), 0.3);
+  EXPECT_NEAR(3 * ar.moments().variance(), ar.asymptotic_variance(), 1.2);
+}
@@ -461,6 +461,37 @@ TEST_F(McmcChains, blocker_variance) {
 
 }
 
+TEST_F(McmcChains, blocker_mean_variance_empty_chains) {
+  std::stringstream out;
+  stan::io::stan_csv blocker1 = stan::io::stan_csv_reader::parse(blocker1_stream, &out);
+  stan::io::stan_csv blocker2 = stan::io::stan_csv_reader::parse(blocker2_stream, &out);
+  EXPECT_EQ("", out.str());
+
+  stan::mcmc::chains<> chains(blocker1);
+  // chain 1 is left empty by adding chain 2 directly
+  chains.add(2, blocker2.samples);
+  // chain 3 is all warmup
+  chains.add(blocker1.samples);
+  chains.set_warmup(3, blocker1.samples.rows());
+  ASSERT_EQ(4, chains.num_chains());
+  EXPECT_EQ(0, chains.num_kept_samples(1));
+  EXPECT_EQ(0, chains.num_kept_samples(3));
+
+  for (int j = 0; j < chains.num_params(); j++) {
+    Eigen::VectorXd x(blocker1.samples.rows() + blocker2.samples.rows());
+    x << blocker1.samples.col(j), blocker2.samples.col(j);
+    ASSERT_FLOAT_EQ(x.mean(), chains.mean(j))
+      << "param mean. index: " << j;
+    ASSERT_NEAR(variance(x), chains.variance(j), 1e-8)
+      << "param variance. index: " << j;
+  }
+
+  stan::mcmc::chains<> empty(blocker1.header);
+  empty.add(0, Eigen::MatrixXd(0, empty.num_params()));
+  EXPECT_TRUE(std::isnan(empty.mean(0)));
+  EXPECT_TRUE(std::isnan(empty.variance(0)));
+}
+
 double covariance(Eigen::VectorXd x, Eigen::VectorXd y) {
   double x_mean = x.mean();
   double y_mean = y.mean();
@@ -884,3 +915,62 @@ TEST_F(McmcChains,blocker_split_potential_scale_reduction) {
   }
 
 }
+
+TEST_F(McmcChains, blocker_summary) {
+  stan::io::stan_csv blocker1 = stan::io::stan_csv_reader::parse(blocker1_stream, 0);
+  stan::io::stan_csv blocker2 = stan::io::stan_csv_reader::parse(blocker2_stream, 0);
+
+  stan::mcmc::chains<> chains(blocker1);
+  chains.add(blocker2);
+  chains.set_warmup(200);
+
+  Eigen::VectorXd probs(3);
+  probs << 0.1, 0.5, 0.9;
+  for (int index = 4; index < chains.num_params(); index++) {
+    Eigen::VectorXd summary = chains.summary(index, probs);
+    ASSERT_EQ(8, summary.size());
+    double n_eff = chains.effective_sample_size(index);
+    EXPECT_FLOAT_EQ(chains.mean(index), summary(0));
+    EXPECT_FLOAT_EQ(chains.sd(index) / std::sqrt(n_eff), summary(1));
+    EXPECT_FLOAT_EQ(chains.sd(index), summary(2));
+    Eigen::VectorXd quantiles = chains.quantiles(index, probs);
+    for (int k = 0; k < probs.size(); k++)
+      EXPECT_FLOAT_EQ(quantiles(k), summary(3 + k));
+    EXPECT_FLOAT_EQ(n_eff, summary(6));
+    EXPECT_FLOAT_EQ(chains.split_potential_scale_reduction(index),
+                    summary(7));
+    EXPECT_TRUE(summary == chains.summary(chains.param_name(index), probs));
+  }
+
+  // cached moments and autocovariances follow changes to the chains
+  stan::mcmc::chains<> copy(chains);
+  double n_eff = copy.effective_sample_size(5);
+  copy.set_warmup(0);
+  EXPECT_FLOAT_EQ(blocker1.samples.col(5).mean(), copy.mean(0, 5));
+  EXPECT_NE(n_eff, copy.effective_sample_size(5));
+  EXPECT_FLOAT_EQ(n_eff, chains.effective_sample_size(5));
+}
+
+TEST_F(McmcChains, blocker_cache_autocovariances) {
+  stan::io::stan_csv blocker1 = stan::io::stan_csv_reader::parse(blocker1_stream, 0);
+  stan::io::stan_csv blocker2 = stan::io::stan_csv_reader::parse(blocker2_stream, 0);
+
+  stan::mcmc::chains<> chains(blocker1);
+  chains.add(blocker2);
+  chains.set_warmup(200);
+  stan::mcmc::chains<> cached(chains);
+  cached.effective_sample_size(5);
+  cached.cache_autocovariances(3);
+
+  for (int index = 4; index < chains.num_params(); index++) {
+    EXPECT_FLOAT_EQ(chains.effective_sample_size(index),
+                    cached.effective_sample_size(index));
+    for (int chain = 0; chain < chains.num_chains(); chain++) {
+      Eigen::VectorXd expected = chains.autocovariance(chain, index);
+      Eigen::VectorXd acov = cached.autocovariance(chain, index);
+      ASSERT_EQ(expected.size(), acov.size());
+      for (int t = 0; t < acov.size(); t++)
+        EXPECT_NEAR(expected(t), acov(t), 1e-12 * expected(0));
+    }
+  }
+}
@@ -0,0 +1,55 @@
+#include <stan/mcmc/quantile_sketch.hpp>
+#include <gtest/gtest.h>
+#include <boost/math/special_functions/fpclassify.hpp>
+#include <cmath>
+
+TEST(McmcQuantileSketch, empty) {
+  stan::mcmc::quantile_sketch sketch;
+  EXPECT_EQ(0U, sketch.count());
+  EXPECT_TRUE(boost::math::isnan(sketch.quantile(0.5)));
+}
+
+TEST(McmcQuantileSketch, exact_below_capacity) {
+  stan::mcmc::quantile_sketch sketch(128);
+  for (int i = 100; i > 0; --i)
+    sketch.add(i);
+  EXPECT_EQ(100U, sketch.count());
+  EXPECT_FLOAT_EQ(1, sketch.quantile(0.0));
+  EXPECT_FLOAT_EQ(10, sketch.quantile(0.1));
+  EXPECT_FLOAT_EQ(50, sketch.quantile(0.5));
+  EXPECT_FLOAT_EQ(100, sketch.quantile(1.0));
+}
+
+TEST(McmcQuantileSketch, rank_error) {
+  // values 0, ..., n - 1 in a scrambled order
+  const int n = 100000;
+  stan::mcmc::quantile_sketch sketch(256);
+  for (int i = 0; i < n; ++i)
+    sketch.add((i * 7919) % n);
+  EXPECT_EQ(static_cast<size_t>(n), sketch.count());
+
+  double probs[] = {0.025, 0.05, 0.25, 0.5, 0.75, 0.95, 0.975};
+  for (int i = 0; i < 7; ++i)
+    EXPECT_NEAR(probs[i] * n, sketch.quantile(probs[i]), 0.01 * n)
+      << "prob = " << probs[i];
+}
+
+TEST(McmcQuantileSketch, merge) {
+  const int n = 20000;
+  stan::mcmc::quantile_sketch whole(64);
+  stan::mcmc::quantile_sketch first(64);
+  stan::mcmc::quantile_sketch second(64);
+  for (int i = 0; i < n; ++i) {
+    double x = (i * 7919) % n;
+    whole.add(x);
+    if (i < n / 4)
+      first.add(x);
+    else
+      second.add(x);
+  }
+  first.merge(second);
+  EXPECT_EQ(whole.count(), first.count());
+  for (double prob = 0.05; prob < 1; prob += 0.1)
+    EXPECT_NEAR(whole.quantile(prob), first.quantile(prob), 0.03 * n)
+      << "prob = " << prob;
+}
@@ -0,0 +1,63 @@
+#include <stan/mcmc/read_chains.hpp>
+#include <gtest/gtest.h>
+#include <fstream>
+#include <sstream>
+#include <stdexcept>
+#include <string>
+#include <vector>
+
+TEST(McmcReadChains, read_chains) {
+  std::vector<std::string> paths;
+  paths.push_back("src/test/unit/mcmc/test_csv_files/blocker.1.csv");
+  paths.push_back("src/test/unit/mcmc/test_csv_files/blocker.2.csv");
+
+  std::stringstream out;
+  stan::mcmc::chains<> chains = stan::mcmc::read_chains(paths, 2, &out);
+  EXPECT_EQ("", out.str());
+
+  std::ifstream blocker1_stream(paths[0].c_str());
+  std::ifstream blocker2_stream(paths[1].c_str());
+  stan::io::stan_csv blocker1
+    = stan::io::stan_csv_reader::parse(blocker1_stream, 0);
+  stan::io::stan_csv blocker2
+    = stan::io::stan_csv_reader::parse(blocker2_stream, 0);
+  stan::mcmc::chains<> expected(blocker1);
+  expected.add(blocker2);
+
+  ASSERT_EQ(expected.num_chains(), chains.num_chains());
+  ASSERT_EQ(expected.num_params(), chains.num_params());
+  for (int chain = 0; chain < chains.num_chains(); ++chain) {
+    EXPECT_EQ(expected.warmup(chain), chains.warmup(chain));
+    for (int index = 0; index < chains.num_params(); ++index)
+      EXPECT_TRUE(expected.samples(chain, index)
+                  == chains.samples(chain, index));
+  }
+}
+
+TEST(McmcReadChains, parse_stan_csv_files_order) {
+  std::vector<std::string> paths;
+  paths.push_back("src/test/unit/mcmc/test_csv_files/epil.1.csv");
+  paths.push_back("src/test/unit/mcmc/test_csv_files/blocker.1.csv");
+  paths.push_back("src/test/unit/mcmc/test_csv_files/blocker.2.csv");
+  std::vector<stan::io::stan_csv> csvs
+    = stan::mcmc::parse_stan_csv_files(paths, 3, 0);
+  ASSERT_EQ(3U, csvs.size());
+  for (size_t n = 0; n < paths.size(); ++n) {
+    std::ifstream in(paths[n].c_str());
+    stan::io::stan_csv expected = stan::io::stan_csv_reader::parse(in, 0);
+    EXPECT_TRUE(expected.header == csvs[n].header);
+    EXPECT_TRUE(expected.samples == csvs[n].samples);
+  }
+}
+
+TEST(McmcReadChains, errors) {
+  std::vector<std::string> paths;
+  EXPECT_THROW(stan::mcmc::read_chains(paths, 2, 0), std::invalid_argument);
+
+  paths.push_back("src/test/unit/mcmc/test_csv_files/blocker.1.csv");
+  paths.push_back("src/test/unit/mcmc/test_csv_files/no_such_file.csv");
+  EXPECT_THROW(stan::mcmc::read_chains(paths, 2, 0), std::invalid_argument);
+
+  paths[1] = "src/test/unit/mcmc/test_csv_files/epil.1.csv";
+  EXPECT_THROW(stan::mcmc::read_chains(paths, 2, 0), std::invalid_argument);
+}
@@ -0,0 +1,79 @@
+#include <stan/mcmc/streaming_chains.hpp>
+#include <stan/mcmc/chains.hpp>
+#include <stan/io/stan_csv_reader.hpp>
+#include <gtest/gtest.h>
+#include <fstream>
+#include <stdexcept>
+#include <string>
+#include <vector>
+
+class McmcStreamingChains : public testing::Test {
+public:
+  void SetUp() {
+    std::ifstream blocker1_stream(
+        "src/test/unit/mcmc/test_csv_files/blocker.1.csv");
+    std::ifstream blocker2_stream(
+        "src/test/unit/mcmc/test_csv_files/blocker.2.csv");
+    blocker1 = stan::io::stan_csv_reader::parse(blocker1_stream, 0);
+    blocker2 = stan::io::stan_csv_reader::parse(blocker2_stream, 0);
+  }
+
+  stan::io::stan_csv blocker1;
+  stan::io::stan_csv blocker2;
+};
+
+TEST_F(McmcStreamingChains, add) {
+  stan::mcmc::streaming_chains streaming(blocker1.header);
+  EXPECT_EQ(0, streaming.num_chains());
+  EXPECT_EQ(blocker1.header.size(),
+            static_cast<size_t>(streaming.num_params()));
+  EXPECT_EQ(stan::mcmc::chains<>(blocker1).index("d"),
+            streaming.index("d"));
+
+  streaming.add(1, blocker2.samples);
+  EXPECT_EQ(2, streaming.num_chains());
+  EXPECT_EQ(0, streaming.num_samples(0));
+  EXPECT_EQ(blocker2.samples.rows(), streaming.num_samples(1));
+
+  streaming.add(0, blocker1.samples);
+  EXPECT_EQ(blocker1.samples.rows(), streaming.num_samples(0));
+  EXPECT_EQ(blocker1.samples.rows() + blocker2.samples.rows(),
+            streaming.num_samples());
+
+  EXPECT_THROW(streaming.add(0, Eigen::VectorXd(2)), std::invalid_argument);
+}
+
+TEST_F(McmcStreamingChains, diagnostics) {
+  stan::mcmc::chains<> chains(blocker1);
+  chains.add(blocker2);
+  stan::mcmc::streaming_chains streaming(blocker1.header);
+  streaming.add(0, blocker1.samples);
+  streaming.add(1, blocker2.samples);
+
+  for (int index = 4; index < chains.num_params(); ++index) {
+    EXPECT_FLOAT_EQ(chains.mean(0, index), streaming.mean(0, index));
+    EXPECT_FLOAT_EQ(chains.mean(index), streaming.mean(index));
+    EXPECT_FLOAT_EQ(chains.sd(1, index), streaming.sd(1, index));
+    EXPECT_FLOAT_EQ(chains.sd(index), streaming.sd(index));
+
+    // the rank error of the sketches is about one percent
+    double sd = chains.sd(index);
+    EXPECT_NEAR(chains.quantile(index, 0.1),
+                streaming.quantile(index, 0.1), 0.1 * sd);
+    EXPECT_NEAR(chains.quantile(index, 0.5),
+                streaming.quantile(index, 0.5), 0.1 * sd);
+    EXPECT_NEAR(chains.quantile(index, 0.9),
+                streaming.quantile(index, 0.9), 0.1 * sd);
+
+    EXPECT_NEAR(chains.split_potential_scale_reduction(index),
+                streaming.split_potential_scale_reduction(index), 0.02);
+
+    // batch means and autocorrelations are different estimators
+    double ess = chains.effective_sample_size(index);
+    EXPECT_GT(streaming.effective_sample_size(index), ess / 4);
+    EXPECT_LT(streaming.effective_sample_size(index), ess * 4);
+  }
+
+  EXPECT_FLOAT_EQ(chains.mean("d"), streaming.mean("d"));
+  EXPECT_FLOAT_EQ(chains.sd("d"), streaming.sd("d"));
+}
@@ -0,0 +1,36 @@
+#include <stan/mcmc/summarize_chains.hpp>
+#include <stan/mcmc/read_chains.hpp>
+#include <gtest/gtest.h>
+#include <cmath>
+#include <string>
+#include <vector>
+
+TEST(McmcSummarizeChains, blocker) {
+  std::vector<std::string> paths;
+  paths.push_back("src/test/unit/mcmc/test_csv_files/blocker.1.csv");
+  paths.push_back("src/test/unit/mcmc/test_csv_files/blocker.2.csv");
+  stan::mcmc::chains<> chains = stan::mcmc::read_chains(paths, 1, 0);
+
+  Eigen::VectorXd probs(3);
+  probs << 0.05, 0.5, 0.95;
+  Eigen::MatrixXd serial = stan::mcmc::summarize_chains(chains, probs, 1);
+  Eigen::MatrixXd parallel = stan::mcmc::summarize_chains(chains, probs, 4);
+  ASSERT_EQ(chains.num_params(), serial.rows());
+  ASSERT_EQ(8, serial.cols());
+  EXPECT_TRUE(serial == parallel);
+
+  for (int index = 4; index < chains.num_params(); ++index) {
+    double n_eff = chains.effective_sample_size(index);
+    EXPECT_EQ(chains.mean(index), serial(index, 0));
+    EXPECT_EQ(chains.sd(index) / std::sqrt(n_eff), serial(index, 1));
+    EXPECT_EQ(chains.sd(index), serial(index, 2));
+    for (int k = 0; k < probs.size(); ++k)
+      EXPECT_EQ(chains.quantile(index, probs(k)), serial(index, 3 + k));
+    EXPECT_EQ(n_eff, serial(index, 6));
+    EXPECT_EQ(chains.split_potential_scale_reduction(index),
+              serial(index, 7));
+  }
+
+  Eigen::VectorXd no_probs(0);
+  EXPECT_EQ(5, stan::mcmc::summarize_chains(chains, no_probs, 2).cols());
+}
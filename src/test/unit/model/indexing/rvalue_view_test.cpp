@@ -0,0 +1,104 @@
+#include <stdexcept>
+#include <vector>
+#include <stan/model/indexing/rvalue.hpp>
+#include <stan/model/indexing/rvalue_view.hpp>
+#include <gtest/gtest.h>
+
+using stan::model::index_list;
+using stan::model::index_uni;
+using stan::model::index_omni;
+using stan::model::index_min;
+using stan::model::index_max;
+using stan::model::index_min_max;
+using stan::model::rvalue;
+using stan::model::rvalue_view;
+using stan::model::assign_view;
+using Eigen::MatrixXd;
+using Eigen::VectorXd;
+using Eigen::RowVectorXd;
+
+template <typename C, typename I>
+void test_view_matches_rvalue(const C& c, const I& idxs) {
+  MatrixXd copied = rvalue(c, idxs);
+  MatrixXd viewed = rvalue_view(c, idxs);
+  ASSERT_EQ(copied.rows(), viewed.rows());
+  ASSERT_EQ(copied.cols(), viewed.cols());
+  for (int i = 0; i < copied.size(); ++i)
+    EXPECT_FLOAT_EQ(copied(i), viewed(i));
+}
+
+template <typename C, typename I>
+void test_view_out_of_range(const C& c, const I& idxs) {
+  EXPECT_THROW(rvalue_view(c, idxs), std::out_of_range);
+}
+
+TEST(ModelIndexing, rvalueViewVector) {
+  VectorXd v(5);
+  v << 1, 2, 3, 4, 5;
+  test_view_matches_rvalue(v, index_list(index_omni()));
+  test_view_matches_rvalue(v, index_list(index_min(2)));
+  test_view_matches_rvalue(v, index_list(index_max(3)));
+  test_view_matches_rvalue(v, index_list(index_min_max(2, 4)));
+  EXPECT_EQ(0, rvalue_view(v, index_list(index_min_max(4, 2))).size());
+  EXPECT_EQ(0, rvalue_view(v, index_list(index_min(6))).size());
+
+  // view shares storage
+  EXPECT_EQ(&v(1), rvalue_view(v, index_list(index_min_max(2, 4))).data());
+
+  test_view_out_of_range(v, index_list(index_min_max(0, 2)));
+  test_view_out_of_range(v, index_list(index_min_max(4, 6)));
+  test_view_out_of_range(v, index_list(index_max(6)));
+  test_view_out_of_range(v, index_list(index_min(0)));
+}
+
+TEST(ModelIndexing, rvalueViewRowVector) {
+  RowVectorXd rv(4);
+  rv << 1, 2, 3, 4;
+  test_view_matches_rvalue(rv, index_list(index_omni()));
+  test_view_matches_rvalue(rv, index_list(index_min(3)));
+  test_view_matches_rvalue(rv, index_list(index_min_max(1, 2)));
+  test_view_out_of_range(rv, index_list(index_min_max(3, 5)));
+}
+
+TEST(ModelIndexing, rvalueViewMatrix) {
+  MatrixXd m(3, 4);
+  m << 1, 2, 3, 4,
+       5, 6, 7, 8,
+       9, 10, 11, 12;
+  test_view_matches_rvalue(m, index_list(index_uni(2)));
+  test_view_matches_rvalue(m, index_list(index_min_max(2, 3)));
+  test_view_matches_rvalue(m, index_list(index_uni(3), index_min(2)));
+  test_view_matches_rvalue(m, index_list(index_max(2), index_uni(4)));
+  test_view_matches_rvalue(m, index_list(index_omni(), index_uni(1)));
+  test_view_matches_rvalue(m, index_list(index_min_max(2, 3),
+                                         index_min_max(2, 4)));
+  test_view_matches_rvalue(m, index_list(index_omni(), index_omni()));
+
+  test_view_out_of_range(m, index_list(index_uni(4)));
+  test_view_out_of_range(m, index_list(index_min_max(2, 4)));
+  test_view_out_of_range(m, index_list(index_uni(0), index_omni()));
+  test_view_out_of_range(m, index_list(index_uni(1), index_min_max(3, 5)));
+  test_view_out_of_range(m, index_list(index_omni(), index_uni(5)));
+  test_view_out_of_range(m, index_list(index_min(0), index_omni()));
+}
+
+TEST(ModelIndexing, assignView) {
+  MatrixXd m(3, 4);
+  m << 1, 2, 3, 4,
+       5, 6, 7, 8,
+       9, 10, 11, 12;
+
+  VectorXd x(2);
+  assign_view(x, rvalue_view(m, index_list(index_min(2), index_uni(3))));
+  EXPECT_FLOAT_EQ(7, x(0));
+  EXPECT_FLOAT_EQ(11, x(1));
+
+  MatrixXd y(2, 2);
+  assign_view(y, rvalue_view(m, index_list(index_max(2), index_min(3))));
+  EXPECT_FLOAT_EQ(3, y(0, 0));
+  EXPECT_FLOAT_EQ(8, y(1, 1));
+
+  RowVectorXd z(3);
+  EXPECT_THROW(assign_view(z, rvalue_view(m, index_list(index_uni(1)))),
+               std::invalid_argument);
+}
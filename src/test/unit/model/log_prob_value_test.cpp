@@ -0,0 +1,36 @@
+#include <stan/model/log_prob_value.hpp>
+#include <test/test-models/good/model/valid.hpp>
+#include <test/unit/model/test_model.hpp>
+#include <test/unit/util.hpp>
+#include <gtest/gtest.h>
+
+TEST(ModelUtil, logProbValueGenerated) {
+  std::fstream data_stream(std::string("").c_str(), std::fstream::in);
+  stan::io::dump data_var_context(data_stream);
+  data_stream.close();
+
+  stan_model model(data_var_context, static_cast<std::stringstream*>(0));
+  EXPECT_TRUE(stan::model::has_log_prob_value<stan_model>::value);
+
+  std::vector<double> params_r(1, 1.5);
+  std::vector<int> params_i(0);
+  EXPECT_FLOAT_EQ(model.log_prob<false, true>(params_r, params_i, 0),
+                  (stan::model::log_prob_value<false, true>(model, params_r,
+                                                            params_i, 0)));
+
+  Eigen::VectorXd p(1);
+  p << 1.5;
+  EXPECT_FLOAT_EQ(model.log_prob<false, true>(p, 0),
+                  (stan::model::log_prob_value<false, true>(model, p, 0)));
+}
+
+TEST(ModelUtil, logProbValueFallback) {
+  TestModel_uniform_01 model;
+  EXPECT_FALSE(stan::model::has_log_prob_value<TestModel_uniform_01>::value);
+
+  std::vector<double> params_r(1, 0.5);
+  std::vector<int> params_i(0);
+  EXPECT_FLOAT_EQ(model.log_prob<false, true>(params_r, params_i, 0),
+                  (stan::model::log_prob_value<false, true>(model, params_r,
+                                                            params_i, 0)));
+}
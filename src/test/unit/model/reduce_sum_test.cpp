@@ -0,0 +1,175 @@
+#include <stan/math.hpp>
+#include <stan/model/reduce_sum.hpp>
+#include <gtest/gtest.h>
+#include <cstdlib>
+#include <ostream>
+#include <sstream>
+#include <stdexcept>
+#include <vector>
+
+using stan::math::var;
+
+// sum over positions start:end of the log normal density of x_r
+// without its constant term, as a partial sum function generated
+// by stanc would compute it
+struct normal_partial_sum {
+  template <typename T>
+  T operator()(const int& start, const int& end,
+               const Eigen::Matrix<T, Eigen::Dynamic, 1>& theta,
+               const std::vector<double>& x_r,
+               const std::vector<int>& x_i, std::ostream* msgs) const {
+    T lp(0);
+    for (int n = start; n <= end; ++n) {
+      T z = (x_r[n - 1] - theta(0)) / theta(1);
+      lp -= 0.5 * (z * z) + log(theta(1));
+    }
+    return lp;
+  }
+};
+
+struct throwing_partial_sum {
+  template <typename T>
+  T operator()(const int& start, const int& end,
+               const Eigen::Matrix<T, Eigen::Dynamic, 1>& theta,
+               const std::vector<double>& x_r,
+               const std::vector<int>& x_i, std::ostream* msgs) const {
+    if (start <= 7 && 7 <= end)
+      throw std::domain_error("position 7");
+    return T(0);
+  }
+};
+
+struct printing_partial_sum {
+  template <typename T>
+  T operator()(const int& start, const int& end,
+               const Eigen::Matrix<T, Eigen::Dynamic, 1>& theta,
+               const std::vector<double>& x_r,
+               const std::vector<int>& x_i, std::ostream* msgs) const {
+    for (int n = start; n <= end; ++n) {
+      if (msgs)
+        *msgs << n << ";";
+      if (n == 9)
+        throw std::domain_error("position 9");
+    }
+    return T(end - start + 1);
+  }
+};
+
+// reduce_sum reads STAN_NUM_THREADS once, so set it before any test
+const int reduce_sum_test_env = setenv("STAN_NUM_THREADS", "3", 1);
+
+std::vector<double> reduce_sum_data(int n) {
+  std::vector<double> x_r;
+  for (int i = 0; i < n; ++i)
+    x_r.push_back(0.1 * i - 0.3 * (i % 4));
+  return x_r;
+}
+
+TEST(ModelUtil, reduceSumNumThreads) {
+  EXPECT_EQ(3, stan::model::reduce_sum_num_threads());
+  setenv("STAN_NUM_THREADS", "5", 1);
+  EXPECT_EQ(3, stan::model::reduce_sum_num_threads());
+
+  EXPECT_EQ(1, stan::model::reduce_sum_parse_num_threads(0));
+  EXPECT_EQ(4, stan::model::reduce_sum_parse_num_threads("4"));
+  EXPECT_EQ(1, stan::model::reduce_sum_parse_num_threads("0"));
+  EXPECT_EQ(1, stan::model::reduce_sum_parse_num_threads("-3"));
+  EXPECT_EQ(1, stan::model::reduce_sum_parse_num_threads("abc"));
+  EXPECT_LE(1, stan::model::reduce_sum_parse_num_threads("-1"));
+}
+
+TEST(ModelUtil, reduceSumDouble) {
+  std::vector<double> x_r = reduce_sum_data(23);
+  std::vector<int> x_i;
+  Eigen::VectorXd theta(2);
+  theta << 0.4, 1.3;
+  double expected
+    = normal_partial_sum()(1, 23, theta, x_r, x_i, 0);
+
+  for (int grainsize = 1; grainsize < 30; grainsize += 4)
+    EXPECT_FLOAT_EQ(expected,
+                    stan::model::reduce_sum(normal_partial_sum(), 23,
+                                            grainsize, theta, x_r, x_i, 0));
+
+  EXPECT_FLOAT_EQ(0, stan::model::reduce_sum(normal_partial_sum(), 0, 5,
+                                             theta, x_r, x_i, 0));
+}
+
+TEST(ModelUtil, reduceSumVar) {
+  std::vector<double> x_r = reduce_sum_data(23);
+  std::vector<int> x_i;
+  double mu = 0.4;
+  double sigma = 1.3;
+  double dmu = 0;
+  double dsigma = 0;
+  for (size_t n = 0; n < x_r.size(); ++n) {
+    double z = (x_r[n] - mu) / sigma;
+    dmu += z / sigma;
+    dsigma += z * z / sigma - 1 / sigma;
+  }
+  Eigen::VectorXd theta_val(2);
+  theta_val << mu, sigma;
+  double expected = normal_partial_sum()(1, 23, theta_val, x_r, x_i, 0);
+
+  Eigen::Matrix<var, Eigen::Dynamic, 1> theta(2);
+  theta << mu, sigma;
+  var lp = stan::model::reduce_sum(normal_partial_sum(), 23, 5, theta,
+                                   x_r, x_i, 0);
+  EXPECT_FLOAT_EQ(expected, lp.val());
+  stan::math::grad(lp.vi_);
+  EXPECT_FLOAT_EQ(dmu, theta(0).adj());
+  EXPECT_FLOAT_EQ(dsigma, theta(1).adj());
+  stan::math::recover_memory();
+}
+
+TEST(ModelUtil, reduceSumThrows) {
+  std::vector<double> x_r = reduce_sum_data(10);
+  std::vector<int> x_i;
+  Eigen::VectorXd theta(2);
+  theta << 0.4, 1.3;
+  EXPECT_THROW(stan::model::reduce_sum(normal_partial_sum(), -1, 5, theta,
+                                       x_r, x_i, 0),
+               std::domain_error);
+  EXPECT_THROW(stan::model::reduce_sum(normal_partial_sum(), 10, 0, theta,
+                                       x_r, x_i, 0),
+               std::domain_error);
+  EXPECT_THROW(stan::model::reduce_sum(throwing_partial_sum(), 10, 3, theta,
+                                       x_r, x_i, 0),
+               std::domain_error);
+
+  Eigen::Matrix<var, Eigen::Dynamic, 1> theta_var(2);
+  theta_var << 0.4, 1.3;
+  EXPECT_THROW(stan::model::reduce_sum(throwing_partial_sum(), 10, 3,
+                                       theta_var, x_r, x_i, 0),
+               std::domain_error);
+  stan::math::recover_memory();
+}
+
+TEST(ModelUtil, reduceSumMessages) {
+  std::vector<double> x_r;
+  std::vector<int> x_i;
+  Eigen::VectorXd theta(1);
+  theta << 0.4;
+  std::stringstream msgs;
+  EXPECT_FLOAT_EQ(8, stan::model::reduce_sum(printing_partial_sum(), 8, 1,
+                                             theta, x_r, x_i, &msgs));
+  EXPECT_EQ("1;2;3;4;5;6;7;8;", msgs.str());
+  EXPECT_FLOAT_EQ(8, stan::model::reduce_sum(printing_partial_sum(), 8, 3,
+                                             theta, x_r, x_i, 0));
+
+  Eigen::Matrix<var, Eigen::Dynamic, 1> theta_var(1);
+  theta_var << 0.4;
+  msgs.str("");
+  EXPECT_FLOAT_EQ(8, stan::model::reduce_sum(printing_partial_sum(), 8, 3,
+                                             theta_var, x_r, x_i, &msgs)
+                  .val());
+  EXPECT_EQ("1;2;3;4;5;6;7;8;", msgs.str());
+
+  // messages of the chunks before the last, which throws, are kept
+  msgs.str("");
+  EXPECT_THROW(stan::model::reduce_sum(printing_partial_sum(), 10, 2,
+                                       theta_var, x_r, x_i, &msgs),
+               std::domain_error);
+  EXPECT_EQ("1;2;3;4;5;6;7;8;9;", msgs.str());
+  stan::math::recover_memory();
+}
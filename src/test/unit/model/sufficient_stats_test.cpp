@@ -0,0 +1,176 @@
+#include <stan/math.hpp>
+#include <stan/model/sufficient_stats.hpp>
+#include <gtest/gtest.h>
+#include <limits>
+#include <stdexcept>
+#include <vector>
+
+using stan::math::var;
+
+TEST(ModelUtil, sufficientStats) {
+  Eigen::VectorXd y(4);
+  y << 1, 2, 4, 9;
+  EXPECT_FLOAT_EQ(4, stan::model::sufficient_mean(y));
+  EXPECT_FLOAT_EQ(38, stan::model::sufficient_sq_dev(y));
+
+  std::vector<int> n;
+  n.push_back(3);
+  n.push_back(0);
+  n.push_back(5);
+  EXPECT_FLOAT_EQ(std::log(6.0) + std::log(120.0),
+                  stan::model::sufficient_log_factorial(n));
+  EXPECT_FLOAT_EQ(8, stan::model::sufficient_sum(n));
+  EXPECT_EQ(0, stan::model::sufficient_min(n));
+  EXPECT_EQ(5, stan::model::sufficient_max(n));
+
+  std::vector<double> empty;
+  EXPECT_FLOAT_EQ(0, stan::model::sufficient_mean(empty));
+  EXPECT_FLOAT_EQ(0, stan::model::sufficient_sq_dev(empty));
+  EXPECT_EQ(0, stan::model::sufficient_min(std::vector<int>()));
+  EXPECT_FLOAT_EQ(0, stan::model::sufficient_sum(std::vector<int>()));
+}
+
+TEST(ModelUtil, normalSufficientLog) {
+  using stan::model::normal_sufficient_log;
+  std::vector<double> y;
+  y.push_back(-0.3);
+  y.push_back(1.7);
+  y.push_back(2.2);
+  y.push_back(0.9);
+  int n = y.size();
+  double y_bar = stan::model::sufficient_mean(y);
+  double ss = stan::model::sufficient_sq_dev(y);
+
+  EXPECT_FLOAT_EQ(stan::math::normal_log<false>(y, 0.4, 1.3),
+                  normal_sufficient_log<false>(n, y_bar, ss, 0.4, 1.3));
+  EXPECT_FLOAT_EQ(0, normal_sufficient_log<true>(n, y_bar, ss, 0.4, 1.3));
+
+  var mu = 0.4;
+  var sigma = 1.3;
+  EXPECT_FLOAT_EQ(stan::math::normal_log<true>(y, mu, sigma).val(),
+                  normal_sufficient_log<true>(n, y_bar, ss, mu, sigma)
+                  .val());
+  EXPECT_FLOAT_EQ(stan::math::normal_log<true>(y, mu, 1.3).val(),
+                  normal_sufficient_log<true>(n, y_bar, ss, mu, 1.3).val());
+
+  EXPECT_FLOAT_EQ(0, normal_sufficient_log<false>(0, 0, 0, 0.4, 1.3));
+  EXPECT_THROW(normal_sufficient_log<false>(n, y_bar, ss, 0.4, -1),
+               std::domain_error);
+}
+
+TEST(ModelUtil, normalSufficientLogEmpty) {
+  using stan::model::normal_sufficient_log;
+  std::vector<double> empty;
+  double y_bar = stan::model::sufficient_mean(empty);
+  double ss = stan::model::sufficient_sq_dev(empty);
+  double nan = std::numeric_limits<double>::quiet_NaN();
+
+  // as for normal_log, parameters are not checked without data
+  EXPECT_FLOAT_EQ(stan::math::normal_log<false>(empty, nan, -1),
+                  normal_sufficient_log<false>(0, y_bar, ss, nan, -1));
+  EXPECT_FLOAT_EQ(0, normal_sufficient_log<false>(0, nan, nan, 0.4, 1.3));
+}
+
+TEST(ModelUtil, normalSufficientLogInfinite) {
+  using stan::model::normal_sufficient_log;
+  double inf = std::numeric_limits<double>::infinity();
+  std::vector<double> y;
+  y.push_back(0.5);
+  y.push_back(inf);
+  y.push_back(1.5);
+  int n = y.size();
+  double y_bar = stan::model::sufficient_mean(y);
+  double ss = stan::model::sufficient_sq_dev(y);
+  EXPECT_FLOAT_EQ(inf, ss);
+
+  EXPECT_FLOAT_EQ(stan::math::normal_log<false>(y, 0.4, 1.3),
+                  normal_sufficient_log<false>(n, y_bar, ss, 0.4, 1.3));
+  EXPECT_FLOAT_EQ(-inf, normal_sufficient_log<false>(n, y_bar, ss, 0.4,
+                                                     1.3));
+  var mu = 0.4;
+  EXPECT_FLOAT_EQ(stan::math::normal_log<true>(y, mu, 1.3).val(),
+                  normal_sufficient_log<true>(n, y_bar, ss, mu, 1.3).val());
+
+  // infinities of both signs
+  y.push_back(-inf);
+  y_bar = stan::model::sufficient_mean(y);
+  ss = stan::model::sufficient_sq_dev(y);
+  EXPECT_FLOAT_EQ(stan::math::normal_log<false>(y, 0.4, 1.3),
+                  normal_sufficient_log<false>(n + 1, y_bar, ss, 0.4, 1.3));
+
+  y.push_back(std::numeric_limits<double>::quiet_NaN());
+  y_bar = stan::model::sufficient_mean(y);
+  ss = stan::model::sufficient_sq_dev(y);
+  EXPECT_THROW(stan::math::normal_log<false>(y, 0.4, 1.3),
+               std::domain_error);
+  EXPECT_THROW(normal_sufficient_log<false>(n + 2, y_bar, ss, 0.4, 1.3),
+               std::domain_error);
+}
+
+TEST(ModelUtil, poissonSufficientLog) {
+  using stan::model::poisson_sufficient_log;
+  std::vector<int> y;
+  y.push_back(3);
+  y.push_back(0);
+  y.push_back(5);
+  y.push_back(1);
+  int n = y.size();
+  double sum = stan::model::sufficient_sum(y);
+  double log_factorial = stan::model::sufficient_log_factorial(y);
+  int min = stan::model::sufficient_min(y);
+
+  EXPECT_FLOAT_EQ(stan::math::poisson_log<false>(y, 2.5),
+                  poisson_sufficient_log<false>(n, sum, log_factorial, min,
+                                                2.5));
+  var lambda = 2.5;
+  EXPECT_FLOAT_EQ(stan::math::poisson_log<true>(y, lambda).val(),
+                  poisson_sufficient_log<true>(n, sum, log_factorial, min,
+                                               lambda).val());
+
+  EXPECT_FLOAT_EQ(stan::math::poisson_log<false>(y, 0.0),
+                  poisson_sufficient_log<false>(n, sum, log_factorial, min,
+                                                0.0));
+  EXPECT_THROW(poisson_sufficient_log<false>(n, sum, log_factorial, -1,
+                                             2.5),
+               std::domain_error);
+}
+
+TEST(ModelUtil, poissonSufficientLogLargeSum) {
+  using stan::model::poisson_sufficient_log;
+  // the sum of the counts does not fit in an int
+  std::vector<int> y(3, std::numeric_limits<int>::max() - 5);
+  int n = y.size();
+  double sum = stan::model::sufficient_sum(y);
+  EXPECT_FLOAT_EQ(3.0 * (std::numeric_limits<int>::max() - 5), sum);
+  double log_factorial = stan::model::sufficient_log_factorial(y);
+  int min = stan::model::sufficient_min(y);
+
+  EXPECT_FLOAT_EQ(stan::math::poisson_log<false>(y, 2e9),
+                  poisson_sufficient_log<false>(n, sum, log_factorial, min,
+                                                2e9));
+  var lambda = 2e9;
+  EXPECT_FLOAT_EQ(stan::math::poisson_log<true>(y, lambda).val(),
+                  poisson_sufficient_log<true>(n, sum, log_factorial, min,
+                                               lambda).val());
+}
+
+TEST(ModelUtil, bernoulliSufficientLog) {
+  using stan::model::bernoulli_sufficient_log;
+  std::vector<int> y;
+  y.push_back(1);
+  y.push_back(0);
+  y.push_back(1);
+  int n = y.size();
+
+  EXPECT_FLOAT_EQ(stan::math::bernoulli_log<false>(y, 0.3),
+                  bernoulli_sufficient_log<false>(n, 2, 0, 1, 0.3));
+  var theta = 0.3;
+  EXPECT_FLOAT_EQ(stan::math::bernoulli_log<true>(y, theta).val(),
+                  bernoulli_sufficient_log<true>(n, 2, 0, 1, theta).val());
+
+  std::vector<int> ones(3, 1);
+  EXPECT_FLOAT_EQ(stan::math::bernoulli_log<false>(ones, 0.3),
+                  bernoulli_sufficient_log<false>(n, 3, 1, 1, 0.3));
+  EXPECT_THROW(bernoulli_sufficient_log<false>(n, 2, 0, 2, 0.3),
+               std::domain_error);
+}
@@ -0,0 +1,25 @@
+#include <stan/model/value_accumulator.hpp>
+#include <gtest/gtest.h>
+#include <vector>
+
+TEST(ModelUtil, valueAccumulator) {
+  stan::model::value_accumulator acc;
+  EXPECT_FLOAT_EQ(0, acc.sum());
+
+  acc.add(1.5);
+  acc.add(2);
+  EXPECT_FLOAT_EQ(3.5, acc.sum());
+
+  Eigen::VectorXd v(3);
+  v << 1, 2, 3;
+  acc.add(v);
+  acc.add(2 * v);
+  EXPECT_FLOAT_EQ(21.5, acc.sum());
+
+  std::vector<Eigen::VectorXd> vs(2, v);
+  acc.add(vs);
+  acc.add(std::vector<double>(4, 0.25));
+  EXPECT_FLOAT_EQ(34.5, acc.sum());
+
+  EXPECT_FLOAT_EQ(35.5, stan::model::get_lp(1.0, acc));
+}
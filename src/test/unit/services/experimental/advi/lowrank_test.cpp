@@ -0,0 +1,72 @@
+#include <stan/services/experimental/advi/lowrank.hpp>
+#include <gtest/gtest.h>
+#include <stan/io/empty_var_context.hpp>
+#include <test/test-models/good/services/test_lp.hpp>
+#include <test/unit/services/instrumented_callbacks.hpp>
+
+class ServicesExperimentalAdviLowrank : public testing::Test {
+public:
+  ServicesExperimentalAdviLowrank()
+    : model(context, &model_log) {}
+
+  std::stringstream model_log;
+  stan::test::unit::instrumented_writer init, parameter, diagnostic;
+  stan::test::unit::instrumented_logger logger;
+  stan::io::empty_var_context context;
+  stan::test::unit::instrumented_interrupt interrupt;
+  stan_model model;
+};
+
+TEST_F(ServicesExperimentalAdviLowrank, lowrank) {
+  unsigned int seed = 0;
+  unsigned int chain = 1;
+  double init_radius = 0;
+  int grad_samples = 1;
+  int elbo_samples = 100;
+  int max_iterations = 10000;
+  double tol_rel_obj = 0.01;
+  double eta = 1.0;
+  bool adapt_engaged = true;
+  int adapt_iterations = 50;
+  int eval_elbo = 100;
+  int output_samples = 1000;
+  int rank = 1;
+  int num_threads = 1;
+
+  int return_code = stan::services::experimental::advi
+    ::lowrank(model, context,
+              seed, chain, init_radius,
+              grad_samples, elbo_samples,
+              max_iterations, tol_rel_obj,
+              eta, adapt_engaged,
+              adapt_iterations,
+              eval_elbo, output_samples,
+              rank, num_threads,
+              interrupt,
+              logger, init, parameter, diagnostic);
+  EXPECT_EQ(0, return_code);
+
+  EXPECT_EQ(1, logger.find_info("EXPERIMENTAL ALGORITHM"))
+    << "Missing experimental algorithm message";
+
+  ASSERT_EQ(1, init.vector_double_values().size());
+  ASSERT_EQ(2, init.vector_double_values().at(0).size());
+  std::vector<double> init_values = init.vector_double_values().at(0);
+  EXPECT_FLOAT_EQ(0, init_values[0]);
+  EXPECT_FLOAT_EQ(0, init_values[1]);
+
+  ASSERT_EQ(output_samples + 1, parameter.vector_double_values().size());
+  ASSERT_EQ(eval_elbo, diagnostic.vector_double_values().size());
+
+  EXPECT_EQ(0, interrupt.call_count());
+}
+
+TEST_F(ServicesExperimentalAdviLowrank, bad_rank) {
+  int return_code = stan::services::experimental::advi
+    ::lowrank(model, context, 0, 1, 0, 1, 100, 10000, 0.01, 1.0, true, 50,
+              100, 1000, 0, 1, interrupt, logger, init, parameter,
+              diagnostic);
+  EXPECT_EQ(stan::services::error_codes::CONFIG, return_code);
+  EXPECT_EQ(1, logger.call_count_error());
+  EXPECT_EQ(0, parameter.vector_double_values().size());
+}
@@ -0,0 +1,86 @@
+#include <stan/services/optimize/laplace_sample.hpp>
+#include <gtest/gtest.h>
+#include <stan/io/array_var_context.hpp>
+#include <stan/io/empty_var_context.hpp>
+#include <test/test-models/good/mcmc/hmc/common/gauss3D.hpp>
+#include <test/unit/services/instrumented_callbacks.hpp>
+
+class ServicesOptimizeLaplaceSample : public testing::Test {
+public:
+  ServicesOptimizeLaplaceSample()
+    : mode(mode_names(), std::vector<double>(3, 0.0), mode_dims()),
+      model(context, &model_ss) {}
+
+  static std::vector<std::string> mode_names() {
+    return std::vector<std::string>(1, "x");
+  }
+
+  static std::vector<std::vector<size_t> > mode_dims() {
+    return std::vector<std::vector<size_t> >(1, std::vector<size_t>(1, 3));
+  }
+
+  std::stringstream model_ss;
+  stan::test::unit::instrumented_interrupt interrupt;
+  stan::test::unit::instrumented_logger logger;
+  stan::test::unit::instrumented_writer sample;
+  stan::io::array_var_context mode;
+  stan::io::empty_var_context context;
+  stan_model model;
+};
+
+TEST_F(ServicesOptimizeLaplaceSample, gauss3D) {
+  int num_draws = 2000;
+  int return_code
+    = stan::services::optimize::laplace_sample(model, mode, num_draws,
+                                               12345, 1, 1,
+                                               interrupt, logger, sample);
+  EXPECT_EQ(stan::services::error_codes::OK, return_code);
+  EXPECT_EQ(0, logger.call_count_error());
+
+  std::vector<std::vector<std::string> > names = sample.vector_string_values();
+  ASSERT_EQ(1, names.size());
+  ASSERT_EQ(5, names[0].size());
+  EXPECT_EQ("log_p__", names[0][0]);
+  EXPECT_EQ("log_g__", names[0][1]);
+  EXPECT_EQ("x.1", names[0][2]);
+
+  std::vector<std::vector<double> > draws = sample.vector_double_values();
+  ASSERT_EQ(num_draws, draws.size());
+  for (int i = 2; i < 5; ++i) {
+    double mean = 0;
+    double sq = 0;
+    for (size_t n = 0; n < draws.size(); ++n) {
+      mean += draws[n][i] / num_draws;
+      sq += draws[n][i] * draws[n][i] / num_draws;
+    }
+    EXPECT_NEAR(0, mean, 0.1);
+    EXPECT_NEAR(1, sq - mean * mean, 0.1);
+  }
+  // the approximation is exact for a standard normal
+  for (size_t n = 0; n < draws.size(); ++n)
+    EXPECT_NEAR(draws[n][0] - draws[0][0], draws[n][1] - draws[0][1], 1e-8);
+}
+
+TEST_F(ServicesOptimizeLaplaceSample, thread_count_invariant) {
+  stan::test::unit::instrumented_writer sample_threaded;
+  stan::services::optimize::laplace_sample(model, mode, 300, 12345, 1, 1,
+                                           interrupt, logger, sample);
+  stan::services::optimize::laplace_sample(model, mode, 300, 12345, 1, 4,
+                                           interrupt, logger,
+                                           sample_threaded);
+  std::vector<std::vector<double> > draws = sample.vector_double_values();
+  std::vector<std::vector<double> > draws_threaded
+    = sample_threaded.vector_double_values();
+  ASSERT_EQ(draws.size(), draws_threaded.size());
+  for (size_t n = 0; n < draws.size(); ++n)
+    for (size_t i = 0; i < draws[n].size(); ++i)
+      EXPECT_FLOAT_EQ(draws[n][i], draws_threaded[n][i]);
+}
+
+TEST_F(ServicesOptimizeLaplaceSample, bad_num_draws) {
+  int return_code
+    = stan::services::optimize::laplace_sample(model, mode, 0, 12345, 1, 1,
+                                               interrupt, logger, sample);
+  EXPECT_EQ(stan::services::error_codes::CONFIG, return_code);
+  EXPECT_EQ(1, logger.call_count_error());
+}
@@ -158,3 +158,116 @@ TEST_F(ServicesStandaloneGQ, genDraws_too_many_params) {
   EXPECT_EQ(return_code, stan::services::error_codes::DATAERR);
   EXPECT_EQ(count_matches("Wrong number of params",logger_ss.str()),1);
 }
+
+TEST_F(ServicesStandaloneGQ, genDraws_parallel) {
+  std::vector<std::vector<double> > draws;
+  for (int n = 0; n < 300; ++n) {
+    std::vector<double> draw;
+    draw.push_back(-2.345 + 0.01 * n);
+    draw.push_back(-6.789 + 0.01 * n);
+    draws.push_back(draw);
+  }
+  const std::vector<std::vector<double> > cdraws(draws);
+  stan::callbacks::stream_logger logger(logger_ss,
+                                        logger_ss,
+                                        logger_ss,
+                                        logger_ss,
+                                        logger_ss);
+
+  std::stringstream serial_ss;
+  stan::callbacks::stream_writer serial_writer(serial_ss, "");
+  int return_code = stan::services::standalone_generate(model,
+                                                        cdraws,
+                                                        12345,
+                                                        1,
+                                                        interrupt,
+                                                        logger,
+                                                        serial_writer);
+  EXPECT_EQ(return_code, stan::services::error_codes::OK);
+  EXPECT_EQ(count_matches("xgq",serial_ss.str()),1);
+  // 300 draws + 1 header
+  EXPECT_EQ(count_matches("\n",serial_ss.str()),301);
+
+  stan::callbacks::stream_writer sample_writer(sample_ss, "");
+  return_code = stan::services::standalone_generate(model,
+                                                    cdraws,
+                                                    12345,
+                                                    4,
+                                                    interrupt,
+                                                    logger,
+                                                    sample_writer);
+  EXPECT_EQ(return_code, stan::services::error_codes::OK);
+  // output does not depend on the number of threads
+  EXPECT_EQ(serial_ss.str(), sample_ss.str());
+}
+
+TEST_F(ServicesStandaloneGQ, genDraws_parallel_missing_params) {
+  std::vector<double> draw1;
+  draw1.push_back(-2.345);
+  draw1.push_back(-6.789);
+  std::vector<double> draw2;
+  draw2.push_back(-3.123);
+  std::vector<std::vector<double> > draws;
+  draws.push_back(draw1);
+  draws.push_back(draw2);
+  const std::vector<std::vector<double> > cdraws(draws);
+  stan::callbacks::stream_writer sample_writer(sample_ss, "");
+  stan::callbacks::stream_logger logger(logger_ss,
+                                        logger_ss,
+                                        logger_ss,
+                                        logger_ss,
+                                        logger_ss);
+  int return_code = stan::services::standalone_generate(model,
+                                                        cdraws,
+                                                        12345,
+                                                        2,
+                                                        interrupt,
+                                                        logger,
+                                                        sample_writer);
+  EXPECT_EQ(return_code, stan::services::error_codes::DATAERR);
+  EXPECT_EQ(count_matches("Wrong number of params",logger_ss.str()),1);
+  // header and the draw before the wrongly sized one
+  EXPECT_EQ(count_matches("\n",sample_ss.str()),2);
+}
+
+TEST_F(ServicesStandaloneGQ, gqDrawFunctor_batches) {
+  std::vector<std::vector<double> > draws;
+  for (int n = 0; n < 10; ++n) {
+    std::vector<double> draw;
+    draw.push_back(-2.345 + 0.01 * n);
+    draw.push_back(-6.789 + 0.01 * n);
+    draws.push_back(draw);
+  }
+  const std::vector<std::vector<double> > cdraws(draws);
+
+  // one batch of every draw, evaluated in reverse order
+  stan::services::gq_draw_functor<stan_model> all(model, cdraws, 12345, 2,
+                                                  10, 0);
+  for (int n = 9; n >= 0; --n)
+    all(n);
+
+  int offsets[] = {0, 3, 4, 9};
+  for (int b = 0; b < 3; ++b) {
+    int size = offsets[b + 1] - offsets[b];
+    stan::services::gq_draw_functor<stan_model> batch(model, cdraws, 12345,
+                                                      2, size, offsets[b]);
+    for (int n = 0; n < size; ++n)
+      batch(n);
+    for (int n = 0; n < size; ++n) {
+      int draw = offsets[b] + n;
+      // draw n uses substream n of chain 1 whatever the batch
+      boost::ecuyer1988 rng
+        = stan::services::util::create_rng(12345, 1, draw);
+      std::vector<double> expected;
+      std::string messages, error;
+      EXPECT_TRUE(stan::services::util::gq_writer::generate_gq_values(
+          model, rng, cdraws[draw], 2, expected, messages, error));
+      ASSERT_EQ(3U, batch.values_[n].size());
+      EXPECT_TRUE(expected == batch.values_[n]) << "draw " << draw;
+      EXPECT_TRUE(all.values_[draw] == batch.values_[n]) << "draw " << draw;
+      EXPECT_EQ(1, batch.ok_[n]);
+    }
+  }
+  // the y_rep draws of neighbouring draws come from different streams
+  EXPECT_NE(all.values_[0][1], all.values_[1][1]);
+}
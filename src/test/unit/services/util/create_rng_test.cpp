@@ -28,3 +28,15 @@ TEST(rng, initialize_with_zero) {
   rng2();
   EXPECT_NE(rng1, rng2);
 }
+
+TEST(rng, initialize_with_substream) {
+  boost::ecuyer1988 rng1 = stan::services::util::create_rng(0, 1, 0);
+  boost::ecuyer1988 rng2 = stan::services::util::create_rng(0, 1);
+  EXPECT_EQ(rng1, rng2);
+
+  for (unsigned int n = 1; n < 20; n++) {
+    boost::ecuyer1988 rng3 = stan::services::util::create_rng(0, 1, n);
+    EXPECT_NE(rng1, rng3);
+    EXPECT_EQ(rng3, stan::services::util::create_rng(0, 1, n));
+  }
+}
@@ -0,0 +1,51 @@
+#include <stan/services/util/parallel_for.hpp>
+#include <gtest/gtest.h>
+#include <stdexcept>
+#include <vector>
+
+struct square_functor {
+  std::vector<double> x_;
+
+  explicit square_functor(size_t size) : x_(size, 0) { }
+
+  void operator()(size_t n) {
+    x_[n] = static_cast<double>(n) * n;
+  }
+};
+
+struct throwing_functor {
+  void operator()(size_t n) {
+    if (n == 7)
+      throw std::domain_error("index 7");
+  }
+};
+
+TEST(ServicesUtil, parallel_for_serial) {
+  square_functor f(10);
+  stan::services::util::parallel_for(10, 1, f);
+  for (size_t n = 0; n < 10; ++n)
+    EXPECT_FLOAT_EQ(n * n, f.x_[n]);
+}
+
+TEST(ServicesUtil, parallel_for_threads) {
+  for (int num_threads = 2; num_threads < 12; ++num_threads) {
+    square_functor f(10);
+    stan::services::util::parallel_for(10, num_threads, f);
+    for (size_t n = 0; n < 10; ++n)
+      EXPECT_FLOAT_EQ(n * n, f.x_[n]);
+  }
+}
+
+TEST(ServicesUtil, parallel_for_empty) {
+  square_functor f(0);
+  stan::services::util::parallel_for(0, 4, f);
+  EXPECT_EQ(0, f.x_.size());
+}
+
+TEST(ServicesUtil, parallel_for_rethrows) {
+  throwing_functor f;
+  EXPECT_THROW(stan::services::util::parallel_for(10, 1, f),
+               std::domain_error);
+  EXPECT_THROW(stan::services::util::parallel_for(10, 3, f),
+               std::domain_error);
+}
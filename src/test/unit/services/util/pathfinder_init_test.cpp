@@ -0,0 +1,56 @@
+#include <stan/services/util/pathfinder_init.hpp>
+#include <stan/io/empty_var_context.hpp>
+#include <test/test-models/good/mcmc/hmc/common/gauss3D.hpp>
+#include <test/unit/services/instrumented_callbacks.hpp>
+#include <gtest/gtest.h>
+
+class ServicesUtilPathfinderInit : public testing::Test {
+public:
+  ServicesUtilPathfinderInit()
+    : model(context, &model_ss) {}
+
+  std::stringstream model_ss;
+  stan::test::unit::instrumented_logger logger;
+  stan::test::unit::instrumented_writer init;
+  stan::io::empty_var_context context;
+  stan_model model;
+};
+
+TEST_F(ServicesUtilPathfinderInit, gauss3D) {
+  std::vector<double> cont_vector;
+  Eigen::MatrixXd draws;
+  bool ok = stan::services::util::pathfinder_init(model, context, 12345, 1,
+                                                  2, 4, 1, logger, init,
+                                                  cont_vector, draws);
+  ASSERT_TRUE(ok);
+  EXPECT_EQ(0, logger.call_count_error());
+  EXPECT_EQ(4, logger.find_info("Pathfinder path"));
+
+  ASSERT_EQ(3, cont_vector.size());
+  ASSERT_EQ(3, draws.rows());
+  EXPECT_EQ(1000, draws.cols());
+  for (int i = 0; i < 3; ++i)
+    EXPECT_FLOAT_EQ(draws(i, 0), cont_vector[i]);
+  ASSERT_EQ(1, init.call_count("vector_double"));
+
+  // standard normal target
+  Eigen::VectorXd inv_metric
+    = stan::services::util::pathfinder_diag_inv_metric(draws);
+  for (int i = 0; i < 3; ++i) {
+    EXPECT_NEAR(0, draws.row(i).mean(), 0.2);
+    EXPECT_NEAR(1, inv_metric(i), 0.3);
+  }
+  Eigen::MatrixXd dense_inv_metric
+    = stan::services::util::pathfinder_dense_inv_metric(draws);
+  for (int i = 0; i < 3; ++i)
+    EXPECT_FLOAT_EQ(inv_metric(i), dense_inv_metric(i, i));
+}
+
+TEST_F(ServicesUtilPathfinderInit, no_paths) {
+  std::vector<double> cont_vector;
+  Eigen::MatrixXd draws;
+  EXPECT_FALSE(stan::services::util::pathfinder_init(model, context, 12345,
+                                                     1, 2, 0, 1, logger,
+                                                     init, cont_vector,
+                                                     draws));
+}
@@ -0,0 +1,138 @@
+#include <test/test-models/good/variational/multivariate_no_constraint.hpp>
+#include <stan/variational/advi.hpp>
+#include <stan/callbacks/stream_logger.hpp>
+#include <gtest/gtest.h>
+#include <test/unit/util.hpp>
+#include <vector>
+#include <string>
+#include <boost/random/additive_combine.hpp> // L'Ecuyer RNG
+
+typedef boost::ecuyer1988 rng_t;
+typedef multivariate_no_constraint_model_namespace::multivariate_no_constraint_model Model;
+
+class advi_threads_test : public ::testing::Test {
+public:
+  advi_threads_test()
+    : logger(log_stream, log_stream, log_stream, log_stream, log_stream),
+      cont_params(Eigen::VectorXd::Constant(2, 0.75)),
+      mu(Eigen::VectorXd::Constant(2, 2.5)) { }
+
+  void SetUp() {
+    static const std::string DATA = "";
+    std::stringstream data_stream(DATA);
+    stan::io::dump dummy_context(data_stream);
+    model = new Model(dummy_context);
+  }
+
+  void TearDown() {
+    delete model;
+  }
+
+  double elbo(int num_threads) {
+    rng_t base_rng(0);
+    stan::variational::advi<Model, stan::variational::normal_meanfield, rng_t>
+      test_advi(*model, cont_params, base_rng, 10, 10000, 100, 1,
+                num_threads);
+    stan::variational::normal_meanfield q(mu, Eigen::VectorXd::Zero(2));
+    return test_advi.calc_ELBO(q, logger);
+  }
+
+  std::stringstream log_stream;
+  stan::callbacks::stream_logger logger;
+  Model* model;
+  Eigen::VectorXd cont_params;
+  Eigen::VectorXd mu;
+};
+
+TEST_F(advi_threads_test, calc_ELBO) {
+  // Can calculate ELBO analytically, see advi_multivar_no_constraint_test
+  double zeta = -0.5 * ( 3*2*log(2.0*stan::math::pi()) + 18.5 + 25 + 13 );
+  Eigen::VectorXd mu_J = Eigen::VectorXd::Zero(2);
+  mu_J(0) = 10.5;
+  mu_J(1) =  7.5;
+
+  double elbo_true = zeta + mu_J.dot(mu) - 0.5 * ( 3*mu.dot(mu) + 3*2 )
+    + 1 + log(2.0*stan::math::pi());
+
+  EXPECT_NEAR(elbo_true, elbo(1), 0.1);
+  EXPECT_NEAR(elbo_true, elbo(4), 0.1);
+  EXPECT_NEAR(elbo_true, elbo(7), 0.1);
+}
+
+TEST_F(advi_threads_test, calc_ELBO_reproducible) {
+  EXPECT_FLOAT_EQ(elbo(1), elbo(1));
+  EXPECT_FLOAT_EQ(elbo(4), elbo(4));
+}
+
+TEST_F(advi_threads_test, calc_grad) {
+  stan::variational::normal_meanfield q(mu, Eigen::VectorXd::Zero(2));
+  for (int num_threads = 1; num_threads <= 4; num_threads += 3) {
+    rng_t base_rng(0);
+    stan::variational::normal_meanfield elbo_grad(2);
+    q.calc_grad(elbo_grad, *model, cont_params, 10000, base_rng, logger,
+                num_threads);
+
+    // grad log p(z) = mu_J - 3 z, so E[grad] = mu_J - 3 mu and the
+    // omega gradient is 1 - 3 sigma^2
+    EXPECT_NEAR(3.0, elbo_grad.mu()(0), 0.2);
+    EXPECT_NEAR(0.0, elbo_grad.mu()(1), 0.2);
+    EXPECT_NEAR(-2.0, elbo_grad.omega()(0), 0.2);
+    EXPECT_NEAR(-2.0, elbo_grad.omega()(1), 0.2);
+  }
+}
+
+TEST_F(advi_threads_test, bad_num_threads) {
+  rng_t base_rng(0);
+  EXPECT_THROW((stan::variational::advi<Model,
+                stan::variational::normal_meanfield, rng_t>
+                (*model, cont_params, base_rng, 10, 100, 100, 1, 0)),
+               std::domain_error);
+}
+
+TEST(advi_adapt_eta, last_needed) {
+  std::vector<double> elbos(5, 0.0);
+  std::vector<int> done(5, 0);
+  double elbo_init = -10.0;
+  EXPECT_EQ(4, stan::variational::adapt_eta_last_needed(elbos, done,
+                                                        elbo_init));
+
+  // the second candidate is worse than the first, which improved on
+  // the initial ELBO, so the later candidates are not needed
+  elbos[0] = -5.0;
+  elbos[1] = -7.0;
+  done[1] = 1;
+  EXPECT_EQ(4, stan::variational::adapt_eta_last_needed(elbos, done,
+                                                        elbo_init));
+  done[0] = 1;
+  EXPECT_EQ(1, stan::variational::adapt_eta_last_needed(elbos, done,
+                                                        elbo_init));
+
+  // a first candidate worse than the initial ELBO does not decide
+  elbos[0] = -20.0;
+  elbos[1] = -30.0;
+  EXPECT_EQ(4, stan::variational::adapt_eta_last_needed(elbos, done,
+                                                        elbo_init));
+  elbos[2] = -8.0;
+  elbos[3] = -9.0;
+  done[3] = 1;
+  EXPECT_EQ(4, stan::variational::adapt_eta_last_needed(elbos, done,
+                                                        elbo_init));
+  done[2] = 1;
+  EXPECT_EQ(3, stan::variational::adapt_eta_last_needed(elbos, done,
+                                                        elbo_init));
+}
+
+TEST_F(advi_threads_test, adapt_eta) {
+  stan::variational::normal_meanfield q(cont_params);
+  for (int num_threads = 1; num_threads <= 5; num_threads += 4) {
+    rng_t base_rng(0);
+    stan::variational::advi<Model, stan::variational::normal_meanfield, rng_t>
+      test_advi(*model, cont_params, base_rng, 10, 100, 100, 1,
+                num_threads);
+    double eta = test_advi.adapt_eta(q, 50, logger);
+    EXPECT_TRUE(eta == 100 || eta == 10 || eta == 1 || eta == 0.1
+                || eta == 0.01);
+    EXPECT_TRUE(log_stream.str().find("Success!") != std::string::npos);
+    log_stream.str("");
+  }
+}
@@ -0,0 +1,162 @@
+#include <stan/variational/families/normal_lowrank.hpp>
+#include <stan/callbacks/stream_logger.hpp>
+#include <vector>
+#include <gtest/gtest.h>
+#include <test/unit/util.hpp>
+#include <boost/random/additive_combine.hpp>
+
+TEST(normal_lowrank_test, zero_init) {
+  int my_dimension = 10;
+  int my_rank = 3;
+
+  stan::variational::normal_lowrank my_normal_lowrank(my_dimension, my_rank);
+  EXPECT_EQ(my_dimension, my_normal_lowrank.dimension());
+  EXPECT_EQ(my_rank, my_normal_lowrank.rank());
+  EXPECT_EQ(my_dimension + my_rank, my_normal_lowrank.eta_dimension());
+
+  for (int i = 0; i < my_dimension; ++i) {
+    EXPECT_FLOAT_EQ(0.0, my_normal_lowrank.mu()(i));
+    EXPECT_FLOAT_EQ(0.0, my_normal_lowrank.omega()(i));
+    for (int j = 0; j < my_rank; ++j)
+      EXPECT_FLOAT_EQ(0.0, my_normal_lowrank.B()(i, j));
+  }
+}
+
+TEST(normal_lowrank_test, sizes) {
+  Eigen::Vector3d mu;
+  mu << 5.7, -3.2, 0.1332;
+
+  Eigen::Vector3d omega;
+  omega << -0.42, 0.8922, 1.34;
+
+  Eigen::MatrixXd B(3, 2);
+  B << 0.5, -0.1,
+       1.2, 0.3,
+       -0.7, 0.9;
+
+  stan::variational::normal_lowrank my_normal_lowrank(mu, omega, B);
+  EXPECT_EQ(3, my_normal_lowrank.dimension());
+  EXPECT_EQ(2, my_normal_lowrank.rank());
+
+  Eigen::MatrixXd B_short(2, 2);
+  B_short << 0.5, -0.1,
+             1.2, 0.3;
+  EXPECT_THROW(stan::variational::normal_lowrank(mu, omega, B_short),
+               std::invalid_argument);
+  EXPECT_THROW(my_normal_lowrank.set_B(B_short), std::invalid_argument);
+
+  double nan = std::numeric_limits<double>::quiet_NaN();
+  Eigen::MatrixXd B_nan = Eigen::MatrixXd::Constant(3, 2, nan);
+  EXPECT_THROW(stan::variational::normal_lowrank(mu, omega, B_nan),
+               std::domain_error);
+  EXPECT_THROW(my_normal_lowrank.set_B(B_nan), std::domain_error);
+
+  stan::variational::normal_lowrank other_rank(3, 1);
+  EXPECT_THROW(other_rank += my_normal_lowrank, std::invalid_argument);
+}
+
+TEST(normal_lowrank_test, entropy) {
+  Eigen::Vector3d mu;
+  mu << 5.7, -3.2, 0.1332;
+
+  Eigen::Vector3d omega;
+  omega << -0.42, 0.8922, 1.34;
+
+  Eigen::MatrixXd B(3, 2);
+  B << 0.5, -0.1,
+       1.2, 0.3,
+       -0.7, 0.9;
+
+  stan::variational::normal_lowrank my_normal_lowrank(mu, omega, B);
+
+  Eigen::MatrixXd Sigma = B * B.transpose();
+  Sigma.diagonal() += (2.0 * omega).array().exp().matrix();
+  double entropy_true = 0.5 * 3 * (1.0 + stan::math::LOG_TWO_PI)
+    + 0.5 * std::log(Sigma.determinant());
+
+  EXPECT_FLOAT_EQ(entropy_true, my_normal_lowrank.entropy());
+}
+
+TEST(normal_lowrank_test, transform) {
+  Eigen::Vector3d mu;
+  mu << 5.7, -3.2, 0.1332;
+
+  Eigen::Vector3d omega;
+  omega << -0.42, 0.8922, 1.34;
+
+  Eigen::MatrixXd B(3, 2);
+  B << 0.5, -0.1,
+       1.2, 0.3,
+       -0.7, 0.9;
+
+  stan::variational::normal_lowrank my_normal_lowrank(mu, omega, B);
+
+  Eigen::VectorXd eta(5);
+  eta << 0.3, -1.2, 0.8, 2.1, -0.4;
+
+  Eigen::VectorXd zeta = my_normal_lowrank.transform(eta);
+  Eigen::VectorXd zeta_true
+    = mu + eta.head(3).cwiseProduct(omega.array().exp().matrix())
+    + B * eta.tail(2);
+  for (int i = 0; i < 3; ++i)
+    EXPECT_FLOAT_EQ(zeta_true(i), zeta(i));
+
+  EXPECT_THROW(my_normal_lowrank.transform(Eigen::VectorXd::Zero(3)),
+               std::invalid_argument);
+}
+
+class flat_model {
+public:
+  template <bool propto, bool jacobian, typename T>
+  T log_prob(Eigen::Matrix<T, Eigen::Dynamic, 1>& params_r,
+             std::ostream* msgs) const {
+    return 0 * params_r.sum();
+  }
+};
+
+TEST(normal_lowrank_test, entropy_gradient) {
+  // the log density is flat, so the ELBO gradient is the entropy
+  // gradient, which is checked against finite differences
+  Eigen::Vector3d mu;
+  mu << 5.7, -3.2, 0.1332;
+
+  Eigen::Vector3d omega;
+  omega << -0.42, 0.8922, 1.34;
+
+  Eigen::MatrixXd B(3, 2);
+  B << 0.5, -0.1,
+       1.2, 0.3,
+       -0.7, 0.9;
+
+  stan::variational::normal_lowrank q(mu, omega, B);
+  stan::variational::normal_lowrank elbo_grad(3, 2);
+
+  flat_model model;
+  Eigen::VectorXd cont_params = mu;
+  boost::ecuyer1988 rng(0);
+  std::stringstream log_stream;
+  stan::callbacks::stream_logger logger(log_stream, log_stream, log_stream,
+                                        log_stream, log_stream);
+  q.calc_grad(elbo_grad, model, cont_params, 10, rng, logger);
+
+  double h = 1e-6;
+  for (int i = 0; i < 3; ++i) {
+    EXPECT_FLOAT_EQ(0.0, elbo_grad.mu()(i));
+
+    Eigen::VectorXd omega_h = omega;
+    omega_h(i) += h;
+    double d_omega
+      = (stan::variational::normal_lowrank(mu, omega_h, B).entropy()
+         - q.entropy()) / h;
+    EXPECT_NEAR(d_omega, elbo_grad.omega()(i), 1e-5);
+
+    for (int j = 0; j < 2; ++j) {
+      Eigen::MatrixXd B_h = B;
+      B_h(i, j) += h;
+      double d_B
+        = (stan::variational::normal_lowrank(mu, omega, B_h).entropy()
+           - q.entropy()) / h;
+      EXPECT_NEAR(d_B, elbo_grad.B()(i, j), 1e-5);
+    }
+  }
+}
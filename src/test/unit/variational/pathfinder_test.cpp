@@ -0,0 +1,106 @@
+#include <stan/variational/pathfinder.hpp>
+#include <boost/random/additive_combine.hpp>
+#include <gtest/gtest.h>
+#include <cmath>
+
+// explicit BFGS inverse Hessian update starting from diag(alpha)
+Eigen::MatrixXd bfgs_inverse_hessian(const Eigen::VectorXd& alpha,
+                                     const Eigen::MatrixXd& S,
+                                     const Eigen::MatrixXd& Y) {
+  int d = alpha.size();
+  Eigen::MatrixXd H = alpha.asDiagonal();
+  Eigen::MatrixXd I = Eigen::MatrixXd::Identity(d, d);
+  for (int j = 0; j < S.cols(); ++j) {
+    double rho = 1.0 / Y.col(j).dot(S.col(j));
+    H = (I - rho * S.col(j) * Y.col(j).transpose()) * H
+      * (I - rho * Y.col(j) * S.col(j).transpose())
+      + rho * S.col(j) * S.col(j).transpose();
+  }
+  return H;
+}
+
+class pathfinder_test : public testing::Test {
+public:
+  void SetUp() {
+    d = 6;
+    Eigen::MatrixXd A(d, d);
+    for (int i = 0; i < d; ++i)
+      for (int j = 0; j < d; ++j)
+        A(i, j) = std::sin(1.0 + i + 3.0 * j);
+    hessian = A * A.transpose() + Eigen::MatrixXd::Identity(d, d);
+    alpha = Eigen::VectorXd::Ones(d);
+    x = Eigen::VectorXd::LinSpaced(d, -1, 1);
+    grad = hessian * x;
+  }
+
+  void history(int m, Eigen::MatrixXd& S, Eigen::MatrixXd& Y) {
+    S.resize(d, m);
+    for (int i = 0; i < d; ++i)
+      for (int j = 0; j < m; ++j)
+        S(i, j) = std::cos(2.0 * i - j);
+    Y = hessian * S;
+  }
+
+  double log_density(const Eigen::MatrixXd& H, const Eigen::VectorXd& mu,
+                     const Eigen::VectorXd& eta) {
+    Eigen::VectorXd c = eta - mu;
+    return -0.5 * (std::log(H.determinant()) + c.dot(H.ldlt().solve(c))
+                   + d * std::log(2 * stan::math::pi()));
+  }
+
+  int d;
+  Eigen::MatrixXd hessian;
+  Eigen::VectorXd alpha, x, grad;
+};
+
+TEST_F(pathfinder_test, low_rank) {
+  Eigen::MatrixXd S, Y;
+  history(2, S, Y);
+  Eigen::MatrixXd H = bfgs_inverse_hessian(alpha, S, Y);
+  stan::variational::lbfgs_normal approx(x, grad, alpha, S, Y);
+  EXPECT_EQ(d, approx.dimension());
+  for (int i = 0; i < d; ++i)
+    EXPECT_NEAR((x - H * grad)(i), approx.mean()(i), 1e-8);
+
+  boost::ecuyer1988 rng(12345);
+  Eigen::VectorXd eta;
+  for (int n = 0; n < 10; ++n) {
+    double log_q = approx.sample(rng, eta);
+    EXPECT_NEAR(log_density(H, approx.mean(), eta), log_q, 1e-8);
+  }
+}
+
+TEST_F(pathfinder_test, dense) {
+  Eigen::MatrixXd S, Y;
+  history(4, S, Y);
+  Eigen::MatrixXd H = bfgs_inverse_hessian(alpha, S, Y);
+  stan::variational::lbfgs_normal approx(x, grad, alpha, S, Y);
+  for (int i = 0; i < d; ++i)
+    EXPECT_NEAR((x - H * grad)(i), approx.mean()(i), 1e-8);
+
+  boost::ecuyer1988 rng(12345);
+  Eigen::VectorXd eta;
+  for (int n = 0; n < 10; ++n) {
+    double log_q = approx.sample(rng, eta);
+    EXPECT_NEAR(log_density(H, approx.mean(), eta), log_q, 1e-8);
+  }
+}
+
+TEST_F(pathfinder_test, update_diagonal) {
+  Eigen::MatrixXd S, Y;
+  history(1, S, Y);
+  Eigen::VectorXd s = S.col(0);
+  Eigen::VectorXd y = Y.col(0);
+  alpha = Eigen::VectorXd::LinSpaced(d, 0.5, 2);
+
+  // diagonal of the BFGS Hessian update from the rescaled initial
+  // Hessian (y' * diag(alpha) * y) / (y' * s) * diag(1 / alpha)
+  Eigen::MatrixXd B0 = (y.dot(alpha.cwiseProduct(y)) / y.dot(s))
+    * alpha.cwiseInverse().asDiagonal();
+  Eigen::MatrixXd B1 = B0 - B0 * s * s.transpose() * B0 / s.dot(B0 * s)
+    + y * y.transpose() / y.dot(s);
+
+  stan::variational::lbfgs_normal::update_diagonal(alpha, s, y);
+  for (int i = 0; i < d; ++i)
+    EXPECT_NEAR(1 / B1(i, i), alpha(i), 1e-8);
+}